@@ -79,12 +79,24 @@
 #define CFG_SC_SIM_HK_TLM_TOPICID    SC_SIM_HK_TLM_TOPICID
 #define CFG_SC_SIM_MGMT_TLM_TOPICID  SC_SIM_MGMT_TLM_TOPICID
 #define CFG_SC_SIM_MODEL_TLM_TOPICID SC_SIM_MODEL_TLM_TOPICID
+#define CFG_SC_SIM_SENSOR_TLM_TOPICID SC_SIM_SENSOR_TLM_TOPICID
 #define CFG_KIT_TO_CMD_TOPICID       KIT_TO_CMD_TOPICID
 #define CFG_EVS_CMD_TOPICID          EVS_CMD_TOPICID
 #define CFG_TIME_CMD_TOPICID         TIME_CMD_TOPICID
 
 #define CFG_SC_SIM_TBL_LOAD_FILE  SC_SIM_TBL_LOAD_FILE
 #define CFG_SC_SIM_TBL_DUMP_FILE  SC_SIM_TBL_DUMP_FILE
+#define CFG_SC_SIM_TGT_FILE       SC_SIM_TGT_FILE
+
+#define CFG_SC_SIM_CRAFT_ID       SC_SIM_CRAFT_ID
+
+#define CFG_SC_SIM_WORKER_CNT       SC_SIM_WORKER_CNT
+#define CFG_SC_SIM_WORKER_PRIORITY  SC_SIM_WORKER_PRIORITY
+
+#define CFG_SC_SIM_SLICE_TOPICID      SC_SIM_SLICE_TOPICID
+#define CFG_SC_SIM_SLICE_BUDGET_USEC  SC_SIM_SLICE_BUDGET_USEC
+
+#define CFG_SC_SIM_LAPSE_TASK_PRIORITY  SC_SIM_LAPSE_TASK_PRIORITY
 
 
 #define APP_CONFIG(XX) \
@@ -97,11 +109,19 @@
    XX(SC_SIM_HK_TLM_TOPICID,uint32) \
    XX(SC_SIM_MGMT_TLM_TOPICID,uint32) \
    XX(SC_SIM_MODEL_TLM_TOPICID,uint32) \
+   XX(SC_SIM_SENSOR_TLM_TOPICID,uint32) \
    XX(KIT_TO_CMD_TOPICID,uint32) \
    XX(EVS_CMD_TOPICID,uint32) \
    XX(TIME_CMD_TOPICID,uint32) \
    XX(SC_SIM_TBL_LOAD_FILE,char*) \
    XX(SC_SIM_TBL_DUMP_FILE,char*) \
+   XX(SC_SIM_TGT_FILE,char*) \
+   XX(SC_SIM_CRAFT_ID,uint32) \
+   XX(SC_SIM_WORKER_CNT,uint32) \
+   XX(SC_SIM_WORKER_PRIORITY,uint32) \
+   XX(SC_SIM_SLICE_TOPICID,uint32) \
+   XX(SC_SIM_SLICE_BUDGET_USEC,uint32) \
+   XX(SC_SIM_LAPSE_TASK_PRIORITY,uint32) \
 
 DECLARE_ENUM(Config,APP_CONFIG)
 
@@ -117,6 +137,18 @@ DECLARE_ENUM(Config,APP_CONFIG)
 #define SC_SIM_APP_BASE_EID  (APP_C_FW_APP_BASE_EID +  0)
 #define SC_SIM_BASE_EID      (APP_C_FW_APP_BASE_EID + 10)
 #define SC_SIM_TBL_BASE_EID  (APP_C_FW_APP_BASE_EID + 50)
+
+#define SC_SIM_EPHEM_BASE_EID  (APP_C_FW_APP_BASE_EID + 200)
+#define SC_SIM_ORBIT_BASE_EID  (APP_C_FW_APP_BASE_EID + 210)
+#define SC_SIM_TNET_BASE_EID   (APP_C_FW_APP_BASE_EID + 220)
+#define SC_SIM_CONTACT_BASE_EID (APP_C_FW_APP_BASE_EID + 230)
+#define SC_SIM_LINK_BASE_EID    (APP_C_FW_APP_BASE_EID + 240)
+#define SC_SIM_REC_BASE_EID     (APP_C_FW_APP_BASE_EID + 250)
+#define SC_SIM_SCI_BASE_EID     (APP_C_FW_APP_BASE_EID + 260)
+#define SC_SIM_TGT_BASE_EID     (APP_C_FW_APP_BASE_EID + 270)
+#define SC_SIM_FAULT_BASE_EID   (APP_C_FW_APP_BASE_EID + 280)
+#define SC_SIM_DAG_BASE_EID     (APP_C_FW_APP_BASE_EID + 290)
+#define SC_SIM_ODE_BASE_EID     (APP_C_FW_APP_BASE_EID + 300)
         
 /*
 ** One event ID is used for all initialization debug messages. Uncomment one of
@@ -140,7 +172,7 @@ DECLARE_ENUM(Config,APP_CONFIG)
 ** SC_SIM Table Macros
 */
 
-#define SC_SIM_TBL_JSON_FILE_MAX_CHAR  5000 
+#define SC_SIM_TBL_JSON_FILE_MAX_CHAR  8000 
 #define SC_SIM_TBL_NAME                "Sim Parameters" 
 
 #endif /* _app_cfg_ */
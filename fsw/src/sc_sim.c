@@ -33,6 +33,7 @@
 */
 
 #include <string.h>
+#include <math.h>
 
 #include "cfe_mission_eds_designparameters.h"
 #include "cfe_evs_eds_cc.h"
@@ -58,12 +59,54 @@
 #define  INSTR (&(ScSim->Instr))
 #define  POWER (&(ScSim->Power))
 #define  THERM (&(ScSim->Therm))
+#define  BUS   (&(ScSim->Bus))
+#define  TMR   (&(ScSim->Timer))
+
+#define  ADCS_NOMINAL_ALT_KM  (500.0)   /* Environment altitude until an orbit is set */
+
+#define  SIM_ALT_KM_DEADBAND     (0.5)    /* Km, altitude published when it moves further */
+#define  SIM_BATT_CURR_DEADBAND  (0.02)   /* Amps, battery current published when it moves further */
+
+#define  LAPSE_GAIN  (0.25f)   /* Smoothing gain of the measured time lapse step and slice periods */
+
+/*
+** Model dependency graph declarations. A bus signal's bit is its SIM_Signal_t
+** value. State bits cover model data accessed directly, ADCS state is split
+** because C&DH only changes the control mode.
+*/
+
+#define  SIG_BIT(s)   (1u << (s))
+#define  SIG_LOADS    (((1u << POWER_LOAD_CNT) - 1) << SIG_LOAD_0)
+
+#define  STATE_ADCS_ORBIT  0x0001   /* Orbit, sun vector and eclipse */
+#define  STATE_ADCS_MODE   0x0002
+#define  STATE_CDH         0x0004
+#define  STATE_COMM        0x0008
+#define  STATE_FSW         0x0010
+#define  STATE_INSTR       0x0020
+#define  STATE_POWER       0x0040
+#define  STATE_THERM       0x0080
+#define  STATE_EVT_CMD     0x0100   /* Runtime event command list */
+#define  STATE_EPHEM       0x0200   /* Ephemeris cache, filled by orbit propagation */
+#define  STATE_TIMER       0x0400   /* Model timer wheel */
+
+/* ModelNode[] indices */
+
+#define  NODE_ADCS   0
+#define  NODE_CDH    1
+#define  NODE_COMM   2
+#define  NODE_INSTR  3
+#define  NODE_FSW    4
+#define  NODE_POWER  5
+#define  NODE_THERM  6
 
 
 /**********************/
 /** Type Definitions **/
 /**********************/
 
+/* The snapshot size is fixed at build time so SC_SIM_SNAP_Constructor() can't fail at run time */
+CompileTimeAssert(sizeof(SC_SIM_Snapshot_t) <= SC_SIM_SNAP_MAX_SIZE, ScSimSnapshotTooLarge);
 
 /**********************/
 /** Global File Data **/
@@ -91,13 +134,14 @@ static const char *ScanfStr[SC_SIM_SCANF_TYPE_CNT] =
    "%i %i",            /* SCANF_2_INT */   
    "%i %i %i",         /* SCANF_3_INT */   
    "%f",               /* SCANF_1_FLT */
-   "%lf %lf %lf",      /* SCANF_3_FLT */
-   "%lf %lf %lf %lf",  /* SCANF_4_FLT */
-   "NONE"
+   "%f %f %f",         /* SCANF_3_FLT */
+   "%f %f %f %f",      /* SCANF_4_FLT */
+   "NONE",
+   "%f %f %f %f %f %f" /* SCANF_6_FLT */
 
 };
 
-static SC_SIM_EventCmd_t SimIdleCmd = { {0,0}, SC_SIM_IDLE_TIME, SC_SIM_Subsystem_SIM,  SC_SIM_EventCmd_IDLE,  SC_SIM_SCANF_NONE,  NULL};
+static SC_SIM_EventCmd_t SimIdleCmd = { {SC_SIM_EVT_CMD_NULL_IDX,SC_SIM_EVT_CMD_NULL_IDX}, SC_SIM_IDLE_TIME, SC_SIM_Subsystem_SIM,  SC_SIM_EventCmd_IDLE,  SC_SIM_SCANF_NONE,  NULL};
 
 /* Links get resolved when sim started */
 static SC_SIM_EventCmd_t SimScenario1[SC_SIM_EVT_CMD_MAX] = 
@@ -118,7 +162,6 @@ static SC_SIM_EventCmd_t SimScenario1[SC_SIM_EVT_CMD_MAX] =
   { {0,0}, SC_SIM_INIT_TIME, SC_SIM_Subsystem_INSTR, INSTR_EVT_ENA_SCIENCE,    SC_SIM_SCANF_NONE,  NULL},
 
   { {0,0}, SC_SIM_INIT_TIME, SC_SIM_Subsystem_POWER, POWER_EVT_SET_BATT_SOC,   SC_SIM_SCANF_1_FLT,  "50"},
-  { {0,0}, SC_SIM_INIT_TIME, SC_SIM_Subsystem_POWER, POWER_EVT_SET_SA_CURRENT, SC_SIM_SCANF_1_FLT,  "0"},
 
   { {0,0}, SC_SIM_INIT_TIME, SC_SIM_Subsystem_THERM, THERM_EVT_ENA_HEATER_1,    SC_SIM_SCANF_1_INT,  "1"},
   { {0,0}, SC_SIM_INIT_TIME, SC_SIM_Subsystem_THERM, THERM_EVT_ENA_HEATER_2,    SC_SIM_SCANF_1_INT,  "1"},
@@ -165,7 +208,6 @@ static SC_SIM_EventCmd_t SimScenario2[SC_SIM_EVT_CMD_MAX] =
   { {0,0}, SC_SIM_INIT_TIME, SC_SIM_Subsystem_INSTR, INSTR_EVT_ENA_SCIENCE,    SC_SIM_SCANF_NONE,  NULL},
 
   { {0,0}, SC_SIM_INIT_TIME, SC_SIM_Subsystem_POWER, POWER_EVT_SET_BATT_SOC,   SC_SIM_SCANF_1_FLT,  "50"},
-  { {0,0}, SC_SIM_INIT_TIME, SC_SIM_Subsystem_POWER, POWER_EVT_SET_SA_CURRENT, SC_SIM_SCANF_1_FLT,  "0"},
 
   { {0,0}, SC_SIM_INIT_TIME, SC_SIM_Subsystem_THERM, THERM_EVT_ENA_HEATER_1,   SC_SIM_SCANF_1_INT,  "1"},
   { {0,0}, SC_SIM_INIT_TIME, SC_SIM_Subsystem_THERM, THERM_EVT_ENA_HEATER_2,   SC_SIM_SCANF_1_INT,  "1"},
@@ -175,9 +217,6 @@ static SC_SIM_EventCmd_t SimScenario2[SC_SIM_EVT_CMD_MAX] =
   { {0,0}, (SC_SIM_REALTIME_EPOCH-3500), SC_SIM_Subsystem_FSW,   FSW_EVT_CLR_EVT_LOG,   SC_SIM_SCANF_NONE,  NULL},
   { {0,0}, (SC_SIM_REALTIME_EPOCH-2400), SC_SIM_Subsystem_ADCS,  ADCS_EVT_EXIT_ECLIPSE, SC_SIM_SCANF_NONE,  NULL},
   { {0,0}, (SC_SIM_REALTIME_EPOCH-1400), SC_SIM_Subsystem_CDH,   CDH_EVT_WATCHDOG_RST,  SC_SIM_SCANF_NONE,  NULL},
-  { {0,0}, (SC_SIM_REALTIME_EPOCH-1398), SC_SIM_Subsystem_ADCS,  ADCS_EVT_SET_MODE,     SC_SIM_SCANF_1_INT, "1"},
-  { {0,0}, (SC_SIM_REALTIME_EPOCH-1396), SC_SIM_Subsystem_INSTR, INSTR_EVT_DIS_POWER,   SC_SIM_SCANF_NONE,  NULL},
-  { {0,0}, (SC_SIM_REALTIME_EPOCH-1394), SC_SIM_Subsystem_INSTR, INSTR_EVT_DIS_SCIENCE, SC_SIM_SCANF_NONE,  NULL},
 
   /* SC_SIM_Phase_REALTIME */
   
@@ -194,6 +233,69 @@ static SC_SIM_EventCmd_t SimScenario2[SC_SIM_EVT_CMD_MAX] =
   
 };
 
+/*
+** Recurring event cmds, see sc_sim_recur.h. Each scenario's items are
+** added to its event cmds one occurrence at a time.
+**
+** Start, Period, Count, Until, Jitter, SubSys, Id, ScanfType, Param
+*/
+
+static const SC_SIM_RECUR_Def_t SimRecur2[] =
+{
+
+  /* Ground contacts during the time lapse */
+  { (SC_SIM_REALTIME_EPOCH-3000), 1200, 0, (SC_SIM_REALTIME_EPOCH-1), 30,
+    SC_SIM_Subsystem_COMM, COMM_EVT_SCH_AOS, SC_SIM_SCANF_3_INT, "30 240 1" }
+
+};
+
+/*
+** Overlay scripts merged with a scenario's cmds when they're selected by
+** the start sim command's overlay mask, bit n selects SimOverlay[n]. Each
+** script must be time sorted.
+*/
+
+/* Faults: recorder upset, wheel failure and a downlink drop during the contact */
+static const SC_SIM_EventCmd_t SimOverlayFaults[] =
+{
+
+  { {0,0}, (SC_SIM_REALTIME_EPOCH-2000), SC_SIM_Subsystem_FSW,  FSW_EVT_REC_SEU,     SC_SIM_SCANF_1_INT, "1073741824"},
+  { {0,0}, (SC_SIM_REALTIME_EPOCH-1000), SC_SIM_Subsystem_ADCS, ADCS_EVT_WHEEL_FAIL, SC_SIM_SCANF_1_INT, "2"},
+  { {0,0}, (SC_SIM_REALTIME_EPOCH+100),  SC_SIM_Subsystem_COMM, COMM_EVT_LINK_DROP,  SC_SIM_SCANF_1_INT, "20"}
+
+};
+
+/* Training injects: low battery and a flight software hang before the contact */
+static const SC_SIM_EventCmd_t SimOverlayTraining[] =
+{
+
+  { {0,0}, (SC_SIM_REALTIME_EPOCH-1500), SC_SIM_Subsystem_POWER, POWER_EVT_SET_BATT_SOC, SC_SIM_SCANF_1_FLT, "30"},
+  { {0,0}, (SC_SIM_REALTIME_EPOCH-600),  SC_SIM_Subsystem_CDH,   CDH_EVT_FSW_HANG,       SC_SIM_SCANF_NONE,  NULL}
+
+};
+
+/* Ops timeline: science mode changes and a recorder playback during the contact */
+static const SC_SIM_EventCmd_t SimOverlayOps[] =
+{
+
+  { {0,0}, (SC_SIM_REALTIME_EPOCH-3000), SC_SIM_Subsystem_INSTR, INSTR_EVT_SET_MODE,     SC_SIM_SCANF_1_INT, "1"},
+  { {0,0}, (SC_SIM_REALTIME_EPOCH-300),  SC_SIM_Subsystem_INSTR, INSTR_EVT_DIS_SCIENCE,  SC_SIM_SCANF_NONE,  NULL},
+  { {0,0}, (SC_SIM_REALTIME_EPOCH+40),   SC_SIM_Subsystem_FSW,   FSW_EVT_START_REC_PLBK, SC_SIM_SCANF_NONE,  NULL},
+  { {0,0}, (SC_SIM_REALTIME_EPOCH+250),  SC_SIM_Subsystem_INSTR, INSTR_EVT_ENA_SCIENCE,  SC_SIM_SCANF_NONE,  NULL}
+
+};
+
+static const SC_SIM_EventStream_t SimOverlay[] =
+{
+
+  { SimOverlayFaults,   (sizeof(SimOverlayFaults)/sizeof(SC_SIM_EventCmd_t)),   0 },
+  { SimOverlayTraining, (sizeof(SimOverlayTraining)/sizeof(SC_SIM_EventCmd_t)), 0 },
+  { SimOverlayOps,      (sizeof(SimOverlayOps)/sizeof(SC_SIM_EventCmd_t)),      0 }
+
+};
+
+#define SIM_OVERLAY_CNT  (sizeof(SimOverlay)/sizeof(SC_SIM_EventStream_t))
+
 /* 
 ** Subsystem strings
 */
@@ -218,9 +320,29 @@ static const char* SubSysStr[] =
 /*******************************/
 
 static void SIM_AcceptNewTbl(void);
-static void SIM_AddEventCmd(SC_SIM_EventCmd_t *NewRunTimeCmd);
+static uint16 SIM_AddEventCmd(SC_SIM_EventCmd_t *NewRunTimeCmd);
+static void SIM_ConfigRates(void);
+static double SIM_Elapsed(double Since);
 static void SIM_ExecuteEventCmd(void);
+static bool SIM_FaultRandParam(uint8 SubSys, uint8 Id);
+static uint16 SIM_TimeLapse(uint16 MaxSteps);
+static uint16 SIM_RunLapse(uint16 MaxSteps, OS_time_t Start);
+static void SIM_LapseProgress(float *Pct, float *RemainSec);
+static void SIM_LapseTask(void);
+static void SIM_PublishSnapshot(void);
+static void SIM_SendSnapshot(void);
+static void SIM_StartLapseTask(uint16 Priority);
+static const SC_SIM_EventCmd_t *SIM_NextEventCmd(uint8 *Stream);
+static void SIM_DefineSignals(void);
+static bool SIM_Integrating(void);
+static double SIM_J2000Sec(void);
+static uint32 SIM_RatePeriod(float Hz);
+static void SIM_SampleSensors(void);
+static void SIM_ScheduleFaults(void);
+static void SIM_ScheduleRecurring(void);
 static void SIM_SetTime(uint32 NewSeconds);
+static void SIM_Step(void);
+static double SIM_Time(void);
 static void SIM_StopSim(void);
 static bool SIM_ProcessEventCmd(const SC_SIM_EventCmd_t *EventCmd);
 #if (SC_SIM_DEBUG == 1)
@@ -230,33 +352,128 @@ static void SIM_DumpScenario(uint8 StartIdx, uint8 EndIdx);
 static void ADCS_Init(ADCS_Model_t *Adcs);
 static void ADCS_Execute(ADCS_Model_t *Adcs);
 static bool ADCS_ProcessEventCmd(ADCS_Model_t *Adcs, const SC_SIM_EventCmd_t *EventCmd);
+static void ADCS_SetMode(ADCS_Model_t *Adcs, ADCS_Mode_t Mode);
+static void ADCS_WheelFail(ADCS_Model_t *Adcs, uint8 Wheel);
+static void ADCS_UpdateLoad(ADCS_Model_t *Adcs);
 
 static void CDH_Init(CDH_Model_t *Cdh);
+static void CDH_Config(CDH_Model_t *Cdh, bool InitState);
 static void CDH_Execute(CDH_Model_t *Cdh);
 static bool CDH_ProcessEventCmd(CDH_Model_t *Cdh, const SC_SIM_EventCmd_t *EventCmd);
+static void CDH_Boot(CDH_Model_t *Cdh, uint32 Time);
+static void CDH_Reset(CDH_Model_t *Cdh, SC_SIM_CdhRstCause_Enum_t Cause, uint32 Time);
+static void CDH_UpdateLoad(CDH_Model_t *Cdh);
+static void CDH_SetWake(CDH_Model_t *Cdh, uint32 Time);
+static void CDH_Wake(void *Obj, uint32 Time);
+static uint32 CDH_WatchdogExpiration(const CDH_Model_t *Cdh);
 
 static void COMM_Init(COMM_Model_t *Comm);
 static void COMM_Execute(COMM_Model_t *Comm);
 static bool COMM_ProcessEventCmd(COMM_Model_t *Comm, const SC_SIM_EventCmd_t *EventCmd);
+static void COMM_EndContact(COMM_Model_t *Comm);
+static void COMM_StartPlannedContact(COMM_Model_t *Comm);
+static void COMM_UpdateLoad(COMM_Model_t *Comm);
+static void COMM_AosTimer(void *Obj, uint32 Time);
+static void COMM_LosTimer(void *Obj, uint32 Time);
+static int16 COMM_TimePending(const COMM_Model_t *Comm);
+static uint16 COMM_TimeRemaining(const COMM_Model_t *Comm);
 
 static void FSW_Init(FSW_Model_t *Fsw);
 static void FSW_Execute(FSW_Model_t *Fsw);
+static bool FSW_StartPlayback(FSW_Model_t *Fsw, uint8 Vc, uint32 StartTime, uint32 EndTime);
+static bool FSW_StoreFile(FSW_Model_t *Fsw, uint32 Size, uint16 Apid, uint8 Vc);
+static void FSW_UpdateRecorder(FSW_Model_t *Fsw);
+static void FSW_StartFileTimers(FSW_Model_t *Fsw);
+static void FSW_HkFileTimer(void *Obj, uint32 Time);
+static void FSW_EvsFileTimer(void *Obj, uint32 Time);
 static bool FSW_ProcessEventCmd(FSW_Model_t *Fsw, const SC_SIM_EventCmd_t *EventCmd);
 
 static void INSTR_Init(INSTR_Model_t *Instr);
+static void INSTR_Config(INSTR_Model_t *Instr, bool InitState);
 static void INSTR_Execute(INSTR_Model_t *Instr);
 static bool INSTR_ProcessEventCmd(INSTR_Model_t *Instr, const SC_SIM_EventCmd_t *EventCmd);
+static void INSTR_UpdateLoad(INSTR_Model_t *Instr);
+static int16 INSTR_FileCycCnt(const INSTR_Model_t *Instr);
 
 static void POWER_Init(POWER_Model_t *Power);
+static void POWER_Config(POWER_Model_t *Power);
 static void POWER_Execute(POWER_Model_t *Power);
+static void POWER_Derivatives(void *Model, double Time, const double *Y, double *Dy);
 static bool POWER_ProcessEventCmd(POWER_Model_t *Power, const SC_SIM_EventCmd_t *EventCmd);
+static void POWER_UpdateBusLoad(POWER_Model_t *Power);
 
 static void THERM_Init(THERM_Model_t *Therm);
+static void THERM_Config(THERM_Model_t *Therm, bool InitTemps);
 static void THERM_Execute(THERM_Model_t *Therm);
+static void THERM_Derivatives(void *Model, double Time, const double *Y, double *Dy);
+static void THERM_HeatLoads(const THERM_Model_t *Therm, double *Load);
 static bool THERM_ProcessEventCmd(THERM_Model_t *Therm, const SC_SIM_EventCmd_t *EventCmd);
+static void THERM_UpdateLoad(THERM_Model_t *Therm);
 
+static void SIM_LoadMgmtTlm(SC_SIM_MgmtTlm_Payload_t *Payload);
+static void SIM_LoadModelTlm(SC_SIM_ModelTlm_Payload_t *Payload);
+static void SIM_LoadSensorTlm(SC_SIM_SensorTlm_Payload_t *Payload);
 static void SC_SIM_SendMgmtPkt(void);
 static void SC_SIM_SendModelPkt(void);
+static void SC_SIM_SendSensorPkt(void);
+
+static void SIM_StepAdcs(void);
+static void SIM_StepCdh(void);
+static void SIM_StepComm(void);
+static void SIM_StepFsw(void);
+static void SIM_StepInstr(void);
+static void SIM_StepPower(void);
+static void SIM_StepThermal(void);
+
+
+/*
+** Model dependency graph nodes in sequential execution order. Each node
+** lists the bus signals and model state it touches including through the
+** functions it calls, e.g. COMM and the instrument queue event commands.
+** The instrument hands its science files to FSW on the bus. Timer
+** callbacks run before the nodes so they aren't declared.
+*/
+static const SC_SIM_DAG_NodeDef_t ModelNode[] =
+{
+
+   /* Name, Execute,
+   **    SigIn,
+   **    SigOut,
+   **    StateIn, StateOut
+   */
+   { "ADCS", SIM_StepAdcs,
+      0,
+      SIG_BIT(SIG_ADCS_ECLIPSE) | SIG_BIT(SIG_ADCS_ATT_ERR) | SIG_BIT(SIG_ADCS_ALT_KM),
+      0, STATE_ADCS_ORBIT | STATE_EPHEM },
+   { "CDH", SIM_StepCdh,
+      0,
+      SIG_BIT(SIG_CDH_STATE),
+      0, STATE_CDH | STATE_TIMER },
+   { "COMM", SIM_StepComm,
+      SIG_BIT(SIG_FSW_REC_PCT_USED),
+      SIG_BIT(SIG_COMM_IN_CONTACT) | SIG_BIT(SIG_COMM_DL_BYTES) | SIG_BIT(SIG_LOAD_0 + POWER_LOAD_COMM),
+      STATE_ADCS_ORBIT | STATE_TIMER, STATE_COMM | STATE_EVT_CMD | STATE_EPHEM },
+   { "INSTR", SIM_StepInstr,
+      0,
+      SIG_BIT(SIG_INSTR_SCI_FILES) | SIG_BIT(SIG_INSTR_SCI_BYTES),
+      STATE_ADCS_ORBIT, STATE_INSTR | STATE_EVT_CMD },
+   { "FSW", SIM_StepFsw,
+      SIG_BIT(SIG_CDH_STATE) | SIG_BIT(SIG_COMM_IN_CONTACT) | SIG_BIT(SIG_COMM_DL_BYTES) |
+      SIG_BIT(SIG_INSTR_SCI_FILES) | SIG_BIT(SIG_INSTR_SCI_BYTES),
+      SIG_BIT(SIG_FSW_REC_PCT_USED),
+      0, STATE_FSW },
+   { "POWER", SIM_StepPower,
+      SIG_BIT(SIG_ADCS_ECLIPSE) | SIG_BIT(SIG_ADCS_MODE) | SIG_BIT(SIG_ADCS_ATT_ERR) |
+      SIG_BIT(SIG_THERM_SA_TEMP) | SIG_LOADS,
+      SIG_BIT(SIG_POWER_SA_SUN_COS) | SIG_BIT(SIG_POWER_BATT_CURR),
+      0, STATE_POWER },
+   { "THERM", SIM_StepThermal,
+      SIG_BIT(SIG_ADCS_ECLIPSE) | SIG_BIT(SIG_ADCS_ALT_KM) | SIG_BIT(SIG_POWER_SA_SUN_COS) |
+      SIG_BIT(SIG_POWER_BATT_CURR) | SIG_LOADS,
+      SIG_BIT(SIG_THERM_SA_TEMP) | SIG_BIT(SIG_LOAD_0 + POWER_LOAD_HEATER_1) | SIG_BIT(SIG_LOAD_0 + POWER_LOAD_HEATER_2),
+      0, STATE_THERM }
+
+};
 
 
 /******************************************************************************
@@ -277,17 +494,33 @@ void SC_SIM_Constructor(SC_SIM_Class_t *ScSimPtr, INITBL_Class_t *IniTbl,
 
    ScSim->Time.Seconds = SC_SIM_IDLE_TIME;
    ScSim->Phase        = SC_SIM_Phase_IDLE;
+   ScSim->CraftId      = (uint16)INITBL_GetIntConfig(IniTbl, CFG_SC_SIM_CRAFT_ID);
    ScSim->LastEventCmd = &SimIdleCmd;
    ScSim->NextEventCmd = &SimIdleCmd;
    
+   SIM_DefineSignals();
+   SC_SIM_TMR_Constructor(TMR);
+   SC_SIM_EPHEM_Constructor();
+
    ADCS_Init(ADCS);
    CDH_Init(CDH);
    COMM_Init(COMM);
    FSW_Init(FSW);
    INSTR_Init(INSTR);
+   SC_SIM_TGT_Load(&INSTR->Tgt, INITBL_GetStrConfig(IniTbl, CFG_SC_SIM_TGT_FILE));
    POWER_Init(POWER);
    THERM_Init(THERM);
 
+   SC_SIM_DAG_Build(&ScSim->Dag, ModelNode, sizeof(ModelNode)/sizeof(SC_SIM_DAG_NodeDef_t));
+   SIM_ConfigRates();
+   SC_SIM_DAG_StartWorkers(&ScSim->Dag, (uint16)INITBL_GetIntConfig(IniTbl, CFG_SC_SIM_WORKER_CNT),
+                           (uint16)INITBL_GetIntConfig(IniTbl, CFG_SC_SIM_WORKER_PRIORITY));
+
+   ScSim->Lapse.Sliced     = (INITBL_GetIntConfig(IniTbl, CFG_SC_SIM_SLICE_TOPICID) != 0);
+   ScSim->Lapse.BudgetUsec = INITBL_GetIntConfig(IniTbl, CFG_SC_SIM_SLICE_BUDGET_USEC);
+   SC_SIM_SNAP_Constructor(&ScSim->Snap, sizeof(SC_SIM_Snapshot_t));
+   SIM_StartLapseTask((uint16)INITBL_GetIntConfig(IniTbl, CFG_SC_SIM_LAPSE_TASK_PRIORITY));
+
    CFE_MSG_Init(CFE_MSG_PTR(ScSim->MgmtTlm.TelemetryHeader), 
                 CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, SC_SIM_MGMT_TLM_TOPICID)),
                 sizeof(SC_SIM_MgmtTlm_t));
@@ -296,6 +529,10 @@ void SC_SIM_Constructor(SC_SIM_Class_t *ScSimPtr, INITBL_Class_t *IniTbl,
                 CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, SC_SIM_MODEL_TLM_TOPICID)),
                 sizeof(SC_SIM_ModelTlm_t));
 
+   CFE_MSG_Init(CFE_MSG_PTR(ScSim->SensorTlm.TelemetryHeader), 
+                CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, SC_SIM_SENSOR_TLM_TOPICID)),
+                sizeof(SC_SIM_SensorTlm_t));
+
    CFE_MSG_Init(CFE_MSG_PTR(CfeSetTimeCmd.CommandBase), 
                 CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, TIME_CMD_TOPICID)), sizeof(CFE_TIME_SetTimeCmd_t));
    CFE_MSG_SetFcnCode(CFE_MSG_PTR(CfeSetTimeCmd.CommandBase), CFE_TIME_SET_TIME_CC);
@@ -341,12 +578,23 @@ void SC_SIM_Constructor(SC_SIM_Class_t *ScSimPtr, INITBL_Class_t *IniTbl,
 ** seconds level of resolution so when seconds are increment nothing is done
 ** WRT to cFE Time. When time jumps occur cFE Time is synchronized.
 **
+** A background time lapse is handed to the time lapse task and until the
+** task is done only the telemetry it publishes is sent.
+**
 */
 bool SC_SIM_Execute(void)
 {
 
    bool RetStatus = true;
-   uint16 TimeLapseExeCnt = 0;
+   bool LapseHandoff = false;
+   
+   if (ScSim->Lapse.Busy)
+   {
+      SIM_SendSnapshot();
+      return RetStatus;
+   }
+   
+   SC_SIM_LockEngine();
    
    if (ScSim->Active)
    {
@@ -362,73 +610,60 @@ bool SC_SIM_Execute(void)
       case SC_SIM_Phase_INIT:
       
          CFE_EVS_SendEvent(SC_SIM_EXECUTE_EID, CFE_EVS_EventType_DEBUG, "SC_SIM_Phase_INIT: Enter");
-         while (ScSim->NextEventCmd->Time == SC_SIM_INIT_TIME)
+         while (SIM_NextEventCmd(NULL)->Time == SC_SIM_INIT_TIME)
          {
             SIM_ExecuteEventCmd();  
          }
          
-         if (ScSim->NextEventCmd->Time < SC_SIM_REALTIME_EPOCH)
+         if (SIM_NextEventCmd(NULL)->Time < SC_SIM_REALTIME_EPOCH)
          {
             /* Time lapse starts with the first time lapse command */
             ScSim->Phase = SC_SIM_Phase_TIME_LAPSE;
-            SIM_SetTime(ScSim->NextEventCmd->Time);  
+            SIM_SetTime(SIM_NextEventCmd(NULL)->Time);  
          }
          else
          {   
             ScSim->Phase = SC_SIM_Phase_REALTIME;
             SIM_SetTime(SC_SIM_REALTIME_EPOCH);
          }
+         
+         ScSim->Lapse.Start = ScSim->Time.Seconds;
+         
+         /* Like the models, timers armed during initialization keep the time they had left */
+         SC_SIM_TMR_Skip(TMR, ScSim->Time.Seconds);
+         FSW_StartFileTimers(FSW);
 
          CFE_EVS_SendEvent(SC_SIM_EXECUTE_EID, CFE_EVS_EventType_DEBUG, "SC_SIM_Phase_INIT: Exit with next phase %d at time %d", ScSim->Phase, ScSim->Time.Seconds);
          break;   
    
       case SC_SIM_Phase_TIME_LAPSE:
 
-         CFE_EVS_SendEvent(SC_SIM_EXECUTE_EID, CFE_EVS_EventType_DEBUG, "SC_SIM_Phase_TIME_LAPSE: Enter at SimTime %d, Next Cmd Time %d", ScSim->Time.Seconds, ScSim->NextEventCmd->Time);
-         while (ScSim->Time.Seconds < SC_SIM_REALTIME_EPOCH && TimeLapseExeCnt < SC_SIM_TIME_LAPSE_EXE_CNT)
+         /* A background time lapse runs in the time lapse task and a sliced one on the slice messages */
+         if (ScSim->Lapse.Background)
          {
-         
-            if (ScSim->Time.Seconds >= (ScSim->NextEventCmd->Time))
-            {
-               SIM_ExecuteEventCmd();
-            }
-            
-            ADCS_Execute(ADCS);
-            CDH_Execute(CDH);
-            COMM_Execute(COMM);
-            FSW_Execute(FSW);
-            INSTR_Execute(INSTR);
-            POWER_Execute(POWER);
-            THERM_Execute(THERM);    
-   
-            ScSim->Time.Seconds++;
-            TimeLapseExeCnt++;
-         
-         } /* End while loop */
-
-         SIM_SetTime(ScSim->Time.Seconds);
-         if (ScSim->Time.Seconds >= SC_SIM_REALTIME_EPOCH) ScSim->Phase = SC_SIM_Phase_REALTIME;
-         
-         CFE_EVS_SendEvent(SC_SIM_EXECUTE_EID, CFE_EVS_EventType_DEBUG, "SC_SIM_Phase_TIME_LAPSE: Exit with next phase %d at time %d", ScSim->Phase, ScSim->Time.Seconds);
+            LapseHandoff = true;
+         }
+         else if (!ScSim->Lapse.Sliced)
+         {
+            SIM_TimeLapse(SC_SIM_TIME_LAPSE_EXE_CNT);
+         }
          break;   
          
       case SC_SIM_Phase_REALTIME:
 
-         if (ScSim->Time.Seconds >= (ScSim->NextEventCmd->Time))
+         if (ScSim->Time.Seconds >= (SIM_NextEventCmd(NULL)->Time))
          {
             SIM_ExecuteEventCmd();
          }
 
-         ADCS_Execute(ADCS);
-         CDH_Execute(CDH);
-         COMM_Execute(COMM);
-         FSW_Execute(FSW);
-         INSTR_Execute(INSTR);
-         POWER_Execute(POWER);
-         THERM_Execute(THERM);
-
-         ScSim->Time.Seconds++;
-         if (ScSim->Time.Seconds >= SC_SIM_REALTIME_END) SIM_StopSim();
+         /* Stopping resets the sim time so the models must not step */
+         if (ScSim->Active)
+         {
+            
+            SIM_Step();
+            if (ScSim->Time.Seconds >= SC_SIM_REALTIME_END) SIM_StopSim();
+         
+         }
             
          break;   
 
@@ -450,18 +685,170 @@ bool SC_SIM_Execute(void)
    **   model behavior 
    */
    
+   SIM_LoadMgmtTlm(&ScSim->MgmtTlm.Payload);
    SC_SIM_SendMgmtPkt();
    
    if (ScSim->Comm.InContact || SC_SIM_DEBUG)
    {
+      SIM_LoadModelTlm(&ScSim->ModelTlm.Payload);
+      SIM_LoadSensorTlm(&ScSim->SensorTlm.Payload);
       SC_SIM_SendModelPkt();
+      SC_SIM_SendSensorPkt();
    }
 
+   /* The task can't take the engine until it's unlocked */
+   if (LapseHandoff)
+   {
+      SIM_PublishSnapshot();
+      ScSim->Lapse.Busy = true;
+      OS_BinSemGive(ScSim->Lapse.RunSem);
+   }
+   
+   SC_SIM_UnlockEngine();
+   
    return RetStatus;
       
 } /* SC_SIM_Execute() */
 
 
+/******************************************************************************
+** Function: SC_SIM_ExecuteSlice
+**
+** Notes:
+**   1. The next slice's step count is the budget divided by the smoothed
+**      step duration. It can at most double from one slice to the next
+**      so a slice whose steps were unusually cheap doesn't overrun the
+**      budget.
+**
+*/
+void SC_SIM_ExecuteSlice(void)
+{
+
+   SC_SIM_Lapse_t *Lapse = &ScSim->Lapse;
+   OS_time_t Start;
+   uint16 Steps;
+   uint32 MaxSteps;
+   float  Usec;
+   
+   OS_GetLocalTime(&Start);
+   
+   if (Lapse->Woken)
+   {
+      Usec = (float)OS_TimeGetTotalMicroseconds(OS_TimeSubtract(Start, Lapse->LastWake));
+      Lapse->PeriodUsec = (Lapse->PeriodUsec > 0.0f) ? (Lapse->PeriodUsec + LAPSE_GAIN*(Usec - Lapse->PeriodUsec)) : Usec;
+   }
+   Lapse->LastWake = Start;
+   Lapse->Woken    = true;
+   
+   if (Lapse->Sliced && ScSim->Active && ScSim->Phase == SC_SIM_Phase_TIME_LAPSE)
+   {
+      
+      Steps = SIM_RunLapse(Lapse->Steps, Start);
+      
+      if (Steps > 0)
+      {
+      
+         MaxSteps = 2*(uint32)Lapse->Steps;
+         if (MaxSteps > SC_SIM_TIME_LAPSE_EXE_CNT) MaxSteps = SC_SIM_TIME_LAPSE_EXE_CNT;
+         
+         Steps = (uint16)MaxSteps;
+         if (Lapse->StepUsec > 0.0f && Lapse->BudgetUsec/Lapse->StepUsec < (float)MaxSteps)
+         {
+            Steps = (uint16)(Lapse->BudgetUsec/Lapse->StepUsec);
+         }
+         Lapse->Steps = (Steps > 0) ? Steps : 1;
+      
+      }
+   } /* End if sliced time lapse */
+
+} /* End SC_SIM_ExecuteSlice() */
+
+
+/******************************************************************************
+** Function: SC_SIM_LockEngine
+**
+** Notes:
+**   1. The time lapse task checks YieldReq after each step while it holds
+**      the mutex so the main task waits at most one step.
+**
+*/
+void SC_SIM_LockEngine(void)
+{
+
+   if (ScSim->Lapse.Background)
+   {
+      ScSim->Lapse.YieldReq = true;
+      OS_MutSemTake(ScSim->Lapse.EngineMutex);
+      ScSim->Lapse.YieldReq = false;
+   }
+
+} /* End SC_SIM_LockEngine() */
+
+
+/******************************************************************************
+** Function: SC_SIM_UnlockEngine
+**
+*/
+void SC_SIM_UnlockEngine(void)
+{
+
+   if (ScSim->Lapse.Background)
+   {
+      OS_MutSemGive(ScSim->Lapse.EngineMutex);
+   }
+
+} /* End SC_SIM_UnlockEngine() */
+
+
+/******************************************************************************
+** Functions: SC_SIM_BenchmarkCmd
+**
+** Notes:
+**   1. Each model's integrator is run on a copy starting from the model's
+**      current state. The difference is the largest state difference
+**      between the two solutions at the end of the span.
+**   2. The power model's integrated state is only current while
+**      integrating so it starts from a copy of the battery SOC.
+*/
+bool SC_SIM_BenchmarkCmd(void *DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   const SC_SIM_Benchmark_CmdPayload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, SC_SIM_Benchmark_t);
+   const SC_SIM_ODE_Class_t *Ode[2] = { &POWER->Ode, &THERM->Ode };
+   double Soc = POWER->BattSoc;
+   const double *State[2] = { &Soc, THERM->Net.Temp };
+   uint32 Span = (Cmd->Span > 0) ? Cmd->Span : 3600;
+   SC_SIM_ODE_Bench_t Bench;
+   uint16 i;
+   
+   if (Span > SC_SIM_BENCHMARK_MAX_SPAN)
+   {
+      CFE_EVS_SendEvent(SC_SIM_BENCHMARK_EID, CFE_EVS_EventType_ERROR,
+                        "Benchmark command rejected, span %u sec exceeds the %d sec limit",
+                        (unsigned int)Span, SC_SIM_BENCHMARK_MAX_SPAN);
+      return false;
+   }
+
+   for (i=0; i < 2; i++)
+   {
+      
+      SC_SIM_ODE_Benchmark(Ode[i], State[i], (double)Span, 1.0, &Bench);
+      
+      CFE_EVS_SendEvent(SC_SIM_BENCHMARK_EID, CFE_EVS_EventType_INFORMATION,
+                        "%s over %d sec, fixed 1 sec steps: %d steps, %d derivatives, %.0f usec",
+                        Ode[i]->Name, (int)Span, (int)Bench.FixedSteps, (int)Bench.FixedDerivs, Bench.FixedUsec);
+      CFE_EVS_SendEvent(SC_SIM_BENCHMARK_EID, CFE_EVS_EventType_INFORMATION,
+                        "%s over %d sec, adaptive: %d steps (%d rejected), %d derivatives, %.0f usec, difference %.2e",
+                        Ode[i]->Name, (int)Span, (int)Bench.AdaptSteps, (int)Bench.AdaptRejects,
+                        (int)Bench.AdaptDerivs, Bench.AdaptUsec, Bench.MaxDiff);
+   
+   }
+   
+   return true;
+
+} /* End SC_SIM_BenchmarkCmd() */
+
+
 /******************************************************************************
 ** Functions: SC_SIM_ProcessJMsgCmd
 **
@@ -480,6 +867,7 @@ bool SC_SIM_ProcessJMsgCmd(void *DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
    bool RetStatus = true;
    const SC_SIM_JMsgCmd_CmdPayload_t *JMsgCmd = CMDMGR_PAYLOAD_PTR(MsgPtr,SC_SIM_JMsgCmd_t);
    SC_SIM_StartSim_t StartSimCmd;
+   SC_SIM_StartPlayback_t StartPlbkCmd;
   
    CFE_EVS_SendEvent(SC_SIM_PROCESS_JMSG_CMD_EID, CFE_EVS_EventType_INFORMATION,
                      "SC_SIM_ProcessJMsgCmd() %d", JMsgCmd->Id);
@@ -487,18 +875,23 @@ bool SC_SIM_ProcessJMsgCmd(void *DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
    switch (JMsgCmd->Id)
    {
       case SC_SIM_JMsgCmdId_START_SIM_1:
-         StartSimCmd.Payload.ScenarioId = SC_SIM_Scenario_GND_CONTACT_1;
+         StartSimCmd.Payload.ScenarioId  = SC_SIM_Scenario_GND_CONTACT_1;
+         StartSimCmd.Payload.OverlayMask = 0;
          SC_SIM_StartSimCmd(DataObjPtr, CFE_MSG_PTR(StartSimCmd));
          break;
       case SC_SIM_JMsgCmdId_START_SIM_2:
-         StartSimCmd.Payload.ScenarioId = SC_SIM_Scenario_GND_CONTACT_2;
+         StartSimCmd.Payload.ScenarioId  = SC_SIM_Scenario_GND_CONTACT_2;
+         StartSimCmd.Payload.OverlayMask = 0;
          SC_SIM_StartSimCmd(DataObjPtr, CFE_MSG_PTR(StartSimCmd));
          break;
       case SC_SIM_JMsgCmdId_STOP_SIM:
          SC_SIM_StopSimCmd(DataObjPtr, NULL);
          break;
       case SC_SIM_JMsgCmdId_START_EVT_PLBK:
-         SC_SIM_StartPlbkCmd(DataObjPtr, NULL);         
+         StartPlbkCmd.Payload.Vc        = SC_SIM_RecVc_ALL;
+         StartPlbkCmd.Payload.StartTime = 0;
+         StartPlbkCmd.Payload.EndTime   = 0;
+         SC_SIM_StartPlbkCmd(DataObjPtr, CFE_MSG_PTR(StartPlbkCmd));         
          break;
       case SC_SIM_JMsgCmdId_STOP_EVT_PLBK:
          SC_SIM_StopPlbkCmd(DataObjPtr, NULL);
@@ -537,8 +930,11 @@ void SC_SIM_ResetStatus(void)
 bool SC_SIM_StartSimCmd(void *DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
 {
    int i;
+   uint64 RunId;
    bool SimEndCmdFound = false;
    bool RetStatus = true;
+   const SC_SIM_RECUR_Def_t *Recur = NULL;
+   uint16 RecurCnt = 0;
    
    const SC_SIM_StartSim_CmdPayload_t *StartSim = CMDMGR_PAYLOAD_PTR(MsgPtr,SC_SIM_StartSim_t);
    
@@ -549,6 +945,8 @@ bool SC_SIM_StartSimCmd(void *DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
    else if (StartSim->ScenarioId == SC_SIM_Scenario_GND_CONTACT_2)
    {
       ScSim->Scenario = SimScenario2;
+      Recur    = SimRecur2;
+      RecurCnt = sizeof(SimRecur2)/sizeof(SC_SIM_RECUR_Def_t);
    }
    else
    {   
@@ -558,6 +956,14 @@ bool SC_SIM_StartSimCmd(void *DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
       RetStatus = false;
    }
 
+   if (RetStatus == true && (StartSim->OverlayMask >> SIM_OVERLAY_CNT) != 0)
+   {
+      CFE_EVS_SendEvent(SC_SIM_START_SIM_ERR_EID, CFE_EVS_EventType_ERROR, 
+                        "Start Sim command rejected. Invalid overlay mask 0x%04X, only the first %d overlays are defined",
+                        StartSim->OverlayMask, (int)SIM_OVERLAY_CNT);
+      RetStatus = false;
+   }
+
 
    if (RetStatus == true)
    {   
@@ -583,6 +989,46 @@ bool SC_SIM_StartSimCmd(void *DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
       CFE_MSG_GenerateChecksum(CFE_MSG_PTR(CfeDisAppEventsCmd.CommandBase));
       CFE_SB_TransmitMsg(CFE_MSG_PTR(CfeDisAppEventsCmd.CommandBase), true);
 
+      /*
+      ** Fit the ephemeris blocks spanning the entire scenario up front so
+      ** the Chebyshev fit cost isn't incurred during the realtime phase 
+      */
+      ScSim->EpochJ2000Sec = SC_SIM_EPHEM_J2000Sec(ScSim->Tbl.Data.Ephem.EpochDay, ScSim->Tbl.Data.Ephem.EpochSec);
+      SC_SIM_EPHEM_Prepare(ScSim->EpochJ2000Sec, ScSim->EpochJ2000Sec + SC_SIM_REALTIME_END);
+
+      /* A scenario must define its own orbit, don't carry one over from a previous sim */
+      SC_SIM_ORBIT_Constructor(&ADCS->Orbit);
+      SC_SIM_ORBIT_Config(&ADCS->Orbit, &ScSim->Tbl.Data.Adcs);
+      ADCS->WheelFailed = 0;
+      SC_SIM_TMR_Reset(TMR, ScSim->Time.Seconds);
+      COMM_EndContact(COMM);
+      SC_SIM_CONTACT_Config(&COMM->Planner, &ScSim->Tbl.Data.Comm);
+      SC_SIM_LINK_Config(&COMM->Link, &ScSim->Tbl.Data.Comm);
+      COMM->PlanAosQueued = false;
+      COMM->DropCnt       = 0;
+      ScSim->Lapse.Start     = ScSim->Time.Seconds;
+      ScSim->Lapse.Steps     = 1;
+      ScSim->Lapse.SliceCnt  = 0;
+      ScSim->Lapse.SliceUsec = 0;
+      ScSim->Lapse.StepUsec  = 0.0f;
+      SC_SIM_REC_Config(&FSW->Recorder.Store, &ScSim->Tbl.Data.Fsw);
+      SC_SIM_REC_Clear(&FSW->Recorder.Store);
+      FSW->SciFileCnt = 0;
+      FSW_UpdateRecorder(FSW);
+      CDH_Config(CDH, true);
+      POWER_Config(POWER);
+      INSTR_Config(INSTR, true);
+      THERM_Config(THERM, true);
+      SIM_ConfigRates();
+
+      /* Each scenario gets its own random streams from the same table run ID */
+      RunId = ((uint64)StartSim->ScenarioId << 32) | ScSim->Tbl.Data.Rng.RunId;
+      SC_SIM_FAULT_Config(&ScSim->Fault, &ScSim->Tbl.Data.Fault, SIM_FaultRandParam);
+      SC_SIM_FAULT_Reset(&ScSim->Fault, RunId, ScSim->CraftId);
+      SC_SIM_RECUR_Reset(&ScSim->Recur, Recur, RecurCnt, RunId, ScSim->CraftId);
+      SC_SIM_SENS_Config(&ScSim->Sensor, &ScSim->Tbl.Data.Sens);
+      SC_SIM_SENS_Reset(&ScSim->Sensor, RunId, ScSim->CraftId, ScSim->Time.Seconds);
+      
       ScSim->ScenarioId   = StartSim->ScenarioId;
       ScSim->LastEventCmd = &SimIdleCmd;
       ScSim->NextEventCmd = &ScSim->Scenario[0];
@@ -637,10 +1083,30 @@ bool SC_SIM_StartSimCmd(void *DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
          } /* End if !SimEndCmdFound */
       } /* End scenario loop */
 
+      /* 
+      ** The selected overlays are merged with the scenario list as they 
+      ** execute, each overlay's first cmd is its key in the merge.
+      */
+      
+      SC_SIM_MERGE_Reset(&ScSim->Merge);
+      ScSim->OverlayMask     = StartSim->OverlayMask;
+      ScSim->LastEventStream = SC_SIM_EVT_STREAM_BASE;
+      
+      for (i=0; i < (int)SIM_OVERLAY_CNT; i++)
+      {
+         
+         ScSim->Overlay[i] = SimOverlay[i];
+         
+         if ((ScSim->OverlayMask & (1 << i)) && SimOverlay[i].Cnt > 0)
+         {
+            SC_SIM_MERGE_Add(&ScSim->Merge, i, SimOverlay[i].Cmd[0].Time);
+         }
+      
+      } /* End overlay loop */
       
       CFE_EVS_SendEvent(SC_SIM_START_SIM_EID, CFE_EVS_EventType_INFORMATION,
-                        "Start Simulation using scenario %d with %d available runtime cmd entries starting at index %d",
-                        StartSim->ScenarioId, (SC_SIM_EVT_CMD_MAX-ScSim->RunTimeCmdIdx), ScSim->RunTimeCmdIdx);
+                        "Start Simulation using scenario %d and overlays 0x%04X with %d available runtime cmd entries starting at index %d",
+                        StartSim->ScenarioId, StartSim->OverlayMask, (SC_SIM_EVT_CMD_MAX-ScSim->RunTimeCmdIdx), ScSim->RunTimeCmdIdx);
 
       #if (SC_SIM_DEBUG == 1)
          SIM_DumpScenario(0,14);
@@ -676,23 +1142,30 @@ bool SC_SIM_StopSimCmd (void *DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
 /******************************************************************************
 ** Functions: SC_SIM_StartPlbkCmd
 **
-** Stop a recorder playback.
+** Start a recorder playback of a virtual channel's files created in a time
+** range.
 **
 ** Notes:
 **  1. This function must comply with the CMDMGR_CmdFuncPtr definition
+**  2. All channels play back in priority order when the channel is ALL.
+**     An end time of 0 selects files up to the present.
+**  3. The event log playback is only started when the event log channel
+**     is selected.
 **
 */
 bool SC_SIM_StartPlbkCmd (void *DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
 {
 
    bool RetStatus = false;
+   const SC_SIM_StartPlayback_CmdPayload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, SC_SIM_StartPlayback_t);
   
    if (ScSim->Comm.InContact)
    {
-      ScSim->Fsw.Recorder.PlaybackEna = true;
-      CFE_SB_TransmitMsg(CFE_MSG_PTR(KitToStartEvtLogPlaybkCmd.CommandBase), true);
-      CFE_EVS_SendEvent(SC_SIM_START_REC_PLBK_EID, CFE_EVS_EventType_INFORMATION,"FSW recorder playback started"); 
-      RetStatus = true;
+      RetStatus = FSW_StartPlayback(FSW, Cmd->Vc, Cmd->StartTime, Cmd->EndTime);
+      if (RetStatus && (Cmd->Vc == SC_SIM_RecVc_EVT_LOG || Cmd->Vc == SC_SIM_RecVc_ALL))
+      {
+         CFE_SB_TransmitMsg(CFE_MSG_PTR(KitToStartEvtLogPlaybkCmd.CommandBase), true);
+      }
    }
    else
    {
@@ -728,23 +1201,23 @@ bool SC_SIM_StopPlbkCmd (void *DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
 
 
 /******************************************************************************
-** Function: SC_SIM_SendMgmtPkt
+** Function: SIM_LoadMgmtTlm
 **
 */
-static void SC_SIM_SendMgmtPkt(void)
+static void SIM_LoadMgmtTlm(SC_SIM_MgmtTlm_Payload_t *Payload)
 {
 
-   SC_SIM_MgmtTlm_Payload_t *Payload = &ScSim->MgmtTlm.Payload;
+   const SC_SIM_EventCmd_t  *NextEventCmd;
 
    Payload->SimTime   = ScSim->Time.Seconds;
    Payload->SimActive = ScSim->Active;
    Payload->SimPhase  = ScSim->Phase;
    Payload->SimCount  = ScSim->Count;
    
-   Payload->ContactTimePending   = ScSim->Comm.Contact.TimePending;
+   Payload->ContactTimePending   = COMM_TimePending(COMM);
    Payload->ContactLength        = ScSim->Comm.Contact.Length;   
-   Payload->ContactTimeConsumed  = ScSim->Comm.Contact.TimeConsumed;
-   Payload->ContactTimeRemaining = ScSim->Comm.Contact.TimeRemaining;
+   Payload->ContactTimeRemaining = COMM_TimeRemaining(COMM);
+   Payload->ContactTimeConsumed  = ScSim->Comm.InContact ? (ScSim->Comm.Contact.Length - Payload->ContactTimeRemaining) : 0;
    
    if (ScSim->LastEventCmd != NULL)
    {
@@ -757,15 +1230,24 @@ static void SC_SIM_SendMgmtPkt(void)
       Payload->LastEventCmdId     = SC_SIM_EventCmd_UNDEF;
    }
    
+   Payload->LastEventStream = ScSim->LastEventStream;
+   
+   SIM_LapseProgress(&Payload->LapsePct, &Payload->LapseRemainSec);
+   Payload->LapseSliceSteps = ScSim->Lapse.Sliced ? ScSim->Lapse.Steps : SC_SIM_TIME_LAPSE_EXE_CNT;
+   Payload->LapseSliceUsec  = ScSim->Lapse.SliceUsec;
+   Payload->LapseStepUsec   = ScSim->Lapse.StepUsec;
+   
    if (ScSim->NextEventCmd != NULL)
    {
-      Payload->NextEventSubSysId  = ScSim->NextEventCmd->SubSys;
-      Payload->NextEventCmdId     = ScSim->NextEventCmd->Id; 
+      NextEventCmd = SIM_NextEventCmd(&Payload->NextEventStream);
+      Payload->NextEventSubSysId  = NextEventCmd->SubSys;
+      Payload->NextEventCmdId     = NextEventCmd->Id; 
    }
    else
    {
       Payload->NextEventSubSysId  = SC_SIM_Subsystem_SIM;
       Payload->NextEventCmdId     = SC_SIM_EventCmd_UNDEF; 
+      Payload->NextEventStream    = SC_SIM_EVT_STREAM_BASE;
    }
       
    Payload->AdcsLastEventCmd.Time = ScSim->Adcs.LastEventCmd.Time;
@@ -782,21 +1264,19 @@ static void SC_SIM_SendMgmtPkt(void)
 
    Payload->ThermLastEventCmd.Time = ScSim->Therm.LastEventCmd.Time;
    Payload->ThermLastEventCmd.Id   = ScSim->Therm.LastEventCmd.Id;
-      
-   CFE_SB_TimeStampMsg(CFE_MSG_PTR(ScSim->MgmtTlm.TelemetryHeader));
-   CFE_SB_TransmitMsg(CFE_MSG_PTR(ScSim->MgmtTlm.TelemetryHeader), true);
 
-} /* End SC_SIM_SendMgmtPkt() */
+} /* End SIM_LoadMgmtTlm() */
 
 
 /******************************************************************************
-** Function: SC_SIM_SendModelPkt
+** Function: SIM_LoadModelTlm
 **
 */
-static void SC_SIM_SendModelPkt(void)
+static void SIM_LoadModelTlm(SC_SIM_ModelTlm_Payload_t *Payload)
 {
 
-   SC_SIM_ModelTlm_Payload_t *Payload = &ScSim->ModelTlm.Payload;
+   const SC_SIM_REC_Class_t  *Store;
+   uint64  DropCnt;
 
    /*
    ** ADCS
@@ -818,19 +1298,32 @@ static void SC_SIM_SendModelPkt(void)
    */
    
    Payload->InContact            = ScSim->Comm.InContact;
-   Payload->ContactTimePending   = ScSim->Comm.Contact.TimePending;
-   Payload->ContactTimeConsumed  = ScSim->Comm.Contact.TimeConsumed;
-   Payload->ContactTimeRemaining = ScSim->Comm.Contact.TimeRemaining;
+   Payload->ContactTimePending   = COMM_TimePending(COMM);
+   Payload->ContactTimeRemaining = COMM_TimeRemaining(COMM);
+   Payload->ContactTimeConsumed  = ScSim->Comm.InContact ? (ScSim->Comm.Contact.Length - Payload->ContactTimeRemaining) : 0;
    Payload->ContactLink          = ScSim->Comm.Contact.Link;
    Payload->ContactTdrsId        = ScSim->Comm.Contact.TdrsId;
    Payload->ContactDataRate      = ScSim->Comm.Contact.DataRate;
+   Payload->ContactStation       = ScSim->Comm.ContactStation;
+   Payload->ContactPlanCnt       = ScSim->Comm.Planner.PlanCnt;
+   Payload->ContactDenyCnt       = ScSim->Comm.Planner.DenyCnt;
+   Payload->LinkMargin           = ScSim->Comm.Link.Margin;
+   
+   Store = &ScSim->Fsw.Recorder.Store;
+   Payload->RecHkFileCnt  = (Store->Vc[SC_SIM_REC_VC_HK].FileCnt  > 0xFFFF) ? 0xFFFF : Store->Vc[SC_SIM_REC_VC_HK].FileCnt;
+   Payload->RecSciFileCnt = (Store->Vc[SC_SIM_REC_VC_SCI].FileCnt > 0xFFFF) ? 0xFFFF : Store->Vc[SC_SIM_REC_VC_SCI].FileCnt;
+   Payload->RecEvsFileCnt = (Store->Vc[SC_SIM_REC_VC_EVS].FileCnt > 0xFFFF) ? 0xFFFF : Store->Vc[SC_SIM_REC_VC_EVS].FileCnt;
+   DropCnt = (uint64)Store->Vc[SC_SIM_REC_VC_HK].DropCnt + Store->Vc[SC_SIM_REC_VC_SCI].DropCnt +
+             Store->Vc[SC_SIM_REC_VC_EVS].DropCnt;
+   Payload->RecDropCnt    = (DropCnt > 0xFFFF) ? 0xFFFF : (uint16)DropCnt;
+   Payload->RecPlbkVc     = Store->PlbkVc;
    
    /*
    ** FSW
    */
    
    Payload->RecPctUsed     = ScSim->Fsw.Recorder.PctUsed;
-   Payload->RecFileCnt     = ScSim->Fsw.Recorder.FileCnt;
+   Payload->RecFileCnt     = (ScSim->Fsw.Recorder.FileCnt > 0xFFFF) ? 0xFFFF : ScSim->Fsw.Recorder.FileCnt;
    Payload->RecPlaybackEna = ScSim->Fsw.Recorder.PlaybackEna;
 
    /*
@@ -841,7 +1334,22 @@ static void SC_SIM_SendModelPkt(void)
    Payload->InstrSciEna = ScSim->Instr.SciEna;
 
    Payload->InstrFileCnt    = ScSim->Instr.FileCnt;
-   Payload->InstrFileCycCnt = ScSim->Instr.FileCycCnt;
+   Payload->InstrFileCycCnt = INSTR_FileCycCnt(INSTR);
+   Payload->InstrMode       = ScSim->Instr.Sci.ModeIdx;
+   Payload->InstrReady      = SC_SIM_SCI_Ready(&ScSim->Instr.Sci, ScSim->Time.Seconds);
+   Payload->InstrDataRate   = SC_SIM_SCI_Rate(&ScSim->Instr.Sci, ScSim->Time.Seconds);
+   Payload->TgtInAccess     = (uint16)ScSim->Instr.Tgt.ActiveCnt;
+   Payload->TgtAccessCnt    = (uint16)ScSim->Instr.Tgt.AccessCnt;
+
+   Payload->CdhState      = ScSim->Cdh.State;
+   Payload->CdhBootImage  = ScSim->Cdh.BootImage;
+   Payload->CdhBootSelect = ScSim->Cdh.BootSelect;
+   Payload->CdhRstCause   = ScSim->Cdh.RstCause;
+
+   Payload->FaultCnt      = (uint16)ScSim->Fault.InjectCnt;
+   Payload->AdcsWheelFail = ScSim->Adcs.WheelFailed;
+   Payload->LinkDropCnt   = ScSim->Comm.DropCnt;
+   Payload->RecUpsetCnt   = (uint16)ScSim->Fsw.Recorder.Store.UpsetCnt;
 
    /*
    ** Power
@@ -856,13 +1364,131 @@ static void SC_SIM_SendModelPkt(void)
    
    Payload->Heater1Ena = ScSim->Therm.Heater1Ena;
    Payload->Heater2Ena = ScSim->Therm.Heater2Ena;
+
+   /*
+   ** Orbit (ADCS)
+   */
+   
+   Payload->OrbitAltKm = ScSim->Adcs.Orbit.AltKm;
+   Payload->BetaAngle  = ScSim->Adcs.BetaAngle;
+
+   /*
+   ** Power battery terminal & bus load breakdown
+   */
+   
+   Payload->BattVolt    = ScSim->Power.BattVolt;
+   Payload->BattCurrent = ScSim->Power.BattCurrent;
+
+   Payload->BusLoad     = ScSim->Power.BusLoad;
+   Payload->LoadCdh     = ScSim->Power.Load[POWER_LOAD_CDH];
+   Payload->LoadAdcs    = ScSim->Power.Load[POWER_LOAD_ADCS];
+   Payload->LoadComm    = ScSim->Power.Load[POWER_LOAD_COMM];
+   Payload->LoadInstr   = ScSim->Power.Load[POWER_LOAD_INSTR];
+   Payload->LoadHeater1 = ScSim->Power.Load[POWER_LOAD_HEATER_1];
+   Payload->LoadHeater2 = ScSim->Power.Load[POWER_LOAD_HEATER_2];
+
+   /*
+   ** Thermal network
+   */
+   
+   Payload->Heater1On    = ScSim->Therm.Heater1On;
+   Payload->Heater2On    = ScSim->Therm.Heater2On;
+   Payload->BattTemp     = SC_SIM_TNET_TempC(&ScSim->Therm.Net, THERM_NODE_BATTERY);
+   Payload->SaTemp       = SC_SIM_TNET_TempC(&ScSim->Therm.Net, THERM_NODE_SOLAR_ARRAY);
+   Payload->AvionicsTemp = SC_SIM_TNET_TempC(&ScSim->Therm.Net, THERM_NODE_AVIONICS);
+   Payload->TankTemp     = SC_SIM_TNET_TempC(&ScSim->Therm.Net, THERM_NODE_PROP_TANK);
+   
+
+} /* End SIM_LoadModelTlm() */
+
+
+/******************************************************************************
+** Function: SIM_LoadSensorTlm
+**
+*/
+static void SIM_LoadSensorTlm(SC_SIM_SensorTlm_Payload_t *Payload)
+{
+
+   const SC_SIM_SENS_Chan_t   *Chan    = ScSim->Sensor.Chan;
+
+   Payload->SimTime     = ScSim->Time.Seconds;
+   Payload->SampleCnt   = ScSim->Sensor.SampleCnt;
+
+   Payload->SunCos      = Chan[SC_SIM_SENS_CSS].Value;
+   Payload->GyroX       = Chan[SC_SIM_SENS_GYRO_X].Value;
+   Payload->GyroY       = Chan[SC_SIM_SENS_GYRO_Y].Value;
+   Payload->GyroZ       = Chan[SC_SIM_SENS_GYRO_Z].Value;
+   Payload->StAttErr    = Chan[SC_SIM_SENS_ST].Value;
    
+   Payload->BattVolt    = Chan[SC_SIM_SENS_BATT_VOLT].Value;
+   Payload->BattCurrent = Chan[SC_SIM_SENS_BATT_CURR].Value;
+
+   Payload->SaTemp       = Chan[SC_SIM_SENS_TEMP_0 + THERM_NODE_SOLAR_ARRAY].Value;
+   Payload->BattTemp     = Chan[SC_SIM_SENS_TEMP_0 + THERM_NODE_BATTERY].Value;
+   Payload->AvionicsTemp = Chan[SC_SIM_SENS_TEMP_0 + THERM_NODE_AVIONICS].Value;
+   Payload->CommTemp     = Chan[SC_SIM_SENS_TEMP_0 + THERM_NODE_COMM].Value;
+   Payload->InstrTemp    = Chan[SC_SIM_SENS_TEMP_0 + THERM_NODE_INSTR].Value;
+   Payload->TankTemp     = Chan[SC_SIM_SENS_TEMP_0 + THERM_NODE_PROP_TANK].Value;
+   Payload->RadiatorTemp = Chan[SC_SIM_SENS_TEMP_0 + THERM_NODE_RADIATOR].Value;
+   Payload->StructTemp   = Chan[SC_SIM_SENS_TEMP_0 + THERM_NODE_STRUCTURE].Value;
+
+} /* End SIM_LoadSensorTlm() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SendMgmtPkt
+**
+*/
+static void SC_SIM_SendMgmtPkt(void)
+{
+
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(ScSim->MgmtTlm.TelemetryHeader));
+   CFE_SB_TransmitMsg(CFE_MSG_PTR(ScSim->MgmtTlm.TelemetryHeader), true);
+
+} /* End SC_SIM_SendMgmtPkt() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SendModelPkt
+**
+*/
+static void SC_SIM_SendModelPkt(void)
+{
+
    CFE_SB_TimeStampMsg(CFE_MSG_PTR(ScSim->ModelTlm.TelemetryHeader));
    CFE_SB_TransmitMsg(CFE_MSG_PTR(ScSim->ModelTlm.TelemetryHeader), true);
 
 } /* End SC_SIM_SendModelPkt() */
 
 
+/******************************************************************************
+** Function: SC_SIM_SendSensorPkt
+**
+*/
+static void SC_SIM_SendSensorPkt(void)
+{
+
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(ScSim->SensorTlm.TelemetryHeader));
+   CFE_SB_TransmitMsg(CFE_MSG_PTR(ScSim->SensorTlm.TelemetryHeader), true);
+
+} /* End SC_SIM_SendSensorPkt() */
+
+
+/******************************************************************************
+** Functions: SIM_StepAdcs ... SIM_StepThermal
+**
+** Model dependency graph node functions, each executes one model.
+**
+*/
+static void SIM_StepAdcs(void)    { ADCS_Execute(ADCS);   }
+static void SIM_StepCdh(void)     { CDH_Execute(CDH);     }
+static void SIM_StepComm(void)    { COMM_Execute(COMM);   }
+static void SIM_StepFsw(void)     { FSW_Execute(FSW);     }
+static void SIM_StepInstr(void)   { INSTR_Execute(INSTR); }
+static void SIM_StepPower(void)   { POWER_Execute(POWER); }
+static void SIM_StepThermal(void) { THERM_Execute(THERM); }
+
+
 /**************************/
 /**************************/
 /****                  ****/
@@ -890,6 +1516,19 @@ static void SIM_AcceptNewTbl(void)
    CFE_EVS_SendEvent (SC_SIM_ACCEPT_NEW_TBL_EID, CFE_EVS_EventType_INFORMATION, 
                       "New simulation parameter table loaded");
    
+   SC_SIM_ORBIT_Config(&ScSim->Adcs.Orbit, &ScSim->Tbl.Data.Adcs);
+   SC_SIM_CONTACT_Config(&ScSim->Comm.Planner, &ScSim->Tbl.Data.Comm);
+   SC_SIM_LINK_Config(&ScSim->Comm.Link, &ScSim->Tbl.Data.Comm);
+   SC_SIM_REC_Config(&ScSim->Fsw.Recorder.Store, &ScSim->Tbl.Data.Fsw);
+   FSW_UpdateRecorder(FSW);
+   CDH_Config(CDH, false);
+   POWER_Config(POWER);
+   INSTR_Config(INSTR, false);
+   THERM_Config(THERM, false);
+   SC_SIM_FAULT_Config(&ScSim->Fault, &ScSim->Tbl.Data.Fault, SIM_FaultRandParam);
+   SC_SIM_SENS_Config(&ScSim->Sensor, &ScSim->Tbl.Data.Sens);
+   SIM_ConfigRates();
+   
    // TODO: Determine what to do on a parameter table load   
 
 } /* End SIM_AcceptNewTbl() */
@@ -897,24 +1536,53 @@ static void SIM_AcceptNewTbl(void)
 /******************************************************************************
 ** Function: SIM_AddEventCmd
 **
-** TODO - Add array bound check
+** Insert a command into the time sorted event list.
+**
+** Notes:
+**   1. Runtime commands use the scenario entries from RunTimeCmdIdx to the
+**      end of the scenario. An entry with no links is free and entries are
+**      freed after they're executed so long simulations can keep adding
+**      commands.
+**   2. A command is inserted after the executed commands so a command whose
+**      time has passed executes next.
+**   3. The parameter is copied to the entry when it fits, a longer one
+**      must remain valid until the command executes like the recurring
+**      event definitions' parameters.
+**   4. Returns the entry's index, SC_SIM_EVT_CMD_NULL_IDX if the command
+**      wasn't added.
 */
-static void SIM_AddEventCmd(SC_SIM_EventCmd_t *NewRunTimeCmd)
+static uint16 SIM_AddEventCmd(SC_SIM_EventCmd_t *NewRunTimeCmd)
 {
    
    bool NewCmdInserted = false;
    bool EndOfBuffer    = false;
    SC_SIM_EventCmd_t *EventCmd   = ScSim->NextEventCmd;
    SC_SIM_EventCmd_t *NewEventCmd;
+   uint16 FreeIdx = SC_SIM_EVT_CMD_NULL_IDX;
+   uint16 i;
    
+   if (ScSim->RunTimeCmdIdx != SC_SIM_EVT_CMD_NULL_IDX)
+   {
+      for (i=ScSim->RunTimeCmdIdx; i < SC_SIM_EVT_CMD_MAX; i++)
+      {
+         if (ScSim->Scenario[i].Link.Prev == SC_SIM_EVT_CMD_NULL_IDX && 
+             ScSim->Scenario[i].Link.Next == SC_SIM_EVT_CMD_NULL_IDX &&
+             &ScSim->Scenario[i] != ScSim->NextEventCmd)
+         {
+            FreeIdx = i;
+            break;
+         }
+      }
+   }
+
    CFE_EVS_SendEvent(SC_SIM_ADD_EVENT_EID, CFE_EVS_EventType_DEBUG, 
                            "Enter SIM_AddEventCmd() for subsystem %d cmd %d added at scenario index %d",
-                           NewRunTimeCmd->SubSys, NewRunTimeCmd->Id, ScSim->RunTimeCmdIdx);
+                           NewRunTimeCmd->SubSys, NewRunTimeCmd->Id, FreeIdx);
    CFE_EVS_SendEvent(SC_SIM_ADD_EVENT_EID, CFE_EVS_EventType_DEBUG, 
                            "NextCmd: (%d,%d) %d, %d, %d",
                            EventCmd->Link.Prev, EventCmd->Link.Next, EventCmd->Time, EventCmd->SubSys, EventCmd->Id);
                            
-   if (ScSim->RunTimeCmdIdx == SC_SIM_EVT_CMD_NULL_IDX)
+   if (FreeIdx == SC_SIM_EVT_CMD_NULL_IDX)
    {
       
       CFE_EVS_SendEvent(SC_SIM_EVENT_ERR_EID, CFE_EVS_EventType_ERROR, 
@@ -927,9 +1595,15 @@ static void SIM_AddEventCmd(SC_SIM_EventCmd_t *NewRunTimeCmd)
    else
    {
    
-      ScSim->Scenario[ScSim->RunTimeCmdIdx] = *NewRunTimeCmd;
+      ScSim->Scenario[FreeIdx] = *NewRunTimeCmd;
 
-      NewEventCmd = &(ScSim->Scenario[ScSim->RunTimeCmdIdx]);
+      NewEventCmd = &(ScSim->Scenario[FreeIdx]);
+      ScSim->RunTimeCmd[FreeIdx].FaultSlot = 0;
+      if (NewRunTimeCmd->Param != NULL && strlen(NewRunTimeCmd->Param) < SC_SIM_EVT_CMD_PARAM_LEN)
+      {
+         strcpy(ScSim->RunTimeCmd[FreeIdx].Param, NewRunTimeCmd->Param);
+         NewEventCmd->Param = ScSim->RunTimeCmd[FreeIdx].Param;
+      }
 
       while (!NewCmdInserted && !EndOfBuffer)
       {
@@ -942,10 +1616,17 @@ static void SIM_AddEventCmd(SC_SIM_EventCmd_t *NewRunTimeCmd)
                               EventCmd->Link.Prev, EventCmd->Link.Next, EventCmd->Time, EventCmd->SubSys, EventCmd->Id);
   
             NewEventCmd->Link.Prev = EventCmd->Link.Prev;
-            NewEventCmd->Link.Next = ScSim->Scenario[EventCmd->Link.Prev].Link.Next;
-
-            ScSim->Scenario[EventCmd->Link.Prev].Link.Next = ScSim->RunTimeCmdIdx;  
-            EventCmd->Link.Prev = ScSim->RunTimeCmdIdx;
+            NewEventCmd->Link.Next = (uint16)(EventCmd - ScSim->Scenario);
+
+            if (EventCmd->Link.Prev == SC_SIM_EVT_CMD_NULL_IDX)
+            {
+               ScSim->NextEventCmd = NewEventCmd;
+            }
+            else
+            {
+               ScSim->Scenario[EventCmd->Link.Prev].Link.Next = FreeIdx;
+            }
+            EventCmd->Link.Prev = FreeIdx;
 
             NewCmdInserted = true;
          
@@ -967,19 +1648,20 @@ static void SIM_AddEventCmd(SC_SIM_EventCmd_t *NewRunTimeCmd)
          
          CFE_EVS_SendEvent(SC_SIM_ADD_EVENT_EID, CFE_EVS_EventType_DEBUG, 
                            "New subsystem %d cmd %d added at scenario index %d",
-                           NewEventCmd->SubSys, NewEventCmd->Id, ScSim->RunTimeCmdIdx);
-
-         ScSim->RunTimeCmdIdx++;
-         if (ScSim->RunTimeCmdIdx == SC_SIM_EVT_CMD_MAX) ScSim->RunTimeCmdIdx = SC_SIM_EVT_CMD_NULL_IDX;
+                           NewEventCmd->SubSys, NewEventCmd->Id, FreeIdx);
       
       }
       else
       {
 
+         NewEventCmd->Link.Prev = SC_SIM_EVT_CMD_NULL_IDX;
+         NewEventCmd->Link.Next = SC_SIM_EVT_CMD_NULL_IDX;
+         
          CFE_EVS_SendEvent(SC_SIM_EVENT_ERR_EID, CFE_EVS_EventType_ERROR, 
                            "Aborting sim due to failure to insert new runtime cmd for subsystem %d cmd %d at index %d",
-                           NewRunTimeCmd->SubSys, NewRunTimeCmd->Id, ScSim->RunTimeCmdIdx);
+                           NewRunTimeCmd->SubSys, NewRunTimeCmd->Id, FreeIdx);
          SIM_StopSim();        
+         FreeIdx = SC_SIM_EVT_CMD_NULL_IDX;
       
       }
    
@@ -989,9 +1671,101 @@ static void SIM_AddEventCmd(SC_SIM_EventCmd_t *NewRunTimeCmd)
       SIM_DumpScenario(8,14);
    #endif
 
+   return FreeIdx;
+   
 } /* End SIM_AddEventCmd() */
 
 
+/******************************************************************************
+** Function:  SIM_ConfigRates
+**
+** Set the minor frame rate and the model rate groups from the table.
+**
+** Notes:
+**   1. C&DH, COMM, FSW and the instrument count whole seconds so they
+**      always execute on the first minor frame of each second.
+*/
+static void SIM_ConfigRates(void)
+{
+
+   const SC_SIM_TBL_Rate_t *Tbl = &ScSim->Tbl.Data.Rate;
+   uint16 Node;
+   
+   ScSim->MinorHz = (uint16)Tbl->MinorHz;
+   if (ScSim->MinorHz == 0) ScSim->MinorHz = 1;
+   if (ScSim->MinorHz > SC_SIM_MAX_MINOR_HZ) ScSim->MinorHz = SC_SIM_MAX_MINOR_HZ;
+   
+   for (Node=0; Node < ScSim->Dag.NodeCnt; Node++)
+   {
+      SC_SIM_DAG_SetPeriod(&ScSim->Dag, Node, ScSim->MinorHz);
+   }
+   SC_SIM_DAG_SetPeriod(&ScSim->Dag, NODE_ADCS,  SIM_RatePeriod(Tbl->AdcsHz));
+   SC_SIM_DAG_SetPeriod(&ScSim->Dag, NODE_POWER, SIM_RatePeriod(Tbl->PowerHz));
+   SC_SIM_DAG_SetPeriod(&ScSim->Dag, NODE_THERM, SIM_RatePeriod(Tbl->ThermHz));
+
+   CFE_EVS_SendEvent(SC_SIM_RATE_EID, CFE_EVS_EventType_DEBUG, 
+                     "Model rates with %d Hz minor frames: ADCS %.2f Hz, POWER %.2f Hz, THERM %.2f Hz",
+                     ScSim->MinorHz, (double)ScSim->MinorHz/ScSim->Dag.Period[NODE_ADCS], 
+                     (double)ScSim->MinorHz/ScSim->Dag.Period[NODE_POWER],
+                     (double)ScSim->MinorHz/ScSim->Dag.Period[NODE_THERM]);
+   
+} /* End SIM_ConfigRates() */
+
+
+/******************************************************************************
+** Function:  SIM_DefineSignals
+**
+** Define the models' output signals and their producers.
+**
+*/
+static void SIM_DefineSignals(void)
+{
+
+   static const char *LoadName[POWER_LOAD_CNT] =
+   {
+      "LoadCdh", "LoadAdcs", "LoadComm", "LoadInstr", "LoadHeater1", "LoadHeater2"
+   };
+   static const uint8 LoadProducer[POWER_LOAD_CNT] =
+   {
+      SC_SIM_Subsystem_CDH, SC_SIM_Subsystem_ADCS, SC_SIM_Subsystem_COMM,
+      SC_SIM_Subsystem_INSTR, SC_SIM_Subsystem_THERM, SC_SIM_Subsystem_THERM
+   };
+   uint16 i;
+   
+   SC_SIM_SIG_Constructor(BUS);
+
+   SC_SIM_SIG_Define(BUS, SIG_ADCS_ECLIPSE,     "AdcsEclipse",    SC_SIM_SIG_BOOL, SC_SIM_Subsystem_ADCS);
+   SC_SIM_SIG_Define(BUS, SIG_ADCS_MODE,        "AdcsMode",       SC_SIM_SIG_INT,  SC_SIM_Subsystem_ADCS);
+   SC_SIM_SIG_Define(BUS, SIG_ADCS_ATT_ERR,     "AdcsAttErr",     SC_SIM_SIG_FLT,  SC_SIM_Subsystem_ADCS);
+   SC_SIM_SIG_Define(BUS, SIG_ADCS_ALT_KM,      "AdcsAltKm",      SC_SIM_SIG_FLT,  SC_SIM_Subsystem_ADCS);
+   SC_SIM_SIG_Define(BUS, SIG_CDH_STATE,        "CdhState",       SC_SIM_SIG_INT,  SC_SIM_Subsystem_CDH);
+   SC_SIM_SIG_Define(BUS, SIG_COMM_IN_CONTACT,  "CommInContact",  SC_SIM_SIG_BOOL, SC_SIM_Subsystem_COMM);
+   SC_SIM_SIG_Define(BUS, SIG_COMM_DL_BYTES,    "CommDlBytes",    SC_SIM_SIG_INT,  SC_SIM_Subsystem_COMM);
+   SC_SIM_SIG_Define(BUS, SIG_FSW_REC_PCT_USED, "FswRecPctUsed",  SC_SIM_SIG_FLT,  SC_SIM_Subsystem_FSW);
+   SC_SIM_SIG_Define(BUS, SIG_POWER_SA_SUN_COS, "PowerSaSunCos",  SC_SIM_SIG_FLT,  SC_SIM_Subsystem_POWER);
+   SC_SIM_SIG_Define(BUS, SIG_POWER_BATT_CURR,  "PowerBattCurr",  SC_SIM_SIG_FLT,  SC_SIM_Subsystem_POWER);
+   SC_SIM_SIG_Define(BUS, SIG_THERM_SA_TEMP,    "ThermSaTemp",    SC_SIM_SIG_FLT,  SC_SIM_Subsystem_THERM);
+   SC_SIM_SIG_Define(BUS, SIG_INSTR_SCI_FILES,  "InstrSciFiles",  SC_SIM_SIG_INT,  SC_SIM_Subsystem_INSTR);
+   SC_SIM_SIG_Define(BUS, SIG_INSTR_SCI_BYTES,  "InstrSciBytes",  SC_SIM_SIG_INT,  SC_SIM_Subsystem_INSTR);
+
+   for (i=0; i < POWER_LOAD_CNT; i++)
+   {
+      SC_SIM_SIG_Define(BUS, SIG_LOAD_0 + i, LoadName[i], SC_SIM_SIG_FLT, LoadProducer[i]);
+   }
+   
+   /* Altitude and battery current change every step, only changes that
+   ** matter to the thermal environment and dissipation are published */
+   SC_SIM_SIG_SetDeadband(BUS, SIG_ADCS_ALT_KM, SIM_ALT_KM_DEADBAND);
+   SC_SIM_SIG_SetDeadband(BUS, SIG_POWER_BATT_CURR, SIM_BATT_CURR_DEADBAND);
+   
+   /* An operational SBC until the C&DH model's first step */
+   SC_SIM_SIG_SetInt(BUS, SIG_CDH_STATE, SC_SIM_CdhState_OPERATIONAL);
+   SC_SIM_SIG_SetBool(BUS, SIG_ADCS_ECLIPSE, true);
+   SC_SIM_SIG_SetFlt(BUS, SIG_ADCS_ALT_KM, ADCS_NOMINAL_ALT_KM);
+
+} /* End SIM_DefineSignals() */
+
+
 /******************************************************************************
 ** Function:  SIM_DumpScenario
 **
@@ -1017,34 +1791,78 @@ static void SIM_DumpScenario(uint8 StartIdx, uint8 EndIdx)
 */
 static void SIM_ExecuteEventCmd(void)
 {
-     
-   CFE_EVS_SendEvent(SC_SIM_EXECUTE_EVENT_EID, CFE_EVS_EventType_DEBUG, "Executing %s cmd %d at time %d",
-                     SubSysStr[ScSim->NextEventCmd->SubSys],ScSim->NextEventCmd->Id,ScSim->NextEventCmd->Time);
    
-   switch (ScSim->NextEventCmd->ScanfType)
+   uint8 Stream;
+   const SC_SIM_EventCmd_t *EventCmd = SIM_NextEventCmd(&Stream);
+   SC_SIM_EventCmd_t       *ListCmd  = ScSim->NextEventCmd;
+   SC_SIM_EventStream_t    *Overlay;
+   SC_SIM_RunTimeCmd_t     *RunTimeCmd;
+   
+   /* 
+   ** Advance before executing so commands added by the event are linked 
+   ** relative to the remaining list. The new head has no predecessor. 
+   */
+   if (Stream >= SC_SIM_EVT_STREAM_OVERLAY)
+   {
+      
+      Overlay = &ScSim->Overlay[Stream - SC_SIM_EVT_STREAM_OVERLAY];
+      if (++Overlay->Idx < Overlay->Cnt)
+      {
+         SC_SIM_MERGE_Replace(&ScSim->Merge, Overlay->Cmd[Overlay->Idx].Time);
+      }
+      else
+      {
+         SC_SIM_MERGE_Remove(&ScSim->Merge);
+      }
+   
+   }
+   else if (ListCmd->Link.Next == SC_SIM_EVT_CMD_NULL_IDX)
+   {
+      
+      /* Executed the list's last cmd, the idle cmd also ends an empty list */
+      ScSim->NextEventCmd = &SimIdleCmd;
+   
+   }
+   else
+   {
+      
+      ScSim->NextEventCmd = &(ScSim->Scenario[ListCmd->Link.Next]);
+      ScSim->NextEventCmd->Link.Prev = SC_SIM_EVT_CMD_NULL_IDX;
+   
+   }
+   
+   CFE_EVS_SendEvent(SC_SIM_EXECUTE_EVENT_EID, CFE_EVS_EventType_DEBUG, "Executing %s cmd %d at time %d from stream %d",
+                     SubSysStr[EventCmd->SubSys],EventCmd->Id,EventCmd->Time,Stream);
+   
+   switch (EventCmd->ScanfType)
    {
    case SC_SIM_SCANF_1_INT:
-      sscanf(ScSim->NextEventCmd->Param, ScanfStr[SC_SIM_SCANF_1_INT], &(ScSim->EventCmdParam.OneInt));
+      sscanf(EventCmd->Param, ScanfStr[SC_SIM_SCANF_1_INT], &(ScSim->EventCmdParam.OneInt));
       break;
 
    case SC_SIM_SCANF_2_INT:
-      sscanf(ScSim->NextEventCmd->Param, ScanfStr[SC_SIM_SCANF_2_INT], &(ScSim->EventCmdParam.TwoInt[0]), &(ScSim->EventCmdParam.TwoInt[1]));
+      sscanf(EventCmd->Param, ScanfStr[SC_SIM_SCANF_2_INT], &(ScSim->EventCmdParam.TwoInt[0]), &(ScSim->EventCmdParam.TwoInt[1]));
       break;
       
    case SC_SIM_SCANF_3_INT:
-      sscanf(ScSim->NextEventCmd->Param, ScanfStr[SC_SIM_SCANF_3_INT], &(ScSim->EventCmdParam.ThreeInt[0]), &(ScSim->EventCmdParam.ThreeInt[1]), &(ScSim->EventCmdParam.ThreeInt[2]));
+      sscanf(EventCmd->Param, ScanfStr[SC_SIM_SCANF_3_INT], &(ScSim->EventCmdParam.ThreeInt[0]), &(ScSim->EventCmdParam.ThreeInt[1]), &(ScSim->EventCmdParam.ThreeInt[2]));
       break;
       
    case SC_SIM_SCANF_1_FLT:
-      sscanf(ScSim->NextEventCmd->Param, ScanfStr[SC_SIM_SCANF_1_FLT], &(ScSim->EventCmdParam.OneFlt));
+      sscanf(EventCmd->Param, ScanfStr[SC_SIM_SCANF_1_FLT], &(ScSim->EventCmdParam.OneFlt));
       break;
 
    case SC_SIM_SCANF_3_FLT:
-      sscanf(ScSim->NextEventCmd->Param, ScanfStr[SC_SIM_SCANF_3_FLT], &(ScSim->EventCmdParam.ThreeFlt[0]), &(ScSim->EventCmdParam.ThreeFlt[1]), &(ScSim->EventCmdParam.ThreeFlt[2]));
+      sscanf(EventCmd->Param, ScanfStr[SC_SIM_SCANF_3_FLT], &(ScSim->EventCmdParam.ThreeFlt[0]), &(ScSim->EventCmdParam.ThreeFlt[1]), &(ScSim->EventCmdParam.ThreeFlt[2]));
       break;
       
    case SC_SIM_SCANF_4_FLT:
-      sscanf(ScSim->NextEventCmd->Param, ScanfStr[SC_SIM_SCANF_3_FLT], &(ScSim->EventCmdParam.FourFlt[0]), &(ScSim->EventCmdParam.FourFlt[1]), &(ScSim->EventCmdParam.FourFlt[2]), &(ScSim->EventCmdParam.FourFlt[3]));
+      sscanf(EventCmd->Param, ScanfStr[SC_SIM_SCANF_4_FLT], &(ScSim->EventCmdParam.FourFlt[0]), &(ScSim->EventCmdParam.FourFlt[1]), &(ScSim->EventCmdParam.FourFlt[2]), &(ScSim->EventCmdParam.FourFlt[3]));
+      break;
+      
+   case SC_SIM_SCANF_6_FLT:
+      sscanf(EventCmd->Param, ScanfStr[SC_SIM_SCANF_6_FLT], &(ScSim->EventCmdParam.SixFlt[0]), &(ScSim->EventCmdParam.SixFlt[1]), &(ScSim->EventCmdParam.SixFlt[2]),
+             &(ScSim->EventCmdParam.SixFlt[3]), &(ScSim->EventCmdParam.SixFlt[4]), &(ScSim->EventCmdParam.SixFlt[5]));
       break;
       
    case SC_SIM_SCANF_NONE:
@@ -1055,56 +1873,576 @@ static void SIM_ExecuteEventCmd(void)
 
    } /* End scanf switch */
 
-   switch (ScSim->NextEventCmd->SubSys)
+   switch (EventCmd->SubSys)
    {
 
       case SC_SIM_Subsystem_SIM:
-         SIM_ProcessEventCmd(ScSim->NextEventCmd);
+         SIM_ProcessEventCmd(EventCmd);
          break;
 
       case SC_SIM_Subsystem_ADCS:
-         ADCS_ProcessEventCmd(ADCS, ScSim->NextEventCmd);
+         ADCS_ProcessEventCmd(ADCS, EventCmd);
          break;
       
       case SC_SIM_Subsystem_CDH:
-         CDH_ProcessEventCmd(CDH, ScSim->NextEventCmd);
+         CDH_ProcessEventCmd(CDH, EventCmd);
          break;
       
       case SC_SIM_Subsystem_COMM:
-         COMM_ProcessEventCmd(COMM, ScSim->NextEventCmd);
+         COMM_ProcessEventCmd(COMM, EventCmd);
          break;
       
       case SC_SIM_Subsystem_FSW:
-         FSW_ProcessEventCmd(FSW, ScSim->NextEventCmd);
+         FSW_ProcessEventCmd(FSW, EventCmd);
          break;
       
       case SC_SIM_Subsystem_INSTR:
-         INSTR_ProcessEventCmd(INSTR, ScSim->NextEventCmd);
+         INSTR_ProcessEventCmd(INSTR, EventCmd);
          break;
 
       case SC_SIM_Subsystem_POWER:
-         POWER_ProcessEventCmd(POWER, ScSim->NextEventCmd);
+         POWER_ProcessEventCmd(POWER, EventCmd);
          break;
       
       case SC_SIM_Subsystem_THERM:
-         THERM_ProcessEventCmd(THERM, ScSim->NextEventCmd);
+         THERM_ProcessEventCmd(THERM, EventCmd);
          break;
 
-      default:
-         break;
-   
-   } /* End subsystem switch */
- 
-   
-   ScSim->LastEventCmd = ScSim->NextEventCmd;
-   
-   ScSim->NextEventCmd = &(ScSim->Scenario[ScSim->NextEventCmd->Link.Next]);
-       
-   CFE_EVS_SendEvent(SC_SIM_EXECUTE_EVENT_EID, CFE_EVS_EventType_DEBUG, 
-                     "Exit SIM_ExecuteEventCmd(): Next Cmd link (%d,%d), time %d, susbsy %d, cmd %d",
-                     ScSim->NextEventCmd->Link.Prev, ScSim->NextEventCmd->Link.Next, ScSim->NextEventCmd->Time, ScSim->NextEventCmd->SubSys, ScSim->NextEventCmd->Id);
+      default:
+         break;
+   
+   } /* End subsystem switch */
+ 
+   
+   ScSim->LastEventCmd    = EventCmd;
+   ScSim->LastEventStream = Stream;
+   
+   /* Executed runtime entries are returned to the free pool */
+   if (Stream == SC_SIM_EVT_STREAM_RUNTIME)
+   {
+      RunTimeCmd = &ScSim->RunTimeCmd[ListCmd - ScSim->Scenario];
+      if (RunTimeCmd->FaultSlot > 0)
+      {
+         SC_SIM_FAULT_Injected(&ScSim->Fault, RunTimeCmd->FaultSlot - 1, EventCmd->Param, ScSim->Time.Seconds);
+         RunTimeCmd->FaultSlot = 0;
+      }
+      ListCmd->Link.Prev = SC_SIM_EVT_CMD_NULL_IDX;
+      ListCmd->Link.Next = SC_SIM_EVT_CMD_NULL_IDX;
+   }
+       
+   CFE_EVS_SendEvent(SC_SIM_EXECUTE_EVENT_EID, CFE_EVS_EventType_DEBUG, 
+                     "Exit SIM_ExecuteEventCmd(): Next Cmd link (%d,%d), time %d, susbsy %d, cmd %d",
+                     ScSim->NextEventCmd->Link.Prev, ScSim->NextEventCmd->Link.Next, ScSim->NextEventCmd->Time, ScSim->NextEventCmd->SubSys, ScSim->NextEventCmd->Id);
+   
+} /* End SIM_ExecuteEventCmd() */
+
+
+/******************************************************************************
+** Function:  SIM_NextEventCmd
+**
+** Return the next event cmd of the scenario list merged with the overlays
+** and, if Stream isn't NULL, the cmd's stream ID.
+**
+** Notes:
+**   1. A scenario list cmd executes before an overlay cmd with the same
+**      time.
+**   2. The list's runtime entries are reported as their own stream.
+*/
+static const SC_SIM_EventCmd_t *SIM_NextEventCmd(uint8 *Stream)
+{
+   
+   const SC_SIM_MERGE_Key_t *Top      = SC_SIM_MERGE_Top(&ScSim->Merge);
+   const SC_SIM_EventCmd_t  *EventCmd = ScSim->NextEventCmd;
+   uint8 EventStream = SC_SIM_EVT_STREAM_BASE;
+   
+   if (Top != NULL && Top->Time < EventCmd->Time)
+   {
+      
+      EventCmd    = &ScSim->Overlay[Top->Stream].Cmd[ScSim->Overlay[Top->Stream].Idx];
+      EventStream = SC_SIM_EVT_STREAM_OVERLAY + Top->Stream;
+   
+   }
+   else if (ScSim->Scenario != NULL && EventCmd >= &ScSim->Scenario[0] &&
+            EventCmd < &ScSim->Scenario[SC_SIM_EVT_CMD_MAX] && 
+            (EventCmd - ScSim->Scenario) >= ScSim->RunTimeCmdIdx)
+   {
+      
+      EventStream = SC_SIM_EVT_STREAM_RUNTIME;
+   
+   }
+   
+   if (Stream != NULL) *Stream = EventStream;
+   
+   return EventCmd;
+   
+} /* End SIM_NextEventCmd() */
+
+
+/******************************************************************************
+** Function:  SIM_TimeLapse
+**
+** Run up to MaxSteps time lapse steps and return the number run. Time
+** lapse ends at the realtime epoch. Stops early when the main task is
+** waiting for the engine mutex.
+**
+*/
+static uint16 SIM_TimeLapse(uint16 MaxSteps)
+{
+   
+   uint16 Steps = 0;
+   
+   CFE_EVS_SendEvent(SC_SIM_EXECUTE_EID, CFE_EVS_EventType_DEBUG, "SC_SIM_Phase_TIME_LAPSE: Enter at SimTime %d, Next Cmd Time %d", ScSim->Time.Seconds, SIM_NextEventCmd(NULL)->Time);
+   while (ScSim->Active && ScSim->Time.Seconds < SC_SIM_REALTIME_EPOCH && Steps < MaxSteps && !ScSim->Lapse.YieldReq)
+   {
+   
+      if (ScSim->Time.Seconds >= (SIM_NextEventCmd(NULL)->Time))
+      {
+         SIM_ExecuteEventCmd();
+         
+         /* Stopping resets the sim time so the models must not step */
+         if (!ScSim->Active) break;
+      }
+      
+      SIM_Step();
+      Steps++;
+   
+   } /* End while loop */
+
+   if (ScSim->Active)
+   {
+      SIM_SetTime(ScSim->Time.Seconds);
+      if (ScSim->Time.Seconds >= SC_SIM_REALTIME_EPOCH) ScSim->Phase = SC_SIM_Phase_REALTIME;
+   }
+   
+   CFE_EVS_SendEvent(SC_SIM_EXECUTE_EID, CFE_EVS_EventType_DEBUG, "SC_SIM_Phase_TIME_LAPSE: Exit with next phase %d at time %d", ScSim->Phase, ScSim->Time.Seconds);
+
+   return Steps;
+   
+} /* End SIM_TimeLapse() */
+
+
+/******************************************************************************
+** Function:  SIM_RunLapse
+**
+** Run up to MaxSteps time lapse steps and measure them from Start. Return
+** the number of steps run.
+**
+*/
+static uint16 SIM_RunLapse(uint16 MaxSteps, OS_time_t Start)
+{
+   
+   SC_SIM_Lapse_t *Lapse = &ScSim->Lapse;
+   OS_time_t End;
+   uint16 Steps;
+   float  Usec;
+   
+   Steps = SIM_TimeLapse(MaxSteps);
+      
+   OS_GetLocalTime(&End);
+   Lapse->SliceUsec = (uint32)OS_TimeGetTotalMicroseconds(OS_TimeSubtract(End, Start));
+   Lapse->SliceCnt++;
+      
+   if (Steps > 0)
+   {
+      Usec = (float)Lapse->SliceUsec/(float)Steps;
+      Lapse->StepUsec = (Lapse->StepUsec > 0.0f) ? (Lapse->StepUsec + LAPSE_GAIN*(Usec - Lapse->StepUsec)) : Usec;
+   }
+   
+   return Steps;
+   
+} /* End SIM_RunLapse() */
+
+
+/******************************************************************************
+** Function:  SIM_LapseProgress
+**
+** Return the time lapse's percent complete and the estimated wall time to
+** finish it.
+**
+** Notes:
+**   1. An unsliced time lapse runs SC_SIM_TIME_LAPSE_EXE_CNT steps per 1Hz
+**      execute. A sliced time lapse's estimate uses the current slice step
+**      count and the measured slice period so it's 0 until a period has
+**      been measured.
+**   2. A background time lapse's estimate uses the measured step duration
+**      that includes the time the task was preempted.
+*/
+static void SIM_LapseProgress(float *Pct, float *RemainSec)
+{
+   
+   const SC_SIM_Lapse_t *Lapse = &ScSim->Lapse;
+   uint32 Remain;
+   uint32 Wakes;
+   
+   *Pct       = 0.0f;
+   *RemainSec = 0.0f;
+   
+   if (ScSim->Phase == SC_SIM_Phase_REALTIME)
+   {
+      *Pct = 100.0f;
+   }
+   else if (ScSim->Phase == SC_SIM_Phase_TIME_LAPSE && Lapse->Start < SC_SIM_REALTIME_EPOCH)
+   {
+      
+      Remain = SC_SIM_REALTIME_EPOCH - ScSim->Time.Seconds;
+      *Pct   = 100.0f*(float)(ScSim->Time.Seconds - Lapse->Start)/(float)(SC_SIM_REALTIME_EPOCH - Lapse->Start);
+      
+      if (Lapse->Background)
+      {
+         *RemainSec = (float)Remain*Lapse->StepUsec/1.0e6f;
+      }
+      else if (Lapse->Sliced)
+      {
+         Wakes = (Remain + Lapse->Steps - 1)/Lapse->Steps;
+         *RemainSec = (float)Wakes*Lapse->PeriodUsec/1.0e6f;
+      }
+      else
+      {
+         *RemainSec = (float)((Remain + SC_SIM_TIME_LAPSE_EXE_CNT - 1)/SC_SIM_TIME_LAPSE_EXE_CNT);
+      }
+   
+   }
+   
+} /* End SIM_LapseProgress() */
+
+
+/******************************************************************************
+** Function:  SIM_LapseTask
+**
+** Run each time lapse handed over by SC_SIM_Execute() to its end or until
+** the sim leaves the time lapse phase, publishing the telemetry after
+** each run of steps.
+**
+** Notes:
+**   1. A command may restart or stop the sim while the task waits for the
+**      engine mutex so the phase is checked before each run of steps.
+**
+*/
+static void SIM_LapseTask(void)
+{
+   
+   SC_SIM_Lapse_t *Lapse = &ScSim->Lapse;
+   OS_time_t Start;
+   bool Running;
+   
+   while (OS_BinSemTake(Lapse->RunSem) == OS_SUCCESS)
+   {
+      do
+      {
+      
+         OS_MutSemTake(Lapse->EngineMutex);
+         
+         Running = (ScSim->Active && ScSim->Phase == SC_SIM_Phase_TIME_LAPSE);
+         if (Running)
+         {
+            OS_GetLocalTime(&Start);
+            SIM_RunLapse(SC_SIM_TIME_LAPSE_EXE_CNT, Start);
+            Running = (ScSim->Active && ScSim->Phase == SC_SIM_Phase_TIME_LAPSE);
+         }
+         
+         Lapse->Busy = Running;
+         SIM_PublishSnapshot();
+         
+         OS_MutSemGive(Lapse->EngineMutex);
+      
+      } while (Running);
+   
+   } /* End while run sem */
+   
+} /* End SIM_LapseTask() */
+
+
+/******************************************************************************
+** Function:  SIM_PublishSnapshot
+**
+** Must be called while holding the engine mutex.
+**
+*/
+static void SIM_PublishSnapshot(void)
+{
+   
+   SC_SIM_Snapshot_t *Stage = &ScSim->Stage;
+   
+   SIM_LoadMgmtTlm(&Stage->Mgmt);
+   SIM_LoadModelTlm(&Stage->Model);
+   SIM_LoadSensorTlm(&Stage->Sensor);
+   Stage->InContact = ScSim->Comm.InContact;
+   
+   SC_SIM_SNAP_Write(&ScSim->Snap, Stage);
+   
+} /* End SIM_PublishSnapshot() */
+
+
+/******************************************************************************
+** Function:  SIM_SendSnapshot
+**
+** Send the telemetry last published by the time lapse task. Called by the
+** main task without the engine mutex.
+**
+*/
+static void SIM_SendSnapshot(void)
+{
+   
+   SC_SIM_Snapshot_t Snapshot;
+   
+   if (SC_SIM_SNAP_Read(&ScSim->Snap, &Snapshot))
+   {
+      
+      ScSim->MgmtTlm.Payload = Snapshot.Mgmt;
+      SC_SIM_SendMgmtPkt();
+      
+      if (Snapshot.InContact || SC_SIM_DEBUG)
+      {
+         ScSim->ModelTlm.Payload  = Snapshot.Model;
+         ScSim->SensorTlm.Payload = Snapshot.Sensor;
+         SC_SIM_SendModelPkt();
+         SC_SIM_SendSensorPkt();
+      }
+   
+   }
+   
+} /* End SIM_SendSnapshot() */
+
+
+/******************************************************************************
+** Function:  SIM_StartLapseTask
+**
+** Create the background time lapse task, a Priority of 0 runs the time
+** lapse in the main task.
+**
+** Notes:
+**   1. A background time lapse replaces a sliced one.
+**
+*/
+static void SIM_StartLapseTask(uint16 Priority)
+{
+   
+   CFE_ES_TaskId_t TaskId;
+   int32 Status;
+   
+   if (Priority == 0) return;
+   
+   Status = OS_MutSemCreate(&ScSim->Lapse.EngineMutex, "SC_SIM_ENGINE", 0);
+   if (Status == OS_SUCCESS) Status = OS_BinSemCreate(&ScSim->Lapse.RunSem, "SC_SIM_LAPSE", 0, 0);
+   
+   if (Status == OS_SUCCESS)
+   {
+      Status = CFE_ES_CreateChildTask(&TaskId, "SC_SIM_LAPSE", SIM_LapseTask, CFE_ES_TASK_STACK_ALLOCATE,
+                                      SC_SIM_LAPSE_TASK_STACK, Priority, 0);
+      if (Status == CFE_SUCCESS)
+      {
+         ScSim->Lapse.Background = true;
+         ScSim->Lapse.Sliced     = false;
+      }
+   }
+   
+   if (!ScSim->Lapse.Background)
+   {
+      CFE_EVS_SendEvent(SC_SIM_LAPSE_TASK_EID, CFE_EVS_EventType_ERROR,
+                        "Time lapse task creation failed, status 0x%08X. Time lapse runs in the main task", (unsigned int)Status);
+   }
+   
+} /* End SIM_StartLapseTask() */
+
+
+/******************************************************************************
+** Function:  SIM_Elapsed
+**
+** Return the sim seconds since a previous SIM_Time().
+**
+** Notes:
+**   1. The difference is rounded to whole minor frames so a model's time
+**      step is exactly the same every execution of its rate group.
+*/
+static double SIM_Elapsed(double Since)
+{
+
+   return floor((SIM_Time() - Since)*ScSim->MinorHz + 0.5)/(double)ScSim->MinorHz;
+
+} /* SIM_Elapsed() */
+
+
+/******************************************************************************
+** Function:  SIM_Integrating
+**
+** Return true if the continuous models use error controlled integration.
+** Only time-lapse uses it so realtime runs keep their fixed steps.
+*/
+static bool SIM_Integrating(void)
+{
+
+   return (ScSim->Tbl.Data.Integ.Adaptive && ScSim->Phase == SC_SIM_Phase_TIME_LAPSE);
+
+} /* SIM_Integrating() */
+
+
+/******************************************************************************
+** Function:  SIM_J2000Sec
+**
+** Return the current sim time in seconds since J2000 for ephemeris queries.
+*/
+static double SIM_J2000Sec(void)
+{
+
+   return (ScSim->EpochJ2000Sec + SIM_Time());
+
+} /* SIM_J2000Sec() */
+
+
+/******************************************************************************
+** Function:  SIM_RatePeriod
+**
+** Return the minor frames between executions for a rate, a rate that isn't
+** positive executes once a second.
+*/
+static uint32 SIM_RatePeriod(float Hz)
+{
+
+   uint32 Period = ScSim->MinorHz;
+   
+   if (Hz > 0.0)
+   {
+      Period = (uint32)floor((double)ScSim->MinorHz/Hz + 0.5);
+      if (Period == 0) Period = 1;
+   }
+   
+   return Period;
+
+} /* SIM_RatePeriod() */
+
+
+/******************************************************************************
+** Function:  SIM_FaultRandParam
+**
+** Return true if the event command takes any parameter from 0 to 2^31-1
+** so a fault slot can draw a random parameter for it.
+**
+** Notes:
+**   1. SC_SIM_FAULT_RandParamFunc_t definition.
+**   2. The wheel is taken modulo the wheel count and the recorder upset
+**      location is a fraction of the recorder memory scaled to 2^31.
+*/
+static bool SIM_FaultRandParam(uint8 SubSys, uint8 Id)
+{
+
+   return ((SubSys == SC_SIM_Subsystem_ADCS && Id == ADCS_EVT_WHEEL_FAIL) ||
+           (SubSys == SC_SIM_Subsystem_FSW  && Id == FSW_EVT_REC_SEU));
+
+} /* SIM_FaultRandParam() */
+
+
+/******************************************************************************
+** Function:  SIM_ScheduleFaults
+**
+** Add the next fault of each fault slot whose pending fault time has been
+** reached to the event command list.
+**
+** Notes:
+**   1. Faults are only injected into the models, a slot targeting the sim
+**      or an undefined subsystem is sampled but never added.
+**   2. The entry records the slot so the fault is counted when the event
+**      cmd executes, see SIM_ExecuteEventCmd().
+*/
+static void SIM_ScheduleFaults(void)
+{
+
+   const SC_SIM_FAULT_Slot_t *Slot;
+   SC_SIM_EventCmd_t FaultEventCmd;
+   uint16 CmdIdx;
+   
+   while ((Slot = SC_SIM_FAULT_Schedule(&ScSim->Fault, ScSim->Time.Seconds)) != NULL)
+   {
+      
+      if (Slot->NextTime < SC_SIM_REALTIME_END &&
+          Slot->SubSys > SC_SIM_Subsystem_SIM && Slot->SubSys < SC_SIM_Subsystem_COUNT)
+      {
+         
+         FaultEventCmd.Link.Prev = SC_SIM_EVT_CMD_NULL_IDX;
+         FaultEventCmd.Link.Next = SC_SIM_EVT_CMD_NULL_IDX;
+         FaultEventCmd.Time      = (int32)Slot->NextTime;
+         FaultEventCmd.SubSys    = Slot->SubSys;
+         FaultEventCmd.Id        = Slot->Id;
+         FaultEventCmd.ScanfType = SC_SIM_SCANF_1_INT;
+         FaultEventCmd.Param     = Slot->ParamStr;
+      
+         CmdIdx = SIM_AddEventCmd(&FaultEventCmd);
+         if (CmdIdx != SC_SIM_EVT_CMD_NULL_IDX)
+         {
+            ScSim->RunTimeCmd[CmdIdx].FaultSlot = (uint8)(Slot - ScSim->Fault.Slot) + 1;
+         }
+      
+      }
+   } /* End while slot due */
+
+} /* SIM_ScheduleFaults() */
+
+
+/******************************************************************************
+** Function:  SIM_ScheduleRecurring
+**
+** Add the next occurrence of each recurring item whose pending occurrence
+** time has been reached to the event command list.
+**
+*/
+static void SIM_ScheduleRecurring(void)
+{
+
+   const SC_SIM_RECUR_Item_t *Item;
+   SC_SIM_EventCmd_t RecurEventCmd;
+   
+   while ((Item = SC_SIM_RECUR_Schedule(&ScSim->Recur, ScSim->Time.Seconds)) != NULL)
+   {
+      
+      if (Item->NextTime < SC_SIM_REALTIME_END)
+      {
+         
+         RecurEventCmd.Link.Prev = SC_SIM_EVT_CMD_NULL_IDX;
+         RecurEventCmd.Link.Next = SC_SIM_EVT_CMD_NULL_IDX;
+         RecurEventCmd.Time      = (int32)Item->NextTime;
+         RecurEventCmd.SubSys    = (SC_SIM_Subsystem_Enum_t)Item->Def->SubSys;
+         RecurEventCmd.Id        = Item->Def->Id;
+         RecurEventCmd.ScanfType = (SC_SIM_ScanfType_t)Item->Def->ScanfType;
+         RecurEventCmd.Param     = Item->Def->Param;
+      
+         SIM_AddEventCmd(&RecurEventCmd);
+      
+      }
+   } /* End while item due */
+
+} /* SIM_ScheduleRecurring() */
+
+
+/******************************************************************************
+** Function:  SIM_SampleSensors
+**
+** Pass the models' current truth values to the sensor models.
+**
+** Notes:
+**   1. There is no attitude dynamics model so the gyros measure a zero
+**      body rate and only show their noise and bias.
+*/
+static void SIM_SampleSensors(void)
+{
+
+   float  Truth[SC_SIM_SENS_CHAN_CNT];
+   uint16 i;
    
-} /* End SIM_ExecuteEventCmd() */
+   Truth[SC_SIM_SENS_CSS]       = ScSim->Power.SaSunCos;
+   Truth[SC_SIM_SENS_GYRO_X]    = 0.0;
+   Truth[SC_SIM_SENS_GYRO_Y]    = 0.0;
+   Truth[SC_SIM_SENS_GYRO_Z]    = 0.0;
+   Truth[SC_SIM_SENS_ST]        = (float)ScSim->Adcs.AttErr;
+   Truth[SC_SIM_SENS_BATT_VOLT] = ScSim->Power.BattVolt;
+   Truth[SC_SIM_SENS_BATT_CURR] = ScSim->Power.BattCurrent;
+
+   for (i=0; i < SC_SIM_SENS_TEMP_CNT; i++)
+   {
+      Truth[SC_SIM_SENS_TEMP_0 + i] = (float)SC_SIM_TNET_TempC(&ScSim->Therm.Net, i);
+   }
+
+   SC_SIM_SENS_Sample(&ScSim->Sensor, ScSim->Time.Seconds, Truth);
+
+} /* SIM_SampleSensors() */
 
 
 /******************************************************************************
@@ -1128,6 +2466,60 @@ static void SIM_SetTime(uint32 NewSeconds)
 
 } /* SIM_SetTime() */
 
+
+/******************************************************************************
+** Function:  SIM_Step
+**
+** Advance the sim one second.
+**
+** Notes:
+**   1. The second is divided into minor frames and each model executes on
+**      the frames of its rate group. Time.Subseconds holds the start of
+**      the current minor frame.
+**   2. Event commands, faults and sensor samples have one second
+**      resolution so they go with the first minor frame.
+**   3. Model timers expire before the models execute so a timer set for
+**      the current second affects this step.
+*/
+static void SIM_Step(void)
+{
+
+   uint32 Frame = ScSim->Time.Seconds*ScSim->MinorHz;
+   
+   SC_SIM_TMR_Run(TMR, ScSim->Time.Seconds);
+   SIM_ScheduleFaults();
+   SIM_ScheduleRecurring();
+   
+   for (ScSim->MinorFrame = 0; ScSim->MinorFrame < ScSim->MinorHz; ScSim->MinorFrame++)
+   {
+      
+      ScSim->Time.Subseconds = (uint32)(((uint64)ScSim->MinorFrame << 32)/ScSim->MinorHz);
+      SC_SIM_DAG_Run(&ScSim->Dag, BUS, Frame + ScSim->MinorFrame);
+      
+      if (ScSim->MinorFrame == 0) SIM_SampleSensors();
+   
+   }
+   
+   ScSim->MinorFrame      = 0;
+   ScSim->Time.Subseconds = 0;
+   ScSim->Time.Seconds++;
+
+} /* SIM_Step() */
+
+
+/******************************************************************************
+** Function:  SIM_Time
+**
+** Return the start of the current minor frame in sim seconds.
+*/
+static double SIM_Time(void)
+{
+
+   return ((double)ScSim->Time.Seconds + (double)ScSim->MinorFrame/(double)ScSim->MinorHz);
+
+} /* SIM_Time() */
+
+
 /******************************************************************************
 ** Function: SIM_StopSim
 **
@@ -1143,6 +2535,8 @@ static void SIM_StopSim(void)
    
    ScSim->LastEventCmd = &SimIdleCmd;
    ScSim->NextEventCmd = &SimIdleCmd;
+   ScSim->LastEventStream = SC_SIM_EVT_STREAM_BASE;
+   SC_SIM_MERGE_Reset(&ScSim->Merge);
 
    SC_SIM_StopPlbkCmd(NULL, NULL);
 
@@ -1228,6 +2622,9 @@ static void ADCS_Init(ADCS_Model_t *Adcs)
  
    Adcs->Eclipse = true;
    Adcs->Mode    = SC_SIM_AdcsMode_UNDEF;
+   SC_SIM_SIG_SetInt(BUS, SIG_ADCS_MODE, Adcs->Mode);   /* Only changed by ADCS_SetMode() */
+
+   SC_SIM_ORBIT_Constructor(&Adcs->Orbit);
 
 } /* ADCS_Init() */
 
@@ -1237,12 +2634,53 @@ static void ADCS_Init(ADCS_Model_t *Adcs)
 ** Update ADCS model state.
 **
 ** Notes:
-**   None
+**   1. Once an orbit is defined the eclipse state is computed from the orbit
+**      and scenario enter/exit eclipse events are overridden on the next
+**      execution cycle.
 */
 static void ADCS_Execute(ADCS_Model_t *Adcs)
 {
    
-   /* TODO - Implement model */
+   double J2000Sec = SIM_J2000Sec();
+   double OrbitNormal[3];
+   double Norm;
+   bool   Eclipse;
+   
+   SC_SIM_EPHEM_SunUnitVec(J2000Sec, Adcs->SunUnitEci);
+
+   if (Adcs->Orbit.Valid)
+   {
+   
+      SC_SIM_ORBIT_Propagate(&Adcs->Orbit, SIM_Time(), J2000Sec);
+      
+      Eclipse = SC_SIM_ORBIT_InShadow(Adcs->Orbit.PosEci, Adcs->SunUnitEci);
+      if (Eclipse != Adcs->Eclipse)
+      {
+         Adcs->Eclipse = Eclipse;
+         if (Eclipse)
+         {
+            CFE_EVS_SendEvent(ADCS_ENTER_ECLIPSE_EID, CFE_EVS_EventType_INFORMATION,"ADCS: Enter eclipse"); 
+         }
+         else
+         {
+            CFE_EVS_SendEvent(ADCS_EXIT_ECLIPSE_EID, CFE_EVS_EventType_INFORMATION,"ADCS: Exit eclipse"); 
+         }
+      }
+      
+      OrbitNormal[0] = Adcs->Orbit.PosEci[1]*Adcs->Orbit.VelEci[2] - Adcs->Orbit.PosEci[2]*Adcs->Orbit.VelEci[1];
+      OrbitNormal[1] = Adcs->Orbit.PosEci[2]*Adcs->Orbit.VelEci[0] - Adcs->Orbit.PosEci[0]*Adcs->Orbit.VelEci[2];
+      OrbitNormal[2] = Adcs->Orbit.PosEci[0]*Adcs->Orbit.VelEci[1] - Adcs->Orbit.PosEci[1]*Adcs->Orbit.VelEci[0];
+      Norm = sqrt(OrbitNormal[0]*OrbitNormal[0] + OrbitNormal[1]*OrbitNormal[1] + OrbitNormal[2]*OrbitNormal[2]);
+      Adcs->BetaAngle = asin((OrbitNormal[0]*Adcs->SunUnitEci[0] + OrbitNormal[1]*Adcs->SunUnitEci[1] +
+                              OrbitNormal[2]*Adcs->SunUnitEci[2])/Norm)*(180.0/M_PI);
+
+   } /* End if orbit defined */
+
+   /* TODO - Implement attitude model */
+
+   SC_SIM_SIG_SetBool(BUS, SIG_ADCS_ECLIPSE, Adcs->Eclipse);
+   SC_SIM_SIG_SetFlt(BUS, SIG_ADCS_ATT_ERR, Adcs->AttErr);
+   SC_SIM_SIG_SetFlt(BUS, SIG_ADCS_ALT_KM, Adcs->Orbit.Valid ? Adcs->Orbit.AltKm : ADCS_NOMINAL_ALT_KM);
 
 } /* ADCS_Execute() */
 
@@ -1262,9 +2700,7 @@ static bool ADCS_ProcessEventCmd(ADCS_Model_t *Adcs, const SC_SIM_EventCmd_t *Ev
    {
       
    case ADCS_EVT_SET_MODE:
-      CFE_EVS_SendEvent(ADCS_CHANGE_MODE_EID, CFE_EVS_EventType_INFORMATION,"ADCS: Control mode changed from %s to %s",
-      AdcsModeStr[Adcs->Mode], AdcsModeStr[ScSim->EventCmdParam.OneInt]); 
-      Adcs->Mode = ScSim->EventCmdParam.OneInt;
+      ADCS_SetMode(Adcs, ScSim->EventCmdParam.OneInt);
       break;
 
    case ADCS_EVT_ENTER_ECLIPSE:
@@ -1277,6 +2713,17 @@ static bool ADCS_ProcessEventCmd(ADCS_Model_t *Adcs, const SC_SIM_EventCmd_t *Ev
       CFE_EVS_SendEvent(ADCS_EXIT_ECLIPSE_EID, CFE_EVS_EventType_INFORMATION,"ADCS: Exit eclipse"); 
       break;
 
+   case ADCS_EVT_SET_ORBIT:
+      RetStatus = SC_SIM_ORBIT_SetElements(&Adcs->Orbit, (double)ScSim->Time.Seconds, SIM_J2000Sec(),
+                                           ScSim->EventCmdParam.SixFlt[0], ScSim->EventCmdParam.SixFlt[1],
+                                           ScSim->EventCmdParam.SixFlt[2], ScSim->EventCmdParam.SixFlt[3],
+                                           ScSim->EventCmdParam.SixFlt[4], ScSim->EventCmdParam.SixFlt[5]);
+      break;
+
+   case ADCS_EVT_WHEEL_FAIL:
+      ADCS_WheelFail(Adcs, (uint8)((uint32)ScSim->EventCmdParam.OneInt % ADCS_WHEEL_CNT));
+      break;
+
    default:
 	   RetStatus = false;
       break;
@@ -1290,6 +2737,85 @@ static bool ADCS_ProcessEventCmd(ADCS_Model_t *Adcs, const SC_SIM_EventCmd_t *Ev
 } /* ADCS_ProcessEventCmd() */
 
 
+/******************************************************************************
+** Functions: ADCS_SetMode
+**
+** Change the control mode and its power load.
+**
+*/
+static void ADCS_SetMode(ADCS_Model_t *Adcs, ADCS_Mode_t Mode)
+{
+
+   CFE_EVS_SendEvent(ADCS_CHANGE_MODE_EID, CFE_EVS_EventType_INFORMATION,"ADCS: Control mode changed from %s to %s",
+                     AdcsModeStr[Adcs->Mode], AdcsModeStr[Mode]); 
+   Adcs->Mode = Mode;
+   SC_SIM_SIG_SetInt(BUS, SIG_ADCS_MODE, Adcs->Mode);
+   ADCS_UpdateLoad(Adcs);
+
+} /* ADCS_SetMode() */
+
+
+/******************************************************************************
+** Functions: ADCS_WheelFail
+**
+** Fail a reaction wheel and go to safehold when too few wheels are left
+** for 3-axis control.
+**
+** Notes:
+**   1. Wheel dynamics aren't modeled so a failure only affects the mode.
+**      Failed wheels stay failed until the next sim starts.
+*/
+static void ADCS_WheelFail(ADCS_Model_t *Adcs, uint8 Wheel)
+{
+
+   uint8 Healthy = 0;
+   uint8 i;
+   
+   if (Adcs->WheelFailed & (1 << Wheel)) return;
+   
+   Adcs->WheelFailed |= (1 << Wheel);
+   for (i=0; i < ADCS_WHEEL_CNT; i++)
+   {
+      if ((Adcs->WheelFailed & (1 << i)) == 0) Healthy++;
+   }
+   
+   CFE_EVS_SendEvent(ADCS_WHEEL_FAIL_EID, CFE_EVS_EventType_INFORMATION,
+                     "ADCS: Reaction wheel %d failed, %d of %d wheels healthy", Wheel+1, Healthy, ADCS_WHEEL_CNT); 
+
+   if (Healthy < ADCS_MIN_WHEELS && Adcs->Mode != ADCS_MODE_SAFEHOLD)
+   {
+      ADCS_SetMode(Adcs, ADCS_MODE_SAFEHOLD);
+   }
+   
+} /* ADCS_WheelFail() */
+
+
+/******************************************************************************
+** Functions: ADCS_UpdateLoad
+**
+** Update the ADCS power load for the current control mode.
+**
+*/
+static void ADCS_UpdateLoad(ADCS_Model_t *Adcs)
+{
+   
+   const SC_SIM_TBL_Load_t *Tbl = &ScSim->Tbl.Data.Load;
+   float Watts;
+   
+   switch (Adcs->Mode)
+   {
+      case ADCS_MODE_SAFEHOLD:  Watts = Tbl->AdcsSafehold; break;
+      case ADCS_MODE_SUN_POINT: Watts = Tbl->AdcsSunPoint; break;
+      case ADCS_MODE_INERTIAL:  Watts = Tbl->AdcsInertial; break;
+      case ADCS_MODE_SLEW:      Watts = Tbl->AdcsSlew;     break;
+      default:                  Watts = 0.0;               break;
+   }
+   
+   SC_SIM_SIG_SetFlt(BUS, SIG_LOAD_0 + POWER_LOAD_ADCS, Watts);
+   
+} /* ADCS_UpdateLoad() */
+
+
 /**************************/
 /**************************/
 /****                  ****/
@@ -1322,78 +2848,347 @@ static void CDH_Init(CDH_Model_t *Cdh)
 
    CFE_PSP_MemSet((void*)Cdh, 0, sizeof(CDH_Model_t));
 
+   Cdh->State   = SC_SIM_CdhState_OPERATIONAL;
+   Cdh->WakeTmr = SC_SIM_TMR_Create(TMR, "CdhWake", CDH_Wake, Cdh);
+   CDH_SetWake(Cdh, CDH_NEVER);
+
 } /* CDH_Init() */
 
 
+/******************************************************************************
+** Functions: CDH_Config
+**
+** Configure the CDH model using the simulation parameter table.
+**
+** Notes:
+**   1. Called with InitState true when a sim is started to power on the SBC
+**      running boot image A, and false when a new table is loaded.
+**   2. A new table's watchdog parameters apply immediately, its boot times
+**      apply to the next boot.
+*/
+static void CDH_Config(CDH_Model_t *Cdh, bool InitState)
+{
+
+   if (InitState)
+   {
+      Cdh->State      = SC_SIM_CdhState_OPERATIONAL;
+      Cdh->BootImage  = SC_SIM_CdhBootImage_A;
+      Cdh->BootSelect = SC_SIM_CdhBootImage_A;
+      Cdh->RstCause   = SC_SIM_CdhRstCause_POWER_ON;
+      Cdh->StateTime  = ScSim->Time.Seconds;
+      Cdh->FswHung    = false;
+      Cdh->LastExeTime = 0;
+   }
+   
+   if (Cdh->State == SC_SIM_CdhState_OPERATIONAL)
+   {
+      CDH_SetWake(Cdh, CDH_WatchdogExpiration(Cdh));
+   }
+
+} /* CDH_Config() */
+
+
 /******************************************************************************
 ** Functions: CDH_Execute
 **
 ** Update CDH model state.
 **
 ** Notes:
-**   None
+**   1. Like the power and thermal models, the time skipped from the
+**      scenario initialization to the first step isn't simulated. The
+**      state's timers are shifted to the first step.
+**   2. State transitions are made by the wake timer before the models
+**      execute, see CDH_Wake().
 */
 static void CDH_Execute(CDH_Model_t *Cdh)
 {
    
-   /* TODO - Implement model */
-
-} /* CDH_Execute() */
+   uint32 Skip;
+   
+   if (Cdh->LastExeTime == 0)
+   {
+      Skip = ScSim->Time.Seconds - Cdh->StateTime;
+      Cdh->StateTime += Skip;
+      if (Cdh->HangTime < Cdh->StateTime) Cdh->HangTime = Cdh->StateTime;
+      if (Cdh->State == SC_SIM_CdhState_OPERATIONAL)
+      {
+         CDH_SetWake(Cdh, CDH_WatchdogExpiration(Cdh));
+      }
+      else if (Cdh->NextWakeTime != CDH_NEVER)
+      {
+         CDH_SetWake(Cdh, Cdh->NextWakeTime + Skip);
+      }
+   }
+   Cdh->LastExeTime = ScSim->Time.Seconds;
+   
+   SC_SIM_SIG_SetInt(BUS, SIG_CDH_STATE, Cdh->State);
+
+} /* CDH_Execute() */
+
+
+/******************************************************************************
+** Functions: CDH_ProcessEventCmd
+**
+** Notes:
+**   1. Hardware commands are decoded by hardware so they're accepted in
+**      every state except a reset can't be commanded while the SBC is off.
+**   2. A boot image selection applies to the next boot.
+*/
+static bool CDH_ProcessEventCmd(CDH_Model_t *Cdh, const SC_SIM_EventCmd_t *EventCmd)
+{
+   
+   bool RetStatus = true;
+   uint16 HwCmdStrIdx = 0;
+   
+   switch ((CDH_EventCmd_t)EventCmd->Id)
+   {
+   
+   case CDH_EVT_WATCHDOG_RST:
+      CDH_Reset(Cdh, SC_SIM_CdhRstCause_WATCHDOG, ScSim->Time.Seconds);
+      break;
+
+   case CDH_EVT_SEND_HW_CMD:
+      Cdh->HwCmdCnt++;
+      Cdh->LastHwCmd = (CDH_HardwareCmd_t)ScSim->EventCmdParam.OneInt;
+      switch (Cdh->LastHwCmd)
+      {
+      case CDH_HW_CMD_RST_SBC:
+         if (Cdh->State == SC_SIM_CdhState_OFF)
+         {
+            RetStatus = false;
+         }
+         else
+         {
+            CDH_Reset(Cdh, SC_SIM_CdhRstCause_HW_CMD, ScSim->Time.Seconds);
+         }
+         break;
+      case CDH_HW_CMD_PWR_CYC_SBC:
+         CDH_Reset(Cdh, SC_SIM_CdhRstCause_PWR_CYCLE, ScSim->Time.Seconds);
+         break;
+      case CDH_HW_CMD_SEL_BOOT_A:
+         Cdh->BootSelect = SC_SIM_CdhBootImage_A;
+         break;
+      case CDH_HW_CMD_SEL_BOOT_B:
+         Cdh->BootSelect = SC_SIM_CdhBootImage_B;
+         break;
+      default:
+	      RetStatus = false;
+         break;
+      }
+
+      HwCmdStrIdx = (RetStatus == true)? Cdh->LastHwCmd : 0;
+      CFE_EVS_SendEvent(CDH_HW_CMD_EID, CFE_EVS_EventType_INFORMATION, "CDH: Received hardware command %s", HwCmdStr[HwCmdStrIdx]);
+      break;
+   
+   case CDH_EVT_FSW_HANG:
+      if (Cdh->State == SC_SIM_CdhState_OPERATIONAL && !Cdh->FswHung)
+      {
+         Cdh->FswHung  = true;
+         Cdh->HangTime = ScSim->Time.Seconds;
+         CDH_SetWake(Cdh, CDH_WatchdogExpiration(Cdh));
+      }
+      else
+      {
+         RetStatus = false;
+      }
+      break;
+      
+   default:
+	   RetStatus = false;
+      break;
+      
+   } /* End Cmd Id switch */
+      
+   Cdh->LastEventCmd = *EventCmd;
+      
+   return RetStatus;
+   
+} /* CDH_ProcessEventCmd() */
+
+
+/******************************************************************************
+** Functions: CDH_Boot
+**
+** Start booting the selected image.
+**
+*/
+static void CDH_Boot(CDH_Model_t *Cdh, uint32 Time)
+{
+
+   const SC_SIM_TBL_Cdh_t *Tbl = &ScSim->Tbl.Data.Cdh;
+   
+   Cdh->State     = SC_SIM_CdhState_BOOTING;
+   Cdh->BootImage = Cdh->BootSelect;
+   Cdh->StateTime = Time;
+   CDH_SetWake(Cdh, Time + ((Cdh->BootImage == SC_SIM_CdhBootImage_A) ? Tbl->BootTimeA : Tbl->BootTimeB));
+
+} /* CDH_Boot() */
+
+
+/******************************************************************************
+** Functions: CDH_Reset
+**
+** Reset or power cycle the SBC.
+**
+** Notes:
+**   1. The rest of the spacecraft loses its flight software control: the
+**      ADCS falls back to safehold, the instrument is powered off and a
+**      recorder playback is stopped.
+*/
+static void CDH_Reset(CDH_Model_t *Cdh, SC_SIM_CdhRstCause_Enum_t Cause, uint32 Time)
+{
+
+   SC_SIM_EventCmd_t InstrCmd = { {SC_SIM_EVT_CMD_NULL_IDX, SC_SIM_EVT_CMD_NULL_IDX}, (int32)Time, 
+                                  SC_SIM_Subsystem_INSTR, INSTR_EVT_DIS_POWER, SC_SIM_SCANF_NONE, NULL };
+   
+   Cdh->SbcRstCnt++;
+   Cdh->RstCause = Cause;
+   Cdh->FswHung  = false;
+   
+   if (Cause == SC_SIM_CdhRstCause_WATCHDOG)
+   {
+      CFE_EVS_SendEvent(CDH_WATCHDOG_RESET_EID, CFE_EVS_EventType_ERROR, "C&DH: Watchdog Reset. Call Professor Wildermann for assistance!!!!");       
+   }
+   else
+   {
+      CFE_EVS_SendEvent(CDH_RESET_EID, CFE_EVS_EventType_INFORMATION, "C&DH: SBC %s", 
+                        (Cause == SC_SIM_CdhRstCause_PWR_CYCLE) ? "power cycled" : "reset");
+   }
+
+   if (Cause == SC_SIM_CdhRstCause_PWR_CYCLE)
+   {
+      Cdh->State        = SC_SIM_CdhState_OFF;
+      Cdh->StateTime    = Time;
+      CDH_SetWake(Cdh, Time + ScSim->Tbl.Data.Cdh.PwrCycOff);
+   }
+   else
+   {
+      CDH_Boot(Cdh, Time);
+   }
+
+   if (ADCS->Mode != ADCS_MODE_SAFEHOLD)
+   {
+      ADCS_SetMode(ADCS, ADCS_MODE_SAFEHOLD);
+   }
+
+   INSTR_ProcessEventCmd(INSTR, &InstrCmd);
+   InstrCmd.Id = INSTR_EVT_DIS_SCIENCE;
+   INSTR_ProcessEventCmd(INSTR, &InstrCmd);
+
+   FSW->Recorder.PlaybackEna = false;
+   
+} /* CDH_Reset() */
+
+
+/******************************************************************************
+** Functions: CDH_UpdateLoad
+**
+** Update the CDH power load, the avionics draw is constant.
+**
+*/
+static void CDH_UpdateLoad(CDH_Model_t *Cdh)
+{
+   
+   SC_SIM_SIG_SetFlt(BUS, SIG_LOAD_0 + POWER_LOAD_CDH, ScSim->Tbl.Data.Load.CdhBase);
+   
+} /* CDH_UpdateLoad() */
+
+
+/******************************************************************************
+** Functions: CDH_SetWake
+**
+** Set the time of the next state transition and arm the wake timer.
+**
+*/
+static void CDH_SetWake(CDH_Model_t *Cdh, uint32 Time)
+{
+   
+   Cdh->NextWakeTime = Time;
+   if (Time == CDH_NEVER)
+   {
+      SC_SIM_TMR_Stop(TMR, Cdh->WakeTmr);
+   }
+   else
+   {
+      SC_SIM_TMR_Start(TMR, Cdh->WakeTmr, Time, 0);
+   }
+   
+} /* CDH_SetWake() */
 
 
 /******************************************************************************
-** Functions: CDH_ProcessEventCmd
+** Functions: CDH_Wake
+**
+** Wake timer callback that makes the state transition due at Time.
 **
 ** Notes:
-**   None
+**   1. A transition that sets a wake time that has already passed, e.g.
+**      a zero boot time, makes the next transition on the same tick.
 */
-static bool CDH_ProcessEventCmd(CDH_Model_t *Cdh, const SC_SIM_EventCmd_t *EventCmd)
+static void CDH_Wake(void *Obj, uint32 Time)
 {
    
-   bool RetStatus = true;
-   uint16 HwCmdStrIdx = 0;
+   CDH_Model_t *Cdh = (CDH_Model_t *)Obj;
    
-   switch ((CDH_EventCmd_t)EventCmd->Id)
+   Cdh->NextWakeTime = CDH_NEVER;
+   
+   switch (Cdh->State)
    {
    
-   case CDH_EVT_WATCHDOG_RST:
-      CFE_EVS_SendEvent(CDH_WATCHDOG_RESET_EID, CFE_EVS_EventType_ERROR, "C&DH: Watchdog Reset. Call Professor Wildermann for assistance!!!!");       
-      Cdh->SbcRstCnt++;
+   case SC_SIM_CdhState_OFF:
+      CDH_Boot(Cdh, Time);
+      break;
+   
+   case SC_SIM_CdhState_BOOTING:
+      Cdh->State     = SC_SIM_CdhState_OPERATIONAL;
+      Cdh->StateTime = Time;
+      Cdh->FswHung   = false;
+      CDH_SetWake(Cdh, CDH_WatchdogExpiration(Cdh));
+      CFE_EVS_SendEvent(CDH_BOOT_EID, CFE_EVS_EventType_INFORMATION, 
+                        "C&DH: SBC operational running boot image %c", 'A' + Cdh->BootImage);
       break;
-
-   case CDH_EVT_SEND_HW_CMD:
-      Cdh->HwCmdCnt++;
-      Cdh->LastHwCmd = (CDH_HardwareCmd_t)ScSim->EventCmdParam.OneInt;
-      switch (Cdh->LastHwCmd)
-      {
-      case CDH_HW_CMD_RST_SBC:
-         Cdh->SbcRstCnt++;
-         break;
-      case CDH_HW_CMD_PWR_CYC_SBC:
-         break;
-      case CDH_HW_CMD_SEL_BOOT_A:
-         break;
-      case CDH_HW_CMD_SEL_BOOT_B:
-         break;
-      default:
-	      RetStatus = false;
-         break;
-      }
-
-      HwCmdStrIdx = (RetStatus == true)? Cdh->LastHwCmd : 0;
-      CFE_EVS_SendEvent(998, CFE_EVS_EventType_INFORMATION, "CDH: Received hardware command %s", HwCmdStr[HwCmdStrIdx]);
    
    default:
-	   RetStatus = false;
+      CDH_Reset(Cdh, SC_SIM_CdhRstCause_WATCHDOG, Time);
       break;
       
-   } /* End Cmd Id switch */
-      
-   Cdh->LastEventCmd = *EventCmd;
-      
-   return RetStatus;
+   } /* End state switch */
    
-} /* CDH_ProcessEventCmd() */
+} /* CDH_Wake() */
+
+
+/******************************************************************************
+** Functions: CDH_WatchdogExpiration
+**
+** Return the time the watchdog expires while the SBC is operational,
+** CDH_NEVER if it's kept kicked.
+**
+** Notes:
+**   1. The flight software kicks at StateTime + k*WdKickPeriod until it
+**      hangs. A kick period longer than the timeout expires the watchdog
+**      before the second kick. A zero timeout disables the watchdog.
+*/
+static uint32 CDH_WatchdogExpiration(const CDH_Model_t *Cdh)
+{
+
+   const SC_SIM_TBL_Cdh_t *Tbl = &ScSim->Tbl.Data.Cdh;
+   uint32 LastKick;
+   
+   if (Tbl->WdTimeout == 0) return CDH_NEVER;
+   
+   if (Tbl->WdKickPeriod > Tbl->WdTimeout) return Cdh->StateTime + Tbl->WdTimeout;
+   
+   if (!Cdh->FswHung) return CDH_NEVER;
+   
+   LastKick = Cdh->HangTime;
+   if (Tbl->WdKickPeriod > 0)
+   {
+      LastKick = Cdh->StateTime + ((Cdh->HangTime - Cdh->StateTime)/Tbl->WdKickPeriod)*Tbl->WdKickPeriod;
+   }
+
+   return LastKick + Tbl->WdTimeout;
+
+} /* CDH_WatchdogExpiration() */
 
 
 
@@ -1424,7 +3219,10 @@ static void COMM_Init(COMM_Model_t *Comm)
    
    Comm->InContact = false;
    Comm->Contact.Link = COMM_LINK_UNDEF;
-   Comm->Contact.TimePending = -1;
+   
+   Comm->AosTmr  = SC_SIM_TMR_Create(TMR, "CommAos",  COMM_AosTimer, Comm);
+   Comm->LosTmr  = SC_SIM_TMR_Create(TMR, "CommLos",  COMM_LosTimer, Comm);
+   Comm->DropTmr = SC_SIM_TMR_Create(TMR, "CommDrop", NULL, Comm);
 
 } /* COMM_Init() */
 
@@ -1438,9 +3236,16 @@ static void COMM_EndContact(COMM_Model_t *Comm)
    Comm->InContact             = false;
    Comm->Contact.Link          = COMM_LINK_UNDEF;
    Comm->Contact.Length        = 0;
-   Comm->Contact.TimePending   = -1;
-   Comm->Contact.TimeConsumed  = 0;
-   Comm->Contact.TimeRemaining = 0;
+   Comm->Contact.DataRate      = Comm->CmdDataRate;
+   Comm->PlannedContact        = false;
+   Comm->ContactStation        = 0;
+   Comm->DownlinkBytes         = 0;
+   
+   SC_SIM_TMR_Stop(TMR, Comm->AosTmr);
+   SC_SIM_TMR_Stop(TMR, Comm->LosTmr);
+   SC_SIM_TMR_Stop(TMR, Comm->DropTmr);
+   SC_SIM_LINK_Clear(&Comm->Link);
+   COMM_UpdateLoad(Comm);
 
 } /* COMM_EndContact() */
 
@@ -1451,40 +3256,61 @@ static void COMM_EndContact(COMM_Model_t *Comm)
 ** Update Comm model state.
 **
 ** Notes:
-**   None
+**   1. When the contact planner has a plan and no contact is active or
+**      pending, an AOS event cmd is added for the next planned contact.
+**      Only one planned AOS is queued at a time so a replan never leaves
+**      stale contacts in the event list.
+**   2. Planned contacts get their data rate from the link budget each
+**      step. Scripted contacts use the commanded rate.
+**   3. Contacts start and end and link drops recover on the COMM timers.
 */
 static void COMM_Execute(COMM_Model_t *Comm)
 {
+
+   const SC_SIM_CONTACT_Window_t *Plan;
+   SC_SIM_EventCmd_t AosEventCmd;
+   double Now = (double)ScSim->Time.Seconds;
+   
+
    if (Comm->InContact)
    {
    
-      Comm->Contact.TimeConsumed++;
-      Comm->Contact.TimeRemaining--;
-      
-      if (Comm->Contact.TimeRemaining <= 0)
-      {   
-         COMM_EndContact(Comm);  
+      if (Comm->PlannedContact)
+      {
+         Comm->Contact.DataRate = (uint16)SC_SIM_LINK_Rate(&Comm->Link, Now);
       }
+      Comm->DownlinkBytes = SC_SIM_TMR_Active(TMR, Comm->DropTmr) ? 
+                            0 : (uint32)Comm->Contact.DataRate*125;  /* kbps to bytes per second */
          
    } /* End if in contact */
-   else
+   else if (!SC_SIM_TMR_Active(TMR, Comm->AosTmr))
    {   
-      if (Comm->Contact.TimePending > 0)
+      if (!Comm->PlanAosQueued && SC_SIM_CONTACT_Update(&Comm->Planner, &ADCS->Orbit, Now,
+                                                        SC_SIM_SIG_GetFlt(BUS, SIG_FSW_REC_PCT_USED)))
       {
       
-         Comm->Contact.TimePending--;
-         if (Comm->Contact.TimePending == 0)
+         Plan = SC_SIM_CONTACT_Next(&Comm->Planner, Now);
+         if (Plan != NULL && Plan->Start < (double)SC_SIM_REALTIME_END)
          {
             
-            Comm->InContact = true;
-            Comm->Contact.TimeConsumed  = 0;
-            Comm->Contact.TimeRemaining = Comm->Contact.Length;
-            
-            CFE_EVS_SendEvent(COMM_START_CONTACT_EID, CFE_EVS_EventType_INFORMATION, "Started contact with length of %d seconds", Comm->Contact.Length);
-         }        
-      } /* End if pending contact */
+            AosEventCmd.Link.Prev = SC_SIM_EVT_CMD_NULL_IDX;
+            AosEventCmd.Link.Next = SC_SIM_EVT_CMD_NULL_IDX;
+            AosEventCmd.Time      = (Plan->Start > Now) ? (int32)ceil(Plan->Start) : (int32)(ScSim->Time.Seconds + 1);
+            AosEventCmd.SubSys    = SC_SIM_Subsystem_COMM;
+            AosEventCmd.Id        = COMM_EVT_PLAN_AOS;
+            AosEventCmd.ScanfType = SC_SIM_SCANF_NONE;
+            AosEventCmd.Param     = NULL;
+      
+            Comm->PlanAosQueued = true;
+            SIM_AddEventCmd(&AosEventCmd);
+         
+         }
+      } /* End if planner */
    } /* End if not in contact */
    
+   SC_SIM_SIG_SetBool(BUS, SIG_COMM_IN_CONTACT, Comm->InContact);
+   SC_SIM_SIG_SetInt(BUS, SIG_COMM_DL_BYTES, (int32)Comm->DownlinkBytes);
+   
 } /* COMM_Execute() */
 
 
@@ -1499,6 +3325,7 @@ static bool COMM_ProcessEventCmd(COMM_Model_t *Comm, const SC_SIM_EventCmd_t *Ev
    
    bool RetStatus = true;
    SC_SIM_EventCmd_t LosEventCmd;
+   uint16 DropTime;
          
    CFE_EVS_SendEvent(COMM_PROCESS_EVENT_EID, CFE_EVS_EventType_DEBUG, "Executing COMM cmd %d", EventCmd->Id);
    
@@ -1507,16 +3334,26 @@ static bool COMM_ProcessEventCmd(COMM_Model_t *Comm, const SC_SIM_EventCmd_t *Ev
    
    case COMM_EVT_SCH_AOS:
  
-      Comm->Contact.TimePending = ScSim->EventCmdParam.ThreeInt[0];
-      Comm->Contact.Length      = ScSim->EventCmdParam.ThreeInt[1];
-      Comm->Contact.Link        = ScSim->EventCmdParam.ThreeInt[2];
-
-      Comm->InContact = false;
-      Comm->Contact.TimeConsumed  = 0;
-      Comm->Contact.TimeRemaining = 0;
+      Comm->Contact.Length = ScSim->EventCmdParam.ThreeInt[1];
+      Comm->Contact.Link   = ScSim->EventCmdParam.ThreeInt[2];
+
+      Comm->InContact      = false;
+      Comm->PlannedContact = false;
+      Comm->ContactStation = 0;
+      SC_SIM_TMR_Stop(TMR, Comm->LosTmr);
+      SC_SIM_TMR_Stop(TMR, Comm->DropTmr);
+      if (ScSim->EventCmdParam.ThreeInt[0] > 0)
+      {
+         SC_SIM_TMR_Start(TMR, Comm->AosTmr, ScSim->Time.Seconds + ScSim->EventCmdParam.ThreeInt[0], 0);
+      }
+      else
+      {
+         SC_SIM_TMR_Stop(TMR, Comm->AosTmr);
+      }
+      COMM_UpdateLoad(Comm);
       CFE_EVS_SendEvent(COMM_PROCESS_EVENT_EID, CFE_EVS_EventType_DEBUG, 
                         "Scheduled AOS in %ds, for %ds with link type %d", 
-                        Comm->Contact.TimePending, Comm->Contact.Length, Comm->Contact.Link);
+                        ScSim->EventCmdParam.ThreeInt[0], Comm->Contact.Length, Comm->Contact.Link);
  
       LosEventCmd.Link.Prev = SC_SIM_EVT_CMD_NULL_IDX;
       LosEventCmd.Link.Next = SC_SIM_EVT_CMD_NULL_IDX;
@@ -1530,17 +3367,41 @@ static bool COMM_ProcessEventCmd(COMM_Model_t *Comm, const SC_SIM_EventCmd_t *Ev
       
       break;
    
+   case COMM_EVT_PLAN_AOS:
+      Comm->PlanAosQueued = false;
+      if (!Comm->InContact) COMM_StartPlannedContact(Comm);
+      break;
+
+   case COMM_EVT_LOS:
+      /* A scripted contact or abort may have replaced the contact the LOS was added for */
+      if (Comm->PlannedContact && EventCmd->Time == Comm->PlanLosTime) COMM_EndContact(Comm);
+      break;
+
    case COMM_EVT_ABORT_CONTACT:
       COMM_EndContact(Comm);  
       break;
 
    case COMM_EVT_SET_DATA_RATE:
-      Comm->Contact.DataRate = ScSim->EventCmdParam.OneInt;
+      Comm->CmdDataRate = ScSim->EventCmdParam.OneInt;
+      if (!Comm->PlannedContact) Comm->Contact.DataRate = Comm->CmdDataRate;
       break;
 
    case COMM_EVT_SET_TDRS_ID:
       Comm->Contact.TdrsId = ScSim->EventCmdParam.OneInt;
       break;
+
+   case COMM_EVT_LINK_DROP:
+      /* The link can only drop while there's a contact */
+      if (Comm->InContact && ScSim->EventCmdParam.OneInt > 0)
+      {
+         DropTime = (ScSim->EventCmdParam.OneInt < COMM_TimeRemaining(Comm)) ?
+                    (uint16)ScSim->EventCmdParam.OneInt : COMM_TimeRemaining(Comm);
+         SC_SIM_TMR_Start(TMR, Comm->DropTmr, ScSim->Time.Seconds + DropTime, 0);
+         Comm->DropCnt++;
+         CFE_EVS_SendEvent(COMM_LINK_DROP_EID, CFE_EVS_EventType_INFORMATION,
+                           "Downlink dropped for %d seconds", DropTime);
+      }
+      break;
    
    default:
 	   RetStatus = false;
@@ -1555,6 +3416,163 @@ static bool COMM_ProcessEventCmd(COMM_Model_t *Comm, const SC_SIM_EventCmd_t *Ev
 } /* COMM_ProcessEventCmd() */
 
 
+/******************************************************************************
+** Functions: COMM_StartPlannedContact
+**
+** Start the planned contact in progress and add its LOS event cmd.
+**
+** Notes:
+**   1. The plan may have been recomputed since the AOS was queued so the
+**      current plan is used and the AOS is ignored if no contact is in
+**      progress.
+*/
+static void COMM_StartPlannedContact(COMM_Model_t *Comm)
+{
+
+   const SC_SIM_CONTACT_Window_t *Plan;
+   const SC_SIM_CONTACT_Asset_t  *Asset;
+   SC_SIM_EventCmd_t LosEventCmd;
+   double Now = (double)ScSim->Time.Seconds;
+   double Length;
+   
+   Plan = SC_SIM_CONTACT_Next(&Comm->Planner, Now);
+   
+   if (Plan == NULL || Plan->Start > Now || (Plan->End - Now) < 1.0)
+   {
+      CFE_EVS_SendEvent(COMM_PROCESS_EVENT_EID, CFE_EVS_EventType_DEBUG, 
+                        "Planned AOS at %d ignored, no contact in the current plan", ScSim->Time.Seconds);
+      return;
+   }
+   
+   Asset  = &Comm->Planner.Asset[Plan->Asset];
+   Length = floor(Plan->End - Now);
+   if (Length > 65535.0) Length = 65535.0;
+   
+   Comm->InContact      = true;
+   Comm->PlannedContact = true;
+   Comm->Contact.Link          = COMM_LINK_DUPLEX;
+   Comm->Contact.Length        = (uint16)Length;
+   SC_SIM_TMR_Stop(TMR, Comm->AosTmr);
+   SC_SIM_TMR_Start(TMR, Comm->LosTmr, ScSim->Time.Seconds + Comm->Contact.Length, 0);
+   
+   if (Asset->Type == SC_SIM_CONTACT_RELAY)
+   {
+      Comm->Contact.TdrsId = Asset->Id + 1;
+      Comm->ContactStation = 0;
+   }
+   else
+   {
+      Comm->Contact.TdrsId = COMM_TDRS_UNDEF;
+      Comm->ContactStation = Asset->Id + 1;
+   }
+   
+   SC_SIM_LINK_Prepare(&Comm->Link, &Comm->Planner, Plan->Asset, &ADCS->Orbit, Now, Length);
+   COMM_UpdateLoad(Comm);
+   
+   CFE_EVS_SendEvent(COMM_START_CONTACT_EID, CFE_EVS_EventType_INFORMATION, 
+                     "Started planned contact with %s %d, length of %d seconds",
+                     (Asset->Type == SC_SIM_CONTACT_RELAY) ? "relay" : "station", Asset->Id + 1, Comm->Contact.Length);
+
+   LosEventCmd.Link.Prev = SC_SIM_EVT_CMD_NULL_IDX;
+   LosEventCmd.Link.Next = SC_SIM_EVT_CMD_NULL_IDX;
+   LosEventCmd.Time      = ScSim->Time.Seconds + Comm->Contact.Length;
+   LosEventCmd.SubSys    = SC_SIM_Subsystem_COMM;
+   LosEventCmd.Id        = COMM_EVT_LOS;
+   LosEventCmd.ScanfType = SC_SIM_SCANF_NONE;
+   LosEventCmd.Param     = NULL;
+   
+   /* The LOS timer ends a contact that runs past the end of the sim */
+   Comm->PlanLosTime = LosEventCmd.Time;
+   if (LosEventCmd.Time < SC_SIM_REALTIME_END) SIM_AddEventCmd(&LosEventCmd);
+   
+} /* COMM_StartPlannedContact() */
+
+
+/******************************************************************************
+** Functions: COMM_UpdateLoad
+**
+** Update the COMM power load. The transmitter is only on during a contact.
+**
+*/
+static void COMM_UpdateLoad(COMM_Model_t *Comm)
+{
+   
+   SC_SIM_SIG_SetFlt(BUS, SIG_LOAD_0 + POWER_LOAD_COMM, Comm->InContact ? ScSim->Tbl.Data.Load.CommTx : 0.0);
+   
+} /* COMM_UpdateLoad() */
+
+
+/******************************************************************************
+** Functions: COMM_AosTimer
+**
+** AOS timer callback that starts a scripted contact.
+**
+*/
+static void COMM_AosTimer(void *Obj, uint32 Time)
+{
+   
+   COMM_Model_t *Comm = (COMM_Model_t *)Obj;
+   
+   Comm->InContact = true;
+   Comm->Contact.DataRate = Comm->CmdDataRate;
+   SC_SIM_TMR_Start(TMR, Comm->LosTmr, Time + Comm->Contact.Length, 0);
+   COMM_UpdateLoad(Comm);
+   
+   CFE_EVS_SendEvent(COMM_START_CONTACT_EID, CFE_EVS_EventType_INFORMATION, "Started contact with length of %d seconds", Comm->Contact.Length);
+   
+} /* COMM_AosTimer() */
+
+
+/******************************************************************************
+** Functions: COMM_LosTimer
+**
+** LOS timer callback that ends the contact.
+**
+*/
+static void COMM_LosTimer(void *Obj, uint32 Time)
+{
+   
+   COMM_EndContact((COMM_Model_t *)Obj);
+   
+} /* COMM_LosTimer() */
+
+
+/******************************************************************************
+** Functions: COMM_TimePending
+**
+** Return the seconds until a scripted contact starts, 0 during a contact
+** and -1 if no contact is pending.
+**
+*/
+static int16 COMM_TimePending(const COMM_Model_t *Comm)
+{
+   
+   if (SC_SIM_TMR_Active(TMR, Comm->AosTmr))
+   {
+      return (int16)(SC_SIM_TMR_Expiry(TMR, Comm->AosTmr) - ScSim->Time.Seconds);
+   }
+   
+   return Comm->InContact ? 0 : -1;
+   
+} /* COMM_TimePending() */
+
+
+/******************************************************************************
+** Functions: COMM_TimeRemaining
+**
+** Return the seconds left in the current contact.
+**
+*/
+static uint16 COMM_TimeRemaining(const COMM_Model_t *Comm)
+{
+   
+   if (!Comm->InContact || !SC_SIM_TMR_Active(TMR, Comm->LosTmr)) return 0;
+   
+   return (uint16)(SC_SIM_TMR_Expiry(TMR, Comm->LosTmr) - ScSim->Time.Seconds);
+   
+} /* COMM_TimeRemaining() */
+
+
 /********************************************/
 /********************************************/
 /****                                    ****/
@@ -1575,6 +3593,10 @@ static void FSW_Init(FSW_Model_t *Fsw)
 {
 
    CFE_PSP_MemSet((void*)Fsw, 0, sizeof(FSW_Model_t));
+   SC_SIM_REC_Constructor(&Fsw->Recorder.Store);
+   
+   Fsw->HkFileTmr  = SC_SIM_TMR_Create(TMR, "FswHkFile",  FSW_HkFileTimer, Fsw);
+   Fsw->EvsFileTmr = SC_SIM_TMR_Create(TMR, "FswEvsFile", FSW_EvsFileTimer, Fsw);
    
 } /* FSW_Init() */
 
@@ -1585,21 +3607,56 @@ static void FSW_Init(FSW_Model_t *Fsw)
 ** Update Flight Software model state.
 **
 ** Notes:
-**   None
+**   1. Housekeeping and event log files are closed periodically on their
+**      own virtual channels. The file timers flag the files that are due.
+**   2. Playback drains the selected files by the bytes the COMM link
+**      carries each step and stops when they have all been played back.
+**   3. Nothing is stored or played back while the SBC is off or booting.
+**   4. The instrument publishes its running count of completed science
+**      files. The files FSW hasn't taken yet are stored after playback,
+**      files completed while the SBC isn't operational wait for it.
 */
 static void FSW_Execute(FSW_Model_t *Fsw)
 {
    
-   /* TODO - Sim CDH & FSW files */
-   //Fsw->Recorder.FileCnt = INSTR->FileCnt;
+   bool HkFileDue  = Fsw->HkFileDue;
+   bool EvsFileDue = Fsw->EvsFileDue;
+   uint32 SciFiles;
+   
+   Fsw->HkFileDue  = false;
+   Fsw->EvsFileDue = false;
+   
+   /* The flight software only runs on an operational SBC */
+   if (SC_SIM_SIG_GetInt(BUS, SIG_CDH_STATE) != SC_SIM_CdhState_OPERATIONAL) return;
+   
+   if (HkFileDue)
+   {
+      FSW_StoreFile(Fsw, FSW_HK_FILE_BYTES, FSW_HK_APID, SC_SIM_REC_VC_HK);
+   }
+   if (EvsFileDue)
+   {
+      FSW_StoreFile(Fsw, FSW_EVS_FILE_BYTES, FSW_EVS_APID, SC_SIM_REC_VC_EVS);
+   }
 
    if (Fsw->Recorder.PlaybackEna)
    {
    
-      if (Fsw->Recorder.FileCnt == 0) Fsw->Recorder.PlaybackEna = false;
-      if (Fsw->Recorder.FileCnt > 0)  Fsw->Recorder.FileCnt--;
+      if (SC_SIM_SIG_GetBool(BUS, SIG_COMM_IN_CONTACT))
+      {
+         SC_SIM_REC_Playback(&Fsw->Recorder.Store, (uint32)SC_SIM_SIG_GetInt(BUS, SIG_COMM_DL_BYTES));
+         FSW_UpdateRecorder(Fsw);
+      }
+      
+      if (!SC_SIM_REC_PlaybackPending(&Fsw->Recorder.Store)) Fsw->Recorder.PlaybackEna = false;
 
    }
+   
+   SciFiles = (uint32)SC_SIM_SIG_GetInt(BUS, SIG_INSTR_SCI_FILES);
+   while (Fsw->SciFileCnt != SciFiles)
+   {
+      FSW_StoreFile(Fsw, (uint32)SC_SIM_SIG_GetInt(BUS, SIG_INSTR_SCI_BYTES), INSTR_SCI_APID, INSTR_SCI_VC);
+      Fsw->SciFileCnt++;
+   }
 
 } /* FSW_Execute() */
 
@@ -1619,21 +3676,42 @@ static bool FSW_ProcessEventCmd(FSW_Model_t* Fsw, const SC_SIM_EventCmd_t* Event
    {
 
    case FSW_EVT_SET_REC_FILE_CNT:
-      Fsw->Recorder.FileCnt = ScSim->EventCmdParam.OneInt;
+      SC_SIM_REC_Preload(&Fsw->Recorder.Store, ScSim->EventCmdParam.OneInt, Fsw->Recorder.Store.UsedBytes,
+                         ScSim->Time.Seconds, INSTR_SCI_APID, INSTR_SCI_VC);
+      FSW_UpdateRecorder(Fsw);
       break;
 
    case FSW_EVT_SET_REC_PCT_USED:
-      Fsw->Recorder.PctUsed = ScSim->EventCmdParam.OneFlt;
+      SC_SIM_REC_Preload(&Fsw->Recorder.Store, (Fsw->Recorder.FileCnt > 0) ? Fsw->Recorder.FileCnt : 1,
+                         (uint64)(ScSim->EventCmdParam.OneFlt*(double)Fsw->Recorder.Store.Capacity/100.0),
+                         ScSim->Time.Seconds, INSTR_SCI_APID, INSTR_SCI_VC);
+      FSW_UpdateRecorder(Fsw);
       break;
       
    case FSW_EVT_START_REC_PLBK:
-      Fsw->Recorder.PlaybackEna = true;
+      if (EventCmd->ScanfType == SC_SIM_SCANF_3_INT)
+      {
+         RetStatus = FSW_StartPlayback(Fsw, ScSim->EventCmdParam.ThreeInt[0], ScSim->EventCmdParam.ThreeInt[1],
+                                       ScSim->EventCmdParam.ThreeInt[2]);
+      }
+      else
+      {
+         RetStatus = FSW_StartPlayback(Fsw, SC_SIM_REC_VC_ALL, 0, 0);
+      }
       break;
 
    case FSW_EVT_STOP_REC_PLBK:
       Fsw->Recorder.PlaybackEna = false;
       break;
 
+   case FSW_EVT_REC_SEU:
+      if (SC_SIM_REC_Upset(&Fsw->Recorder.Store, (double)((uint32)ScSim->EventCmdParam.OneInt & 0x7FFFFFFF)/2147483648.0))
+      {
+         CFE_EVS_SendEvent(FSW_REC_SEU_EID, CFE_EVS_EventType_INFORMATION,
+                           "Recorder upset corrupted a file, %d corrupted files", Fsw->Recorder.Store.UpsetCnt);
+      }
+      break;
+
    case FSW_EVT_CLR_EVT_LOG:
 OS_printf("CFE_SB_TransmitMsg(CFE_MSG_PTR(CfeClrEventLogCmd), true);\n");
       CFE_SB_TransmitMsg(CFE_MSG_PTR(CfeClrEventLogCmd), true);
@@ -1648,9 +3726,132 @@ OS_printf("CFE_SB_TransmitMsg(CFE_MSG_PTR(CfeClrEventLogCmd), true);\n");
    
    Fsw->LastEventCmd = *EventCmd;
    
-   return RetStatus;
+   return RetStatus;
+   
+} /* FSW_ProcessEventCmd() */
+
+
+/******************************************************************************
+** Functions: FSW_StartPlayback
+**
+** Select a channel's files created from StartTime to EndTime and enable
+** playback.
+**
+** Notes:
+**   1. An EndTime of 0 selects files up to the present.
+**   2. Returns false if the parameters are invalid.
+*/
+static bool FSW_StartPlayback(FSW_Model_t *Fsw, uint8 Vc, uint32 StartTime, uint32 EndTime)
+{
+
+   static const char *VcStr[SC_SIM_REC_VC_CNT+1] = { "housekeeping", "science", "event log", "all" };
+   uint32 FileCnt;
+   
+   if (EndTime == 0) EndTime = 0xFFFFFFFF;
+   
+   if (Vc > SC_SIM_REC_VC_ALL || StartTime > EndTime)
+   {
+      CFE_EVS_SendEvent(SC_SIM_START_REC_PLBK_EID, CFE_EVS_EventType_ERROR,
+                        "Start playback rejected, invalid channel %d or time range %u to %u",
+                        Vc, StartTime, EndTime);
+      return false;
+   }
+   
+   FileCnt = SC_SIM_REC_Select(&Fsw->Recorder.Store, Vc, StartTime, EndTime);
+   Fsw->Recorder.PlaybackEna = true;
+
+   CFE_EVS_SendEvent(SC_SIM_START_REC_PLBK_EID, CFE_EVS_EventType_INFORMATION,
+                     "FSW recorder playback of %s channel started with %u files from time %u",
+                     VcStr[Vc], FileCnt, StartTime); 
+
+   return true;
+   
+} /* FSW_StartPlayback() */
+
+
+/******************************************************************************
+** Functions: FSW_StoreFile
+**
+** Store a file in the recorder.
+**
+** Notes:
+**   1. Returns false if the recorder rejected the file.
+*/
+static bool FSW_StoreFile(FSW_Model_t *Fsw, uint32 Size, uint16 Apid, uint8 Vc)
+{
+
+   bool RetStatus;
+   
+   RetStatus = SC_SIM_REC_Store(&Fsw->Recorder.Store, Size, ScSim->Time.Seconds, Apid, Vc);
+   FSW_UpdateRecorder(Fsw);
+   
+   return RetStatus;
+   
+} /* FSW_StoreFile() */
+
+
+/******************************************************************************
+** Functions: FSW_UpdateRecorder
+**
+** Refresh the recorder status derived from the file store.
+**
+*/
+static void FSW_UpdateRecorder(FSW_Model_t *Fsw)
+{
+
+   Fsw->Recorder.PctUsed = SC_SIM_REC_PctUsed(&Fsw->Recorder.Store);
+   Fsw->Recorder.FileCnt = Fsw->Recorder.Store.FileCnt;
+   SC_SIM_SIG_SetFlt(BUS, SIG_FSW_REC_PCT_USED, Fsw->Recorder.PctUsed);
+   
+} /* FSW_UpdateRecorder() */
+
+
+/******************************************************************************
+** Functions: FSW_StartFileTimers
+**
+** Arm the periodic file timers at the first step of a sim.
+**
+** Notes:
+**   1. Files are closed on multiples of their period in sim time, a file
+**      due on the first step is flagged directly because the timers can
+**      only expire after it.
+*/
+static void FSW_StartFileTimers(FSW_Model_t *Fsw)
+{
+   
+   uint32 Now = ScSim->Time.Seconds;
+   
+   Fsw->HkFileDue  = (Now > 0 && (Now % FSW_HK_FILE_PERIOD) == 0);
+   Fsw->EvsFileDue = (Now > 0 && (Now % FSW_EVS_FILE_PERIOD) == 0);
+   
+   SC_SIM_TMR_Start(TMR, Fsw->HkFileTmr, (Now/FSW_HK_FILE_PERIOD + 1)*FSW_HK_FILE_PERIOD, FSW_HK_FILE_PERIOD);
+   SC_SIM_TMR_Start(TMR, Fsw->EvsFileTmr, (Now/FSW_EVS_FILE_PERIOD + 1)*FSW_EVS_FILE_PERIOD, FSW_EVS_FILE_PERIOD);
+   
+} /* FSW_StartFileTimers() */
+
+
+/******************************************************************************
+** Functions: FSW_HkFileTimer
+**
+*/
+static void FSW_HkFileTimer(void *Obj, uint32 Time)
+{
+   
+   ((FSW_Model_t *)Obj)->HkFileDue = true;
+   
+} /* FSW_HkFileTimer() */
+
+
+/******************************************************************************
+** Functions: FSW_EvsFileTimer
+**
+*/
+static void FSW_EvsFileTimer(void *Obj, uint32 Time)
+{
+   
+   ((FSW_Model_t *)Obj)->EvsFileDue = true;
    
-} /* FSW_ProcessEventCmd() */
+} /* FSW_EvsFileTimer() */
 
 
 /***************************************/
@@ -1677,34 +3878,100 @@ static void INSTR_Init(INSTR_Model_t *Instr)
 } /* INSTR_Init() */
 
 
+/******************************************************************************
+** Functions: INSTR_Config
+**
+** Load the instrument modes and field of view using the simulation
+** parameter table.
+**
+** Notes:
+**   1. Called with InitState true when a sim is started to power off the
+**      instrument and clear its data, and false when a new table is
+**      loaded.
+*/
+static void INSTR_Config(INSTR_Model_t *Instr, bool InitState)
+{
+
+   SC_SIM_SCI_Config(&Instr->Sci, &ScSim->Tbl.Data.Instr);
+   SC_SIM_TGT_Config(&Instr->Tgt, ScSim->Tbl.Data.Instr.Fov);
+   
+   if (InitState || !ScSim->Tbl.Data.Instr.TargetEna)
+   {
+      SC_SIM_TGT_Clear(&Instr->Tgt);
+   }
+   
+   if (InitState)
+   {
+      SC_SIM_SCI_Reset(&Instr->Sci, ScSim->Time.Seconds);
+      Instr->PwrEna     = false;
+      Instr->SciEna     = false;
+      Instr->LastExeTime = 0;
+      Instr->FileCnt     = 0;
+      Instr->SciFileSeq  = 0;
+      Instr->FileCycCnt  = 0;
+      Instr->FileCycStart = ScSim->Time.Seconds;
+      INSTR_UpdateLoad(Instr);
+      SC_SIM_SIG_SetInt(BUS, SIG_INSTR_SCI_FILES, 0);
+   }
+
+} /* INSTR_Config() */
+
+
 /******************************************************************************
 ** Functions: INSTR_Execute
 **
 ** Update Instrument model state.
 **
 ** Notes:
-**   None
+**   1. The step covers the sim second that starts at the current time.
+**      Every file completed in the step is published to FSW on the bus,
+**      see FSW_Execute().
+**   2. Like the power and thermal models, the time skipped from the
+**      scenario initialization to the first step isn't simulated.
+**   3. When target collection is enabled the first target entering the
+**      footprint queues a science enable and the last target leaving it
+**      queues a science disable, so they're logged like scripted events.
+**   4. The seconds since the last file are counted from time stamps, see
+**      INSTR_FileCycCnt().
 */
 static void INSTR_Execute(INSTR_Model_t *Instr)
 {
 
-  if (Instr->PwrEna && Instr->SciEna)
-  {
-  
-     Instr->FileCycCnt++;
-     if (Instr->FileCycCnt >= INSTR_CYCLES_PER_FILE)
-     {
-        
-        //Instr->FileCnt++;
-        FSW->Recorder.FileCnt++;
-        Instr->FileCycCnt = 0;
-     
-     }
-  }
-  else
-  {
-     Instr->FileCycCnt = 0;
-  }
+   SC_SIM_EventCmd_t SciEventCmd;
+   uint32 Files;
+   
+   if (ScSim->Tbl.Data.Instr.TargetEna && ADCS->Orbit.Valid && !ADCS->Orbit.Decayed)
+   {
+      if (SC_SIM_TGT_Update(&Instr->Tgt, ADCS->Orbit.PosEci, SIM_J2000Sec()))
+      {
+         SciEventCmd.Link.Prev = SC_SIM_EVT_CMD_NULL_IDX;
+         SciEventCmd.Link.Next = SC_SIM_EVT_CMD_NULL_IDX;
+         SciEventCmd.Time      = (int32)(ScSim->Time.Seconds + 1);
+         SciEventCmd.SubSys    = SC_SIM_Subsystem_INSTR;
+         SciEventCmd.Id        = (Instr->Tgt.ActiveCnt > 0) ? INSTR_EVT_ENA_SCIENCE : INSTR_EVT_DIS_SCIENCE;
+         SciEventCmd.ScanfType = SC_SIM_SCANF_NONE;
+         SciEventCmd.Param     = NULL;
+         SIM_AddEventCmd(&SciEventCmd);
+      }
+   }
+   
+   if (Instr->LastExeTime == 0)
+   {
+      SC_SIM_SCI_Skip(&Instr->Sci, ScSim->Time.Seconds);
+   }
+   Instr->LastExeTime = ScSim->Time.Seconds;
+   
+   Files = SC_SIM_SCI_Advance(&Instr->Sci, ScSim->Time.Seconds + 1.0);
+
+   if (Files > 0)
+   {
+      Instr->FileCnt    += (int16)Files;
+      Instr->SciFileSeq += Files;
+      SC_SIM_SIG_SetInt(BUS, SIG_INSTR_SCI_BYTES, (int32)Instr->Sci.FileBytes);
+      SC_SIM_SIG_SetInt(BUS, SIG_INSTR_SCI_FILES, (int32)Instr->SciFileSeq);
+      Instr->FileCycCnt   = 0;
+      Instr->FileCycStart = ScSim->Time.Seconds + 1;
+   }
    
 } /* INSTR_Execute() */
 
@@ -1719,24 +3986,40 @@ static bool INSTR_ProcessEventCmd(INSTR_Model_t *Instr, const SC_SIM_EventCmd_t
 {
    
    bool RetStatus = true;
+   bool Collecting = (Instr->PwrEna && Instr->SciEna);
+   
+   /* Close the collection interval, a new one starts below if still collecting */
+   if (Collecting)
+   {
+      Instr->FileCycCnt   = INSTR_FileCycCnt(Instr);
+      Instr->FileCycStart = ScSim->Time.Seconds;
+   }
    
    switch ((INSTR_EventCmd_t)EventCmd->Id)
    {
    case INSTR_EVT_ENA_POWER:
       Instr->PwrEna = true;
+      SC_SIM_SCI_SetPower(&Instr->Sci, true, ScSim->Time.Seconds);
       break;
 
    case INSTR_EVT_DIS_POWER:
       CFE_EVS_SendEvent(INSTR_DIS_POWER_EID, CFE_EVS_EventType_INFORMATION, "INSTR: Science instrument powered off");       
       Instr->PwrEna = false;
+      SC_SIM_SCI_SetPower(&Instr->Sci, false, ScSim->Time.Seconds);
       break;
 
    case INSTR_EVT_ENA_SCIENCE:
       Instr->SciEna = true;
+      SC_SIM_SCI_SetScience(&Instr->Sci, true, ScSim->Time.Seconds);
       break;
 
    case INSTR_EVT_DIS_SCIENCE:
       Instr->SciEna = false;
+      SC_SIM_SCI_SetScience(&Instr->Sci, false, ScSim->Time.Seconds);
+      break;
+
+   case INSTR_EVT_SET_MODE:
+      RetStatus = SC_SIM_SCI_SetMode(&Instr->Sci, ScSim->EventCmdParam.OneInt, ScSim->Time.Seconds);
       break;
 
    default:
@@ -1744,7 +4027,11 @@ static bool INSTR_ProcessEventCmd(INSTR_Model_t *Instr, const SC_SIM_EventCmd_t
       break;
       
    } /* End Cmd Id switch */
+   
+   if (!Collecting) Instr->FileCycStart = ScSim->Time.Seconds;
       
+   INSTR_UpdateLoad(Instr);
+   
    Instr->LastEventCmd = *EventCmd;
       
    return RetStatus;
@@ -1752,6 +4039,50 @@ static bool INSTR_ProcessEventCmd(INSTR_Model_t *Instr, const SC_SIM_EventCmd_t
 } /* INSTR_ProcessEventCmd() */
 
 
+/******************************************************************************
+** Functions: INSTR_UpdateLoad
+**
+** Update the instrument power load from the power and science states.
+**
+*/
+static void INSTR_UpdateLoad(INSTR_Model_t *Instr)
+{
+   
+   const SC_SIM_TBL_Load_t *Tbl = &ScSim->Tbl.Data.Load;
+   float Watts = 0.0;
+   
+   if (Instr->PwrEna)
+   {
+      Watts = Tbl->InstrPwr;
+      if (Instr->SciEna) Watts += Tbl->InstrSci;
+   }
+   
+   SC_SIM_SIG_SetFlt(BUS, SIG_LOAD_0 + POWER_LOAD_INSTR, Watts);
+   
+} /* INSTR_UpdateLoad() */
+
+
+/******************************************************************************
+** Functions: INSTR_FileCycCnt
+**
+** Return the seconds collecting science since the last file was stored.
+**
+*/
+static int16 INSTR_FileCycCnt(const INSTR_Model_t *Instr)
+{
+   
+   int32 Cnt = Instr->FileCycCnt;
+   
+   if (Instr->PwrEna && Instr->SciEna && ScSim->Time.Seconds > Instr->FileCycStart)
+   {
+      Cnt += (int32)(ScSim->Time.Seconds - Instr->FileCycStart);
+   }
+   
+   return (int16)((Cnt > INT16_MAX) ? INT16_MAX : Cnt);
+   
+} /* INSTR_FileCycCnt() */
+
+
 /**********************************/
 /**********************************/
 /****                          ****/
@@ -1771,47 +4102,207 @@ static bool INSTR_ProcessEventCmd(INSTR_Model_t *Instr, const SC_SIM_EventCmd_t
 static void POWER_Init(POWER_Model_t *Power)
 {
 
+   uint16 i;
+   
    CFE_PSP_MemSet((void*)Power, 0, sizeof(POWER_Model_t));
 
+   SC_SIM_SIG_Subscribe(&Power->SunSub, SIG_ADCS_ECLIPSE);
+   SC_SIM_SIG_Subscribe(&Power->SunSub, SIG_ADCS_MODE);
+   SC_SIM_SIG_Subscribe(&Power->SunSub, SIG_ADCS_ATT_ERR);
+   
+   for (i=0; i < POWER_LOAD_CNT; i++)
+   {
+      SC_SIM_SIG_Subscribe(&Power->LoadSub, SIG_LOAD_0 + i);
+   }
+
+   SC_SIM_ODE_Register(&Power->Ode, "Power", SC_SIM_ODE_DOPRI45, &Power->OdeSoc, 1, POWER_Derivatives, Power);
+
 } /* POWER_Init() */
 
 
+/******************************************************************************
+** Functions: POWER_Config
+**
+** Load the power model parameters from the simulation parameter table.
+**
+** Notes:
+**   1. Called when a sim is started and when a new table is loaded.
+*/
+static void POWER_Config(POWER_Model_t *Power)
+{
+
+   const SC_SIM_TBL_Power_t *Tbl = &ScSim->Tbl.Data.Power;
+   const SC_SIM_TBL_Integ_t *Integ = &ScSim->Tbl.Data.Integ;
+   
+   SC_SIM_LUT_Load(&Power->OcvLut, 0.0, 100.0/(SC_SIM_TBL_OCV_PTS-1), Tbl->Ocv, SC_SIM_TBL_OCV_PTS);
+
+   Power->LastExeTime = 0.0;
+   SC_SIM_ODE_Config(&Power->Ode, Integ->RelTol, Integ->AbsTol, Integ->MaxStep);
+   Power->OdeActive = false;
+
+   /* Republish every component's draw with the table's loads */
+   CDH_UpdateLoad(CDH);
+   ADCS_UpdateLoad(ADCS);
+   COMM_UpdateLoad(COMM);
+   INSTR_UpdateLoad(INSTR);
+   THERM_UpdateLoad(THERM);
+   
+   SC_SIM_SIG_Invalidate(&Power->SunSub);
+   SC_SIM_SIG_Invalidate(&Power->LoadSub);
+   POWER_UpdateBusLoad(Power);
+
+} /* POWER_Config() */
+
+
 /******************************************************************************
 ** Functions: POWER_Execute
 **
 ** Update Power model state.
 **
 ** Notes:
-**   None
+**   1. The battery is an open circuit voltage source in series with an
+**      internal resistance. Charge current is derated by the charge
+**      efficiency and current beyond a full battery is shunted.
+**   2. Array current scales with the cosine of the sun incidence angle and
+**      linearly with the thermal model's array temperature. Sun pointing
+**      modes use the ADCS attitude error as the incidence angle.
+**   3. The bus load is drawn as constant power at the battery voltage.
+**   4. Integrates over the time since the last execution. The first
+**      execution of a sim establishes the starting time.
+**   5. The sun incidence and the bus load are only recomputed when one of
+**      their signals changed.
+**   6. When integrating the charge is advanced to the execution time with
+**      the inputs held since the last restart. The integration restarts
+**      when the array current or the bus load drifts beyond the table's
+**      input tolerance, e.g. at an eclipse entry or a load switching.
 */
 static void POWER_Execute(POWER_Model_t *Power)
 {
 
-   /*
-   ** Simple linear model not based on any physics. 
-   ** +/- 1% change for every minute charging/discharging   
-   */
+   const SC_SIM_TBL_Power_t *Tbl = &ScSim->Tbl.Data.Power;
+   double Now = SIM_Time();
+   bool   Integrating = SIM_Integrating();
+   float  Dt = 0.0;
+   float  Ocv, DeltaAh;
+   double Input[2];
+   int32  Mode;
    
-   if (ADCS->Eclipse == true)
+   if (Power->LastExeTime != 0.0)
+   {
+      Dt = (float)SIM_Elapsed(Power->LastExeTime);
+   }
+   Power->LastExeTime = Now;
+
+   if (Integrating && Power->OdeActive)
    {
+      SC_SIM_ODE_Advance(&Power->Ode, Now);
+      Power->BattSoc = (float)Power->OdeSoc;
+      if (Power->BattSoc > 100.0) Power->BattSoc = 100.0;
+      if (Power->BattSoc < 0.0)   Power->BattSoc = 0.0;
+   }
+
+   if (SC_SIM_SIG_Changed(BUS, &Power->SunSub))
+   {
+   
+      Mode = SC_SIM_SIG_GetInt(BUS, SIG_ADCS_MODE);
+      if (SC_SIM_SIG_GetBool(BUS, SIG_ADCS_ECLIPSE))
+      {
+         Power->SaSunCos = 0.0;
+      }
+      else if (Mode == ADCS_MODE_SAFEHOLD || Mode == ADCS_MODE_SUN_POINT)
+      {
+         Power->SaSunCos = cos(SC_SIM_SIG_GetFlt(BUS, SIG_ADCS_ATT_ERR)*(M_PI/180.0));
+      }
+      else
+      {
+         Power->SaSunCos = Tbl->SaInertialCos;
+      }
+      SC_SIM_SIG_Ack(BUS, &Power->SunSub);
+   
+   }
+   
+   if (SC_SIM_SIG_Changed(BUS, &Power->LoadSub)) POWER_UpdateBusLoad(Power);
+   
+   Power->SaTemp    = SC_SIM_SIG_GetFlt(BUS, SIG_THERM_SA_TEMP);
+   Power->SaCurrent = Tbl->SaIsc*Power->SaSunCos*(1.0 + Tbl->SaTempCoef*(Power->SaTemp - Tbl->SaRefTemp));
+   if (Power->SaCurrent < 0.0) Power->SaCurrent = 0.0;
 
-     Power->SaCurrent = 0.0;
+   Ocv = SC_SIM_LUT_Eval(&Power->OcvLut, Power->BattSoc);
+   
+   Power->LoadCurrent = (Ocv > 0.0) ? Power->BusLoad/Ocv : 0.0;
+   Power->BattCurrent = Power->SaCurrent - Power->LoadCurrent;
+   if (Power->BattSoc >= 100.0 && Power->BattCurrent > 0.0) Power->BattCurrent = 0.0;
+   
+   Power->BattVolt = Ocv + Power->BattCurrent*Tbl->BattResistance;
 
-     Power->BattSoc -= 1.0/50.0;
-     if (Power->BattSoc > 100.0) Power->BattSoc = 100.0;
-     
+   if (Integrating)
+   {
+   
+      Input[0] = Power->SaCurrent;
+      Input[1] = Power->BusLoad;
+      if (!Power->OdeActive ||
+          SC_SIM_ODE_Drifted(&Power->OdeInput[0], &Input[0], 1, ScSim->Tbl.Data.Integ.InputTol) ||
+          SC_SIM_ODE_Drifted(&Power->OdeInput[1], &Input[1], 1, ScSim->Tbl.Data.Integ.InputTol))
+      {
+         Power->OdeInput[0] = Input[0];
+         Power->OdeInput[1] = Input[1];
+         Power->OdeSoc = Power->BattSoc;
+         SC_SIM_ODE_Restart(&Power->Ode, Now);
+         Power->OdeActive = true;
+      }
+   
    }
    else
    {
+   
+      Power->OdeActive = false;
+      if (Tbl->BattCapacity > 0.0)
+      {
+         DeltaAh = Power->BattCurrent*Dt/3600.0;
+         if (DeltaAh > 0.0) DeltaAh *= Tbl->ChargeEff;
+      
+         Power->BattSoc += 100.0*DeltaAh/Tbl->BattCapacity;
+         if (Power->BattSoc > 100.0) Power->BattSoc = 100.0;
+         if (Power->BattSoc < 0.0)   Power->BattSoc = 0.0;
+      }
+   
+   }
+   
+   SC_SIM_SIG_SetFlt(BUS, SIG_POWER_SA_SUN_COS, Power->SaSunCos);
+   SC_SIM_SIG_SetFlt(BUS, SIG_POWER_BATT_CURR, Power->BattCurrent);
+   
+} /* POWER_Execute() */
+
 
-     Power->SaCurrent = 10.0;
+/******************************************************************************
+** Functions: POWER_Derivatives
+**
+** Rate of change of the battery state of charge (percent/sec).
+**
+** Notes:
+**   1. Same battery model as POWER_Execute() with the array current and
+**      the bus load held at their OdeInput[] values from the last restart.
+*/
+static void POWER_Derivatives(void *Model, double Time, const double *Y, double *Dy)
+{
 
-     Power->BattSoc += 1.0/50.0;
-     if (Power->BattSoc < 0.0) Power->BattSoc = 0.0;
+   const POWER_Model_t *Power = (const POWER_Model_t *)Model;
+   const SC_SIM_TBL_Power_t *Tbl = &ScSim->Tbl.Data.Power;
+   double Ocv = SC_SIM_LUT_Eval(&Power->OcvLut, (float)Y[0]);
+   double Current = Power->OdeInput[0] - ((Ocv > 0.0) ? Power->OdeInput[1]/Ocv : 0.0);
    
+   if (Current > 0.0) Current *= Tbl->ChargeEff;
+   
+   if (Tbl->BattCapacity <= 0.0 || (Y[0] >= 100.0 && Current > 0.0) || (Y[0] <= 0.0 && Current < 0.0))
+   {
+      Dy[0] = 0.0;
+   }
+   else
+   {
+      Dy[0] = 100.0*Current/(3600.0*Tbl->BattCapacity);
    }
    
-} /* POWER_Execute() */
+} /* POWER_Derivatives() */
 
 
 /******************************************************************************
@@ -1830,10 +4321,7 @@ static bool POWER_ProcessEventCmd(POWER_Model_t *Power, const SC_SIM_EventCmd_t
       
    case POWER_EVT_SET_BATT_SOC:
       Power->BattSoc = ScSim->EventCmdParam.OneFlt;
-      break;
-
-   case POWER_EVT_SET_SA_CURRENT:
-      Power->SaCurrent = ScSim->EventCmdParam.OneFlt;
+      Power->OdeActive = false;
       break;
 
    default:
@@ -1849,6 +4337,28 @@ static bool POWER_ProcessEventCmd(POWER_Model_t *Power, const SC_SIM_EventCmd_t
 } /* POWER_ProcessEventCmd() */
 
 
+/******************************************************************************
+** Functions: POWER_UpdateBusLoad
+**
+** Read each component's draw from the signal bus and re-sum the bus load.
+**
+*/
+static void POWER_UpdateBusLoad(POWER_Model_t *Power)
+{
+   
+   uint16 i;
+   
+   Power->BusLoad = 0.0;
+   for (i=0; i < POWER_LOAD_CNT; i++)
+   {
+      Power->Load[i]  = (float)SC_SIM_SIG_GetFlt(BUS, SIG_LOAD_0 + i);
+      Power->BusLoad += (double)Power->Load[i];
+   }
+   SC_SIM_SIG_Ack(BUS, &Power->LoadSub);
+   
+} /* POWER_UpdateBusLoad() */
+
+
 /************************************/
 /************************************/
 /****                            ****/
@@ -1857,6 +4367,61 @@ static bool POWER_ProcessEventCmd(POWER_Model_t *Power, const SC_SIM_EventCmd_t
 /************************************/
 /************************************/
 
+/*
+** Default spacecraft thermal network. Solar areas are absorptivity times the
+** area projected toward the sun when sun pointing.
+*/
+
+static const SC_SIM_TNET_NodeDef_t ThermNode[THERM_NODE_CNT] =
+{
+
+   /* Name           Capacitance  InitTemp  SolarArea  AlbedoArea  IrArea */
+   { "Solar Array",      3000.0,     20.0,     0.90,      0.10,     0.15 },   /* THERM_NODE_SOLAR_ARRAY */
+   { "Battery",          1500.0,     15.0,     0.00,      0.00,     0.00 },   /* THERM_NODE_BATTERY     */
+   { "Avionics",         2000.0,     20.0,     0.00,      0.00,     0.00 },   /* THERM_NODE_AVIONICS    */
+   { "Comm",              800.0,     20.0,     0.00,      0.00,     0.00 },   /* THERM_NODE_COMM        */
+   { "Instrument",       2500.0,     15.0,     0.02,      0.02,     0.02 },   /* THERM_NODE_INSTR       */
+   { "Propellant Tank",  1200.0,     15.0,     0.00,      0.00,     0.00 },   /* THERM_NODE_PROP_TANK   */
+   { "Radiator",         1000.0,     10.0,     0.02,      0.05,     0.15 },   /* THERM_NODE_RADIATOR    */
+   { "Structure",        8000.0,     20.0,     0.05,      0.02,     0.05 }    /* THERM_NODE_STRUCTURE   */
+
+};
+
+static const SC_SIM_TNET_CouplingDef_t ThermCoupling[] =
+{
+
+   { THERM_NODE_SOLAR_ARRAY, THERM_NODE_STRUCTURE, SC_SIM_TNET_CONDUCTIVE, 0.5  },
+   { THERM_NODE_BATTERY,     THERM_NODE_STRUCTURE, SC_SIM_TNET_CONDUCTIVE, 1.0  },
+   { THERM_NODE_AVIONICS,    THERM_NODE_STRUCTURE, SC_SIM_TNET_CONDUCTIVE, 2.0  },
+   { THERM_NODE_COMM,        THERM_NODE_STRUCTURE, SC_SIM_TNET_CONDUCTIVE, 1.5  },
+   { THERM_NODE_INSTR,       THERM_NODE_STRUCTURE, SC_SIM_TNET_CONDUCTIVE, 0.8  },
+   { THERM_NODE_PROP_TANK,   THERM_NODE_STRUCTURE, SC_SIM_TNET_CONDUCTIVE, 0.6  },
+   { THERM_NODE_RADIATOR,    THERM_NODE_STRUCTURE, SC_SIM_TNET_CONDUCTIVE, 3.0  },
+   { THERM_NODE_BATTERY,     THERM_NODE_RADIATOR,  SC_SIM_TNET_CONDUCTIVE, 0.5  },
+   { THERM_NODE_AVIONICS,    THERM_NODE_RADIATOR,  SC_SIM_TNET_CONDUCTIVE, 1.0  },
+   { THERM_NODE_BATTERY,     THERM_NODE_STRUCTURE, SC_SIM_TNET_RADIATIVE,  0.05 },
+   { THERM_NODE_INSTR,       THERM_NODE_STRUCTURE, SC_SIM_TNET_RADIATIVE,  0.05 },
+   { THERM_NODE_SOLAR_ARRAY, SC_SIM_TNET_SPACE,    SC_SIM_TNET_RADIATIVE,  1.70 },
+   { THERM_NODE_RADIATOR,    SC_SIM_TNET_SPACE,    SC_SIM_TNET_RADIATIVE,  0.25 },
+   { THERM_NODE_INSTR,       SC_SIM_TNET_SPACE,    SC_SIM_TNET_RADIATIVE,  0.02 },
+   { THERM_NODE_STRUCTURE,   SC_SIM_TNET_SPACE,    SC_SIM_TNET_RADIATIVE,  0.10 }
+
+};
+
+/* Node that dissipates each bus load component */
+static const uint16 ThermLoadNode[POWER_LOAD_CNT] =
+{
+
+   THERM_NODE_AVIONICS,   /* POWER_LOAD_CDH      */
+   THERM_NODE_STRUCTURE,  /* POWER_LOAD_ADCS     */
+   THERM_NODE_COMM,       /* POWER_LOAD_COMM     */
+   THERM_NODE_INSTR,      /* POWER_LOAD_INSTR    */
+   THERM_NODE_BATTERY,    /* POWER_LOAD_HEATER_1 */
+   THERM_NODE_PROP_TANK   /* POWER_LOAD_HEATER_2 */
+
+};
+
+
 /******************************************************************************
 ** Functions: THERM_Init
 **
@@ -1868,36 +4433,215 @@ static bool POWER_ProcessEventCmd(POWER_Model_t *Power, const SC_SIM_EventCmd_t
 static void THERM_Init(THERM_Model_t *Therm)
 {
 
+   uint16 i;
+   
    CFE_PSP_MemSet((void*)Therm, 0, sizeof(THERM_Model_t));
    
+   Therm->Heater1Ena = true;
+   Therm->Heater2Ena = true;
+   
+   SC_SIM_SIG_Subscribe(&Therm->EnvSub, SIG_ADCS_ECLIPSE);
+   SC_SIM_SIG_Subscribe(&Therm->EnvSub, SIG_ADCS_ALT_KM);
+   SC_SIM_SIG_Subscribe(&Therm->EnvSub, SIG_POWER_SA_SUN_COS);
+   
+   SC_SIM_SIG_Subscribe(&Therm->PowerSub, SIG_POWER_BATT_CURR);
+   for (i=0; i < POWER_LOAD_CNT; i++)
+   {
+      SC_SIM_SIG_Subscribe(&Therm->PowerSub, SIG_LOAD_0 + i);
+   }
+   
+   SC_SIM_ODE_Register(&Therm->Ode, "Thermal", SC_SIM_ODE_ROS2, Therm->Net.Temp, THERM_NODE_CNT, THERM_Derivatives, Therm);
+
 } /* THERM_Init() */
 
 
 /******************************************************************************
-** Functions: Thermal_Execute
+** Functions: THERM_Config
+**
+** Build and factor the thermal network using the simulation parameter table.
+**
+** Notes:
+**   1. Called with InitTemps true when a sim is started and false when a
+**      new table is loaded so a table load doesn't reset temperatures.
+*/
+static void THERM_Config(THERM_Model_t *Therm, bool InitTemps)
+{
+
+   double Step = (ScSim->Tbl.Data.Therm.Step > 0.0) ? ScSim->Tbl.Data.Therm.Step : 1.0;
+   
+   SC_SIM_TNET_Config(&Therm->Net, ThermNode, THERM_NODE_CNT, ThermCoupling,
+                      (sizeof(ThermCoupling)/sizeof(SC_SIM_TNET_CouplingDef_t)), Step);
+   
+   if (InitTemps) SC_SIM_TNET_InitTemps(&Therm->Net);
+
+   Therm->LastExeTime = 0.0;
+   SC_SIM_ODE_Config(&Therm->Ode, ScSim->Tbl.Data.Integ.RelTol, ScSim->Tbl.Data.Integ.AbsTol, ScSim->Tbl.Data.Integ.MaxStep);
+   Therm->OdeActive = false;
+   SC_SIM_SIG_Invalidate(&Therm->EnvSub);
+   SC_SIM_SIG_Invalidate(&Therm->PowerSub);
+   Therm->EnvSkipCnt   = 0;
+   Therm->PowerSkipCnt = 0;
+   SC_SIM_SIG_SetFlt(BUS, SIG_THERM_SA_TEMP, SC_SIM_TNET_TempC(&Therm->Net, THERM_NODE_SOLAR_ARRAY));
+   
+} /* THERM_Config() */
+
+
+/******************************************************************************
+** Functions: THERM_Execute
 **
 ** Update Thermal model state.
 **
 ** Notes:
-**   None
+**   1. Environment loads use the power model's array sun incidence for
+**      solar flux and a 1/r^2 falloff for Earth albedo and IR.
+**   2. Bus loads are dissipated in their component's node and battery
+**      I^2R losses in the battery node.
+**   3. Heaters are thermostat controlled with hysteresis between their on
+**      and off temperatures when enabled.
+**   4. Steps over the time since the last execution. The first execution
+**      of a sim establishes the starting time.
+**   5. The environment and dissipation are only reloaded into the network
+**      when one of their signals changed. Altitude and battery current
+**      are published with a deadband so most steps skip the reload.
+**   6. When integrating the temperatures are advanced to the execution
+**      time with the heat loads held since the last restart. The
+**      integration restarts when the node heat loads drift beyond the
+**      table's input tolerance, e.g. at an eclipse entry or a heater
+**      switching.
 */
 static void THERM_Execute(THERM_Model_t *Therm)
 {
    
-   if (ADCS->Eclipse == true)
+   const SC_SIM_TBL_Therm_t *Tbl = &ScSim->Tbl.Data.Therm;
+   double Now = SIM_Time();
+   bool   Integrating = SIM_Integrating();
+   double Dt = 0.0;
+   double EarthFac, RadiusKm, BattTemp, TankTemp;
+   double Load[THERM_NODE_CNT];
+   float  BattCurrent;
+   bool   Heater1On, Heater2On;
+   uint16 i;
+   
+   if (Therm->LastExeTime != 0.0)
+   {
+      Dt = SIM_Elapsed(Therm->LastExeTime);
+   }
+   Therm->LastExeTime = Now;
+   
+   if (Integrating && Therm->OdeActive) SC_SIM_ODE_Advance(&Therm->Ode, Now);
+   
+   if (SC_SIM_SIG_Changed(BUS, &Therm->EnvSub))
+   {
+      
+      RadiusKm = SC_SIM_SIG_GetFlt(BUS, SIG_ADCS_ALT_KM) + SC_SIM_ORBIT_RE_KM;
+      EarthFac = (SC_SIM_ORBIT_RE_KM/RadiusKm)*(SC_SIM_ORBIT_RE_KM/RadiusKm);
+   
+      SC_SIM_TNET_SetEnvironment(&Therm->Net, Tbl->SolarFlux*SC_SIM_SIG_GetFlt(BUS, SIG_POWER_SA_SUN_COS),
+                                 SC_SIM_SIG_GetBool(BUS, SIG_ADCS_ECLIPSE) ? 0.0 : Tbl->Albedo*Tbl->SolarFlux*EarthFac,
+                                 Tbl->EarthIr*EarthFac);
+      SC_SIM_SIG_Ack(BUS, &Therm->EnvSub);
+   
+   }
+   else
+   {
+      Therm->EnvSkipCnt++;
+   }
+   
+   if (SC_SIM_SIG_Changed(BUS, &Therm->PowerSub))
+   {
+      
+      BattCurrent = SC_SIM_SIG_GetFlt(BUS, SIG_POWER_BATT_CURR);
+      
+      for (i=0; i < THERM_NODE_CNT; i++) SC_SIM_TNET_SetPower(&Therm->Net, i, 0.0);
+      for (i=0; i < POWER_LOAD_CNT; i++)
+      {
+         SC_SIM_TNET_SetPower(&Therm->Net, ThermLoadNode[i], Therm->Net.Power[ThermLoadNode[i]] + 
+                              (float)SC_SIM_SIG_GetFlt(BUS, SIG_LOAD_0 + i));
+      }
+      SC_SIM_TNET_SetPower(&Therm->Net, THERM_NODE_BATTERY, Therm->Net.Power[THERM_NODE_BATTERY] + 
+                           BattCurrent*BattCurrent*ScSim->Tbl.Data.Power.BattResistance);
+      SC_SIM_SIG_Ack(BUS, &Therm->PowerSub);
+   
+   }
+   else
+   {
+      Therm->PowerSkipCnt++;
+   }
+   
+   if (Integrating)
    {
-      Therm->Heater1Ena = true;
-      Therm->Heater2Ena = true;  
+      
+      THERM_HeatLoads(Therm, Load);
+      if (!Therm->OdeActive ||
+          SC_SIM_ODE_Drifted(Therm->OdeInput, Load, THERM_NODE_CNT, ScSim->Tbl.Data.Integ.InputTol))
+      {
+         memcpy(Therm->OdeInput, Load, sizeof(Therm->OdeInput));
+         SC_SIM_ODE_Restart(&Therm->Ode, Now);
+         Therm->OdeActive = true;
+      }
+      
    }
    else
    {
-      Therm->Heater1Ena = false;
-      Therm->Heater2Ena = false;
+      
+      SC_SIM_TNET_Step(&Therm->Net, Dt);
+      Therm->OdeActive = false;
+   
+   }
+   
+   SC_SIM_SIG_SetFlt(BUS, SIG_THERM_SA_TEMP, SC_SIM_TNET_TempC(&Therm->Net, THERM_NODE_SOLAR_ARRAY));
+   
+   BattTemp = SC_SIM_TNET_TempC(&Therm->Net, THERM_NODE_BATTERY);
+   TankTemp = SC_SIM_TNET_TempC(&Therm->Net, THERM_NODE_PROP_TANK);
+   
+   Heater1On = Therm->Heater1Ena && (BattTemp <= Tbl->Heater1OnTemp || (Therm->Heater1On && BattTemp < Tbl->Heater1OffTemp));
+   Heater2On = Therm->Heater2Ena && (TankTemp <= Tbl->Heater2OnTemp || (Therm->Heater2On && TankTemp < Tbl->Heater2OffTemp));
+   
+   if (Heater1On != Therm->Heater1On || Heater2On != Therm->Heater2On)
+   {
+      Therm->Heater1On = Heater1On;
+      Therm->Heater2On = Heater2On;
+      THERM_UpdateLoad(Therm);
    }
    
 } /* THERM_Execute() */
 
 
+/******************************************************************************
+** Functions: THERM_Derivatives
+**
+** Rate of change of the network temperatures with the heat loads held.
+**
+*/
+static void THERM_Derivatives(void *Model, double Time, const double *Y, double *Dy)
+{
+
+   SC_SIM_TNET_Derivatives(&((const THERM_Model_t *)Model)->Net, Y, Dy);
+   
+} /* THERM_Derivatives() */
+
+
+/******************************************************************************
+** Functions: THERM_HeatLoads
+**
+** Total heat (W) absorbed and dissipated by each node of the network.
+**
+*/
+static void THERM_HeatLoads(const THERM_Model_t *Therm, double *Load)
+{
+
+   const SC_SIM_TNET_Class_t *Net = &Therm->Net;
+   uint16 i;
+   
+   for (i=0; i < THERM_NODE_CNT; i++)
+   {
+      Load[i] = Net->Power[i] + Net->SolarFlux*ThermNode[i].SolarArea +
+                Net->AlbedoFlux*ThermNode[i].AlbedoArea + Net->EarthIrFlux*ThermNode[i].IrArea;
+   }
+   
+} /* THERM_HeatLoads() */
+
+
 /******************************************************************************
 ** Functions: THERM_ProcessEventCmd
 **
@@ -1914,10 +4658,12 @@ static bool THERM_ProcessEventCmd(THERM_Model_t *Therm, const SC_SIM_EventCmd_t
 
    case THERM_EVT_ENA_HEATER_1:
       Therm->Heater1Ena = ScSim->EventCmdParam.OneInt;
+      if (!Therm->Heater1Ena) Therm->Heater1On = false;
       break;
 
    case THERM_EVT_ENA_HEATER_2:
       Therm->Heater2Ena = ScSim->EventCmdParam.OneInt;
+      if (!Therm->Heater2Ena) Therm->Heater2On = false;
       break;
 
    default:
@@ -1926,9 +4672,25 @@ static bool THERM_ProcessEventCmd(THERM_Model_t *Therm, const SC_SIM_EventCmd_t
       
    } /* End Cmd Id switch */
    
+   THERM_UpdateLoad(Therm);
    
    Therm->LastEventCmd = *EventCmd;
    
    return RetStatus;
    
 } /* THERM_ProcessEventCmd() */
+
+
+/******************************************************************************
+** Functions: THERM_UpdateLoad
+**
+** Update the heater power loads.
+**
+*/
+static void THERM_UpdateLoad(THERM_Model_t *Therm)
+{
+   
+   SC_SIM_SIG_SetFlt(BUS, SIG_LOAD_0 + POWER_LOAD_HEATER_1, Therm->Heater1On ? ScSim->Tbl.Data.Load.Heater1 : 0.0);
+   SC_SIM_SIG_SetFlt(BUS, SIG_LOAD_0 + POWER_LOAD_HEATER_2, Therm->Heater2On ? ScSim->Tbl.Data.Load.Heater2 : 0.0);
+   
+} /* THERM_UpdateLoad() */
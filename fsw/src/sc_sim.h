@@ -38,6 +38,24 @@
 
 #include "app_cfg.h"
 #include "sc_sim_tbl.h"
+#include "sc_sim_ephem.h"
+#include "sc_sim_orbit.h"
+#include "sc_sim_lut.h"
+#include "sc_sim_tnet.h"
+#include "sc_sim_contact.h"
+#include "sc_sim_link.h"
+#include "sc_sim_rec.h"
+#include "sc_sim_sci.h"
+#include "sc_sim_tgt.h"
+#include "sc_sim_fault.h"
+#include "sc_sim_recur.h"
+#include "sc_sim_merge.h"
+#include "sc_sim_sens.h"
+#include "sc_sim_sig.h"
+#include "sc_sim_dag.h"
+#include "sc_sim_ode.h"
+#include "sc_sim_tmr.h"
+#include "sc_sim_snap.h"
 #include "sc_sim_eds_typedefs.h"
 
 /***********************/
@@ -62,17 +80,25 @@
 #define SC_SIM_EXECUTE_EID          (SC_SIM_BASE_EID + 10)
 #define SC_SIM_ACCEPT_NEW_TBL_EID   (SC_SIM_BASE_EID + 11)
 #define SC_SIM_PROCESS_JMSG_CMD_EID (SC_SIM_BASE_EID + 12)
+#define SC_SIM_RATE_EID             (SC_SIM_BASE_EID + 13)
+#define SC_SIM_BENCHMARK_EID        (SC_SIM_BASE_EID + 14)
+#define SC_SIM_LAPSE_TASK_EID       (SC_SIM_BASE_EID + 15)
 
 #define ADCS_ENTER_ECLIPSE_EID    (SC_SIM_BASE_EID + 20)
 #define ADCS_EXIT_ECLIPSE_EID     (SC_SIM_BASE_EID + 21)
 #define ADCS_CHANGE_MODE_EID      (SC_SIM_BASE_EID + 22)
+#define ADCS_WHEEL_FAIL_EID       (SC_SIM_BASE_EID + 23)
 
 #define CDH_WATCHDOG_RESET_EID    (SC_SIM_BASE_EID + 30)
+#define CDH_RESET_EID             (SC_SIM_BASE_EID + 31)
+#define CDH_BOOT_EID              (SC_SIM_BASE_EID + 32)
+#define CDH_HW_CMD_EID            (SC_SIM_BASE_EID + 33)
 
 #define COMM_START_CONTACT_EID    (SC_SIM_BASE_EID + 40)
 #define COMM_PROCESS_EVENT_EID    (SC_SIM_BASE_EID + 41)
+#define COMM_LINK_DROP_EID        (SC_SIM_BASE_EID + 42)
 
-// FSW + 50
+#define FSW_REC_SEU_EID           (SC_SIM_BASE_EID + 50)
 
 #define INSTR_DIS_POWER_EID       (SC_SIM_BASE_EID + 60)
 
@@ -109,12 +135,25 @@
 #define SC_SIM_INIT_TIME             (1)  /* Model initialization */  
 
 #define SC_SIM_TIME_LAPSE_EXE_CNT (1000)  /* Number of simulation seconds to perform in one SC_SIM execution cycle during time lapse phase */
+#define SC_SIM_LAPSE_TASK_STACK  (32768)  /* Background time lapse child task */
 
 #define SC_SIM_REALTIME_EPOCH    (10000)  /* Time when realtime simulation starts */ 
 #define SC_SIM_REALTIME_END      (20000)  /* Sim doesn't execute until this time. Thsi time indicates sim is over */ 
 
-#define SC_SIM_EVT_CMD_MAX          (25)  /* Maximum number of event commands */
+#define SC_SIM_MAX_MINOR_HZ        (100)  /* Maximum minor frames per second */
+
+#define SC_SIM_BENCHMARK_MAX_SPAN  (86400)  /* Longest integrator benchmark span, seconds */
+
+#define SC_SIM_EVT_CMD_MAX          (32)  /* Maximum number of event commands */
 #define SC_SIM_EVT_CMD_NULL_IDX     (99)  /* Maximum number of event commands */
+#define SC_SIM_EVT_CMD_PARAM_LEN    (48)  /* Runtime cmd parameter copy, including the terminator */
+
+#define SC_SIM_OVERLAY_MAX          (SC_SIM_MERGE_MAX)  /* Overlay scripts that can be merged with a scenario */
+
+/* Event cmd stream IDs reported in telemetry */
+#define SC_SIM_EVT_STREAM_BASE      (0)  /* Scenario cmds */
+#define SC_SIM_EVT_STREAM_RUNTIME   (1)  /* Cmds added while the sim runs */
+#define SC_SIM_EVT_STREAM_OVERLAY   (2)  /* Overlay n is stream n+2 */
 
 /**********************/
 /** Type Definitions **/
@@ -146,7 +185,8 @@ typedef enum
    SC_SIM_SCANF_3_FLT    = 5,
    SC_SIM_SCANF_4_FLT    = 6,
    SC_SIM_SCANF_NONE     = 7,
-   SC_SIM_SCANF_TYPE_CNT = 8
+   SC_SIM_SCANF_6_FLT    = 8,
+   SC_SIM_SCANF_TYPE_CNT = 9
    
 } SC_SIM_ScanfType_t;
 
@@ -159,6 +199,7 @@ typedef struct
    float  OneFlt;
    float  ThreeFlt[3];
    float  FourFlt[4];
+   float  SixFlt[6];
    
 } SC_SIM_EventCmdParam_t;
 
@@ -226,6 +267,62 @@ typedef struct
       
 } SC_SIM_EventCmd_t;
 
+/*
+** Data owned by a runtime event cmd entry, indexed like the scenario's
+** cmds. The parameter is copied so the adder's string can be reused.
+*/
+typedef struct
+{
+
+   char   Param[SC_SIM_EVT_CMD_PARAM_LEN];
+   uint8  FaultSlot;        /* Fault slot that added the cmd plus 1, 0 if not a fault */
+
+} SC_SIM_RunTimeCmd_t;
+
+/*
+** An overlay script is a time sorted array of event cmds that is merged
+** with the scenario's cmds as the sim runs. Overlay cmds don't use links.
+*/
+typedef struct
+{
+
+   const SC_SIM_EventCmd_t  *Cmd;
+   uint16                   Cnt;
+   uint16                   Idx;   /* Next cmd */
+   
+} SC_SIM_EventStream_t;
+
+
+/*************/
+/** Signals **/
+/*************/
+
+/*
+** Model outputs published on the signal bus. A model reads other models'
+** outputs from the bus, see SIM_DefineSignals() for each signal's type
+** and producer. Bus loads are indexed by POWER_Load_t.
+*/
+typedef enum
+{
+
+   SIG_ADCS_ECLIPSE      = 0,
+   SIG_ADCS_MODE         = 1,
+   SIG_ADCS_ATT_ERR      = 2,   /* Deg */
+   SIG_ADCS_ALT_KM       = 3,   /* Orbit altitude, nominal altitude if no orbit */
+   SIG_CDH_STATE         = 4,
+   SIG_COMM_IN_CONTACT   = 5,
+   SIG_COMM_DL_BYTES     = 6,   /* Downlink bytes per second */
+   SIG_FSW_REC_PCT_USED  = 7,
+   SIG_POWER_SA_SUN_COS  = 8,
+   SIG_POWER_BATT_CURR   = 9,   /* Amps */
+   SIG_THERM_SA_TEMP     = 10,  /* Deg C */
+   SIG_INSTR_SCI_FILES   = 11,  /* Science files completed since the sim started */
+   SIG_INSTR_SCI_BYTES   = 12,  /* Science file size of the current mode */
+   SIG_LOAD_0            = 13,  /* Watts, one per bus load component */
+   SIG_CNT               = (SIG_LOAD_0 + 6)
+
+} SIM_Signal_t;
+
 
 /**********/
 /** ADCS **/
@@ -240,7 +337,8 @@ typedef enum
    ADCS_EVT_ENTER_ECLIPSE  = 2,
    ADCS_EVT_EXIT_ECLIPSE   = 3,
    ADCS_EVT_SET_ATTITUDE   = 4,
-   ADCS_EVT_SET_ORBIT      = 5
+   ADCS_EVT_SET_ORBIT      = 5,  /* SMA(km) Ecc Inc Raan ArgPer MeanAnom(deg) */
+   ADCS_EVT_WHEEL_FAIL     = 6   /* Wheel number, taken modulo the wheel count */
 
 } ADCS_EventCmd_t;
 
@@ -255,6 +353,9 @@ typedef enum
 
 } ADCS_Mode_t;
 
+#define ADCS_WHEEL_CNT   4   /* Reaction wheels */
+#define ADCS_MIN_WHEELS  3   /* Healthy wheels needed for 3-axis control */
+
 typedef struct
 {
 
@@ -267,6 +368,12 @@ typedef struct
    bool         Eclipse;
    ADCS_Mode_t  Mode;
    double       AttErr;
+   double       SunUnitEci[3];  /* From ephemeris service */
+   
+   SC_SIM_ORBIT_Class_t Orbit;  /* Eclipse is computed from the orbit once one is set */
+   double       BetaAngle;      /* Sun angle above the orbit plane (deg) */
+   
+   uint8        WheelFailed;    /* Bit n set when wheel n has failed */
    
 } ADCS_Model_t;
 
@@ -275,13 +382,30 @@ typedef struct
 /** CDH **/
 /*********/
 
+/*
+** The single board computer (SBC) is a state machine:
+**
+**   OFF --(power cycle off time)--> BOOTING --(boot time)--> OPERATIONAL
+**
+** A reset from OPERATIONAL or BOOTING goes to BOOTING with the selected
+** boot image and a power cycle goes to OFF. While OPERATIONAL the flight
+** software kicks the watchdog every kick period and the watchdog resets the
+** SBC if it isn't kicked for the timeout.
+**
+** The state only changes at the model's next wake time so the model costs
+** a comparison per step between transitions. Kicks aren't simulated, the
+** watchdog expiration is computed from the kick schedule.
+*/
+
+#define CDH_NEVER  (0xFFFFFFFF)  /* No wake time */
 
 typedef enum
 {
 
    CDH_EVT_UNDEF        = 0,
    CDH_EVT_WATCHDOG_RST = 1,
-   CDH_EVT_SEND_HW_CMD  = 2
+   CDH_EVT_SEND_HW_CMD  = 2,
+   CDH_EVT_FSW_HANG     = 3   /* Flight software stops kicking the watchdog */
    
 } CDH_EventCmd_t;
 
@@ -311,6 +435,18 @@ typedef struct
    uint16  HwCmdCnt;
    CDH_HardwareCmd_t  LastHwCmd;
    
+   SC_SIM_CdhState_Enum_t      State;
+   SC_SIM_CdhBootImage_Enum_t  BootImage;     /* Running or booting image */
+   SC_SIM_CdhBootImage_Enum_t  BootSelect;    /* Image used by the next boot */
+   SC_SIM_CdhRstCause_Enum_t   RstCause;      /* Cause of the last reset */
+   
+   uint32  LastExeTime;
+   uint32  StateTime;      /* Time the current state was entered */
+   uint32  NextWakeTime;   /* Time of the next state transition, CDH_NEVER if none */
+   uint16  WakeTmr;        /* Expires at NextWakeTime */
+   bool    FswHung;
+   uint32  HangTime;       /* Time the flight software stopped kicking the watchdog */
+   
 } CDH_Model_t;
 
 /**********/
@@ -323,9 +459,11 @@ typedef enum
    COMM_EVT_UNDEF         = 0,
    COMM_EVT_SCH_AOS       = 1,  /* Schedule relative start time, length, Link Type */
    COMM_EVT_LOS           = 2,  /* Schedule loss of signal */
-   COMM_EVT_SET_DATA_RATE = 3,  /* Set rate for next contact */
+   COMM_EVT_SET_DATA_RATE = 3,  /* Set rate for scripted contacts, planned contacts use the link budget */
    COMM_EVT_SET_TDRS_ID   = 4,
-   COMM_EVT_ABORT_CONTACT = 5
+   COMM_EVT_ABORT_CONTACT = 5,
+   COMM_EVT_PLAN_AOS      = 6,  /* Start the planned contact, added by the contact planner */
+   COMM_EVT_LINK_DROP     = 7   /* Seconds the downlink is lost during a contact */
    
 } COMM_EventCmd_t;
 
@@ -354,11 +492,8 @@ typedef struct
 
    COMM_Link_t Link;
    uint16      TdrsId;
-   uint16      DataRate;
-   int16       TimePending;  /* Countdown timer until next contact. Negative value indicates no contect pending */ 
-   uint16      Length;
-   uint16      TimeConsumed;
-   uint16      TimeRemaining;
+   uint16      DataRate;     /* Current downlink rate (kbps) */
+   uint16      Length;       /* Seconds, the time pending, consumed and remaining come from the COMM timers */
         
 } COMM_Contact_t;
 
@@ -374,6 +509,24 @@ typedef struct
 
    bool           InContact;
    COMM_Contact_t Contact;
+   uint16         AosTmr;           /* Scripted contact start */
+   uint16         LosTmr;           /* Contact end */
+   
+   /* Contact Planner */
+   
+   SC_SIM_CONTACT_Class_t Planner;
+   bool           PlanAosQueued;    /* Planned AOS event cmd in the event list */
+   bool           PlannedContact;   /* Current contact is from the planner */
+   int32          PlanLosTime;      /* Sim time of the planned contact's LOS event cmd */
+   uint16         ContactStation;   /* Station table index + 1, 0 if not a station contact */
+   
+   /* Downlink */
+   
+   SC_SIM_LINK_Class_t Link;
+   uint16         CmdDataRate;      /* Scripted contact rate (kbps) */
+   uint32         DownlinkBytes;    /* Bytes the link can carry this step */
+   uint16         DropTmr;          /* Transient link drop end */
+   uint16         DropCnt;
    
 } COMM_Model_t;
 
@@ -386,15 +539,24 @@ typedef struct
 ** FSW uses a combination of simulated behavior and actual FSW status. Things like 
 ** playback are much easier to manipulate in a simulation. 
 */
+
+#define FSW_HK_FILE_PERIOD   60      /* Seconds of housekeeping per file */
+#define FSW_HK_FILE_BYTES    30000   /* 4 kbps housekeeping stream */
+#define FSW_HK_APID          0x0100
+#define FSW_EVS_FILE_PERIOD  600     /* Seconds of event log per file */
+#define FSW_EVS_FILE_BYTES   16384
+#define FSW_EVS_APID         0x0200
+
 typedef enum
 {
 
    FSW_EVT_UNDEF             = 0,
    FSW_EVT_SET_REC_FILE_CNT  = 1, /* Percentage of recorder memory used */
    FSW_EVT_SET_REC_PCT_USED  = 2, /* Number of files in recorder */
-   FSW_EVT_START_REC_PLBK    = 3,
+   FSW_EVT_START_REC_PLBK    = 3, /* Optional channel, start time and end time (see SC_SIM_StartPlbkCmd) */
    FSW_EVT_STOP_REC_PLBK     = 4,
-   FSW_EVT_CLR_EVT_LOG       = 5
+   FSW_EVT_CLR_EVT_LOG       = 5,
+   FSW_EVT_REC_SEU           = 6  /* Upset location, fraction of the recorder memory scaled to 2^31 */
 
 } FSW_EventCmd_t;
 
@@ -402,9 +564,11 @@ typedef enum
 typedef struct
 {
 
-   float   PctUsed;
-   uint16  FileCnt;
+   float   PctUsed;         /* Derived from Store */
+   uint32  FileCnt;         /* Derived from Store */
    bool    PlaybackEna;
+   
+   SC_SIM_REC_Class_t Store;
 
 } FSW_Recorder_t;
 
@@ -419,6 +583,12 @@ typedef struct
    /* Model State */
 
    FSW_Recorder_t Recorder;
+   
+   uint16  HkFileTmr;      /* Periodic housekeeping and event log file closes */
+   uint16  EvsFileTmr;
+   bool    HkFileDue;      /* Set by the timers, the file is stored when FSW executes */
+   bool    EvsFileDue;
+   uint32  SciFileCnt;     /* Instrument science files taken from the bus */
         
 } FSW_Model_t;
 
@@ -427,7 +597,8 @@ typedef struct
 /** Instrument **/
 /****************/
 
-#define INSTR_CYCLES_PER_FILE  30 /* Number of simulation cycles to 'generate' a new file */
+#define INSTR_SCI_APID         0x0400
+#define INSTR_SCI_VC           SC_SIM_REC_VC_SCI
  
 typedef enum
 {
@@ -436,7 +607,8 @@ typedef enum
    INSTR_EVT_ENA_POWER   = 1,
    INSTR_EVT_DIS_POWER   = 2,
    INSTR_EVT_ENA_SCIENCE = 3,
-   INSTR_EVT_DIS_SCIENCE = 4
+   INSTR_EVT_DIS_SCIENCE = 4,
+   INSTR_EVT_SET_MODE    = 5  /* Table mode index */
 
 } INSTR_EventCmd_t;
 
@@ -453,7 +625,13 @@ typedef struct
    bool   SciEna;
    
    int16  FileCnt;
-   int16  FileCycCnt;
+   uint32 SciFileSeq;      /* Files published to FSW on the bus since the sim started */
+   uint32 LastExeTime;
+   int16  FileCycCnt;      /* Collecting seconds since the last file before FileCycStart */
+   uint32 FileCycStart;    /* Time the current collection interval started */
+   
+   SC_SIM_SCI_Class_t Sci;
+   SC_SIM_TGT_Class_t Tgt;
         
 } INSTR_Model_t;
 
@@ -465,24 +643,62 @@ typedef struct
 typedef enum
 {
 
-   POWER_EVT_UNDEF          = 0,
-   POWER_EVT_SET_BATT_SOC   = 1,
-   POWER_EVT_SET_SA_CURRENT = 2
+   POWER_EVT_UNDEF        = 0,
+   POWER_EVT_SET_BATT_SOC = 1
 
 } POWER_EventCmd_t;
 
+/*
+** Bus load components. Each model publishes its component's draw on the
+** signal bus when its power state changes and the bus load is only
+** re-summed when a draw changed.
+*/
+typedef enum
+{
+
+   POWER_LOAD_CDH      = 0,
+   POWER_LOAD_ADCS     = 1,
+   POWER_LOAD_COMM     = 2,
+   POWER_LOAD_INSTR    = 3,
+   POWER_LOAD_HEATER_1 = 4,
+   POWER_LOAD_HEATER_2 = 5,
+   POWER_LOAD_CNT      = 6
+
+} POWER_Load_t;
+
 typedef struct
 {
 
    /* Model Management */
 
    SC_SIM_EventCmd_t  LastEventCmd;
+   double             LastExeTime;  /* Sim seconds, zero until the first execution of a sim */
+
+   SC_SIM_LUT_Class_t OcvLut;       /* Battery open circuit voltage vs SOC */
+   
+   SC_SIM_SIG_Sub_t   SunSub;       /* Inputs of the array's sun incidence */
+   SC_SIM_SIG_Sub_t   LoadSub;      /* Bus load components */
 
    /* Model State */
 
-   float  BattSoc;
-   float  SaCurrent;
+   float  BattSoc;      /* Percent */
+   float  SaCurrent;    /* Amps */
+   float  SaSunCos;     /* Cosine of the sun incidence angle on the array, 0 in eclipse */
+   float  SaTemp;       /* Deg C, from the thermal model */
+   float  BattVolt;     /* Terminal voltage */
+   float  BattCurrent;  /* Amps, positive is charging */
+   float  LoadCurrent;  /* Amps */
+   
+   float  Load[POWER_LOAD_CNT];  /* Watts drawn by each component */
+   double BusLoad;               /* Watts, sum of Load[] */
    
+   /* Error controlled integration of the battery charge */
+   
+   SC_SIM_ODE_Class_t Ode;
+   bool   OdeActive;             /* False forces a restart */
+   double OdeSoc;                /* Integrated state, copied to BattSoc */
+   double OdeInput[2];           /* SaCurrent and BusLoad at the last restart */
+
 } POWER_Model_t;
 
 
@@ -499,21 +715,113 @@ typedef enum
 
 } THERM_EventCmd_t;
 
+/*
+** Default thermal network nodes. The structure is coupled to every other
+** node so it's numbered last to keep the solver's matrix profile small.
+*/
+typedef enum
+{
+
+   THERM_NODE_SOLAR_ARRAY = 0,
+   THERM_NODE_BATTERY     = 1,
+   THERM_NODE_AVIONICS    = 2,
+   THERM_NODE_COMM        = 3,
+   THERM_NODE_INSTR       = 4,
+   THERM_NODE_PROP_TANK   = 5,
+   THERM_NODE_RADIATOR    = 6,
+   THERM_NODE_STRUCTURE   = 7,
+   THERM_NODE_CNT         = 8
+
+} THERM_Node_t;
+
 typedef struct
 {
 
    /* Model Management */
 
    SC_SIM_EventCmd_t  LastEventCmd;
+   double             LastExeTime;  /* Sim seconds, zero until the first execution of a sim */
+
+   SC_SIM_TNET_Class_t Net;
+   
+   SC_SIM_SIG_Sub_t   EnvSub;       /* Inputs of the orbit environment heating */
+   SC_SIM_SIG_Sub_t   PowerSub;     /* Inputs of the internal dissipation */
+   uint32             EnvSkipCnt;   /* Steps that reused the loads because no input changed */
+   uint32             PowerSkipCnt;
 
    /* Model State */
 
-   bool   Heater1Ena;
+   bool   Heater1Ena;   /* Thermostat control enabled */
    bool   Heater2Ena;
+   bool   Heater1On;    /* Heater 1 warms the battery */
+   bool   Heater2On;    /* Heater 2 warms the propellant tank */
         
+   /* Error controlled integration of the network temperatures */
+   
+   SC_SIM_ODE_Class_t Ode;
+   bool   OdeActive;                   /* False forces a restart */
+   double OdeInput[THERM_NODE_CNT];    /* Node heat loads (W) at the last restart */
+
 } THERM_Model_t;
 
 
+/******************************************************************************
+** Time Lapse
+**
+** By default the time lapse phase runs up to SC_SIM_TIME_LAPSE_EXE_CNT
+** steps on each execute message. When a slice message is configured the
+** steps are spread over the slice messages instead and each slice runs
+** the number of steps expected to fit in the slice's time budget.
+**
+** When a time lapse task priority is configured a lower priority child
+** task runs the whole time lapse instead, SC_SIM_TIME_LAPSE_EXE_CNT steps
+** at a time. The task holds the engine mutex while it steps and gives it
+** up after the current step when the main task asks for it, so commands
+** wait at most one step. While the task runs the execute message only
+** sends the telemetry the task publishes to the snapshot after each run
+** of steps.
+*/
+
+typedef struct
+{
+
+   bool       Sliced;       /* Time lapse runs on the slice messages */
+   uint32     BudgetUsec;   /* Time allowed per slice */
+   uint32     Start;        /* Sim time the time lapse started */
+   
+   uint16     Steps;        /* Steps in the next slice */
+   uint32     SliceCnt;
+   uint32     SliceUsec;    /* Duration of the last slice */
+   float      StepUsec;     /* Smoothed duration of a step, 0 until measured */
+   float      PeriodUsec;   /* Smoothed time between slice messages, 0 until measured */
+   OS_time_t  LastWake;
+   bool       Woken;        /* LastWake is valid */
+
+   bool       Background;   /* Time lapse runs in the child task */
+   osal_id_t  EngineMutex;  /* Held while the sim state is used */
+   osal_id_t  RunSem;       /* Starts the child task's time lapse */
+   volatile bool Busy;      /* Child task owns the time lapse until it ends or stops */
+   volatile bool YieldReq;  /* Main task is waiting for the engine mutex */
+
+} SC_SIM_Lapse_t;
+
+
+/*
+** Telemetry published by the task that runs the sim for the main task to
+** send
+*/
+
+typedef struct
+{
+
+   SC_SIM_MgmtTlm_Payload_t    Mgmt;
+   SC_SIM_ModelTlm_Payload_t   Model;
+   SC_SIM_SensorTlm_Payload_t  Sensor;
+   bool                        InContact;
+
+} SC_SIM_Snapshot_t;
+
+
 /******************************************************************************
 ** Command & Telmetery Packets
 **
@@ -538,6 +846,10 @@ typedef struct
   
    SC_SIM_MgmtTlm_t  MgmtTlm;
    SC_SIM_ModelTlm_t ModelTlm;
+   SC_SIM_SensorTlm_t SensorTlm;
+
+   SC_SIM_Snapshot_t   Stage;   /* Filled while holding the engine mutex */
+   SC_SIM_SNAP_Class_t Snap;
 
 
    /*
@@ -551,16 +863,34 @@ typedef struct
    
    bool                 Active;
    SC_SIM_Phase_Enum_t  Phase;
-   CFE_TIME_SysTime_t   Time;   /* Subseconds unused */
+   CFE_TIME_SysTime_t   Time;   /* Subseconds is the current minor frame's start */
+   uint16               MinorHz;        /* Minor frames per second */
+   uint16               MinorFrame;     /* Minor frame in the current second */
    uint32               Count;
+   double               EpochJ2000Sec;  /* Sim time zero in seconds since J2000 */
+   uint16               CraftId;        /* Keys the random streams with the table's run ID */
+   SC_SIM_Lapse_t       Lapse;
    
-   SC_SIM_EventCmd_t       *LastEventCmd;
-   SC_SIM_EventCmd_t       *NextEventCmd;   
+   const SC_SIM_EventCmd_t *LastEventCmd;
+   SC_SIM_EventCmd_t       *NextEventCmd;   /* Head of the scenario's event cmd list */
+   uint8                   LastEventStream;
    SC_SIM_EventCmdParam_t  EventCmdParam;
 
    SC_SIM_EventCmd_t  *Scenario;
    uint16             ScenarioId;
-   uint16             RunTimeCmdIdx;
+   uint16             RunTimeCmdIdx;  /* First runtime cmd entry, entries are reused after they execute */
+   SC_SIM_RunTimeCmd_t RunTimeCmd[SC_SIM_EVT_CMD_MAX];
+   uint16             OverlayMask;    /* Bit n set when overlay n is merged with the scenario */
+
+   SC_SIM_EventStream_t  Overlay[SC_SIM_OVERLAY_MAX];
+   SC_SIM_MERGE_Class_t  Merge;       /* Orders the overlays' next cmds */
+
+   SC_SIM_FAULT_Class_t  Fault;       /* Adds random fault event cmds */
+   SC_SIM_RECUR_Class_t  Recur;       /* Adds recurring event cmds */
+   SC_SIM_SENS_Class_t   Sensor;      /* Measures the models' truth values */
+   SC_SIM_SIG_Class_t    Bus;         /* Model outputs */
+   SC_SIM_DAG_Class_t    Dag;         /* Model execution schedule */
+   SC_SIM_TMR_Class_t    Timer;       /* Model countdown timers */
  
    /* Sim Models */
    
@@ -604,6 +934,54 @@ void SC_SIM_Constructor(SC_SIM_Class_t *ScSimPtr, INITBL_Class_t *IniTbl,
 bool SC_SIM_Execute(void);
 
 
+/******************************************************************************
+** Function: SC_SIM_ExecuteSlice
+**
+** Run a slice of the time lapse phase. Called on each slice message, it
+** only measures the message period when the time lapse isn't sliced or
+** isn't running.
+**
+*/
+void SC_SIM_ExecuteSlice(void);
+
+
+/******************************************************************************
+** Function: SC_SIM_LockEngine
+**
+** Wait for the time lapse task to finish its current step and take the
+** engine mutex. Functions that use the sim state from the main task must
+** be called while holding it, except SC_SIM_Execute() that takes it
+** itself. Does nothing when the time lapse doesn't run in the background.
+**
+*/
+void SC_SIM_LockEngine(void);
+
+
+/******************************************************************************
+** Function: SC_SIM_UnlockEngine
+**
+*/
+void SC_SIM_UnlockEngine(void);
+
+
+/******************************************************************************
+** Functions: SC_SIM_BenchmarkCmd
+**
+** Integrate the power and thermal models' continuous states over a span
+** with fixed 1 second steps and with error controlled steps and report
+** the steps taken and the wall time of each.
+**
+** Notes:
+**  1. This function must comply with the CMDMGR_CmdFuncPtr definition
+**  2. The models' current inputs are held over the span and the models
+**     aren't changed.
+**  3. A span above SC_SIM_BENCHMARK_MAX_SPAN is rejected since the fixed
+**     step run takes a step per second while the command is processed.
+**
+*/
+bool SC_SIM_BenchmarkCmd(void *DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
 /******************************************************************************
 ** Functions: SC_SIM_ProcessJMsgCmd
 **
@@ -659,10 +1037,15 @@ bool SC_SIM_StopSimCmd(void *DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
 /******************************************************************************
 ** Functions: SC_SIM_StartPlbkCmd
 **
-** Stop a recorder playback.
+** Start a recorder playback of a virtual channel's files created in a time
+** range.
 **
 ** Notes:
 **  1. This function must comply with the CMDMGR_CmdFuncPtr definition
+**  2. All channels play back in priority order when the channel is ALL.
+**     An end time of 0 selects files up to the present.
+**  3. The event log playback is only started when the event log channel
+**     is selected.
 **
 */
 bool SC_SIM_StartPlbkCmd(void *DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
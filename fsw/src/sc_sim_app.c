@@ -159,6 +159,11 @@ static int32 InitApp(void)
       
       ScSimApp.CmdMid     = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_SC_SIM_CMD_TOPICID));
       ScSimApp.ExecuteMid = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_BC_SCH_1_HZ_TOPICID));
+      ScSimApp.SliceMid   = CFE_SB_INVALID_MSG_ID;
+      if (INITBL_GetIntConfig(INITBL_OBJ, CFG_SC_SIM_SLICE_TOPICID) != 0)
+      {
+         ScSimApp.SliceMid = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_SC_SIM_SLICE_TOPICID));
+      }
 
       /* Must constructor table manager prior to any app objects that contain tables */
       TBLMGR_Constructor(TBLMGR_OBJ, INITBL_GetStrConfig(INITBL_OBJ, CFG_APP_CFE_NAME));
@@ -172,6 +177,10 @@ static int32 InitApp(void)
       CFE_SB_CreatePipe(&ScSimApp.CmdPipe, INITBL_GetIntConfig(INITBL_OBJ, CFG_APP_CMD_PIPE_DEPTH), INITBL_GetStrConfig(INITBL_OBJ, CFG_APP_CMD_PIPE_NAME));
       CFE_SB_Subscribe(ScSimApp.CmdMid, ScSimApp.CmdPipe);
       CFE_SB_Subscribe(ScSimApp.ExecuteMid, ScSimApp.CmdPipe);
+      if (CFE_SB_IsValidMsgId(ScSimApp.SliceMid))
+      {
+         CFE_SB_Subscribe(ScSimApp.SliceMid, ScSimApp.CmdPipe);
+      }
 
       /*
       ** Initialize App Framework Components 
@@ -186,9 +195,10 @@ static int32 InitApp(void)
        
       CMDMGR_RegisterFunc(CMDMGR_OBJ, SC_SIM_START_SIM_CC,      SC_SIM, SC_SIM_StartSimCmd,        sizeof(SC_SIM_StartSim_CmdPayload_t));
       CMDMGR_RegisterFunc(CMDMGR_OBJ, SC_SIM_STOP_SIM_CC,       SC_SIM, SC_SIM_StopSimCmd,         0);
-      CMDMGR_RegisterFunc(CMDMGR_OBJ, SC_SIM_START_PLAYBACK_CC, SC_SIM, SC_SIM_StartPlbkCmd,       0);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, SC_SIM_START_PLAYBACK_CC, SC_SIM, SC_SIM_StartPlbkCmd,       sizeof(SC_SIM_StartPlayback_CmdPayload_t));
       CMDMGR_RegisterFunc(CMDMGR_OBJ, SC_SIM_STOP_PLAYBACK_CC,  SC_SIM, SC_SIM_StopPlbkCmd,        0);
       CMDMGR_RegisterFunc(CMDMGR_OBJ, SC_SIM_J_MSG_CC,          SC_SIM, SC_SIM_ProcessJMsgCmd, sizeof(SC_SIM_JMsgCmd_CmdPayload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, SC_SIM_BENCHMARK_CC,      SC_SIM, SC_SIM_BenchmarkCmd,       sizeof(SC_SIM_Benchmark_CmdPayload_t));
 
       CFE_MSG_Init(CFE_MSG_PTR(ScSimApp.HkTlm.TelemetryHeader), 
                    CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_SC_SIM_HK_TLM_TOPICID)),
@@ -235,13 +245,19 @@ static int32 ProcessCommands(void)
 
          if (CFE_SB_MsgId_Equal(MsgId, ScSimApp.CmdMid))
          {
+            SC_SIM_LockEngine();
             CMDMGR_DispatchFunc(CMDMGR_OBJ, &SbBufPtr->Msg);
+            SC_SIM_UnlockEngine();
          } 
          else if (CFE_SB_MsgId_Equal(MsgId, ScSimApp.ExecuteMid))
          {
             SC_SIM_Execute();
             SendHkTlm();
          }
+         else if (CFE_SB_MsgId_Equal(MsgId, ScSimApp.SliceMid))
+         {
+            SC_SIM_ExecuteSlice();
+         }
          else
          {   
             CFE_EVS_SendEvent(SC_SIM_APP_CMD_INVALID_MID_EID, CFE_EVS_EventType_ERROR,
@@ -293,12 +309,14 @@ static void SendHkTlm(void)
    
    /*
    ** Spacecraft Simulator 
+   ** - Sim status is the management packet just sent, the sim state may
+   **   be changing in the time lapse task
    */
    
-   Payload->SimActive = ScSimApp.ScSim.Active;
-   Payload->SimPhase  = ScSimApp.ScSim.Phase;
-   Payload->SimTime   = ScSimApp.ScSim.Time.Seconds;
-   Payload->SimCount  = ScSimApp.ScSim.Count;
+   Payload->SimActive = ScSimApp.ScSim.MgmtTlm.Payload.SimActive;
+   Payload->SimPhase  = ScSimApp.ScSim.MgmtTlm.Payload.SimPhase;
+   Payload->SimTime   = ScSimApp.ScSim.MgmtTlm.Payload.SimTime;
+   Payload->SimCount  = ScSimApp.ScSim.MgmtTlm.Payload.SimCount;
    
    CFE_SB_TimeStampMsg(CFE_MSG_PTR(ScSimApp.HkTlm.TelemetryHeader));
    CFE_SB_TransmitMsg(CFE_MSG_PTR(ScSimApp.HkTlm.TelemetryHeader), true);
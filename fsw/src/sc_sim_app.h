@@ -78,6 +78,7 @@ typedef struct
    uint32            PerfId;
    CFE_SB_MsgId_t    CmdMid;
    CFE_SB_MsgId_t    ExecuteMid;
+   CFE_SB_MsgId_t    SliceMid;     /* CFE_SB_INVALID_MSG_ID when the time lapse isn't sliced */
    
    SC_SIM_Class_t     ScSim;
    SC_SIM_TBL_Class_t ScSimTbl;
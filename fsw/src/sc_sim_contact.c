@@ -0,0 +1,658 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Implement the ground station and relay contact planner
+**
+** Notes:
+**   1. Station positions use the WGS-84 ellipsoid. Earth orientation is
+**      GMST only, precession, nutation and polar motion are ignored.
+**   2. Peer orbits ignore drag and SRP even when the spacecraft uses the
+**      numerical propagator. They only need to be good enough to model
+**      competition for the assets.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "sc_sim_contact.h"
+#include "sc_sim_ephem.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define DEG2RAD  (M_PI/180.0)
+
+#define WGS84_E2  (6.69437999014e-3)   /* First eccentricity squared */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+/*
+** Orbit state at a search grid point
+*/
+typedef struct
+{
+
+   double  Time;
+   double  Pos[3];
+   double  Vel[3];
+
+} GridPt_t;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void   BuildPlan(SC_SIM_CONTACT_Class_t *Contact);
+static double Crossing(const SC_SIM_CONTACT_Class_t *Contact, const SC_SIM_CONTACT_Asset_t *Asset,
+                       const GridPt_t *Pt0, const GridPt_t *Pt1, double J2000Offset);
+static bool   FindWindows(SC_SIM_CONTACT_Class_t *Contact, const SC_SIM_ORBIT_Class_t *Orbit, double Time,
+                          uint16 Craft, double RecFill);
+static void   GrantWindows(SC_SIM_CONTACT_Class_t *Contact);
+static void   Interpolate(const GridPt_t *Pt0, const GridPt_t *Pt1, double Time, double Pos[3]);
+static double Visibility(const SC_SIM_CONTACT_Class_t *Contact, const SC_SIM_CONTACT_Asset_t *Asset,
+                         const double PosEci[3], double J2000Sec);
+
+
+/******************************************************************************
+** Function: SC_SIM_CONTACT_Config
+**
+*/
+void SC_SIM_CONTACT_Config(SC_SIM_CONTACT_Class_t *Contact, const SC_SIM_TBL_Comm_t *Tbl)
+{
+
+   SC_SIM_CONTACT_Asset_t *Asset;
+   double Lat, Lon, SinLat, N;
+   uint16 i;
+
+   Contact->Enabled     = (Tbl->PlannerEna != 0);
+   Contact->Policy      = (Tbl->Policy == SC_SIM_CONTACT_POLICY_PRIORITY) ? SC_SIM_CONTACT_POLICY_PRIORITY : SC_SIM_CONTACT_POLICY_LONGEST;
+   Contact->Horizon     = (Tbl->Horizon  > 0.0) ? Tbl->Horizon : 86400.0;
+   Contact->GridStep    = (Tbl->GridStep > 0.0) ? Tbl->GridStep : 60.0;
+   Contact->MinPass     = Tbl->MinPass;
+   Contact->GrazeRadius = SC_SIM_ORBIT_RE_KM + Tbl->RelayGrazeAlt;
+   Contact->AssetCnt    = 0;
+
+   /* Stations first so asset order is the priority policy's order */
+   for (i=0; i < SC_SIM_TBL_STATION_CNT; i++)
+   {
+
+      if (Tbl->Station[i].Ena)
+      {
+
+         Asset  = &Contact->Asset[Contact->AssetCnt++];
+         Lat    = Tbl->Station[i].Lat*DEG2RAD;
+         Lon    = Tbl->Station[i].Lon*DEG2RAD;
+         SinLat = sin(Lat);
+         N      = SC_SIM_ORBIT_RE_KM/sqrt(1.0 - WGS84_E2*SinLat*SinLat);
+
+         Asset->Type = SC_SIM_CONTACT_STATION;
+         Asset->Id   = i;
+         Asset->PosEcef[0] = (N + Tbl->Station[i].Alt)*cos(Lat)*cos(Lon);
+         Asset->PosEcef[1] = (N + Tbl->Station[i].Alt)*cos(Lat)*sin(Lon);
+         Asset->PosEcef[2] = (N*(1.0 - WGS84_E2) + Tbl->Station[i].Alt)*SinLat;
+         Asset->Up[0] = cos(Lat)*cos(Lon);
+         Asset->Up[1] = cos(Lat)*sin(Lon);
+         Asset->Up[2] = SinLat;
+         Asset->SinMinElev = sin(Tbl->Station[i].MinElev*DEG2RAD);
+         Asset->Capacity   = (Tbl->Station[i].Capacity > 0) ? Tbl->Station[i].Capacity : 1;
+
+      }
+   } /* End station loop */
+
+   for (i=0; i < SC_SIM_TBL_RELAY_CNT; i++)
+   {
+
+      if (Tbl->Relay[i].Ena)
+      {
+
+         Asset = &Contact->Asset[Contact->AssetCnt++];
+         Lon   = Tbl->Relay[i].Lon*DEG2RAD;
+
+         Asset->Type = SC_SIM_CONTACT_RELAY;
+         Asset->Id   = i;
+         Asset->PosEcef[0] = SC_SIM_CONTACT_GEO_RADIUS_KM*cos(Lon);
+         Asset->PosEcef[1] = SC_SIM_CONTACT_GEO_RADIUS_KM*sin(Lon);
+         Asset->PosEcef[2] = 0.0;
+         Asset->Up[0] = Asset->Up[1] = Asset->Up[2] = 0.0;
+         Asset->SinMinElev = 0.0;
+         Asset->Capacity   = (Tbl->Relay[i].Capacity > 0) ? Tbl->Relay[i].Capacity : 1;
+
+      }
+   } /* End relay loop */
+
+   Contact->PeerCnt = 0;
+   for (i=0; i < SC_SIM_TBL_PEER_CNT; i++)
+   {
+
+      if (Tbl->Peer[i].Ena)
+      {
+         Contact->Peer[Contact->PeerCnt].RaanOffset  = Tbl->Peer[i].RaanOffset*DEG2RAD;
+         Contact->Peer[Contact->PeerCnt].PhaseOffset = Tbl->Peer[i].PhaseOffset*DEG2RAD;
+         Contact->Peer[Contact->PeerCnt].RecFill     = Tbl->Peer[i].RecFill;
+         Contact->PeerCnt++;
+      }
+   } /* End peer loop */
+
+   SC_SIM_CONTACT_Invalidate(Contact);
+
+} /* End SC_SIM_CONTACT_Config() */
+
+
+/******************************************************************************
+** Function: SC_SIM_CONTACT_Geometry
+**
+*/
+void SC_SIM_CONTACT_Geometry(const SC_SIM_CONTACT_Class_t *Contact, uint16 Asset,
+                             const double PosEci[3], double J2000Sec,
+                             double *RangeKm, double *SinElev)
+{
+
+   const SC_SIM_CONTACT_Asset_t *Site = &Contact->Asset[Asset];
+   double Pos[3], Los[3];
+   int    i;
+
+   SC_SIM_EPHEM_EciToEcef(PosEci, J2000Sec, Pos);
+   for (i=0; i < 3; i++) Los[i] = Pos[i] - Site->PosEcef[i];
+
+   *RangeKm = sqrt(Los[0]*Los[0] + Los[1]*Los[1] + Los[2]*Los[2]);
+
+   if (Site->Type == SC_SIM_CONTACT_STATION)
+   {
+      *SinElev = (Los[0]*Site->Up[0] + Los[1]*Site->Up[1] + Los[2]*Site->Up[2])/(*RangeKm);
+   }
+   else
+   {
+      *SinElev = 1.0;
+   }
+
+} /* End SC_SIM_CONTACT_Geometry() */
+
+
+/******************************************************************************
+** Function: SC_SIM_CONTACT_Invalidate
+**
+*/
+void SC_SIM_CONTACT_Invalidate(SC_SIM_CONTACT_Class_t *Contact)
+{
+
+   Contact->Valid     = false;
+   Contact->WindowCnt = 0;
+   Contact->PlanCnt   = 0;
+   Contact->PlanIdx   = 0;
+   Contact->DenyCnt   = 0;
+
+} /* End SC_SIM_CONTACT_Invalidate() */
+
+
+/******************************************************************************
+** Function: SC_SIM_CONTACT_Next
+**
+*/
+const SC_SIM_CONTACT_Window_t *SC_SIM_CONTACT_Next(SC_SIM_CONTACT_Class_t *Contact, double Time)
+{
+
+   while (Contact->PlanIdx < Contact->PlanCnt && Contact->Plan[Contact->PlanIdx].End <= Time)
+   {
+      Contact->PlanIdx++;
+   }
+
+   return (Contact->PlanIdx < Contact->PlanCnt) ? &Contact->Plan[Contact->PlanIdx] : NULL;
+
+} /* End SC_SIM_CONTACT_Next() */
+
+
+/******************************************************************************
+** Function: SC_SIM_CONTACT_Update
+**
+*/
+bool SC_SIM_CONTACT_Update(SC_SIM_CONTACT_Class_t *Contact, const SC_SIM_ORBIT_Class_t *Orbit,
+                           double Time, double RecFill)
+{
+
+   SC_SIM_ORBIT_Class_t PeerOrbit;
+   uint16 Capacity[SC_SIM_CONTACT_MAX_ASSETS];
+   uint16 i;
+
+   if (!Contact->Enabled || !Orbit->Valid || Orbit->Decayed || Contact->AssetCnt == 0) return false;
+
+   if (Contact->Valid)
+   {
+      if (Orbit->EpochTime != Contact->OrbitEpoch ||
+          memcmp(&Orbit->Elements, &Contact->OrbitElements, sizeof(SC_SIM_ORBIT_Elements_t)) != 0 ||
+          Time > (Contact->PlanStart + 0.5*Contact->Horizon) ||
+          (Contact->PeerCnt > 0 && fabs(RecFill - Contact->RecFill) >= SC_SIM_CONTACT_REPLAN_FILL))
+      {
+         Contact->Valid = false;
+      }
+   }
+
+   if (!Contact->Valid)
+   {
+
+      Contact->OrbitEpoch    = Orbit->EpochTime;
+      Contact->OrbitElements = Orbit->Elements;
+      Contact->PlanStart     = Time;
+      Contact->PlanEnd       = Time + Contact->Horizon;
+      Contact->RecFill       = RecFill;
+
+      SC_SIM_SCHED_Clear(&Contact->Sched);
+      
+      if (FindWindows(Contact, Orbit, Time, SC_SIM_CONTACT_OWN_CRAFT, RecFill))
+      {
+         for (i=0; i < Contact->PeerCnt; i++)
+         {
+            SC_SIM_ORBIT_Copy(&PeerOrbit, Orbit);
+            PeerOrbit.Prop = SC_SIM_ORBIT_PROP_ANALYTIC;
+            PeerOrbit.Elements.Raan     += Contact->Peer[i].RaanOffset;
+            PeerOrbit.Elements.MeanAnom += Contact->Peer[i].PhaseOffset;
+            if (!FindWindows(Contact, &PeerOrbit, Time, i+1, Contact->Peer[i].RecFill)) break;
+         }
+      }
+
+      for (i=0; i < Contact->AssetCnt; i++)
+      {
+         Capacity[i] = Contact->Asset[i].Capacity;
+      }
+      SC_SIM_SCHED_Resolve(&Contact->Sched, Capacity, Contact->AssetCnt);
+      
+      GrantWindows(Contact);
+      BuildPlan(Contact);
+
+      Contact->Valid = true;
+      Contact->ComputeCnt++;
+
+      CFE_EVS_SendEvent(SC_SIM_CONTACT_PLAN_EID, CFE_EVS_EventType_DEBUG,
+                        "Contact plan computed from %.0f to %.0f: %d windows, %d lost to %d peers, %d contacts",
+                        Contact->PlanStart, Contact->PlanEnd, Contact->WindowCnt, Contact->DenyCnt,
+                        Contact->PeerCnt, Contact->PlanCnt);
+   }
+
+   return true;
+
+} /* End SC_SIM_CONTACT_Update() */
+
+
+/******************************************************************************
+** Function: BuildPlan
+**
+** Reduce the visibility windows to a sequence of non-overlapping contacts.
+**
+** Notes:
+**   1. Windows are sorted by start time.
+**   2. A contact isn't started if it's shorter than the minimum pass,
+**      including one a priority handover would cut short.
+**
+*/
+static void BuildPlan(SC_SIM_CONTACT_Class_t *Contact)
+{
+
+   const SC_SIM_CONTACT_Window_t *Win, *Best;
+   double Time = Contact->PlanStart;
+   double End, NextStart;
+   uint16 i;
+
+   Contact->PlanCnt = 0;
+   Contact->PlanIdx = 0;
+
+   while (Contact->PlanCnt < SC_SIM_CONTACT_MAX_PLAN)
+   {
+
+      Best      = NULL;
+      NextStart = Contact->PlanEnd;
+
+      for (i=0; i < Contact->WindowCnt; i++)
+      {
+
+         Win = &Contact->Window[i];
+         if (Win->Start > Time)
+         {
+            if (Win->Start < NextStart) NextStart = Win->Start;
+         }
+         else if ((Win->End - Time) >= Contact->MinPass && Win->End > Time)
+         {
+            if (Best == NULL ||
+                (Contact->Policy == SC_SIM_CONTACT_POLICY_LONGEST  && Win->End > Best->End) ||
+                (Contact->Policy == SC_SIM_CONTACT_POLICY_PRIORITY && Win->Asset < Best->Asset))
+            {
+               Best = Win;
+            }
+         }
+      } /* End window loop */
+
+      if (Best == NULL)
+      {
+         if (NextStart >= Contact->PlanEnd) break;
+         Time = NextStart;
+         continue;
+      }
+
+      End = Best->End;
+      if (Contact->Policy == SC_SIM_CONTACT_POLICY_PRIORITY)
+      {
+         for (i=0; i < Contact->WindowCnt; i++)
+         {
+            Win = &Contact->Window[i];
+            if (Win->Asset < Best->Asset && Win->Start > Time && Win->Start < End &&
+                (Win->End - Win->Start) >= Contact->MinPass)
+            {
+               End = Win->Start;
+            }
+         }
+      }
+
+      /* Don't start a contact that would be handed over before the minimum pass */
+      if ((End - Time) < Contact->MinPass && End < Best->End)
+      {
+         Time = End;
+         continue;
+      }
+
+      Contact->Plan[Contact->PlanCnt].Asset = Best->Asset;
+      Contact->Plan[Contact->PlanCnt].Start = Time;
+      Contact->Plan[Contact->PlanCnt].End   = End;
+      Contact->PlanCnt++;
+
+      Time = End;
+
+   } /* End plan loop */
+
+} /* End BuildPlan() */
+
+
+/******************************************************************************
+** Function: Crossing
+**
+** Bisect for the time an asset's visibility changes sign between two grid
+** points.
+**
+*/
+static double Crossing(const SC_SIM_CONTACT_Class_t *Contact, const SC_SIM_CONTACT_Asset_t *Asset,
+                       const GridPt_t *Pt0, const GridPt_t *Pt1, double J2000Offset)
+{
+
+   double T0 = Pt0->Time;
+   double T1 = Pt1->Time;
+   double Tm, Pos[3];
+   bool   Vis0 = (Visibility(Contact, Asset, Pt0->Pos, T0 + J2000Offset) > 0.0);
+
+   while ((T1 - T0) > SC_SIM_CONTACT_BISECT_TOL)
+   {
+
+      Tm = 0.5*(T0 + T1);
+      Interpolate(Pt0, Pt1, Tm, Pos);
+      if ((Visibility(Contact, Asset, Pos, Tm + J2000Offset) > 0.0) == Vis0)
+      {
+         T0 = Tm;
+      }
+      else
+      {
+         T1 = Tm;
+      }
+   }
+
+   return 0.5*(T0 + T1);
+
+} /* End Crossing() */
+
+
+/******************************************************************************
+** Function: FindWindows
+**
+** Add a craft's visibility windows to the scheduler requests. Returns
+** false if the request buffer filled.
+**
+** Notes:
+**   1. A window in progress at the start of the plan starts at the plan
+**      start and one in progress at the end of the horizon ends there.
+**   2. A request's weight is its duration scaled by the craft's recorder
+**      fill so fuller recorders win contested time.
+**
+*/
+static bool FindWindows(SC_SIM_CONTACT_Class_t *Contact, const SC_SIM_ORBIT_Class_t *Orbit, double Time,
+                        uint16 Craft, double RecFill)
+{
+
+   SC_SIM_ORBIT_Class_t Prop;
+   GridPt_t Pt[2];
+   double   AosTime[SC_SIM_CONTACT_MAX_ASSETS];
+   bool     InView[SC_SIM_CONTACT_MAX_ASSETS];
+   bool     Vis, FirstPt = true, LastPt = false, Full = false;
+   uint16   Cur = 0, a;
+   double   T = Time, Los;
+   double   FillScale = 1.0 + SC_SIM_CONTACT_FILL_GAIN*RecFill/100.0;
+
+   SC_SIM_ORBIT_Copy(&Prop, Orbit);
+
+   while (!LastPt)
+   {
+
+      if (T >= Contact->PlanEnd)
+      {
+         T = Contact->PlanEnd;
+         LastPt = true;
+      }
+
+      SC_SIM_ORBIT_Propagate(&Prop, T, T + Prop.J2000Offset);
+      if (Prop.Decayed) LastPt = true;
+
+      Pt[Cur].Time = T;
+      memcpy(Pt[Cur].Pos, Prop.PosEci, sizeof(Prop.PosEci));
+      memcpy(Pt[Cur].Vel, Prop.VelEci, sizeof(Prop.VelEci));
+
+      for (a=0; a < Contact->AssetCnt; a++)
+      {
+
+         Vis = (Visibility(Contact, &Contact->Asset[a], Pt[Cur].Pos, T + Prop.J2000Offset) > 0.0);
+
+         if (FirstPt)
+         {
+            InView[a]  = Vis;
+            AosTime[a] = T;
+         }
+         else if (Vis != InView[a])
+         {
+            if (Vis)
+            {
+               AosTime[a] = Crossing(Contact, &Contact->Asset[a], &Pt[1-Cur], &Pt[Cur], Prop.J2000Offset);
+            }
+            else
+            {
+               Los = Crossing(Contact, &Contact->Asset[a], &Pt[1-Cur], &Pt[Cur], Prop.J2000Offset);
+               if ((Los - AosTime[a]) >= Contact->MinPass || AosTime[a] == Time)
+               {
+                  if (!SC_SIM_SCHED_AddRequest(&Contact->Sched, Craft, a, AosTime[a], Los, (Los - AosTime[a])*FillScale))
+                  {
+                     Full = true;
+                     LastPt = true;
+                  }
+               }
+            }
+            InView[a] = Vis;
+         }
+      } /* End asset loop */
+
+      FirstPt = false;
+      Cur = 1 - Cur;
+      T  += Contact->GridStep;
+
+   } /* End grid loop */
+
+   /* Close windows still open at the end of the horizon */
+   for (a=0; a < Contact->AssetCnt && !Full; a++)
+   {
+      if (InView[a])
+      {
+         Los  = Pt[1-Cur].Time;
+         Full = !SC_SIM_SCHED_AddRequest(&Contact->Sched, Craft, a, AosTime[a], Los, (Los - AosTime[a])*FillScale);
+      }
+   }
+
+   if (Full)
+   {
+      CFE_EVS_SendEvent(SC_SIM_CONTACT_OVERFLOW_EID, CFE_EVS_EventType_ERROR,
+                        "Contact request buffer full for craft %d at %.0f, plan truncated", Craft, T);
+   }
+
+   return !Full;
+
+} /* End FindWindows() */
+
+
+/******************************************************************************
+** Function: GrantWindows
+**
+** Copy the spacecraft's granted requests to the window list in start
+** time order.
+**
+*/
+static void GrantWindows(SC_SIM_CONTACT_Class_t *Contact)
+{
+
+   const SC_SIM_SCHED_Request_t *Req;
+   SC_SIM_CONTACT_Window_t *Win, Key;
+   uint16 i, j;
+
+   Contact->WindowCnt = 0;
+   Contact->DenyCnt   = 0;
+
+   for (i=0; i < Contact->Sched.ReqCnt; i++)
+   {
+
+      Req = &Contact->Sched.Req[i];
+      if (Req->Craft != SC_SIM_CONTACT_OWN_CRAFT) continue;
+
+      if (!Req->Granted)
+      {
+         Contact->DenyCnt++;
+      }
+      else if (Contact->WindowCnt < SC_SIM_CONTACT_MAX_WINDOWS)
+      {
+         Win = &Contact->Window[Contact->WindowCnt++];
+         Win->Asset = Req->Resource;
+         Win->Start = Req->Start;
+         Win->End   = Req->End;
+      }
+      else
+      {
+         CFE_EVS_SendEvent(SC_SIM_CONTACT_OVERFLOW_EID, CFE_EVS_EventType_ERROR,
+                           "Contact window buffer full at %.0f, plan truncated", Req->Start);
+         break;
+      }
+   } /* End request loop */
+
+   /* Windows were recorded at LOS so sort by start, the count is small */
+   for (i=1; i < Contact->WindowCnt; i++)
+   {
+      Key = Contact->Window[i];
+      j = i;
+      while (j > 0 && Contact->Window[j-1].Start > Key.Start)
+      {
+         Contact->Window[j] = Contact->Window[j-1];
+         j--;
+      }
+      Contact->Window[j] = Key;
+   }
+
+} /* End GrantWindows() */
+
+
+/******************************************************************************
+** Function: Interpolate
+**
+** Cubic Hermite interpolation of the position between two grid points.
+**
+** Notes:
+**   1. For a 60 second LEO grid the error is well under a meter.
+**
+*/
+static void Interpolate(const GridPt_t *Pt0, const GridPt_t *Pt1, double Time, double Pos[3])
+{
+
+   double H  = Pt1->Time - Pt0->Time;
+   double S  = (Time - Pt0->Time)/H;
+   double S2 = S*S, S3 = S2*S;
+   double H00 = 2.0*S3 - 3.0*S2 + 1.0;
+   double H10 = S3 - 2.0*S2 + S;
+   double H01 = -2.0*S3 + 3.0*S2;
+   double H11 = S3 - S2;
+   int    i;
+
+   for (i=0; i < 3; i++)
+   {
+      Pos[i] = H00*Pt0->Pos[i] + H10*H*Pt0->Vel[i] + H01*Pt1->Pos[i] + H11*H*Pt1->Vel[i];
+   }
+
+} /* End Interpolate() */
+
+
+/******************************************************************************
+** Function: Visibility
+**
+** Return a value that's positive when the asset can see the spacecraft.
+**
+** Notes:
+**   1. Stations return the sine of the elevation less the sine of the
+**      minimum elevation.
+**   2. Relays return the closest approach of the line of sight to the
+**      Earth's center less the graze radius (km).
+**
+*/
+static double Visibility(const SC_SIM_CONTACT_Class_t *Contact, const SC_SIM_CONTACT_Asset_t *Asset,
+                         const double PosEci[3], double J2000Sec)
+{
+
+   double Pos[3], Los[3], LosMag2, Dot, S, Closest[3];
+   double RetVal;
+   int    i;
+
+   SC_SIM_EPHEM_EciToEcef(PosEci, J2000Sec, Pos);
+
+   for (i=0; i < 3; i++) Los[i] = Pos[i] - Asset->PosEcef[i];
+   LosMag2 = Los[0]*Los[0] + Los[1]*Los[1] + Los[2]*Los[2];
+
+   if (Asset->Type == SC_SIM_CONTACT_STATION)
+   {
+
+      Dot    = Los[0]*Asset->Up[0] + Los[1]*Asset->Up[1] + Los[2]*Asset->Up[2];
+      RetVal = Dot/sqrt(LosMag2) - Asset->SinMinElev;
+
+   }
+   else
+   {
+
+      /* Closest point to the Earth's center on the segment from the relay to the spacecraft */
+      Dot = -(Asset->PosEcef[0]*Los[0] + Asset->PosEcef[1]*Los[1] + Asset->PosEcef[2]*Los[2]);
+      S   = Dot/LosMag2;
+      if (S < 0.0) S = 0.0;
+      if (S > 1.0) S = 1.0;
+      for (i=0; i < 3; i++) Closest[i] = Asset->PosEcef[i] + S*Los[i];
+
+      RetVal = sqrt(Closest[0]*Closest[0] + Closest[1]*Closest[1] + Closest[2]*Closest[2]) - Contact->GrazeRadius;
+
+   }
+
+   return RetVal;
+
+} /* End Visibility() */
@@ -0,0 +1,240 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Define a ground station and relay contact planner
+**
+** Notes:
+**   1. Visibility windows are found by sampling the spacecraft orbit on a
+**      coarse grid and bisecting each visibility sign change. Positions
+**      between grid samples are cubic Hermite interpolated from the
+**      sampled position and velocity so bisection doesn't propagate the
+**      orbit. The orbit is sampled with a copy of the ADCS orbit object so
+**      the model's propagator state is untouched.
+**   2. A ground station is visible above its minimum elevation. A relay is
+**      a geosynchronous slot that's visible while the line of sight clears
+**      the Earth by the graze altitude.
+**   3. Constellation peers share the stations and relays. A peer's orbit
+**      is the spacecraft's mean elements offset in RAAN and mean anomaly,
+**      propagated analytically. Every craft's windows are weighted by
+**      duration and recorder fill and the shared resource scheduler
+**      grants them within each asset's capacity.
+**   4. The spacecraft's granted windows are reduced to a contact plan, a
+**      time ordered sequence of non-overlapping contacts, using the
+**      configured handover policy.
+**   5. The windows and plan are cached and only recomputed when the orbit
+**      elements or table change, when half of the planning horizon has
+**      elapsed, or when peers are defined and the recorder fill has moved
+**      enough to change the spacecraft's priority.
+**   6. Times are sim seconds.
+**
+*/
+
+#ifndef _sc_sim_contact_
+#define _sc_sim_contact_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "sc_sim_orbit.h"
+#include "sc_sim_sched.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SC_SIM_CONTACT_MAX_ASSETS   (SC_SIM_TBL_STATION_CNT + SC_SIM_TBL_RELAY_CNT)
+#define SC_SIM_CONTACT_MAX_WINDOWS  (96)
+#define SC_SIM_CONTACT_MAX_PLAN     (96)
+
+#define SC_SIM_CONTACT_GEO_RADIUS_KM  (42164.17)
+#define SC_SIM_CONTACT_BISECT_TOL     (0.5)    /* Seconds */
+
+#define SC_SIM_CONTACT_ASSET_NONE   (0xFFFF)
+
+#define SC_SIM_CONTACT_OWN_CRAFT      (0)      /* Scheduler craft ID, peers are 1..N */
+#define SC_SIM_CONTACT_FILL_GAIN      (4.0)    /* A full recorder weighs contact time 5x an empty one */
+#define SC_SIM_CONTACT_REPLAN_FILL    (10.0)   /* Recorder fill change (%) that replans when peers compete */
+
+/*
+** Event Message IDs
+*/
+
+#define SC_SIM_CONTACT_PLAN_EID      (SC_SIM_CONTACT_BASE_EID + 0)
+#define SC_SIM_CONTACT_OVERFLOW_EID  (SC_SIM_CONTACT_BASE_EID + 1)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+
+   SC_SIM_CONTACT_POLICY_LONGEST  = 0,  /* Stay with the visible asset with the latest LOS */
+   SC_SIM_CONTACT_POLICY_PRIORITY = 1   /* Table order, stations before relays. Hand over when a higher priority asset rises */
+
+} SC_SIM_CONTACT_Policy_t;
+
+
+typedef enum
+{
+
+   SC_SIM_CONTACT_STATION = 0,
+   SC_SIM_CONTACT_RELAY   = 1
+
+} SC_SIM_CONTACT_AssetType_t;
+
+
+typedef struct
+{
+
+   SC_SIM_CONTACT_AssetType_t Type;
+   uint16  Id;              /* Station or relay table index */
+   double  PosEcef[3];
+   double  Up[3];           /* Station local vertical */
+   double  SinMinElev;
+   uint16  Capacity;
+
+} SC_SIM_CONTACT_Asset_t;
+
+
+typedef struct
+{
+
+   double  RaanOffset;      /* Radians */
+   double  PhaseOffset;     /* Radians */
+   double  RecFill;         /* Percent */
+
+} SC_SIM_CONTACT_Peer_t;
+
+
+typedef struct
+{
+
+   uint16  Asset;
+   double  Start;
+   double  End;
+
+} SC_SIM_CONTACT_Window_t;
+
+
+typedef struct
+{
+
+   /* Configuration */
+
+   bool    Enabled;
+   SC_SIM_CONTACT_Policy_t Policy;
+   double  Horizon;
+   double  GridStep;
+   double  MinPass;
+   double  GrazeRadius;     /* Earth radius plus relay graze altitude */
+   uint16  AssetCnt;
+   SC_SIM_CONTACT_Asset_t Asset[SC_SIM_CONTACT_MAX_ASSETS];
+   uint16  PeerCnt;
+   SC_SIM_CONTACT_Peer_t  Peer[SC_SIM_TBL_PEER_CNT];
+
+   /* Cache */
+
+   bool    Valid;
+   double  PlanStart;
+   double  PlanEnd;
+   double  OrbitEpoch;      /* Orbit definition the cache was computed for */
+   SC_SIM_ORBIT_Elements_t OrbitElements;
+   double  RecFill;         /* Spacecraft recorder fill the cache was computed for */
+
+   uint16  WindowCnt;
+   SC_SIM_CONTACT_Window_t Window[SC_SIM_CONTACT_MAX_WINDOWS];
+   uint16  PlanCnt;
+   SC_SIM_CONTACT_Window_t Plan[SC_SIM_CONTACT_MAX_PLAN];
+   uint16  PlanIdx;         /* First plan entry that hasn't ended */
+   uint16  DenyCnt;         /* Spacecraft windows lost to peers */
+
+   SC_SIM_SCHED_Class_t Sched;
+
+   uint32  ComputeCnt;
+
+} SC_SIM_CONTACT_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SC_SIM_CONTACT_Config
+**
+** Build the station, relay and peer definitions from the table and
+** invalidate the cached plan.
+**
+*/
+void SC_SIM_CONTACT_Config(SC_SIM_CONTACT_Class_t *Contact, const SC_SIM_TBL_Comm_t *Tbl);
+
+
+/******************************************************************************
+** Function: SC_SIM_CONTACT_Update
+**
+** Recompute the windows and plan starting at Time if the cache is stale.
+** RecFill is the spacecraft's recorder fill (%), its scheduling priority.
+**
+** Notes:
+**   1. Returns false if the planner is disabled or there's no valid orbit.
+**
+*/
+bool SC_SIM_CONTACT_Update(SC_SIM_CONTACT_Class_t *Contact, const SC_SIM_ORBIT_Class_t *Orbit,
+                           double Time, double RecFill);
+
+
+/******************************************************************************
+** Function: SC_SIM_CONTACT_Next
+**
+** Return the first planned contact that hasn't ended at Time, NULL if
+** there are none in the plan.
+**
+** Notes:
+**   1. The returned contact may be in progress, Start <= Time.
+**
+*/
+const SC_SIM_CONTACT_Window_t *SC_SIM_CONTACT_Next(SC_SIM_CONTACT_Class_t *Contact, double Time);
+
+
+/******************************************************************************
+** Function: SC_SIM_CONTACT_Geometry
+**
+** Compute the slant range (km) from an asset to a spacecraft ECI position
+** and the sine of the spacecraft's elevation seen from the asset.
+**
+** Notes:
+**   1. Relays have no local horizon so the elevation sine is 1.
+**
+*/
+void SC_SIM_CONTACT_Geometry(const SC_SIM_CONTACT_Class_t *Contact, uint16 Asset,
+                             const double PosEci[3], double J2000Sec,
+                             double *RangeKm, double *SinElev);
+
+
+/******************************************************************************
+** Function: SC_SIM_CONTACT_Invalidate
+**
+** Force the next update to recompute the plan.
+**
+*/
+void SC_SIM_CONTACT_Invalidate(SC_SIM_CONTACT_Class_t *Contact);
+
+
+#endif /* _sc_sim_contact_ */
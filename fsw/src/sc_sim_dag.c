@@ -0,0 +1,286 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Implement the model dependency graph scheduler
+**
+** Notes:
+**   None
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdio.h>
+
+#include "sc_sim_dag.h"
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static SC_SIM_DAG_Class_t *PoolDag = NULL;   /* Child tasks don't take a parameter */
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool Interact(const SC_SIM_DAG_NodeDef_t *A, const SC_SIM_DAG_NodeDef_t *B);
+static void RunJobs(SC_SIM_DAG_Class_t *Dag);
+static void WorkerTask(void);
+
+
+/******************************************************************************
+** Function: SC_SIM_DAG_Build
+**
+** Notes:
+**   1. Nodes are visited in declared order so every node a node depends on
+**      already has its level, a single pass is a topological sort.
+**   2. Nodes keep their declared order within a level.
+**
+*/
+bool SC_SIM_DAG_Build(SC_SIM_DAG_Class_t *Dag, const SC_SIM_DAG_NodeDef_t *Node, uint16 NodeCnt)
+{
+
+   uint16 Width[SC_SIM_DAG_MAX_NODES];
+   uint16 i, j, k;
+
+   if (NodeCnt > SC_SIM_DAG_MAX_NODES) return false;
+
+   Dag->Node     = Node;
+   Dag->NodeCnt  = NodeCnt;
+   Dag->LevelCnt = 0;
+   Dag->MaxWidth = 0;
+
+   for (j=0; j < NodeCnt; j++)
+   {
+      Dag->Period[j] = 1;
+      Dag->Level[j]  = 0;
+      for (i=0; i < j; i++)
+      {
+         if (Interact(&Node[i], &Node[j]) && Dag->Level[j] <= Dag->Level[i])
+         {
+            Dag->Level[j] = Dag->Level[i] + 1;
+         }
+      }
+      if (Dag->Level[j] >= Dag->LevelCnt) Dag->LevelCnt = Dag->Level[j] + 1;
+   }
+
+   k = 0;
+   for (i=0; i < Dag->LevelCnt; i++)
+   {
+      Dag->LevelStart[i] = k;
+      for (j=0; j < NodeCnt; j++)
+      {
+         if (Dag->Level[j] == i) Dag->Order[k++] = j;
+      }
+      Width[i] = k - Dag->LevelStart[i];
+      if (Width[i] > Dag->MaxWidth) Dag->MaxWidth = Width[i];
+   }
+   Dag->LevelStart[Dag->LevelCnt] = k;
+
+   CFE_EVS_SendEvent(SC_SIM_DAG_SCHEDULE_EID, CFE_EVS_EventType_DEBUG,
+                     "Model schedule has %d levels for %d models, widest level has %d models",
+                     Dag->LevelCnt, NodeCnt, Dag->MaxWidth);
+
+   return true;
+
+} /* End SC_SIM_DAG_Build() */
+
+
+/******************************************************************************
+** Function: SC_SIM_DAG_Run
+**
+** Notes:
+**   1. The caller runs nodes too so a level of n due nodes only wakes n-1
+**      workers. A worker that finds no node left just reports done.
+**
+*/
+void SC_SIM_DAG_Run(SC_SIM_DAG_Class_t *Dag, SC_SIM_SIG_Class_t *Bus, uint32 Frame)
+{
+
+   uint16 Level, Node, Cnt, Wake, i;
+
+   for (Level=0; Level < Dag->LevelCnt; Level++)
+   {
+
+      Cnt = 0;
+      for (i=Dag->LevelStart[Level]; i < Dag->LevelStart[Level+1]; i++)
+      {
+         Node = Dag->Order[i];
+         if ((Frame % Dag->Period[Node]) == 0)
+         {
+            Dag->Job[Cnt++] = Node;
+            Dag->ExeCnt[Node]++;
+         }
+      }
+      if (Cnt == 0) continue;
+      
+      SC_SIM_SIG_NextEpoch(Bus);
+
+      Wake = (Cnt - 1 < Dag->WorkerCnt) ? (Cnt - 1) : Dag->WorkerCnt;
+
+      if (Wake == 0)
+      {
+         for (i=0; i < Cnt; i++)
+         {
+            Dag->Node[Dag->Job[i]].Execute();
+         }
+      }
+      else
+      {
+         Dag->JobNext = 0;
+         Dag->JobEnd  = Cnt;
+         for (i=0; i < Wake; i++) OS_CountSemGive(Dag->WorkSem);
+         
+         RunJobs(Dag);
+         
+         for (i=0; i < Wake; i++) OS_CountSemTake(Dag->DoneSem);
+      }
+
+   } /* End level loop */
+
+   Dag->RunCnt++;
+
+} /* End SC_SIM_DAG_Run() */
+
+
+/******************************************************************************
+** Function: SC_SIM_DAG_SetPeriod
+**
+*/
+void SC_SIM_DAG_SetPeriod(SC_SIM_DAG_Class_t *Dag, uint16 Node, uint32 Period)
+{
+
+   if (Node < Dag->NodeCnt) Dag->Period[Node] = (Period > 0) ? Period : 1;
+
+} /* End SC_SIM_DAG_SetPeriod() */
+
+
+/******************************************************************************
+** Function: SC_SIM_DAG_StartWorkers
+**
+*/
+uint16 SC_SIM_DAG_StartWorkers(SC_SIM_DAG_Class_t *Dag, uint16 WorkerCnt, uint16 Priority)
+{
+
+   CFE_ES_TaskId_t TaskId;
+   char   TaskName[OS_MAX_API_NAME];
+   int32  Status;
+   uint16 i;
+
+   Dag->WorkerCnt = 0;
+   
+   if (WorkerCnt > SC_SIM_DAG_MAX_WORKERS) WorkerCnt = SC_SIM_DAG_MAX_WORKERS;
+   if (Dag->MaxWidth == 0 || WorkerCnt > (Dag->MaxWidth - 1)) WorkerCnt = (Dag->MaxWidth > 0) ? (Dag->MaxWidth - 1) : 0;
+   if (WorkerCnt == 0 || PoolDag != NULL) return 0;
+
+   Status = OS_CountSemCreate(&Dag->WorkSem, "SC_SIM_DAG_WORK", 0, 0);
+   if (Status == OS_SUCCESS) Status = OS_CountSemCreate(&Dag->DoneSem, "SC_SIM_DAG_DONE", 0, 0);
+   if (Status == OS_SUCCESS) Status = OS_MutSemCreate(&Dag->JobMutex, "SC_SIM_DAG_JOB", 0);
+   
+   if (Status != OS_SUCCESS)
+   {
+      CFE_EVS_SendEvent(SC_SIM_DAG_WORKER_EID, CFE_EVS_EventType_ERROR,
+                        "Model worker semaphore creation failed, status 0x%08X. Models run sequentially", (unsigned int)Status);
+      return 0;
+   }
+
+   PoolDag = Dag;
+   for (i=0; i < WorkerCnt; i++)
+   {
+      
+      snprintf(TaskName, sizeof(TaskName), "SC_SIM_WORKER_%d", i);
+      Status = CFE_ES_CreateChildTask(&TaskId, TaskName, WorkerTask, CFE_ES_TASK_STACK_ALLOCATE,
+                                      SC_SIM_DAG_WORKER_STACK, Priority, 0);
+      if (Status != CFE_SUCCESS)
+      {
+         CFE_EVS_SendEvent(SC_SIM_DAG_WORKER_EID, CFE_EVS_EventType_ERROR,
+                           "Model worker %s creation failed, status 0x%08X. Running with %d workers", 
+                           TaskName, (unsigned int)Status, i);
+         break;
+      }
+      Dag->WorkerCnt++;
+   
+   }
+
+   return Dag->WorkerCnt;
+
+} /* End SC_SIM_DAG_StartWorkers() */
+
+
+/******************************************************************************
+** Function: Interact
+**
+** Return true if either node writes something the other reads or writes.
+**
+*/
+static bool Interact(const SC_SIM_DAG_NodeDef_t *A, const SC_SIM_DAG_NodeDef_t *B)
+{
+
+   return ((A->SigOut   & (B->SigIn   | B->SigOut))   != 0 ||
+           (B->SigOut   & A->SigIn)                   != 0 ||
+           (A->StateOut & (B->StateIn | B->StateOut)) != 0 ||
+           (B->StateOut & A->StateIn)                 != 0);
+
+} /* End Interact() */
+
+
+/******************************************************************************
+** Function: RunJobs
+**
+** Claim and execute the current level's nodes until none are left.
+**
+*/
+static void RunJobs(SC_SIM_DAG_Class_t *Dag)
+{
+
+   uint16 Job;
+
+   for (;;)
+   {
+   
+      OS_MutSemTake(Dag->JobMutex);
+      Job = Dag->JobNext;
+      if (Job < Dag->JobEnd) Dag->JobNext++;
+      OS_MutSemGive(Dag->JobMutex);
+
+      if (Job >= Dag->JobEnd) break;
+
+      Dag->Node[Dag->Job[Job]].Execute();
+   
+   }
+
+} /* End RunJobs() */
+
+
+/******************************************************************************
+** Function: WorkerTask
+**
+*/
+static void WorkerTask(void)
+{
+
+   SC_SIM_DAG_Class_t *Dag = PoolDag;
+
+   while (OS_CountSemTake(Dag->WorkSem) == OS_SUCCESS)
+   {
+      RunJobs(Dag);
+      OS_CountSemGive(Dag->DoneSem);
+   }
+
+} /* End WorkerTask() */
@@ -0,0 +1,166 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Define the model dependency graph scheduler
+**
+** Notes:
+**   1. Each model is a node that declares the bus signals it reads and
+**      publishes and the model state it reads and writes directly. Two
+**      models interact if one writes something the other reads or
+**      writes. Interacting models keep their declared (sequential) order
+**      so the edges always point from an earlier to a later node and the
+**      graph is acyclic by construction.
+**   2. The graph is sorted once into levels, a node's level is one more
+**      than the deepest node it depends on. The nodes of a level don't
+**      interact so running them concurrently gives the same results as
+**      running them in their declared order.
+**   3. A level with more than one node is shared by the calling task and
+**      a small pool of worker child tasks. The caller waits for every
+**      node of a level to finish before starting the next level.
+**   4. The signal bus epoch is advanced before each level, see
+**      sc_sim_sig.h.
+**   5. Each node has a rate group, it only executes on the minor frames
+**      that are a multiple of its period. A level without a due node is
+**      skipped.
+**
+*/
+
+#ifndef _sc_sim_dag_
+#define _sc_sim_dag_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "sc_sim_sig.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SC_SIM_DAG_MAX_NODES     (16)
+#define SC_SIM_DAG_MAX_WORKERS   (4)
+#define SC_SIM_DAG_WORKER_STACK  (16384)
+
+/*
+** Event Message IDs
+*/
+
+#define SC_SIM_DAG_SCHEDULE_EID  (SC_SIM_DAG_BASE_EID + 0)
+#define SC_SIM_DAG_WORKER_EID    (SC_SIM_DAG_BASE_EID + 1)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef void (*SC_SIM_DAG_ExecuteFunc_t)(void);
+
+typedef struct
+{
+
+   const char  *Name;
+   SC_SIM_DAG_ExecuteFunc_t Execute;
+   uint32  SigIn;           /* Bit n set when the node reads bus signal n */
+   uint32  SigOut;          /* Bus signals the node publishes, including through calls to other models */
+   uint32  StateIn;         /* Model state the node reads directly, one bit per model */
+   uint32  StateOut;        /* Model state the node writes directly, including its own */
+
+} SC_SIM_DAG_NodeDef_t;
+
+
+typedef struct
+{
+
+   const SC_SIM_DAG_NodeDef_t *Node;
+   uint16  NodeCnt;
+   uint16  LevelCnt;
+   uint16  MaxWidth;                              /* Nodes in the widest level */
+   uint16  Level[SC_SIM_DAG_MAX_NODES];           /* Each node's level */
+   uint16  Order[SC_SIM_DAG_MAX_NODES];           /* Nodes in level order */
+   uint16  LevelStart[SC_SIM_DAG_MAX_NODES+1];    /* Index in Order[] of each level's first node */
+   uint32  Period[SC_SIM_DAG_MAX_NODES];          /* Minor frames between executions */
+   uint32  ExeCnt[SC_SIM_DAG_MAX_NODES];
+
+   /* Worker pool */
+
+   uint16     WorkerCnt;
+   osal_id_t  WorkSem;      /* Given once per worker needed by a level */
+   osal_id_t  DoneSem;      /* Given by a worker when it finds no more nodes */
+   osal_id_t  JobMutex;
+   uint16     Job[SC_SIM_DAG_MAX_NODES];   /* Due nodes of the current level */
+   uint16     JobNext;      /* Next unclaimed index in Job[] */
+   uint16     JobEnd;
+   
+   uint32     RunCnt;
+
+} SC_SIM_DAG_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SC_SIM_DAG_Build
+**
+** Find the node dependencies and sort the nodes into levels. Returns false
+** if there are too many nodes.
+**
+** Notes:
+**   1. Node definitions are referenced, not copied.
+**   2. Every node's period is set to one minor frame.
+**
+*/
+bool SC_SIM_DAG_Build(SC_SIM_DAG_Class_t *Dag, const SC_SIM_DAG_NodeDef_t *Node, uint16 NodeCnt);
+
+
+/******************************************************************************
+** Function: SC_SIM_DAG_Run
+**
+** Execute the nodes due on minor frame Frame once, level by level.
+**
+*/
+void SC_SIM_DAG_Run(SC_SIM_DAG_Class_t *Dag, SC_SIM_SIG_Class_t *Bus, uint32 Frame);
+
+
+/******************************************************************************
+** Function: SC_SIM_DAG_SetPeriod
+**
+** Set the number of minor frames between a node's executions, 0 is
+** treated as 1.
+**
+*/
+void SC_SIM_DAG_SetPeriod(SC_SIM_DAG_Class_t *Dag, uint16 Node, uint32 Period);
+
+
+/******************************************************************************
+** Function: SC_SIM_DAG_StartWorkers
+**
+** Create up to WorkerCnt worker child tasks, limited to the number the
+** widest level can use. Returns the number of workers running, with no
+** workers every level is run by the calling task.
+**
+** Notes:
+**   1. Call once after SC_SIM_DAG_Build(). Only one graph can have workers.
+**
+*/
+uint16 SC_SIM_DAG_StartWorkers(SC_SIM_DAG_Class_t *Dag, uint16 WorkerCnt, uint16 Priority);
+
+
+#endif /* _sc_sim_dag_ */
@@ -0,0 +1,379 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Implement the sun/moon ephemeris service
+**
+** Notes:
+**   1. See sc_sim_ephem.h prologue for the design overview.
+**   2. GetBlock() and the evaluation of the block it returns must be done
+**      while holding EphemMutex. A block is marked valid only after all
+**      of its coefficients have been written.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "sc_sim_ephem.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define DEG2RAD       (M_PI/180.0)
+#define ARCSEC2RAD    (M_PI/(180.0*3600.0))
+#define J2000_JD      (2451545.0)
+#define DAYS_PER_CENT (36525.0)
+
+#define GMST_J2000_RAD   (4.894961212823756)  /* 280.46061837 deg */
+#define GMST_RATE_RADDAY (6.300388098984893)  /* 360.98564736629 deg/day */
+
+#define BLOCK_IDX_MASK  (SC_SIM_EPHEM_BLOCK_CNT-1)
+
+#define EPHEM_MUTEX_NAME  "SC_SIM_EPHEM"
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   bool    Valid;
+   int32   BlockNum;   /* Absolute block number, floor(J2000Sec/SC_SIM_EPHEM_BLOCK_SECS) */
+   double  Coeff[SC_SIM_EPHEM_BODY_CNT][3][SC_SIM_EPHEM_CHEB_COEFF];
+
+} EphemBlock_t;
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+/* Shared by all SC_SIM instances in the process, see prologue */
+static EphemBlock_t EphemCache[SC_SIM_EPHEM_BLOCK_CNT];
+static osal_id_t    EphemMutex = OS_OBJECT_ID_UNDEFINED;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static const EphemBlock_t *GetBlock(int32 BlockNum);
+static void FillBlock(EphemBlock_t *Block, int32 BlockNum);
+static void MoonAnalytic(double J2000Sec, double PosKm[3]);
+static void SunAnalytic(double J2000Sec, double PosKm[3]);
+
+
+/******************************************************************************
+** Function: SC_SIM_EPHEM_Constructor
+**
+*/
+bool SC_SIM_EPHEM_Constructor(void)
+{
+
+   osal_id_t MutexId;
+   int32     Status;
+
+   Status = OS_MutSemCreate(&MutexId, EPHEM_MUTEX_NAME, 0);
+   if (Status == OS_ERR_NAME_TAKEN)
+   {
+      Status = OS_MutSemGetIdByName(&MutexId, EPHEM_MUTEX_NAME);
+   }
+
+   if (Status != OS_SUCCESS)
+   {
+      CFE_EVS_SendEvent(SC_SIM_EPHEM_MUTEX_EID, CFE_EVS_EventType_ERROR,
+                        "Ephemeris cache mutex creation failed, status 0x%08X", (unsigned int)Status);
+      return false;
+   }
+
+   EphemMutex = MutexId;
+
+   return true;
+
+} /* End SC_SIM_EPHEM_Constructor() */
+
+
+/******************************************************************************
+** Function: SC_SIM_EPHEM_EciToEcef
+**
+*/
+void SC_SIM_EPHEM_EciToEcef(const double PosEci[3], double J2000Sec, double PosEcef[3])
+{
+
+   double Gmst = fmod(GMST_J2000_RAD + GMST_RATE_RADDAY*(J2000Sec/SC_SIM_EPHEM_SEC_PER_DAY), 2.0*M_PI);
+   double CosG = cos(Gmst), SinG = sin(Gmst);
+
+   PosEcef[0] =  CosG*PosEci[0] + SinG*PosEci[1];
+   PosEcef[1] = -SinG*PosEci[0] + CosG*PosEci[1];
+   PosEcef[2] =  PosEci[2];
+
+} /* End SC_SIM_EPHEM_EciToEcef() */
+
+
+/******************************************************************************
+** Function: SC_SIM_EPHEM_J2000Sec
+**
+** Notes:
+**   1. J2000Day is the day count from 2000-01-01 and DaySec is seconds past
+**      midnight. The J2000 epoch is noon so 43200 seconds are removed.
+*/
+double SC_SIM_EPHEM_J2000Sec(uint32 J2000Day, uint32 DaySec)
+{
+
+   return ((double)J2000Day*SC_SIM_EPHEM_SEC_PER_DAY + (double)DaySec - 43200.0);
+
+} /* End SC_SIM_EPHEM_J2000Sec() */
+
+
+/******************************************************************************
+** Function: SC_SIM_EPHEM_Prepare
+**
+*/
+void SC_SIM_EPHEM_Prepare(double StartSec, double EndSec)
+{
+
+   int32 BlockNum  = (int32)floor(StartSec/SC_SIM_EPHEM_BLOCK_SECS);
+   int32 EndBlock  = (int32)floor(EndSec/SC_SIM_EPHEM_BLOCK_SECS);
+
+   if ((EndBlock - BlockNum) >= SC_SIM_EPHEM_BLOCK_CNT)
+   {
+      EndBlock = BlockNum + SC_SIM_EPHEM_BLOCK_CNT - 1;
+   }
+
+   for ( ; BlockNum <= EndBlock; BlockNum++)
+   {
+      OS_MutSemTake(EphemMutex);
+      GetBlock(BlockNum);
+      OS_MutSemGive(EphemMutex);
+   }
+
+} /* End SC_SIM_EPHEM_Prepare() */
+
+
+/******************************************************************************
+** Function: SC_SIM_EPHEM_Position
+**
+** Notes:
+**   1. Clenshaw recurrence over the normalized block time Tau in [-1,1].
+**      The first coefficient is stored pre-halved by FillBlock().
+*/
+void SC_SIM_EPHEM_Position(SC_SIM_EPHEM_Body_t Body, double J2000Sec, double PosKm[3])
+{
+
+   int32   BlockNum = (int32)floor(J2000Sec/SC_SIM_EPHEM_BLOCK_SECS);
+   double  Tau = 2.0*(J2000Sec/SC_SIM_EPHEM_BLOCK_SECS - (double)BlockNum) - 1.0;
+   double  Tau2 = 2.0*Tau;
+   double  B0, B1, B2;
+   const double *Coeff;
+   const EphemBlock_t *Block;
+   int Axis, i;
+
+   OS_MutSemTake(EphemMutex);
+   
+   Block = GetBlock(BlockNum);
+   for (Axis=0; Axis < 3; Axis++)
+   {
+
+      Coeff = Block->Coeff[Body][Axis];
+      B1 = 0.0;
+      B2 = 0.0;
+      for (i=SC_SIM_EPHEM_CHEB_COEFF-1; i > 0; i--)
+      {
+         B0 = Coeff[i] + Tau2*B1 - B2;
+         B2 = B1;
+         B1 = B0;
+      }
+      PosKm[Axis] = Coeff[0] + Tau*B1 - B2;
+
+   }
+
+   OS_MutSemGive(EphemMutex);
+
+} /* End SC_SIM_EPHEM_Position() */
+
+
+/******************************************************************************
+** Function: SC_SIM_EPHEM_SunUnitVec
+**
+*/
+double SC_SIM_EPHEM_SunUnitVec(double J2000Sec, double SunUnit[3])
+{
+
+   double Dist;
+
+   SC_SIM_EPHEM_Position(SC_SIM_EPHEM_BODY_SUN, J2000Sec, SunUnit);
+
+   Dist = sqrt(SunUnit[0]*SunUnit[0] + SunUnit[1]*SunUnit[1] + SunUnit[2]*SunUnit[2]);
+
+   SunUnit[0] /= Dist;
+   SunUnit[1] /= Dist;
+   SunUnit[2] /= Dist;
+
+   return Dist;
+
+} /* End SC_SIM_EPHEM_SunUnitVec() */
+
+
+/******************************************************************************
+** Function: GetBlock
+**
+** Return the cache block for BlockNum, filling the slot if it holds a
+** different block.
+*/
+static const EphemBlock_t *GetBlock(int32 BlockNum)
+{
+
+   EphemBlock_t *Block = &EphemCache[BlockNum & BLOCK_IDX_MASK];
+
+   if (!Block->Valid || Block->BlockNum != BlockNum)
+   {
+      FillBlock(Block, BlockNum);
+   }
+
+   return Block;
+
+} /* End GetBlock() */
+
+
+/******************************************************************************
+** Function: FillBlock
+**
+** Sample the analytic series at the Chebyshev nodes of the block and compute
+** the coefficients with the discrete cosine transform.
+*/
+static void FillBlock(EphemBlock_t *Block, int32 BlockNum)
+{
+
+   double  Sample[SC_SIM_EPHEM_BODY_CNT][SC_SIM_EPHEM_CHEB_COEFF][3];
+   double  Theta, Sum, StartSec;
+   int     Body, Axis, j, k;
+
+   Block->Valid = false;
+
+   StartSec = (double)BlockNum*SC_SIM_EPHEM_BLOCK_SECS;
+
+   for (k=0; k < SC_SIM_EPHEM_CHEB_COEFF; k++)
+   {
+      Theta = M_PI*((double)k + 0.5)/SC_SIM_EPHEM_CHEB_COEFF;
+      SunAnalytic(StartSec + 0.5*SC_SIM_EPHEM_BLOCK_SECS*(cos(Theta) + 1.0), Sample[SC_SIM_EPHEM_BODY_SUN][k]);
+      MoonAnalytic(StartSec + 0.5*SC_SIM_EPHEM_BLOCK_SECS*(cos(Theta) + 1.0), Sample[SC_SIM_EPHEM_BODY_MOON][k]);
+   }
+
+   for (Body=0; Body < SC_SIM_EPHEM_BODY_CNT; Body++)
+   {
+      for (Axis=0; Axis < 3; Axis++)
+      {
+         for (j=0; j < SC_SIM_EPHEM_CHEB_COEFF; j++)
+         {
+            Sum = 0.0;
+            for (k=0; k < SC_SIM_EPHEM_CHEB_COEFF; k++)
+            {
+               Sum += Sample[Body][k][Axis]*cos(M_PI*(double)j*((double)k + 0.5)/SC_SIM_EPHEM_CHEB_COEFF);
+            }
+            Block->Coeff[Body][Axis][j] = (2.0/SC_SIM_EPHEM_CHEB_COEFF)*Sum;
+         }
+         Block->Coeff[Body][Axis][0] *= 0.5;
+      }
+   }
+
+   Block->BlockNum = BlockNum;
+   Block->Valid    = true;
+
+   CFE_EVS_SendEvent(SC_SIM_EPHEM_FILL_BLOCK_EID, CFE_EVS_EventType_DEBUG,
+                     "Ephemeris block %d computed in cache slot %d",
+                     (int)BlockNum, (int)(BlockNum & BLOCK_IDX_MASK));
+
+} /* End FillBlock() */
+
+
+/******************************************************************************
+** Function: MoonAnalytic
+**
+** Low precision lunar series from Montenbruck & Gill, Satellite Orbits,
+** section 3.3.2.
+*/
+static void MoonAnalytic(double J2000Sec, double PosKm[3])
+{
+
+   double T = J2000Sec/(SC_SIM_EPHEM_SEC_PER_DAY*DAYS_PER_CENT);
+   double L0, l, lp, F, D, Lon, Lat, Dist, Eps;
+   double x, y, z;
+
+   L0 = (218.31617 + 481267.88088*T - 1.3972*T)*DEG2RAD;
+   l  = (134.96292 + 477198.86753*T)*DEG2RAD;
+   lp = (357.52543 +  35999.04944*T)*DEG2RAD;
+   F  = ( 93.27283 + 483202.01873*T)*DEG2RAD;
+   D  = (297.85027 + 445267.11135*T)*DEG2RAD;
+
+   Lon = L0 + ARCSEC2RAD*( 22640.0*sin(l) + 769.0*sin(2.0*l)
+                         - 4586.0*sin(l-2.0*D) + 2370.0*sin(2.0*D)
+                         -  668.0*sin(lp) - 412.0*sin(2.0*F)
+                         -  212.0*sin(2.0*l-2.0*D) - 206.0*sin(l+lp-2.0*D)
+                         +  192.0*sin(l+2.0*D) - 165.0*sin(lp-2.0*D)
+                         +  148.0*sin(l-lp) - 125.0*sin(D)
+                         -  110.0*sin(l+lp) - 55.0*sin(2.0*F-2.0*D));
+
+   Lat = ARCSEC2RAD*( 18520.0*sin(F + Lon - L0 + ARCSEC2RAD*(412.0*sin(2.0*F) + 541.0*sin(lp)))
+                    - 526.0*sin(F-2.0*D) + 44.0*sin(l+F-2.0*D) - 31.0*sin(-l+F-2.0*D)
+                    -  25.0*sin(-2.0*l+F) - 23.0*sin(lp+F-2.0*D) + 21.0*sin(-l+F)
+                    +  11.0*sin(-lp+F-2.0*D));
+
+   Dist = 385000.0 - 20905.0*cos(l) - 3699.0*cos(2.0*D-l) - 2956.0*cos(2.0*D)
+        - 570.0*cos(2.0*l) + 246.0*cos(2.0*l-2.0*D) - 205.0*cos(lp-2.0*D)
+        - 171.0*cos(l+2.0*D) - 152.0*cos(l+lp-2.0*D);
+
+   Eps = (23.43929111 - 0.0130042*T)*DEG2RAD;
+
+   x = Dist*cos(Lat)*cos(Lon);
+   y = Dist*cos(Lat)*sin(Lon);
+   z = Dist*sin(Lat);
+
+   PosKm[0] = x;
+   PosKm[1] = y*cos(Eps) - z*sin(Eps);
+   PosKm[2] = y*sin(Eps) + z*cos(Eps);
+
+} /* End MoonAnalytic() */
+
+
+/******************************************************************************
+** Function: SunAnalytic
+**
+** Low precision solar coordinates from the Astronomical Almanac.
+*/
+static void SunAnalytic(double J2000Sec, double PosKm[3])
+{
+
+   double n = J2000Sec/SC_SIM_EPHEM_SEC_PER_DAY;
+   double L, g, Lon, Eps, Dist;
+
+   L   = (280.460 + 0.9856474*n)*DEG2RAD;
+   g   = (357.528 + 0.9856003*n)*DEG2RAD;
+   Lon = L + (1.915*sin(g) + 0.020*sin(2.0*g))*DEG2RAD;
+   Eps = (23.439 - 0.0000004*n)*DEG2RAD;
+
+   Dist = (1.00014 - 0.01671*cos(g) - 0.00014*cos(2.0*g))*SC_SIM_EPHEM_AU_KM;
+
+   PosKm[0] = Dist*cos(Lon);
+   PosKm[1] = Dist*cos(Eps)*sin(Lon);
+   PosKm[2] = Dist*sin(Eps)*sin(Lon);
+
+} /* End SunAnalytic() */
@@ -0,0 +1,157 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Define the sun/moon ephemeris service
+**
+** Notes:
+**   1. Sun and moon positions are computed from low precision analytic
+**      series (Astronomical Almanac sun, Montenbruck & Gill moon) and
+**      fit with Chebyshev polynomials over fixed length time blocks.
+**      Queries evaluate the fit using Clenshaw's recurrence so each
+**      query is a few multiply-adds per axis.
+**   2. Blocks are held in a direct mapped cache indexed by the absolute
+**      block number. A block is computed when a scenario is prepared or
+**      lazily on first access. A slot is refilled when a block that maps
+**      to it is needed, e.g. when another instance's epoch is far away.
+**   3. The cache is file scope data keyed by absolute time so it is
+**      shared by every SC_SIM instance in the process regardless of the
+**      instance's epoch. Filling and evaluating a block are done while
+**      holding a named OSAL mutex so an instance never reads a block
+**      another instance or task is rewriting.
+**   4. Positions are Earth centered inertial (mean equator and equinox of
+**      date) in kilometers. The accuracy (~0.01 deg sun, ~0.3 deg moon)
+**      is sufficient for eclipse, beta angle and illumination models.
+**
+*/
+
+#ifndef _sc_sim_ephem_
+#define _sc_sim_ephem_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SC_SIM_EPHEM_BLOCK_SECS   (86400.0)  /* Time span covered by one coefficient block */
+#define SC_SIM_EPHEM_CHEB_COEFF   (12)       /* Chebyshev coefficients per axis */
+#define SC_SIM_EPHEM_BLOCK_CNT    (16)       /* Cache slots, must be a power of 2 */
+
+#define SC_SIM_EPHEM_SEC_PER_DAY  (86400.0)
+#define SC_SIM_EPHEM_AU_KM        (149597870.7)
+
+/*
+** Event Message IDs
+*/
+
+#define SC_SIM_EPHEM_FILL_BLOCK_EID  (SC_SIM_EPHEM_BASE_EID + 0)
+#define SC_SIM_EPHEM_MUTEX_EID       (SC_SIM_EPHEM_BASE_EID + 1)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+
+   SC_SIM_EPHEM_BODY_SUN  = 0,
+   SC_SIM_EPHEM_BODY_MOON = 1,
+   SC_SIM_EPHEM_BODY_CNT  = 2
+
+} SC_SIM_EPHEM_Body_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SC_SIM_EPHEM_Constructor
+**
+** Create the cache mutex or, when another instance already created it,
+** look it up. Return false if neither succeeds.
+**
+** Notes:
+**   1. Must be called before the other functions. Without the mutex the
+**      cache is only safe for a single task.
+**
+*/
+bool SC_SIM_EPHEM_Constructor(void);
+
+
+/******************************************************************************
+** Function: SC_SIM_EPHEM_Prepare
+**
+** Fill the cache blocks spanning [StartSec, EndSec].
+**
+** Notes:
+**   1. Times are seconds since J2000 (2000-01-01 12:00 TT).
+**   2. Optional. Queries fill missing blocks on demand but preparing the
+**      blocks when a scenario starts keeps the fit cost out of the
+**      realtime phase.
+**   3. Spans longer than the cache are truncated to the cache size.
+**
+*/
+void SC_SIM_EPHEM_Prepare(double StartSec, double EndSec);
+
+
+/******************************************************************************
+** Function: SC_SIM_EPHEM_Position
+**
+** Load Body's ECI position in kilometers at J2000Sec into PosKm.
+**
+*/
+void SC_SIM_EPHEM_Position(SC_SIM_EPHEM_Body_t Body, double J2000Sec, double PosKm[3]);
+
+
+/******************************************************************************
+** Function: SC_SIM_EPHEM_SunUnitVec
+**
+** Load the ECI unit vector from the Earth to the sun at J2000Sec and return
+** the Earth-sun distance in kilometers.
+**
+*/
+double SC_SIM_EPHEM_SunUnitVec(double J2000Sec, double SunUnit[3]);
+
+
+/******************************************************************************
+** Function: SC_SIM_EPHEM_EciToEcef
+**
+** Rotate an ECI position to Earth fixed coordinates at J2000Sec.
+**
+** Notes:
+**   1. Only the Earth's rotation (GMST) is applied, precession, nutation
+**      and polar motion are ignored.
+**
+*/
+void SC_SIM_EPHEM_EciToEcef(const double PosEci[3], double J2000Sec, double PosEcef[3]);
+
+
+/******************************************************************************
+** Function: SC_SIM_EPHEM_J2000Sec
+**
+** Convert a J2000 day number and second of day into seconds since J2000.
+**
+*/
+double SC_SIM_EPHEM_J2000Sec(uint32 J2000Day, uint32 DaySec);
+
+
+#endif /* _sc_sim_ephem_ */
@@ -0,0 +1,205 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Implement the stochastic fault injection engine
+**
+** Notes:
+**   None
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <math.h>
+#include <stdio.h>
+
+#include "sc_sim_fault.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SEC_PER_HOUR  (3600.0)
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void UpdateNextTime(SC_SIM_FAULT_Class_t *Fault);
+
+
+/******************************************************************************
+** Function: SC_SIM_FAULT_Config
+**
+*/
+void SC_SIM_FAULT_Config(SC_SIM_FAULT_Class_t *Fault, const SC_SIM_TBL_Fault_t *Tbl,
+                         SC_SIM_FAULT_RandParamFunc_t RandParam)
+{
+
+   SC_SIM_FAULT_Slot_t *Slot;
+   uint16 i;
+
+   for (i=0; i < SC_SIM_FAULT_SLOT_CNT; i++)
+   {
+
+      Slot = &Fault->Slot[i];
+      Slot->LogQ   = (Tbl->Slot[i].Rate > 0.0) ? -(double)Tbl->Slot[i].Rate/SEC_PER_HOUR : 0.0;
+      Slot->SubSys = (uint8)Tbl->Slot[i].SubSys;
+      Slot->Id     = (uint8)Tbl->Slot[i].Event;
+      Slot->Param  = Tbl->Slot[i].Param;
+
+      if (Slot->LogQ != 0.0 && Slot->Param < 0 && !RandParam(Slot->SubSys, Slot->Id))
+      {
+         CFE_EVS_SendEvent(SC_SIM_FAULT_CONFIG_EID, CFE_EVS_EventType_ERROR,
+                           "Fault slot %d disabled, subsystem %d event %d doesn't accept a random parameter",
+                           i+1, Slot->SubSys, Slot->Id);
+         Slot->LogQ = 0.0;
+      }
+
+      if (Slot->LogQ == 0.0)
+      {
+         Slot->NextTime = SC_SIM_FAULT_NEVER;
+         Slot->Pending  = false;
+      }
+      else if (!Slot->Pending)
+      {
+         Slot->NextTime = 0;
+      }
+
+   }
+
+   UpdateNextTime(Fault);
+
+} /* End SC_SIM_FAULT_Config() */
+
+
+/******************************************************************************
+** Function: SC_SIM_FAULT_Reset
+**
+*/
+void SC_SIM_FAULT_Reset(SC_SIM_FAULT_Class_t *Fault, uint64 RunId, uint16 CraftId)
+{
+
+   SC_SIM_FAULT_Slot_t *Slot;
+   uint16 i;
+
+   SC_SIM_RNG_Seed(&Fault->Rng, RunId, CraftId, SC_SIM_RNG_MODEL_FAULT);
+
+   for (i=0; i < SC_SIM_FAULT_SLOT_CNT; i++)
+   {
+      Slot = &Fault->Slot[i];
+      Slot->NextTime  = (Slot->LogQ == 0.0) ? SC_SIM_FAULT_NEVER : 0;
+      Slot->Pending   = false;
+      Slot->InjectCnt = 0;
+   }
+
+   Fault->InjectCnt = 0;
+   UpdateNextTime(Fault);
+
+} /* End SC_SIM_FAULT_Reset() */
+
+
+/******************************************************************************
+** Function: SC_SIM_FAULT_Schedule
+**
+** Notes:
+**   1. The gap is 1 + floor(ln(U)/ln(1-p)) seconds with U uniform on (0,1],
+**      the inverse of the geometric distribution's CDF.
+**   2. The gap is counted from Time so a slot that starts sampling after a
+**      long idle period doesn't inject faults in the past.
+**
+*/
+const SC_SIM_FAULT_Slot_t *SC_SIM_FAULT_Schedule(SC_SIM_FAULT_Class_t *Fault, uint32 Time)
+{
+
+   SC_SIM_FAULT_Slot_t *Slot = NULL;
+   double Gap;
+   uint16 i;
+
+   if (Time < Fault->NextTime) return NULL;
+
+   for (i=0; i < SC_SIM_FAULT_SLOT_CNT; i++)
+   {
+      if (Fault->Slot[i].NextTime <= Time)
+      {
+         Slot = &Fault->Slot[i];
+         break;
+      }
+   }
+
+   if (Slot == NULL) return NULL;
+
+   Gap = 1.0 + floor(log(SC_SIM_RNG_Uniform(&Fault->Rng))/Slot->LogQ);
+   if (Gap < (double)(SC_SIM_FAULT_NEVER - Time))
+   {
+      Slot->NextTime = Time + (uint32)Gap;
+      Slot->Pending  = true;
+   }
+   else
+   {
+      Slot->NextTime = SC_SIM_FAULT_NEVER;
+      Slot->Pending  = false;
+   }
+
+   snprintf(Slot->ParamStr, SC_SIM_FAULT_PARAM_LEN, "%d",
+            (Slot->Param < 0) ? (int)(SC_SIM_RNG_Next(&Fault->Rng) >> 1) : (int)Slot->Param);
+
+   UpdateNextTime(Fault);
+
+   return Slot;
+
+} /* End SC_SIM_FAULT_Schedule() */
+
+
+/******************************************************************************
+** Function: SC_SIM_FAULT_Injected
+**
+*/
+void SC_SIM_FAULT_Injected(SC_SIM_FAULT_Class_t *Fault, uint16 SlotIdx, const char *Param, uint32 Time)
+{
+
+   SC_SIM_FAULT_Slot_t *Slot;
+
+   if (SlotIdx >= SC_SIM_FAULT_SLOT_CNT) return;
+
+   Slot = &Fault->Slot[SlotIdx];
+   Slot->InjectCnt++;
+   Fault->InjectCnt++;
+   CFE_EVS_SendEvent(SC_SIM_FAULT_INJECT_EID, CFE_EVS_EventType_INFORMATION,
+                     "Fault slot %d injected subsystem %d event %d with parameter %s at %d",
+                     SlotIdx+1, Slot->SubSys, Slot->Id, (Param != NULL) ? Param : "", (int)Time);
+
+} /* End SC_SIM_FAULT_Injected() */
+
+
+/******************************************************************************
+** Function: UpdateNextTime
+**
+*/
+static void UpdateNextTime(SC_SIM_FAULT_Class_t *Fault)
+{
+
+   uint16 i;
+
+   Fault->NextTime = SC_SIM_FAULT_NEVER;
+   for (i=0; i < SC_SIM_FAULT_SLOT_CNT; i++)
+   {
+      if (Fault->Slot[i].NextTime < Fault->NextTime) Fault->NextTime = Fault->Slot[i].NextTime;
+   }
+
+} /* End UpdateNextTime() */
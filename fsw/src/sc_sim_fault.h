@@ -0,0 +1,162 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Define a stochastic fault injection engine
+**
+** Notes:
+**   1. Each fault slot injects a subsystem event command at random times
+**      with a mean rate per sim hour. Fault arrivals are a Poisson process
+**      sampled on whole sim seconds, the gap to the next arrival is
+**      geometric with a per second probability of 1 - exp(-rate/3600).
+**   2. Only the next arrival of each slot is sampled. The sim adds it to
+**      the event command list and asks for the slot's following arrival
+**      when the time is reached, so a step costs one comparison no
+**      matter how many seconds there are between faults.
+**   3. Faults draw from the fault model's random stream, reset at the
+**      start of each sim, so a run ID and scenario always inject the same
+**      faults at the same times.
+**   4. A fault is counted as injected when its event command executes, a
+**      sampled fault the sim doesn't add (e.g. after the end of the sim)
+**      isn't injected.
+**
+*/
+
+#ifndef _sc_sim_fault_
+#define _sc_sim_fault_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "sc_sim_tbl.h"
+#include "sc_sim_rng.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SC_SIM_FAULT_SLOT_CNT   SC_SIM_TBL_FAULT_CNT
+#define SC_SIM_FAULT_NEVER      (0xFFFFFFFF)
+#define SC_SIM_FAULT_PARAM_LEN  (12)
+
+/*
+** Event Message IDs
+*/
+
+#define SC_SIM_FAULT_INJECT_EID  (SC_SIM_FAULT_BASE_EID + 0)
+#define SC_SIM_FAULT_CONFIG_EID  (SC_SIM_FAULT_BASE_EID + 1)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/*
+** Returns true if a target subsystem's event command accepts any
+** parameter from 0 to 2^31-1, see SC_SIM_FAULT_Config().
+*/
+typedef bool (*SC_SIM_FAULT_RandParamFunc_t)(uint8 SubSys, uint8 Id);
+
+typedef struct
+{
+
+   double  LogQ;            /* ln(1-p) = -rate/3600, 0 if the slot is disabled */
+   uint8   SubSys;
+   uint8   Id;
+   int32   Param;           /* Negative draws a random 31 bit parameter for each fault */
+
+   uint32  NextTime;        /* Sim time of the slot's pending fault */
+   bool    Pending;         /* NextTime is a sampled fault, not a request to sample one */
+   uint32  InjectCnt;
+   char    ParamStr[SC_SIM_FAULT_PARAM_LEN];
+
+} SC_SIM_FAULT_Slot_t;
+
+
+typedef struct
+{
+
+   SC_SIM_RNG_Class_t Rng;
+   uint32  NextTime;        /* Earliest slot time */
+   uint32  InjectCnt;
+
+   SC_SIM_FAULT_Slot_t Slot[SC_SIM_FAULT_SLOT_CNT];
+
+} SC_SIM_FAULT_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SC_SIM_FAULT_Config
+**
+** Load the slots' rates and targets from the table.
+**
+** Notes:
+**   1. Pending faults keep their times, the new rates apply to the
+**      following arrivals. A slot that becomes enabled samples its first
+**      arrival on the next schedule.
+**   2. A slot with a negative parameter is disabled with an error event
+**      unless RandParam accepts its target, otherwise each of its faults
+**      would be rejected by the target's event command.
+**
+*/
+void SC_SIM_FAULT_Config(SC_SIM_FAULT_Class_t *Fault, const SC_SIM_TBL_Fault_t *Tbl,
+                         SC_SIM_FAULT_RandParamFunc_t RandParam);
+
+
+/******************************************************************************
+** Function: SC_SIM_FAULT_Reset
+**
+** Select the run's fault stream and discard pending faults. The enabled
+** slots sample their first arrival on the first schedule.
+**
+*/
+void SC_SIM_FAULT_Reset(SC_SIM_FAULT_Class_t *Fault, uint64 RunId, uint16 CraftId);
+
+
+/******************************************************************************
+** Function: SC_SIM_FAULT_Schedule
+**
+** Return a slot whose pending fault time has been reached after sampling
+** its next fault, NULL if no slot is due. The caller adds the slot's
+** event command at the slot's NextTime and calls again until it gets NULL.
+**
+** Notes:
+**   1. A slot's NextTime is SC_SIM_FAULT_NEVER when its next fault is
+**      too far away to represent.
+**   2. The slot's ParamStr is overwritten when its next fault is sampled
+**      so the caller copies it into the event command.
+**
+*/
+const SC_SIM_FAULT_Slot_t *SC_SIM_FAULT_Schedule(SC_SIM_FAULT_Class_t *Fault, uint32 Time);
+
+
+/******************************************************************************
+** Function: SC_SIM_FAULT_Injected
+**
+** Count and report a fault of slot SlotIdx whose event command executed
+** with parameter Param at Time.
+**
+*/
+void SC_SIM_FAULT_Injected(SC_SIM_FAULT_Class_t *Fault, uint16 SlotIdx, const char *Param, uint32 Time);
+
+
+#endif /* _sc_sim_fault_ */
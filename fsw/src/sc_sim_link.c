@@ -0,0 +1,207 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Implement the downlink budget
+**
+** Notes:
+**   None
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <math.h>
+
+#include "sc_sim_link.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define BOLTZMANN_DB    (228.6)   /* -10log10(k) */
+#define FSPL_KM_GHZ_DB  (92.45)   /* 20log10(4*pi*1e12/c) */
+#define MIN_SIN_ELEV    (0.05)    /* Bounds the atmospheric loss near the horizon */
+
+
+/******************************************************************************
+** Function: SC_SIM_LINK_Clear
+**
+*/
+void SC_SIM_LINK_Clear(SC_SIM_LINK_Class_t *Link)
+{
+
+   Link->Valid     = false;
+   Link->PtCnt     = 0;
+   Link->Acquired  = false;
+   Link->ModcodIdx = SC_SIM_LINK_NO_MODCOD;
+   Link->CN0Now    = 0.0;
+   Link->Margin    = 0.0;
+
+} /* End SC_SIM_LINK_Clear() */
+
+
+/******************************************************************************
+** Function: SC_SIM_LINK_Config
+**
+*/
+void SC_SIM_LINK_Config(SC_SIM_LINK_Class_t *Link, const SC_SIM_TBL_Comm_t *Tbl)
+{
+
+   SC_SIM_LINK_Modcod_t *Modcod;
+   uint16 i;
+
+   Link->Eirp       = Tbl->Eirp;
+   Link->FreqDb     = 20.0*log10((Tbl->LinkFreq > 0.0) ? Tbl->LinkFreq : 1.0) + FSPL_KM_GHZ_DB;
+   Link->StationGt  = Tbl->StationGt;
+   Link->RelayGt    = Tbl->RelayGt;
+   Link->AtmLoss    = Tbl->AtmLoss;
+   Link->ImplLoss   = Tbl->ImplLoss;
+   Link->LinkMargin = Tbl->LinkMargin;
+   Link->RateHyst   = Tbl->RateHyst;
+   Link->ModcodCnt  = 0;
+
+   for (i=0; i < SC_SIM_TBL_MODCOD_CNT; i++)
+   {
+      if (Tbl->Modcod[i].Rate > 0.0)
+      {
+         Modcod = &Link->Modcod[Link->ModcodCnt++];
+         Modcod->Rate   = (Tbl->Modcod[i].Rate < SC_SIM_LINK_MAX_RATE) ? Tbl->Modcod[i].Rate : SC_SIM_LINK_MAX_RATE;
+         Modcod->CN0Req = Tbl->Modcod[i].EbN0 + 10.0*log10(Modcod->Rate*1000.0) + Tbl->LinkMargin;
+      }
+   }
+
+   SC_SIM_LINK_Clear(Link);
+
+} /* End SC_SIM_LINK_Config() */
+
+
+/******************************************************************************
+** Function: SC_SIM_LINK_Prepare
+**
+** Notes:
+**   1. The sample spacing is stretched for long contacts so the whole pass
+**      fits in the profile.
+**
+*/
+bool SC_SIM_LINK_Prepare(SC_SIM_LINK_Class_t *Link, const SC_SIM_CONTACT_Class_t *Contact,
+                         uint16 Asset, const SC_SIM_ORBIT_Class_t *Orbit,
+                         double Start, double Length)
+{
+
+   SC_SIM_ORBIT_Class_t Prop;
+   bool   Relay = (Contact->Asset[Asset].Type == SC_SIM_CONTACT_RELAY);
+   double Step  = Length/(double)(SC_SIM_LINK_MAX_PTS - 1);
+   double Base, T, RangeKm, SinElev;
+   uint16 i;
+
+   SC_SIM_LINK_Clear(Link);
+
+   if (!Orbit->Valid || Orbit->Decayed) return false;
+
+   if (Step < SC_SIM_LINK_MIN_STEP) Step = SC_SIM_LINK_MIN_STEP;
+
+   SC_SIM_ORBIT_Copy(&Prop, Orbit);
+
+   Base = Link->Eirp - Link->FreqDb - Link->ImplLoss + (Relay ? Link->RelayGt : Link->StationGt) + BOLTZMANN_DB;
+
+   Link->Start   = Start;
+   Link->InvStep = 1.0/Step;
+   Link->PtCnt   = (uint16)ceil(Length/Step) + 1;
+   if (Link->PtCnt > SC_SIM_LINK_MAX_PTS) Link->PtCnt = SC_SIM_LINK_MAX_PTS;
+
+   for (i=0; i < Link->PtCnt; i++)
+   {
+
+      T = Start + i*Step;
+      SC_SIM_ORBIT_Propagate(&Prop, T, T + Prop.J2000Offset);
+      if (Prop.Decayed)
+      {
+         Link->PtCnt = (i > 0) ? i : 1;
+         break;
+      }
+
+      SC_SIM_CONTACT_Geometry(Contact, Asset, Prop.PosEci, T + Prop.J2000Offset, &RangeKm, &SinElev);
+
+      Link->CN0[i] = Base - 20.0*log10(RangeKm);
+      if (!Relay)
+      {
+         Link->CN0[i] -= Link->AtmLoss/((SinElev > MIN_SIN_ELEV) ? SinElev : MIN_SIN_ELEV);
+      }
+
+   } /* End profile loop */
+
+   Link->Valid = true;
+
+   return true;
+
+} /* End SC_SIM_LINK_Prepare() */
+
+
+/******************************************************************************
+** Function: SC_SIM_LINK_Rate
+**
+*/
+double SC_SIM_LINK_Rate(SC_SIM_LINK_Class_t *Link, double Time)
+{
+
+   double X;
+   uint16 i;
+   int16  m;
+
+   if (!Link->Valid || Link->ModcodCnt == 0) return 0.0;
+
+   X = (Time - Link->Start)*Link->InvStep;
+   if (X <= 0.0)
+   {
+      Link->CN0Now = Link->CN0[0];
+   }
+   else if (X >= (double)(Link->PtCnt - 1))
+   {
+      Link->CN0Now = Link->CN0[Link->PtCnt - 1];
+   }
+   else
+   {
+      i = (uint16)X;
+      Link->CN0Now = Link->CN0[i] + (float)(X - i)*(Link->CN0[i+1] - Link->CN0[i]);
+   }
+
+   m = Link->ModcodIdx;
+   if (!Link->Acquired)
+   {
+      m = SC_SIM_LINK_NO_MODCOD;
+      while ((m+1) < Link->ModcodCnt && Link->CN0Now >= Link->Modcod[m+1].CN0Req) m++;
+      Link->Acquired = true;
+   }
+   else
+   {
+      while (m >= 0 && Link->CN0Now < Link->Modcod[m].CN0Req) m--;
+      while ((m+1) < Link->ModcodCnt && Link->CN0Now >= (Link->Modcod[m+1].CN0Req + Link->RateHyst)) m++;
+   }
+
+   if (m != Link->ModcodIdx)
+   {
+      CFE_EVS_SendEvent(SC_SIM_LINK_RATE_EID, CFE_EVS_EventType_DEBUG,
+                        "Downlink rate changed to %.0f kbps, C/N0 %.1f dB-Hz",
+                        (m >= 0) ? Link->Modcod[m].Rate : 0.0, Link->CN0Now);
+      Link->ModcodIdx = m;
+   }
+
+   Link->Margin = Link->CN0Now - Link->Modcod[(m >= 0) ? m : 0].CN0Req + Link->LinkMargin;
+
+   return (m >= 0) ? Link->Modcod[m].Rate : 0.0;
+
+} /* End SC_SIM_LINK_Rate() */
@@ -0,0 +1,160 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Define a downlink budget with adaptive rate selection
+**
+** Notes:
+**   1. The carrier to noise density, C/N0 (dB-Hz), is
+**         EIRP - FSPL(range) - AtmLoss/sin(elev) - ImplLoss + G/T + 228.6
+**      Relays use the relay G/T and have no atmospheric loss.
+**   2. When a planned contact starts its C/N0 is sampled over the whole
+**      pass on a copy of the orbit. Each step is then a profile lookup and
+**      a comparison against the modulation/coding steps' C/N0 thresholds,
+**      there are no logarithms or orbit propagation per step.
+**   3. Rates switch down as soon as the current step stops closing and
+**      switch up when the next step closes with the hysteresis margin.
+**
+*/
+
+#ifndef _sc_sim_link_
+#define _sc_sim_link_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "sc_sim_contact.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SC_SIM_LINK_MAX_PTS    (512)
+#define SC_SIM_LINK_MIN_STEP   (10.0)    /* Profile sample spacing lower limit (sec) */
+#define SC_SIM_LINK_MAX_RATE   (65535.0) /* Contact data rate (kbps) telemetry limit */
+
+#define SC_SIM_LINK_NO_MODCOD  (-1)
+
+/*
+** Event Message IDs
+*/
+
+#define SC_SIM_LINK_RATE_EID  (SC_SIM_LINK_BASE_EID + 0)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+
+   double  Rate;            /* kbps */
+   double  CN0Req;          /* C/N0 needed for the Eb/N0 plus the link margin (dB-Hz) */
+
+} SC_SIM_LINK_Modcod_t;
+
+
+typedef struct
+{
+
+   /* Configuration */
+
+   double  Eirp;
+   double  FreqDb;          /* FSPL = 20log10(range km) + FreqDb */
+   double  StationGt;
+   double  RelayGt;
+   double  AtmLoss;
+   double  ImplLoss;
+   double  LinkMargin;
+   double  RateHyst;
+   uint16  ModcodCnt;
+   SC_SIM_LINK_Modcod_t Modcod[SC_SIM_TBL_MODCOD_CNT];
+
+   /* Pass profile */
+
+   bool    Valid;
+   double  Start;
+   double  InvStep;
+   uint16  PtCnt;
+   float   CN0[SC_SIM_LINK_MAX_PTS];
+
+   /* State */
+
+   bool    Acquired;
+   int16   ModcodIdx;       /* SC_SIM_LINK_NO_MODCOD when no step closes */
+   float   CN0Now;
+   float   Margin;          /* Eb/N0 above the current step's requirement (dB) */
+
+} SC_SIM_LINK_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SC_SIM_LINK_Config
+**
+** Load the link budget terms and modulation/coding steps from the table
+** and clear the pass profile.
+**
+** Notes:
+**   1. Steps with a zero rate are dropped. The remaining steps must be in
+**      increasing rate order.
+**   2. Rates above SC_SIM_LINK_MAX_RATE are limited to it so a rate always
+**      fits the contact's 16 bit data rate.
+**
+*/
+void SC_SIM_LINK_Config(SC_SIM_LINK_Class_t *Link, const SC_SIM_TBL_Comm_t *Tbl);
+
+
+/******************************************************************************
+** Function: SC_SIM_LINK_Clear
+**
+** Clear the pass profile at the end of a contact.
+**
+*/
+void SC_SIM_LINK_Clear(SC_SIM_LINK_Class_t *Link);
+
+
+/******************************************************************************
+** Function: SC_SIM_LINK_Prepare
+**
+** Sample the C/N0 of a contact with a planner asset from Start for
+** Length seconds.
+**
+** Notes:
+**   1. Returns false if there's no valid orbit.
+**
+*/
+bool SC_SIM_LINK_Prepare(SC_SIM_LINK_Class_t *Link, const SC_SIM_CONTACT_Class_t *Contact,
+                         uint16 Asset, const SC_SIM_ORBIT_Class_t *Orbit,
+                         double Start, double Length);
+
+
+/******************************************************************************
+** Function: SC_SIM_LINK_Rate
+**
+** Return the data rate (kbps) at Time, 0 if no step closes.
+**
+*/
+double SC_SIM_LINK_Rate(SC_SIM_LINK_Class_t *Link, double Time);
+
+
+#endif /* _sc_sim_link_ */
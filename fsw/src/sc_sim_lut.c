@@ -0,0 +1,83 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Implement the uniformly gridded lookup table utility
+**
+** Notes:
+**   None
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <math.h>
+
+#include "sc_sim_lut.h"
+
+
+/******************************************************************************
+** Function: SC_SIM_LUT_Load
+**
+*/
+bool SC_SIM_LUT_Load(SC_SIM_LUT_Class_t *Lut, float X0, float Dx,
+                     const float *Y, uint16 PtCnt)
+{
+
+   uint16 i;
+
+   if (PtCnt < 2 || PtCnt > SC_SIM_LUT_MAX_PTS || !(Dx > 0.0f)) return false;
+
+   Lut->X0    = X0;
+   Lut->Dx    = Dx;
+   Lut->InvDx = 1.0f/Dx;
+   Lut->XMax  = X0 + Dx*(float)(PtCnt-1);
+   Lut->PtCnt = PtCnt;
+
+   for (i=0; i < PtCnt; i++)
+   {
+      Lut->Y[i] = Y[i];
+   }
+   for (i=0; i < (PtCnt-1); i++)
+   {
+      Lut->Slope[i] = (Y[i+1] - Y[i])*Lut->InvDx;
+   }
+   Lut->Y[PtCnt]       = Y[PtCnt-1];
+   Lut->Slope[PtCnt-1] = 0.0f;
+   Lut->Slope[PtCnt]   = 0.0f;
+
+   return true;
+
+} /* End SC_SIM_LUT_Load() */
+
+
+/******************************************************************************
+** Function: SC_SIM_LUT_Eval
+**
+** Notes:
+**   1. fminf/fmaxf compile to min/max instructions on the supported targets
+**      so the clamp and index computation don't branch. An index rounded
+**      past the last breakpoint reads the repeated last point.
+**
+*/
+float SC_SIM_LUT_Eval(const SC_SIM_LUT_Class_t *Lut, float X)
+{
+
+   float  Xc = fminf(fmaxf(X, Lut->X0), Lut->XMax);
+   uint16 i  = (uint16)((Xc - Lut->X0)*Lut->InvDx);
+
+   return Lut->Y[i] + Lut->Slope[i]*(Xc - (Lut->X0 + Lut->Dx*(float)i));
+
+} /* End SC_SIM_LUT_Eval() */
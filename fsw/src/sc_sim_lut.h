@@ -0,0 +1,93 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Define a uniformly gridded lookup table utility
+**
+** Notes:
+**   1. Breakpoints are evenly spaced so the interval index is computed
+**      directly from the input rather than searched for.
+**   2. Segment slopes are computed when the table is loaded. The slope of
+**      the last breakpoint is zero and the last breakpoint is repeated
+**      after the table so an input clamped to the table's end evaluates
+**      to the last value even if float rounding indexes past it, there's
+**      no end-of-table branch.
+**   3. Inputs outside the table's range are clamped to the end values.
+**
+*/
+
+#ifndef _sc_sim_lut_
+#define _sc_sim_lut_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SC_SIM_LUT_MAX_PTS  (16)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   float   X0;       /* First breakpoint */
+   float   Dx;       /* Breakpoint spacing */
+   float   InvDx;
+   float   XMax;     /* Last breakpoint */
+   uint16  PtCnt;
+
+   float   Y[SC_SIM_LUT_MAX_PTS+1];      /* Last value repeated after the table */
+   float   Slope[SC_SIM_LUT_MAX_PTS+1];  /* Per breakpoint, dY/dX to the next breakpoint */
+
+} SC_SIM_LUT_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SC_SIM_LUT_Load
+**
+** Load PtCnt values breakpointed at X0, X0+Dx, ... and compute the slopes.
+**
+** Notes:
+**   1. Returns false and leaves the table unchanged if PtCnt is less than
+**      2 or greater than SC_SIM_LUT_MAX_PTS, or Dx isn't positive.
+**
+*/
+bool SC_SIM_LUT_Load(SC_SIM_LUT_Class_t *Lut, float X0, float Dx,
+                     const float *Y, uint16 PtCnt);
+
+
+/******************************************************************************
+** Function: SC_SIM_LUT_Eval
+**
+** Linearly interpolate the table at X.
+**
+*/
+float SC_SIM_LUT_Eval(const SC_SIM_LUT_Class_t *Lut, float X);
+
+
+#endif /* _sc_sim_lut_ */
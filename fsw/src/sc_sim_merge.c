@@ -0,0 +1,156 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Implement the event stream merge
+**
+** Notes:
+**   None
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "sc_sim_merge.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool Before(const SC_SIM_MERGE_Key_t *A, const SC_SIM_MERGE_Key_t *B);
+static void SiftDown(SC_SIM_MERGE_Class_t *Merge, uint16 i);
+
+
+/******************************************************************************
+** Function: SC_SIM_MERGE_Reset
+**
+*/
+void SC_SIM_MERGE_Reset(SC_SIM_MERGE_Class_t *Merge)
+{
+
+   memset(Merge, 0, sizeof(SC_SIM_MERGE_Class_t));
+
+} /* End SC_SIM_MERGE_Reset() */
+
+
+/******************************************************************************
+** Function: SC_SIM_MERGE_Add
+**
+*/
+bool SC_SIM_MERGE_Add(SC_SIM_MERGE_Class_t *Merge, uint16 Stream, int32 Time)
+{
+
+   SC_SIM_MERGE_Key_t Key;
+   uint16 i;
+
+   if (Merge->KeyCnt >= SC_SIM_MERGE_MAX) return false;
+
+   Key.Time   = Time;
+   Key.Stream = Stream;
+   
+   for (i = Merge->KeyCnt++; i > 0 && Before(&Key, &Merge->Heap[(i-1)/2]); i = (i-1)/2)
+   {
+      Merge->Heap[i] = Merge->Heap[(i-1)/2];
+   }
+   Merge->Heap[i] = Key;
+
+   return true;
+
+} /* End SC_SIM_MERGE_Add() */
+
+
+/******************************************************************************
+** Function: SC_SIM_MERGE_Top
+**
+*/
+const SC_SIM_MERGE_Key_t *SC_SIM_MERGE_Top(const SC_SIM_MERGE_Class_t *Merge)
+{
+
+   return (Merge->KeyCnt > 0) ? &Merge->Heap[0] : NULL;
+
+} /* End SC_SIM_MERGE_Top() */
+
+
+/******************************************************************************
+** Function: SC_SIM_MERGE_Replace
+**
+*/
+void SC_SIM_MERGE_Replace(SC_SIM_MERGE_Class_t *Merge, int32 Time)
+{
+
+   if (Merge->KeyCnt == 0) return;
+
+   Merge->PopCnt++;
+   Merge->Heap[0].Time = Time;
+   SiftDown(Merge, 0);
+
+} /* End SC_SIM_MERGE_Replace() */
+
+
+/******************************************************************************
+** Function: SC_SIM_MERGE_Remove
+**
+*/
+void SC_SIM_MERGE_Remove(SC_SIM_MERGE_Class_t *Merge)
+{
+
+   if (Merge->KeyCnt == 0) return;
+
+   Merge->PopCnt++;
+   Merge->Heap[0] = Merge->Heap[--Merge->KeyCnt];
+   SiftDown(Merge, 0);
+
+} /* End SC_SIM_MERGE_Remove() */
+
+
+/******************************************************************************
+** Function: Before
+**
+** Order keys by time and then by stream.
+**
+*/
+static bool Before(const SC_SIM_MERGE_Key_t *A, const SC_SIM_MERGE_Key_t *B)
+{
+
+   return (A->Time < B->Time) || (A->Time == B->Time && A->Stream < B->Stream);
+
+} /* End Before() */
+
+
+/******************************************************************************
+** Function: SiftDown
+**
+** Move the key at i down until neither child comes before it.
+**
+*/
+static void SiftDown(SC_SIM_MERGE_Class_t *Merge, uint16 i)
+{
+
+   SC_SIM_MERGE_Key_t Key = Merge->Heap[i];
+   uint16 Child;
+
+   while ((Child = 2*i + 1) < Merge->KeyCnt)
+   {
+      if (Child+1 < Merge->KeyCnt && Before(&Merge->Heap[Child+1], &Merge->Heap[Child])) Child++;
+      if (!Before(&Merge->Heap[Child], &Key)) break;
+      Merge->Heap[i] = Merge->Heap[Child];
+      i = Child;
+   }
+   Merge->Heap[i] = Key;
+
+} /* End SiftDown() */
@@ -0,0 +1,125 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Define the event stream merge
+**
+** Notes:
+**   1. Overlay scripts are time sorted event cmd streams that are merged
+**      with a scenario as the sim runs rather than copied into it. The
+**      merge keeps one key per stream, the time of the stream's next
+**      cmd, in a binary min-heap so the next cmd of k streams is found
+**      in O(1) and a stream is advanced in O(log k). A stream takes no
+**      event cmd entries however long it is.
+**   2. Keys with equal times are ordered by stream number so streams
+**      are merged in a repeatable order.
+**   3. The merge only knows stream numbers and times. The owner keeps
+**      each stream's cmds and position and replaces the top key when it
+**      advances the top stream.
+**
+*/
+
+#ifndef _sc_sim_merge_
+#define _sc_sim_merge_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SC_SIM_MERGE_MAX  16
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+
+   int32   Time;       /* Time of the stream's next cmd */
+   uint16  Stream;
+
+} SC_SIM_MERGE_Key_t;
+
+typedef struct
+{
+
+   uint16  KeyCnt;     /* Streams with cmds remaining */
+   uint32  PopCnt;     /* Cmds taken from the streams */
+   
+   SC_SIM_MERGE_Key_t Heap[SC_SIM_MERGE_MAX];
+
+} SC_SIM_MERGE_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SC_SIM_MERGE_Reset
+**
+** Remove all streams.
+**
+*/
+void SC_SIM_MERGE_Reset(SC_SIM_MERGE_Class_t *Merge);
+
+
+/******************************************************************************
+** Function: SC_SIM_MERGE_Add
+**
+** Add a stream whose next cmd is at Time. Return false if the merge is
+** full.
+**
+*/
+bool SC_SIM_MERGE_Add(SC_SIM_MERGE_Class_t *Merge, uint16 Stream, int32 Time);
+
+
+/******************************************************************************
+** Function: SC_SIM_MERGE_Top
+**
+** Return the key of the stream with the earliest next cmd, NULL when no
+** streams remain.
+**
+*/
+const SC_SIM_MERGE_Key_t *SC_SIM_MERGE_Top(const SC_SIM_MERGE_Class_t *Merge);
+
+
+/******************************************************************************
+** Function: SC_SIM_MERGE_Replace
+**
+** Set the top stream's next cmd time after its cmd was taken.
+**
+*/
+void SC_SIM_MERGE_Replace(SC_SIM_MERGE_Class_t *Merge, int32 Time);
+
+
+/******************************************************************************
+** Function: SC_SIM_MERGE_Remove
+**
+** Remove the top stream after its last cmd was taken.
+**
+*/
+void SC_SIM_MERGE_Remove(SC_SIM_MERGE_Class_t *Merge);
+
+
+#endif /* _sc_sim_merge_ */
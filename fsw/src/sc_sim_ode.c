@@ -0,0 +1,654 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Implement the integrator service for continuous model states
+**
+** Notes:
+**   1. Dormand-Prince coefficients and the continuous extension follow
+**      Hairer, Norsett & Wanner's DOPRI5. The Rosenbrock solution is
+**      interpolated with a cubic Hermite polynomial between the ends of
+**      the step which is more accurate than the 2nd order method.
+**   2. ROS2 (gamma = 1 + 1/sqrt(2)) is 2nd order for any Jacobian
+**      approximation so one linearization is reused until a step is
+**      rejected and the iteration matrix is only refactored when the
+**      step size changes.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "sc_sim_ode.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define ROS2_GAMMA  (1.0 + 1.0/M_SQRT2)
+#define SQRT_EPS    (1.4901161193847656e-8)
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+/* Dormand-Prince 5(4) tableau */
+
+static const double DpC[7] = { 0.0, 1.0/5.0, 3.0/10.0, 4.0/5.0, 8.0/9.0, 1.0, 1.0 };
+
+static const double DpA[7][6] =
+{
+   { 0.0 },
+   { 1.0/5.0 },
+   { 3.0/40.0, 9.0/40.0 },
+   { 44.0/45.0, -56.0/15.0, 32.0/9.0 },
+   { 19372.0/6561.0, -25360.0/2187.0, 64448.0/6561.0, -212.0/729.0 },
+   { 9017.0/3168.0, -355.0/33.0, 46732.0/5247.0, 49.0/176.0, -5103.0/18656.0 },
+   { 35.0/384.0, 0.0, 500.0/1113.0, 125.0/192.0, -2187.0/6784.0, 11.0/84.0 }
+};
+
+static const double DpE[7] = { 71.0/57600.0, 0.0, -71.0/16695.0, 71.0/1920.0,
+                               -17253.0/339200.0, 22.0/525.0, -1.0/40.0 };
+
+static const double DpD[7] = { -12715105075.0/11282082432.0, 0.0, 87487479700.0/32700410799.0,
+                               -10690763975.0/1880347072.0, 701980252875.0/199316789632.0,
+                               -1453857185.0/822651844.0, 69997945.0/29380423.0 };
+
+/* Benchmark copy, too large for a command handler's stack */
+
+static SC_SIM_ODE_Class_t BenchOde;
+static double BenchState[SC_SIM_ODE_MAX_STATES];
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void   ContinuousOutput(const SC_SIM_ODE_Class_t *Ode, double Time, double *Y);
+static double DopriStep(SC_SIM_ODE_Class_t *Ode, double H);
+static bool   Factor(SC_SIM_ODE_Class_t *Ode, double H);
+static void   InitialStep(SC_SIM_ODE_Class_t *Ode);
+static void   Jacobian(SC_SIM_ODE_Class_t *Ode);
+static double Ros2Step(SC_SIM_ODE_Class_t *Ode, double H);
+static double ScaledNorm(const SC_SIM_ODE_Class_t *Ode, const double *V, const double *Ya, const double *Yb);
+static void   Solve(const SC_SIM_ODE_Class_t *Ode, double *B);
+static void   TakeStep(SC_SIM_ODE_Class_t *Ode, double FixedH);
+
+
+/******************************************************************************
+** Function: SC_SIM_ODE_Register
+**
+*/
+bool SC_SIM_ODE_Register(SC_SIM_ODE_Class_t *Ode, const char *Name, SC_SIM_ODE_Method_t Method,
+                         double *State, uint16 StateCnt, SC_SIM_ODE_DerivFunc_t Deriv, void *Model)
+{
+
+   memset(Ode, 0, sizeof(SC_SIM_ODE_Class_t));
+
+   if (StateCnt == 0 || StateCnt > SC_SIM_ODE_MAX_STATES)
+   {
+      CFE_EVS_SendEvent(SC_SIM_ODE_REGISTER_EID, CFE_EVS_EventType_ERROR,
+                        "%s integrator rejected: %d states, limit is %d",
+                        Name, StateCnt, SC_SIM_ODE_MAX_STATES);
+      return false;
+   }
+
+   Ode->Name     = Name;
+   Ode->Method   = Method;
+   Ode->StateCnt = StateCnt;
+   Ode->State    = State;
+   Ode->Deriv    = Deriv;
+   Ode->Model    = Model;
+
+   Ode->RelTol  = 1.0e-6;
+   Ode->AbsTol  = 1.0e-6;
+   Ode->MaxStep = 60.0;
+
+   return true;
+
+} /* End SC_SIM_ODE_Register() */
+
+
+/******************************************************************************
+** Function: SC_SIM_ODE_Config
+**
+*/
+void SC_SIM_ODE_Config(SC_SIM_ODE_Class_t *Ode, double RelTol, double AbsTol, double MaxStep)
+{
+
+   if (RelTol > 0.0) Ode->RelTol = RelTol;
+   if (AbsTol > 0.0) Ode->AbsTol = AbsTol;
+   Ode->MaxStep = (MaxStep > SC_SIM_ODE_MIN_STEP) ? MaxStep : SC_SIM_ODE_MIN_STEP;
+
+} /* End SC_SIM_ODE_Config() */
+
+
+/******************************************************************************
+** Function: SC_SIM_ODE_Restart
+**
+*/
+void SC_SIM_ODE_Restart(SC_SIM_ODE_Class_t *Ode, double Time)
+{
+
+   if (Ode->StateCnt == 0) return;
+
+   Ode->T0 = Time;
+   Ode->H  = 0.0;
+   memcpy(Ode->Y1, Ode->State, Ode->StateCnt*sizeof(double));
+
+   (Ode->Deriv)(Ode->Model, Time, Ode->Y1, Ode->K[6]);
+   Ode->DerivCnt++;
+
+   Ode->JacValid = false;
+   Ode->RestartCnt++;
+
+   if (Ode->NextH <= 0.0) InitialStep(Ode);
+
+} /* End SC_SIM_ODE_Restart() */
+
+
+/******************************************************************************
+** Function: SC_SIM_ODE_Advance
+**
+*/
+uint32 SC_SIM_ODE_Advance(SC_SIM_ODE_Class_t *Ode, double Time)
+{
+
+   uint32 StepCnt = 0;
+
+   if (Ode->StateCnt == 0) return 0;
+
+   while ((Ode->T0 + Ode->H) < Time)
+   {
+      TakeStep(Ode, 0.0);
+      StepCnt++;
+   }
+
+   ContinuousOutput(Ode, Time, Ode->State);
+
+   return StepCnt;
+
+} /* End SC_SIM_ODE_Advance() */
+
+
+/******************************************************************************
+** Function: SC_SIM_ODE_Drifted
+**
+*/
+bool SC_SIM_ODE_Drifted(const double *Held, const double *Value, uint16 Cnt, double Tol)
+{
+
+   double Diff = 0.0;
+   double Mag  = 0.0;
+   uint16 i;
+
+   for (i=0; i < Cnt; i++)
+   {
+      Diff += fabs(Value[i] - Held[i]);
+      Mag  += (fabs(Value[i]) > fabs(Held[i])) ? fabs(Value[i]) : fabs(Held[i]);
+   }
+
+   return (Diff > Tol*Mag);
+
+} /* End SC_SIM_ODE_Drifted() */
+
+
+/******************************************************************************
+** Function: SC_SIM_ODE_Benchmark
+**
+*/
+void SC_SIM_ODE_Benchmark(const SC_SIM_ODE_Class_t *Ode, const double *State, double Span,
+                          double FixedDt, SC_SIM_ODE_Bench_t *Bench)
+{
+
+   double    FixedY[SC_SIM_ODE_MAX_STATES];
+   double    Diff;
+   OS_time_t Start, End;
+   uint16    i;
+
+   memset(Bench, 0, sizeof(SC_SIM_ODE_Bench_t));
+   if (Ode->StateCnt == 0 || Span <= 0.0 || FixedDt <= 0.0) return;
+
+   /* Fixed steps */
+
+   BenchOde = *Ode;
+   BenchOde.State = BenchState;
+   BenchOde.NextH = 0.0;
+   BenchOde.StepCnt = BenchOde.RejectCnt = BenchOde.DerivCnt = 0;
+   memcpy(BenchState, State, Ode->StateCnt*sizeof(double));
+
+   OS_GetLocalTime(&Start);
+   SC_SIM_ODE_Restart(&BenchOde, 0.0);
+   while ((BenchOde.T0 + BenchOde.H) < Span)
+   {
+      Diff = Span - (BenchOde.T0 + BenchOde.H);
+      TakeStep(&BenchOde, (Diff < FixedDt) ? Diff : FixedDt);
+   }
+   OS_GetLocalTime(&End);
+
+   memcpy(FixedY, BenchOde.Y1, Ode->StateCnt*sizeof(double));
+   Bench->FixedSteps  = BenchOde.StepCnt;
+   Bench->FixedDerivs = BenchOde.DerivCnt;
+   Bench->FixedUsec   = (double)OS_TimeGetTotalMicroseconds(OS_TimeSubtract(End, Start));
+
+   /* Error controlled steps */
+
+   BenchOde = *Ode;
+   BenchOde.State = BenchState;
+   BenchOde.NextH = 0.0;
+   BenchOde.StepCnt = BenchOde.RejectCnt = BenchOde.DerivCnt = 0;
+   memcpy(BenchState, State, Ode->StateCnt*sizeof(double));
+
+   OS_GetLocalTime(&Start);
+   SC_SIM_ODE_Restart(&BenchOde, 0.0);
+   SC_SIM_ODE_Advance(&BenchOde, Span);
+   OS_GetLocalTime(&End);
+
+   Bench->AdaptSteps   = BenchOde.StepCnt;
+   Bench->AdaptRejects = BenchOde.RejectCnt;
+   Bench->AdaptDerivs  = BenchOde.DerivCnt;
+   Bench->AdaptUsec    = (double)OS_TimeGetTotalMicroseconds(OS_TimeSubtract(End, Start));
+
+   for (i=0; i < Ode->StateCnt; i++)
+   {
+      Diff = fabs(BenchState[i] - FixedY[i]);
+      if (Diff > Bench->MaxDiff) Bench->MaxDiff = Diff;
+   }
+
+} /* End SC_SIM_ODE_Benchmark() */
+
+
+/******************************************************************************
+** Function: ContinuousOutput
+**
+** Interpolate the last accepted step at Time.
+**
+*/
+static void ContinuousOutput(const SC_SIM_ODE_Class_t *Ode, double Time, double *Y)
+{
+
+   double S, S1, YDiff, BSpl, R4, R5;
+   uint16 i;
+
+   if (Ode->H <= 0.0)
+   {
+      memcpy(Y, Ode->Y1, Ode->StateCnt*sizeof(double));
+      return;
+   }
+
+   S = (Time - Ode->T0)/Ode->H;
+   if (S < 0.0) S = 0.0;
+   if (S > 1.0) S = 1.0;
+   S1 = 1.0 - S;
+
+   for (i=0; i < Ode->StateCnt; i++)
+   {
+
+      if (Ode->Method == SC_SIM_ODE_ROS2)
+      {
+         Y[i] = (1.0 + 2.0*S)*S1*S1*Ode->Y0[i] + S*S1*S1*Ode->H*Ode->K[0][i] +
+                S*S*(3.0 - 2.0*S)*Ode->Y1[i] - S*S*S1*Ode->H*Ode->K[6][i];
+      }
+      else
+      {
+         YDiff = Ode->Y1[i] - Ode->Y0[i];
+         BSpl  = Ode->H*Ode->K[0][i] - YDiff;
+         R4    = YDiff - Ode->H*Ode->K[6][i] - BSpl;
+         R5    = Ode->H*(DpD[0]*Ode->K[0][i] + DpD[2]*Ode->K[2][i] + DpD[3]*Ode->K[3][i] +
+                         DpD[4]*Ode->K[4][i] + DpD[5]*Ode->K[5][i] + DpD[6]*Ode->K[6][i]);
+
+         Y[i] = Ode->Y0[i] + S*(YDiff + S1*(BSpl + S*(R4 + S1*R5)));
+      }
+
+   } /* End state loop */
+
+} /* End ContinuousOutput() */
+
+
+/******************************************************************************
+** Function: DopriStep
+**
+** Attempt a Dormand-Prince step of H from Y0 and return the scaled error.
+** The last stage is evaluated at the 5th order solution so K[6] is the
+** derivative at Y1.
+**
+*/
+static double DopriStep(SC_SIM_ODE_Class_t *Ode, double H)
+{
+
+   double YStage[SC_SIM_ODE_MAX_STATES];
+   double Err[SC_SIM_ODE_MAX_STATES];
+   uint16 Stage, i, j;
+
+   for (Stage=1; Stage < 7; Stage++)
+   {
+      for (i=0; i < Ode->StateCnt; i++)
+      {
+         YStage[i] = Ode->Y0[i];
+         for (j=0; j < Stage; j++) YStage[i] += H*DpA[Stage][j]*Ode->K[j][i];
+      }
+      (Ode->Deriv)(Ode->Model, Ode->T0 + DpC[Stage]*H, YStage, Ode->K[Stage]);
+   }
+   Ode->DerivCnt += 6;
+   memcpy(Ode->Y1, YStage, Ode->StateCnt*sizeof(double));
+
+   for (i=0; i < Ode->StateCnt; i++)
+   {
+      Err[i] = 0.0;
+      for (j=0; j < 7; j++) Err[i] += DpE[j]*Ode->K[j][i];
+      Err[i] *= H;
+   }
+
+   return ScaledNorm(Ode, Err, Ode->Y0, Ode->Y1);
+
+} /* End DopriStep() */
+
+
+/******************************************************************************
+** Function: Factor
+**
+** LU factor I - gamma*H*Jac with partial pivoting.
+**
+*/
+static bool Factor(SC_SIM_ODE_Class_t *Ode, double H)
+{
+
+   uint16 N = Ode->StateCnt;
+   double *A = Ode->Lu;
+   double Max, Tmp, Mult;
+   uint16 i, j, k, P;
+
+   for (i=0; i < N*N; i++) A[i] = -ROS2_GAMMA*H*Ode->Jac[i];
+   for (i=0; i < N; i++) A[i*N+i] += 1.0;
+
+   for (k=0; k < N; k++)
+   {
+
+      P = k;
+      Max = fabs(A[k*N+k]);
+      for (i=k+1; i < N; i++)
+      {
+         if (fabs(A[i*N+k]) > Max)
+         {
+            Max = fabs(A[i*N+k]);
+            P = i;
+         }
+      }
+
+      if (Max == 0.0)
+      {
+         CFE_EVS_SendEvent(SC_SIM_ODE_SINGULAR_EID, CFE_EVS_EventType_ERROR,
+                           "%s integrator iteration matrix is singular for a %.3f second step",
+                           Ode->Name, H);
+         Ode->LuH = 0.0;
+         return false;
+      }
+
+      Ode->Pivot[k] = P;
+      if (P != k)
+      {
+         for (j=0; j < N; j++)
+         {
+            Tmp = A[k*N+j];
+            A[k*N+j] = A[P*N+j];
+            A[P*N+j] = Tmp;
+         }
+      }
+
+      for (i=k+1; i < N; i++)
+      {
+         Mult = A[i*N+k]/A[k*N+k];
+         A[i*N+k] = Mult;
+         for (j=k+1; j < N; j++) A[i*N+j] -= Mult*A[k*N+j];
+      }
+
+   } /* End column loop */
+
+   Ode->LuH = H;
+
+   return true;
+
+} /* End Factor() */
+
+
+/******************************************************************************
+** Function: InitialStep
+**
+** Trial step that changes the state by about 1% of its tolerance scaled
+** magnitude.
+**
+*/
+static void InitialStep(SC_SIM_ODE_Class_t *Ode)
+{
+
+   double D0 = ScaledNorm(Ode, Ode->Y1, Ode->Y1, Ode->Y1);
+   double D1 = ScaledNorm(Ode, Ode->K[6], Ode->Y1, Ode->Y1);
+
+   Ode->NextH = (D0 < 1.0e-5 || D1 < 1.0e-5) ? SC_SIM_ODE_MIN_STEP : 0.01*D0/D1;
+
+   if (Ode->NextH > Ode->MaxStep)         Ode->NextH = Ode->MaxStep;
+   if (Ode->NextH < SC_SIM_ODE_MIN_STEP)  Ode->NextH = SC_SIM_ODE_MIN_STEP;
+
+} /* End InitialStep() */
+
+
+/******************************************************************************
+** Function: Jacobian
+**
+** Forward difference Jacobian at Y0. Invalidates the factored matrix.
+**
+*/
+static void Jacobian(SC_SIM_ODE_Class_t *Ode)
+{
+
+   uint16 N = Ode->StateCnt;
+   double Yp[SC_SIM_ODE_MAX_STATES];
+   double Fp[SC_SIM_ODE_MAX_STATES];
+   double Del;
+   uint16 i, j;
+
+   memcpy(Yp, Ode->Y0, N*sizeof(double));
+
+   for (j=0; j < N; j++)
+   {
+      Del = SQRT_EPS*((fabs(Ode->Y0[j]) > 1.0) ? fabs(Ode->Y0[j]) : 1.0);
+      Yp[j] = Ode->Y0[j] + Del;
+      (Ode->Deriv)(Ode->Model, Ode->T0, Yp, Fp);
+      for (i=0; i < N; i++) Ode->Jac[i*N+j] = (Fp[i] - Ode->K[0][i])/Del;
+      Yp[j] = Ode->Y0[j];
+   }
+
+   Ode->DerivCnt += N;
+   Ode->JacCnt++;
+   Ode->JacValid = true;
+   Ode->LuH = 0.0;
+
+} /* End Jacobian() */
+
+
+/******************************************************************************
+** Function: Ros2Step
+**
+** Attempt a ROS2 step of H from Y0 and return the scaled error.
+**
+** Notes:
+**   1. With W = I - gamma*H*J
+**         W k1 = f(y0)
+**         W k2 = f(y0 + H k1) - 2 k1
+**         y1   = y0 + 3/2 H k1 + 1/2 H k2
+**      and the error is y1 less the linearly implicit Euler solution
+**      y0 + H k1.
+**
+*/
+static double Ros2Step(SC_SIM_ODE_Class_t *Ode, double H)
+{
+
+   double *K1 = Ode->K[1];
+   double *K2 = Ode->K[2];
+   double *YStage = Ode->K[3];
+   double Err[SC_SIM_ODE_MAX_STATES];
+   uint16 i;
+
+   if (!Ode->JacValid) Jacobian(Ode);
+   if (H != Ode->LuH)
+   {
+      if (!Factor(Ode, H)) return 1.0e6;
+   }
+
+   memcpy(K1, Ode->K[0], Ode->StateCnt*sizeof(double));
+   Solve(Ode, K1);
+
+   for (i=0; i < Ode->StateCnt; i++) YStage[i] = Ode->Y0[i] + H*K1[i];
+   (Ode->Deriv)(Ode->Model, Ode->T0 + H, YStage, K2);
+   Ode->DerivCnt++;
+
+   for (i=0; i < Ode->StateCnt; i++) K2[i] -= 2.0*K1[i];
+   Solve(Ode, K2);
+
+   for (i=0; i < Ode->StateCnt; i++)
+   {
+      Ode->Y1[i] = Ode->Y0[i] + 1.5*H*K1[i] + 0.5*H*K2[i];
+      Err[i] = 0.5*H*(K1[i] + K2[i]);
+   }
+
+   return ScaledNorm(Ode, Err, Ode->Y0, Ode->Y1);
+
+} /* End Ros2Step() */
+
+
+/******************************************************************************
+** Function: ScaledNorm
+**
+** RMS of V scaled by AbsTol + RelTol*max(|Ya|,|Yb|).
+**
+*/
+static double ScaledNorm(const SC_SIM_ODE_Class_t *Ode, const double *V, const double *Ya, const double *Yb)
+{
+
+   double Sum = 0.0;
+   double Sc, Q;
+   uint16 i;
+
+   for (i=0; i < Ode->StateCnt; i++)
+   {
+      Sc  = Ode->AbsTol + Ode->RelTol*((fabs(Ya[i]) > fabs(Yb[i])) ? fabs(Ya[i]) : fabs(Yb[i]));
+      Q   = V[i]/Sc;
+      Sum += Q*Q;
+   }
+
+   return sqrt(Sum/Ode->StateCnt);
+
+} /* End ScaledNorm() */
+
+
+/******************************************************************************
+** Function: Solve
+**
+** Solve (I - gamma*H*Jac) X = B in place with the factored matrix.
+**
+*/
+static void Solve(const SC_SIM_ODE_Class_t *Ode, double *B)
+{
+
+   uint16 N = Ode->StateCnt;
+   const double *A = Ode->Lu;
+   double Tmp;
+   uint16 i, k;
+
+   for (k=0; k < N; k++)
+   {
+      if (Ode->Pivot[k] != k)
+      {
+         Tmp = B[k];
+         B[k] = B[Ode->Pivot[k]];
+         B[Ode->Pivot[k]] = Tmp;
+      }
+      for (i=k+1; i < N; i++) B[i] -= A[i*N+k]*B[k];
+   }
+
+   for (i=N; i-- > 0; )
+   {
+      for (k=i+1; k < N; k++) B[i] -= A[i*N+k]*B[k];
+      B[i] /= A[i*N+i];
+   }
+
+} /* End Solve() */
+
+
+/******************************************************************************
+** Function: TakeStep
+**
+** Take one accepted step from the end of the previous step. Error
+** controlled steps shrink and retry when rejected, a FixedH greater than
+** zero is taken without control.
+**
+*/
+static void TakeStep(SC_SIM_ODE_Class_t *Ode, double FixedH)
+{
+
+   double H, Err, Fac, Expo;
+   bool   Accepted = false;
+
+   Ode->T0 += Ode->H;
+   Ode->H   = 0.0;
+   memcpy(Ode->Y0, Ode->Y1, Ode->StateCnt*sizeof(double));
+   memcpy(Ode->K[0], Ode->K[6], Ode->StateCnt*sizeof(double));   /* FSAL */
+
+   Expo = (Ode->Method == SC_SIM_ODE_ROS2) ? -0.5 : -0.2;
+   if (FixedH > 0.0)
+   {
+      H = FixedH;
+   }
+   else
+   {
+      H = (Ode->NextH < Ode->MaxStep) ? Ode->NextH : Ode->MaxStep;
+   }
+
+   while (!Accepted)
+   {
+
+      Err = (Ode->Method == SC_SIM_ODE_ROS2) ? Ros2Step(Ode, H) : DopriStep(Ode, H);
+
+      Fac = (Err > 0.0) ? 0.9*pow(Err, Expo) : 5.0;
+      if (Fac > 5.0) Fac = 5.0;
+      if (Fac < 0.2) Fac = 0.2;
+
+      if (FixedH > 0.0 || Err <= 1.0 || H <= SC_SIM_ODE_MIN_STEP)
+      {
+         Accepted = true;
+         Ode->H = H;
+         if (FixedH <= 0.0) Ode->NextH = H*Fac;
+         Ode->StepCnt++;
+         if (Ode->Method == SC_SIM_ODE_ROS2)
+         {
+            (Ode->Deriv)(Ode->Model, Ode->T0 + H, Ode->Y1, Ode->K[6]);
+            Ode->DerivCnt++;
+         }
+      }
+      else
+      {
+         H *= Fac;
+         if (H < SC_SIM_ODE_MIN_STEP) H = SC_SIM_ODE_MIN_STEP;
+         Ode->RejectCnt++;
+         Ode->JacValid = false;   /* Relinearize at Y0 before retrying */
+      }
+
+   } /* End while not accepted */
+
+} /* End TakeStep() */
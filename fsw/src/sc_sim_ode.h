@@ -0,0 +1,228 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Define the integrator service for continuous model states
+**
+** Notes:
+**   1. A model registers a state vector and a derivative function with an
+**      integrator object and advances it to each execution time. Steps
+**      are error controlled and independent of the execution times: the
+**      integrator steps past the requested time and answers from the
+**      step's continuous extension so executions between steps are free.
+**   2. Inputs are held constant by the derivative function between
+**      restarts. When an input changes discretely or the model sets its
+**      state the model restarts the integrator at the execution time so
+**      the solution lands exactly on the event and no step straddles it.
+**   3. SC_SIM_ODE_DOPRI45 is the explicit Dormand-Prince 5(4) pair used
+**      by the orbit propagator and the battery. SC_SIM_ODE_ROS2 is the linearly implicit
+**      2nd order Rosenbrock W-method of Verwer, Spee, Blom & Hundsdorfer
+**      with a 1st order embedded estimate for stiff systems such as
+**      thermal networks. Its Jacobian is evaluated by differences at a
+**      restart and after a rejected step.
+**
+*/
+
+#ifndef _sc_sim_ode_
+#define _sc_sim_ode_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SC_SIM_ODE_MAX_STATES  (8)      /* Dense Jacobian, kept small since orbits are copied for predictions */
+#define SC_SIM_ODE_MIN_STEP    (1.0e-3) /* Step floor, seconds */
+
+/*
+** Event Message IDs
+*/
+
+#define SC_SIM_ODE_REGISTER_EID  (SC_SIM_ODE_BASE_EID + 0)
+#define SC_SIM_ODE_SINGULAR_EID  (SC_SIM_ODE_BASE_EID + 1)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+
+   SC_SIM_ODE_DOPRI45 = 0,
+   SC_SIM_ODE_ROS2    = 1
+
+} SC_SIM_ODE_Method_t;
+
+
+/*
+** Derivative of state Y at Time using the model's held inputs
+*/
+typedef void (*SC_SIM_ODE_DerivFunc_t)(void *Model, double Time, const double *Y, double *Dy);
+
+
+typedef struct
+{
+
+   /* Registration */
+
+   const char *Name;
+   SC_SIM_ODE_Method_t    Method;
+   uint16                 StateCnt;   /* 0 if not registered */
+   double                *State;      /* Model's state, written by SC_SIM_ODE_Advance() */
+   SC_SIM_ODE_DerivFunc_t Deriv;
+   void                  *Model;
+
+   /* Configuration */
+
+   double  RelTol;
+   double  AbsTol;
+   double  MaxStep;   /* Seconds */
+
+   /* Last accepted step [T0, T0+H] */
+
+   double  T0;
+   double  H;
+   double  NextH;
+   double  Y0[SC_SIM_ODE_MAX_STATES];
+   double  Y1[SC_SIM_ODE_MAX_STATES];
+   double  K[7][SC_SIM_ODE_MAX_STATES];   /* Stage derivatives, K[0] at Y0 and K[6] at Y1 */
+
+   /* Implicit method */
+
+   double  Jac[SC_SIM_ODE_MAX_STATES*SC_SIM_ODE_MAX_STATES];
+   double  Lu[SC_SIM_ODE_MAX_STATES*SC_SIM_ODE_MAX_STATES];   /* Factored I - gamma*H*Jac */
+   uint16  Pivot[SC_SIM_ODE_MAX_STATES];
+   bool    JacValid;
+   double  LuH;       /* Step Lu was factored for, 0 if none */
+
+   /* Statistics */
+
+   uint32  StepCnt;
+   uint32  RejectCnt;
+   uint32  DerivCnt;
+   uint32  JacCnt;
+   uint32  RestartCnt;
+
+} SC_SIM_ODE_Class_t;
+
+
+/*
+** Result of integrating a span both ways
+*/
+typedef struct
+{
+
+   uint32  FixedSteps;
+   uint32  FixedDerivs;
+   double  FixedUsec;      /* Wall time */
+   uint32  AdaptSteps;
+   uint32  AdaptRejects;
+   uint32  AdaptDerivs;
+   double  AdaptUsec;
+   double  MaxDiff;        /* Largest state difference at the end of the span */
+
+} SC_SIM_ODE_Bench_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SC_SIM_ODE_Register
+**
+** Register a model's continuous state with an integrator.
+**
+** Notes:
+**   1. State and Model must remain valid while registered. The integrator
+**      is inactive until the first SC_SIM_ODE_Restart().
+**   2. Returns false if StateCnt is 0 or exceeds SC_SIM_ODE_MAX_STATES.
+**
+*/
+bool SC_SIM_ODE_Register(SC_SIM_ODE_Class_t *Ode, const char *Name, SC_SIM_ODE_Method_t Method,
+                         double *State, uint16 StateCnt, SC_SIM_ODE_DerivFunc_t Deriv, void *Model);
+
+
+/******************************************************************************
+** Function: SC_SIM_ODE_Config
+**
+** Set the error tolerances and the largest step.
+**
+** Notes:
+**   1. The error of each state is scaled by AbsTol + RelTol*|y|.
+**
+*/
+void SC_SIM_ODE_Config(SC_SIM_ODE_Class_t *Ode, double RelTol, double AbsTol, double MaxStep);
+
+
+/******************************************************************************
+** Function: SC_SIM_ODE_Restart
+**
+** Start a new solution from the model's state at Time.
+**
+** Notes:
+**   1. Call after the model's inputs changed discretely or it set its
+**      state. The step size of the previous solution is kept as the
+**      first trial step.
+**
+*/
+void SC_SIM_ODE_Restart(SC_SIM_ODE_Class_t *Ode, double Time);
+
+
+/******************************************************************************
+** Function: SC_SIM_ODE_Advance
+**
+** Integrate until the last accepted step spans Time and write the
+** solution at Time to the model's state. Returns the number of steps taken.
+**
+*/
+uint32 SC_SIM_ODE_Advance(SC_SIM_ODE_Class_t *Ode, double Time);
+
+
+/******************************************************************************
+** Function: SC_SIM_ODE_Drifted
+**
+** Return true if inputs Value have moved from the values Held at the last
+** restart by more than Tol relative to their magnitude (L1 norms).
+**
+*/
+bool SC_SIM_ODE_Drifted(const double *Held, const double *Value, uint16 Cnt, double Tol);
+
+
+/******************************************************************************
+** Function: SC_SIM_ODE_Benchmark
+**
+** Integrate the registered system over Span seconds from State with
+** fixed FixedDt steps and with error controlled steps and report the
+** cost of each.
+**
+** Notes:
+**   1. Runs on a copy with the model's current inputs held so neither the
+**      model nor the integrator is changed. State holds the registered
+**      number of states and is only read, a model whose registered state
+**      is only current while integrating passes a copy of its state.
+**
+*/
+void SC_SIM_ODE_Benchmark(const SC_SIM_ODE_Class_t *Ode, const double *State, double Span,
+                          double FixedDt, SC_SIM_ODE_Bench_t *Bench);
+
+
+#endif /* _sc_sim_ode_ */
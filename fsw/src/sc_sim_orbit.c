@@ -0,0 +1,463 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Implement the orbit propagator used by the ADCS model
+**
+** Notes:
+**   1. The numerical propagator integrates with the integrator service's
+**      Dormand-Prince 5(4) pair, see sc_sim_ode.h.
+**   2. Zonal gravity terms and the exponential atmosphere table follow
+**      Vallado, Fundamentals of Astrodynamics and Applications.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "sc_sim_orbit.h"
+#include "sc_sim_ephem.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define DEG2RAD  (M_PI/180.0)
+
+#define J2  ( 1.08262668e-3)
+#define J3  (-2.53265649e-6)
+#define J4  (-1.61962159e-6)
+
+#define SRP_AT_1AU  (4.56e-6)   /* N/m^2 */
+
+#define DECAY_ALT_KM  (100.0)
+
+#define INTEG_ABS_TOL  (1.0e-9)   /* Km and km/s */
+
+#define ATM_LAYER_CNT (sizeof(AtmLayer)/sizeof(AtmLayer_t))
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   double  BaseAlt;   /* km */
+   double  BaseRho;   /* kg/m^3 */
+   double  ScaleHt;   /* km */
+
+} AtmLayer_t;
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static const AtmLayer_t AtmLayer[] =
+{
+
+   {    0.0, 1.225,     7.249 }, {   25.0, 3.899e-2,  6.349 }, {   30.0, 1.774e-2,  6.682 },
+   {   40.0, 3.972e-3,  7.554 }, {   50.0, 1.057e-3,  8.382 }, {   60.0, 3.206e-4,  7.714 },
+   {   70.0, 8.770e-5,  6.549 }, {   80.0, 1.905e-5,  5.799 }, {   90.0, 3.396e-6,  5.382 },
+   {  100.0, 5.297e-7,  5.877 }, {  110.0, 9.661e-8,  7.263 }, {  120.0, 2.438e-8,  9.473 },
+   {  130.0, 8.484e-9, 12.636 }, {  140.0, 3.845e-9, 16.149 }, {  150.0, 2.070e-9, 22.523 },
+   {  180.0, 5.464e-10,29.740 }, {  200.0, 2.789e-10,37.105 }, {  250.0, 7.248e-11,45.546 },
+   {  300.0, 2.418e-11,53.628 }, {  350.0, 9.518e-12,53.298 }, {  400.0, 3.725e-12,58.515 },
+   {  450.0, 1.585e-12,60.828 }, {  500.0, 6.967e-13,63.822 }, {  600.0, 1.454e-13,71.835 },
+   {  700.0, 3.614e-14,88.667 }, {  800.0, 1.170e-14,124.64 }, {  900.0, 5.245e-15,181.05 },
+   { 1000.0, 3.019e-15,268.00 }
+
+};
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static double AtmDensity(double AltKm);
+static void   Derivatives(void *Model, double Time, const double *Y, double *Dy);
+static void   ElementsToEci(const SC_SIM_ORBIT_Class_t *Orbit, double Time, double Pos[3], double Vel[3]);
+static void   PropagateAnalytic(SC_SIM_ORBIT_Class_t *Orbit, double Time);
+static void   PropagateNumerical(SC_SIM_ORBIT_Class_t *Orbit, double Time);
+
+
+/******************************************************************************
+** Function: SC_SIM_ORBIT_Constructor
+**
+*/
+void SC_SIM_ORBIT_Constructor(SC_SIM_ORBIT_Class_t *Orbit)
+{
+
+   CFE_PSP_MemSet((void*)Orbit, 0, sizeof(SC_SIM_ORBIT_Class_t));
+
+   Orbit->PropCfg = SC_SIM_ORBIT_PROP_ANALYTIC;
+   Orbit->Prop    = SC_SIM_ORBIT_PROP_ANALYTIC;
+   Orbit->MaxStep = 60.0;
+   Orbit->RelTol  = 1.0e-9;
+
+   SC_SIM_ODE_Register(&Orbit->Ode, "Orbit", SC_SIM_ODE_DOPRI45, Orbit->State, 6, Derivatives, Orbit);
+   SC_SIM_ODE_Config(&Orbit->Ode, Orbit->RelTol, INTEG_ABS_TOL, Orbit->MaxStep);
+
+} /* End SC_SIM_ORBIT_Constructor() */
+
+
+/******************************************************************************
+** Function: SC_SIM_ORBIT_Copy
+**
+*/
+void SC_SIM_ORBIT_Copy(SC_SIM_ORBIT_Class_t *Dst, const SC_SIM_ORBIT_Class_t *Src)
+{
+
+   *Dst = *Src;
+   Dst->Ode.State = Dst->State;
+   Dst->Ode.Model = Dst;
+
+} /* End SC_SIM_ORBIT_Copy() */
+
+
+/******************************************************************************
+** Function: SC_SIM_ORBIT_Config
+**
+*/
+void SC_SIM_ORBIT_Config(SC_SIM_ORBIT_Class_t *Orbit, const SC_SIM_TBL_Adcs_t *Tbl)
+{
+
+   Orbit->PropCfg = (Tbl->OrbitProp == SC_SIM_ORBIT_PROP_NUMERICAL) ?
+                 SC_SIM_ORBIT_PROP_NUMERICAL : SC_SIM_ORBIT_PROP_ANALYTIC;
+
+   Orbit->BallisticCoef = Tbl->BallisticCoef;
+   Orbit->SrpCoef       = Tbl->SrpCoef;
+   Orbit->MaxStep       = (Tbl->MaxStep > SC_SIM_ODE_MIN_STEP) ? Tbl->MaxStep : SC_SIM_ODE_MIN_STEP;
+   Orbit->RelTol        = (Tbl->RelTol > 0.0) ? Tbl->RelTol : 1.0e-9;
+
+   SC_SIM_ODE_Config(&Orbit->Ode, Orbit->RelTol, INTEG_ABS_TOL, Orbit->MaxStep);
+
+} /* End SC_SIM_ORBIT_Config() */
+
+
+/******************************************************************************
+** Function: SC_SIM_ORBIT_InShadow
+**
+*/
+bool SC_SIM_ORBIT_InShadow(const double PosEci[3], const double SunUnit[3])
+{
+
+   double SunDist = PosEci[0]*SunUnit[0] + PosEci[1]*SunUnit[1] + PosEci[2]*SunUnit[2];
+   double Perp[3];
+
+   if (SunDist >= 0.0) return false;
+
+   Perp[0] = PosEci[0] - SunDist*SunUnit[0];
+   Perp[1] = PosEci[1] - SunDist*SunUnit[1];
+   Perp[2] = PosEci[2] - SunDist*SunUnit[2];
+
+   return ((Perp[0]*Perp[0] + Perp[1]*Perp[1] + Perp[2]*Perp[2]) < (SC_SIM_ORBIT_RE_KM*SC_SIM_ORBIT_RE_KM));
+
+} /* End SC_SIM_ORBIT_InShadow() */
+
+
+/******************************************************************************
+** Function: SC_SIM_ORBIT_Propagate
+**
+*/
+void SC_SIM_ORBIT_Propagate(SC_SIM_ORBIT_Class_t *Orbit, double Time, double J2000Sec)
+{
+
+   if (!Orbit->Valid || Orbit->Decayed) return;
+
+   Orbit->J2000Offset = J2000Sec - Time;
+
+   if (Orbit->Prop == SC_SIM_ORBIT_PROP_NUMERICAL)
+   {
+      PropagateNumerical(Orbit, Time);
+   }
+   else
+   {
+      PropagateAnalytic(Orbit, Time);
+   }
+
+   Orbit->Time  = Time;
+   Orbit->AltKm = sqrt(Orbit->PosEci[0]*Orbit->PosEci[0] + Orbit->PosEci[1]*Orbit->PosEci[1] +
+                       Orbit->PosEci[2]*Orbit->PosEci[2]) - SC_SIM_ORBIT_RE_KM;
+
+   if (Orbit->AltKm < DECAY_ALT_KM)
+   {
+      Orbit->Decayed = true;
+      CFE_EVS_SendEvent(SC_SIM_ORBIT_DECAY_EID, CFE_EVS_EventType_ERROR,
+                        "Orbit decayed below %d km at sim time %.0f after %d integration steps",
+                        (int)DECAY_ALT_KM, Time, Orbit->Ode.StepCnt);
+   }
+
+} /* End SC_SIM_ORBIT_Propagate() */
+
+
+/******************************************************************************
+** Function: SC_SIM_ORBIT_SetElements
+**
+*/
+bool SC_SIM_ORBIT_SetElements(SC_SIM_ORBIT_Class_t *Orbit, double Time, double J2000Sec,
+                              double SmaKm, double Ecc, double IncDeg, double RaanDeg,
+                              double ArgPerDeg, double MeanAnomDeg)
+{
+
+   SC_SIM_ORBIT_Elements_t *Elem = &Orbit->Elements;
+   double P, CosInc, J2Fac;
+   bool   RetStatus = false;
+
+   if ((SmaKm*(1.0-Ecc)) > (SC_SIM_ORBIT_RE_KM + DECAY_ALT_KM) && Ecc >= 0.0 && Ecc < 1.0)
+   {
+
+      Elem->Sma      = SmaKm;
+      Elem->Ecc      = Ecc;
+      Elem->Inc      = IncDeg*DEG2RAD;
+      Elem->Raan     = RaanDeg*DEG2RAD;
+      Elem->ArgPer   = ArgPerDeg*DEG2RAD;
+      Elem->MeanAnom = MeanAnomDeg*DEG2RAD;
+
+      P      = SmaKm*(1.0 - Ecc*Ecc);
+      CosInc = cos(Elem->Inc);
+      J2Fac  = J2*(SC_SIM_ORBIT_RE_KM/P)*(SC_SIM_ORBIT_RE_KM/P);
+
+      Orbit->MeanMotion = sqrt(SC_SIM_ORBIT_MU_KM3S2/(SmaKm*SmaKm*SmaKm));
+      Orbit->RaanRate   = -1.5*Orbit->MeanMotion*J2Fac*CosInc;
+      Orbit->ArgPerRate = 0.75*Orbit->MeanMotion*J2Fac*(5.0*CosInc*CosInc - 1.0);
+      Orbit->MeanMotion += 0.75*Orbit->MeanMotion*J2Fac*sqrt(1.0-Ecc*Ecc)*(3.0*CosInc*CosInc - 1.0);
+
+      Orbit->Prop        = Orbit->PropCfg;
+      Orbit->EpochTime   = Time;
+      Orbit->J2000Offset = J2000Sec - Time;
+      Orbit->Decayed     = false;
+      Orbit->Ode.StepCnt   = 0;
+      Orbit->Ode.RejectCnt = 0;
+
+      ElementsToEci(Orbit, Time, Orbit->PosEci, Orbit->VelEci);
+
+      memcpy(&Orbit->State[0], Orbit->PosEci, sizeof(Orbit->PosEci));
+      memcpy(&Orbit->State[3], Orbit->VelEci, sizeof(Orbit->VelEci));
+      SC_SIM_ODE_Restart(&Orbit->Ode, Time);
+
+      Orbit->Valid = true;
+      Orbit->Time  = Time;
+      Orbit->AltKm = SmaKm*(1.0 - Ecc) - SC_SIM_ORBIT_RE_KM;
+      RetStatus    = true;
+
+      CFE_EVS_SendEvent(SC_SIM_ORBIT_SET_ELEMENTS_EID, CFE_EVS_EventType_INFORMATION,
+                        "Orbit set using %s propagator: SMA %.1f km, Ecc %.4f, Inc %.2f deg",
+                        (Orbit->Prop == SC_SIM_ORBIT_PROP_NUMERICAL) ? "numerical" : "analytic",
+                        SmaKm, Ecc, IncDeg);
+
+   }
+   else
+   {
+
+      CFE_EVS_SendEvent(SC_SIM_ORBIT_SET_ELEMENTS_EID, CFE_EVS_EventType_ERROR,
+                        "Invalid orbit elements rejected: SMA %.1f km, Ecc %.4f",
+                        SmaKm, Ecc);
+
+   }
+
+   return RetStatus;
+
+} /* End SC_SIM_ORBIT_SetElements() */
+
+
+/******************************************************************************
+** Function: AtmDensity
+**
+** Exponential atmosphere density (kg/m^3).
+*/
+static double AtmDensity(double AltKm)
+{
+
+   int i = ATM_LAYER_CNT - 1;
+
+   if (AltKm < 0.0) AltKm = 0.0;
+
+   while (i > 0 && AltKm < AtmLayer[i].BaseAlt) i--;
+
+   return AtmLayer[i].BaseRho*exp(-(AltKm - AtmLayer[i].BaseAlt)/AtmLayer[i].ScaleHt);
+
+} /* End AtmDensity() */
+
+
+/******************************************************************************
+** Function: Derivatives
+**
+** State derivative for Y = [r v] with point mass, J2-J4 zonal, drag and
+** SRP accelerations.
+*/
+static void Derivatives(void *Model, double Time, const double *Y, double *Dy)
+{
+
+   const SC_SIM_ORBIT_Class_t *Orbit = (const SC_SIM_ORBIT_Class_t *)Model;
+   double X = Y[0], Yp = Y[1], Z = Y[2];
+   double R2 = X*X + Yp*Yp + Z*Z;
+   double R  = sqrt(R2);
+   double Z2R2 = Z*Z/R2;
+   double Mu_R3 = SC_SIM_ORBIT_MU_KM3S2/(R2*R);
+   double Re2_R2 = (SC_SIM_ORBIT_RE_KM*SC_SIM_ORBIT_RE_KM)/R2;
+   double Fac, Rho, VRel[3], VRelMag, Sun[3], ToSun[3], SunDist;
+   double Acc[3];
+   int    i;
+
+   /* Point mass */
+   Acc[0] = -Mu_R3*X;
+   Acc[1] = -Mu_R3*Yp;
+   Acc[2] = -Mu_R3*Z;
+
+   /* J2 */
+   Fac = -1.5*J2*Mu_R3*Re2_R2;
+   Acc[0] += Fac*X*(1.0 - 5.0*Z2R2);
+   Acc[1] += Fac*Yp*(1.0 - 5.0*Z2R2);
+   Acc[2] += Fac*Z*(3.0 - 5.0*Z2R2);
+
+   /* J3 */
+   Fac = -2.5*J3*Mu_R3*Re2_R2*(SC_SIM_ORBIT_RE_KM/R)/R;
+   Acc[0] += Fac*X*(3.0*Z - 7.0*Z*Z2R2);
+   Acc[1] += Fac*Yp*(3.0*Z - 7.0*Z*Z2R2);
+   Acc[2] += Fac*(6.0*Z*Z - 7.0*Z*Z*Z2R2 - 0.6*R2);
+
+   /* J4 */
+   Fac = 1.875*J4*Mu_R3*Re2_R2*Re2_R2;
+   Acc[0] += Fac*X*(1.0 - 14.0*Z2R2 + 21.0*Z2R2*Z2R2);
+   Acc[1] += Fac*Yp*(1.0 - 14.0*Z2R2 + 21.0*Z2R2*Z2R2);
+   Acc[2] += Fac*Z*(5.0 - (70.0/3.0)*Z2R2 + 21.0*Z2R2*Z2R2);
+
+   /* Drag relative to a co-rotating atmosphere. 1000 converts m/s^2 in km/s units */
+   if (Orbit->BallisticCoef > 0.0)
+   {
+      Rho = AtmDensity(R - SC_SIM_ORBIT_RE_KM);
+      VRel[0] = Y[3] + SC_SIM_ORBIT_WE_RADS*Yp;
+      VRel[1] = Y[4] - SC_SIM_ORBIT_WE_RADS*X;
+      VRel[2] = Y[5];
+      VRelMag = sqrt(VRel[0]*VRel[0] + VRel[1]*VRel[1] + VRel[2]*VRel[2]);
+      Fac = -0.5*Orbit->BallisticCoef*Rho*VRelMag*1000.0;
+      for (i=0; i < 3; i++) Acc[i] += Fac*VRel[i];
+   }
+
+   /* Solar radiation pressure, zero in shadow. 1.0e-3 converts m/s^2 to km/s^2 */
+   if (Orbit->SrpCoef > 0.0)
+   {
+      SC_SIM_EPHEM_Position(SC_SIM_EPHEM_BODY_SUN, Orbit->J2000Offset + Time, Sun);
+      for (i=0; i < 3; i++) ToSun[i] = Sun[i] - Y[i];
+      SunDist = sqrt(ToSun[0]*ToSun[0] + ToSun[1]*ToSun[1] + ToSun[2]*ToSun[2]);
+      for (i=0; i < 3; i++) ToSun[i] /= SunDist;
+      if (!SC_SIM_ORBIT_InShadow(Y, ToSun))
+      {
+         Fac = -SRP_AT_1AU*Orbit->SrpCoef*1.0e-3*
+               (SC_SIM_EPHEM_AU_KM/SunDist)*(SC_SIM_EPHEM_AU_KM/SunDist);
+         for (i=0; i < 3; i++) Acc[i] += Fac*ToSun[i];
+      }
+   }
+
+   Dy[0] = Y[3];
+   Dy[1] = Y[4];
+   Dy[2] = Y[5];
+   Dy[3] = Acc[0];
+   Dy[4] = Acc[1];
+   Dy[5] = Acc[2];
+
+} /* End Derivatives() */
+
+
+/******************************************************************************
+** Function: ElementsToEci
+**
+** Analytic state from the mean elements with J2 secular drift.
+*/
+static void ElementsToEci(const SC_SIM_ORBIT_Class_t *Orbit, double Time, double Pos[3], double Vel[3])
+{
+
+   const SC_SIM_ORBIT_Elements_t *Elem = &Orbit->Elements;
+   double Dt   = Time - Orbit->EpochTime;
+   double Raan = Elem->Raan + Orbit->RaanRate*Dt;
+   double ArgP = Elem->ArgPer + Orbit->ArgPerRate*Dt;
+   double M    = fmod(Elem->MeanAnom + Orbit->MeanMotion*Dt, 2.0*M_PI);
+   double E    = M, DeltaE;
+   double CosE, SinE, R, Xpf, Ypf, VXpf, VYpf, Sqrt1E2, VFac;
+   double CO, SO, CW, SW, CI, SI;
+   double P[3], Q[3];
+   int    i;
+
+   /* Kepler's equation */
+   for (i=0; i < 10; i++)
+   {
+      DeltaE = (E - Elem->Ecc*sin(E) - M)/(1.0 - Elem->Ecc*cos(E));
+      E -= DeltaE;
+      if (fabs(DeltaE) < 1.0e-12) break;
+   }
+
+   CosE = cos(E);
+   SinE = sin(E);
+   Sqrt1E2 = sqrt(1.0 - Elem->Ecc*Elem->Ecc);
+   R = Elem->Sma*(1.0 - Elem->Ecc*CosE);
+
+   Xpf  = Elem->Sma*(CosE - Elem->Ecc);
+   Ypf  = Elem->Sma*Sqrt1E2*SinE;
+   VFac = sqrt(SC_SIM_ORBIT_MU_KM3S2*Elem->Sma)/R;
+   VXpf = -VFac*SinE;
+   VYpf =  VFac*Sqrt1E2*CosE;
+
+   CO = cos(Raan); SO = sin(Raan);
+   CW = cos(ArgP); SW = sin(ArgP);
+   CI = cos(Elem->Inc); SI = sin(Elem->Inc);
+
+   P[0] =  CO*CW - SO*SW*CI;
+   P[1] =  SO*CW + CO*SW*CI;
+   P[2] =  SW*SI;
+   Q[0] = -CO*SW - SO*CW*CI;
+   Q[1] = -SO*SW + CO*CW*CI;
+   Q[2] =  CW*SI;
+
+   for (i=0; i < 3; i++)
+   {
+      Pos[i] = Xpf*P[i] + Ypf*Q[i];
+      Vel[i] = VXpf*P[i] + VYpf*Q[i];
+   }
+
+} /* End ElementsToEci() */
+
+
+/******************************************************************************
+** Function: PropagateAnalytic
+**
+*/
+static void PropagateAnalytic(SC_SIM_ORBIT_Class_t *Orbit, double Time)
+{
+
+   ElementsToEci(Orbit, Time, Orbit->PosEci, Orbit->VelEci);
+
+} /* End PropagateAnalytic() */
+
+
+/******************************************************************************
+** Function: PropagateNumerical
+**
+** Integrate until the last accepted step spans Time and interpolate.
+*/
+static void PropagateNumerical(SC_SIM_ORBIT_Class_t *Orbit, double Time)
+{
+
+   SC_SIM_ODE_Advance(&Orbit->Ode, Time);
+
+   memcpy(Orbit->PosEci, &Orbit->State[0], sizeof(Orbit->PosEci));
+   memcpy(Orbit->VelEci, &Orbit->State[3], sizeof(Orbit->VelEci));
+
+} /* End PropagateNumerical() */
@@ -0,0 +1,198 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Define the orbit propagator used by the ADCS model
+**
+** Notes:
+**   1. Two propagators publish the same position/velocity interface:
+**      - ANALYTIC: Keplerian elements with J2 secular rates. Cheap and
+**        used for realtime training scenarios.
+**      - NUMERICAL: Dormand-Prince 5(4) adaptive step integration of
+**        J2-J4 zonal gravity, exponential atmosphere drag and solar
+**        radiation pressure with a cylindrical Earth shadow. Intended
+**        for multi-month batch runs that need altitude decay and
+**        eclipse season changes.
+**   2. The numerical propagator registers its position and velocity with
+**      the integrator service's Dormand-Prince 5(4) pair. The step size
+**      is chosen by its error control, not by the caller's query rate.
+**      Queries that fall inside the last accepted step are answered with
+**      the continuous extension so once-per-second queries during the
+**      time-lapse phase cost an interpolation, not a step.
+**   3. Distances are kilometers, times are seconds and angles in the
+**      exported interface are degrees.
+**   4. The integrator refers to the orbit's state so an orbit copied for
+**      a prediction must be copied with SC_SIM_ORBIT_Copy().
+**
+*/
+
+#ifndef _sc_sim_orbit_
+#define _sc_sim_orbit_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "sc_sim_tbl.h"
+#include "sc_sim_ode.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SC_SIM_ORBIT_MU_KM3S2   (398600.4418)
+#define SC_SIM_ORBIT_RE_KM      (6378.137)
+#define SC_SIM_ORBIT_WE_RADS    (7.2921150e-5)   /* Earth rotation rate */
+
+/*
+** Event Message IDs
+*/
+
+#define SC_SIM_ORBIT_SET_ELEMENTS_EID  (SC_SIM_ORBIT_BASE_EID + 0)
+#define SC_SIM_ORBIT_DECAY_EID         (SC_SIM_ORBIT_BASE_EID + 1)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+
+   SC_SIM_ORBIT_PROP_ANALYTIC  = 0,
+   SC_SIM_ORBIT_PROP_NUMERICAL = 1
+
+} SC_SIM_ORBIT_Prop_t;
+
+
+/*
+** Classical elements. Angles stored in radians.
+*/
+typedef struct
+{
+
+   double  Sma;       /* Semi-major axis (km) */
+   double  Ecc;
+   double  Inc;
+   double  Raan;
+   double  ArgPer;
+   double  MeanAnom;
+
+} SC_SIM_ORBIT_Elements_t;
+
+
+typedef struct
+{
+
+   /* Configuration */
+
+   SC_SIM_ORBIT_Prop_t  PropCfg;
+   double  BallisticCoef;   /* Cd*A/m (m^2/kg) */
+   double  SrpCoef;         /* Cr*A/m (m^2/kg) */
+   double  MaxStep;         /* Seconds */
+   double  RelTol;
+
+   /* State */
+
+   bool    Valid;
+   SC_SIM_ORBIT_Prop_t  Prop;  /* Propagator in use, latched from PropCfg */
+   double  EpochTime;       /* Sim time the elements are referenced to */
+   double  J2000Offset;     /* Seconds since J2000 at sim time zero */
+   SC_SIM_ORBIT_Elements_t  Elements;
+   double  RaanRate;        /* J2 secular rates (rad/s) */
+   double  ArgPerRate;
+   double  MeanMotion;
+   double  State[6];        /* Numerically integrated position and velocity */
+   SC_SIM_ODE_Class_t       Ode;
+
+   /* Published */
+
+   double  Time;
+   double  PosEci[3];
+   double  VelEci[3];
+   double  AltKm;
+   bool    Decayed;
+
+} SC_SIM_ORBIT_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SC_SIM_ORBIT_Constructor
+**
+** Initialize an orbit object to a known state with no orbit defined.
+**
+*/
+void SC_SIM_ORBIT_Constructor(SC_SIM_ORBIT_Class_t *Orbit);
+
+
+/******************************************************************************
+** Function: SC_SIM_ORBIT_Copy
+**
+** Copy an orbit, e.g. to propagate a prediction without changing the
+** source orbit.
+**
+*/
+void SC_SIM_ORBIT_Copy(SC_SIM_ORBIT_Class_t *Dst, const SC_SIM_ORBIT_Class_t *Src);
+
+
+/******************************************************************************
+** Function: SC_SIM_ORBIT_Config
+**
+** Load propagator configuration parameters.
+**
+** Notes:
+**   1. Takes effect on the next SC_SIM_ORBIT_SetElements() call so a
+**      parameter table load doesn't switch propagators mid-orbit.
+**
+*/
+void SC_SIM_ORBIT_Config(SC_SIM_ORBIT_Class_t *Orbit, const SC_SIM_TBL_Adcs_t *Tbl);
+
+
+/******************************************************************************
+** Function: SC_SIM_ORBIT_SetElements
+**
+** Define the orbit with classical elements (km & degrees) at sim Time.
+**
+*/
+bool SC_SIM_ORBIT_SetElements(SC_SIM_ORBIT_Class_t *Orbit, double Time, double J2000Sec,
+                              double SmaKm, double Ecc, double IncDeg, double RaanDeg,
+                              double ArgPerDeg, double MeanAnomDeg);
+
+
+/******************************************************************************
+** Function: SC_SIM_ORBIT_Propagate
+**
+** Propagate the published state to sim Time. J2000Sec is the same instant
+** in seconds since J2000, used for sun dependent forces.
+**
+*/
+void SC_SIM_ORBIT_Propagate(SC_SIM_ORBIT_Class_t *Orbit, double Time, double J2000Sec);
+
+
+/******************************************************************************
+** Function: SC_SIM_ORBIT_InShadow
+**
+** Return true if PosEci is inside the cylindrical Earth shadow.
+**
+*/
+bool SC_SIM_ORBIT_InShadow(const double PosEci[3], const double SunUnit[3]);
+
+
+#endif /* _sc_sim_orbit_ */
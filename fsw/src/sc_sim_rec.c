@@ -0,0 +1,566 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Implement the onboard recorder model
+**
+** Notes:
+**   None
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "sc_sim_rec.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define RING_MASK(Vc)  ((Vc)->MaxFiles - 1)
+
+#define VC_FILE(Vc,i)  (&(Vc)->File[((Vc)->Head + (i)) & RING_MASK(Vc)])
+
+#define TIME_MAX  (0xFFFFFFFF)
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void   DropOldest(SC_SIM_REC_Class_t *Rec, SC_SIM_REC_Vc_t *Vc);
+static void   FreePlayed(SC_SIM_REC_Vc_t *Vc);
+static uint32 Search(const SC_SIM_REC_Vc_t *Vc, uint32 Time, bool After);
+static uint32 SelectVc(SC_SIM_REC_Class_t *Rec, SC_SIM_REC_Vc_t *Vc);
+static void   SkipPlayed(SC_SIM_REC_Vc_t *Vc);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static const char *VcName[SC_SIM_REC_VC_CNT] = { "housekeeping", "science", "event log" };
+
+static const uint32 VcMaxFiles[SC_SIM_REC_VC_CNT] =
+{
+   SC_SIM_REC_HK_MAX_FILES, SC_SIM_REC_SCI_MAX_FILES, SC_SIM_REC_EVS_MAX_FILES
+};
+
+
+/******************************************************************************
+** Function: SC_SIM_REC_Constructor
+**
+*/
+void SC_SIM_REC_Constructor(SC_SIM_REC_Class_t *Rec)
+{
+
+   uint32 Base = 0;
+   uint16 i;
+
+   memset(Rec, 0, sizeof(SC_SIM_REC_Class_t));
+
+   for (i=0; i < SC_SIM_REC_VC_CNT; i++)
+   {
+      Rec->Vc[i].MaxFiles = VcMaxFiles[i];
+      Rec->Vc[i].File     = &Rec->File[Base];
+      Base += VcMaxFiles[i];
+   }
+
+   SC_SIM_REC_Clear(Rec);
+
+} /* End SC_SIM_REC_Constructor() */
+
+
+/******************************************************************************
+** Function: SC_SIM_REC_Clear
+**
+*/
+void SC_SIM_REC_Clear(SC_SIM_REC_Class_t *Rec)
+{
+
+   SC_SIM_REC_Vc_t *Vc;
+   uint16 i;
+
+   for (i=0; i < SC_SIM_REC_VC_CNT; i++)
+   {
+      Vc = &Rec->Vc[i];
+      Vc->UsedBytes = 0;
+      Vc->FileCnt   = 0;
+      Vc->SlotCnt   = 0;
+      Vc->Head      = 0;
+      Vc->Cursor    = 0;
+      Vc->Full      = false;
+   }
+
+   Rec->UsedBytes = 0;
+   Rec->FileCnt   = 0;
+   Rec->UpsetCnt  = 0;
+   Rec->PlbkVc    = SC_SIM_REC_VC_ALL;
+   Rec->PlbkStart = 0;
+   Rec->PlbkEnd   = TIME_MAX;
+
+} /* End SC_SIM_REC_Clear() */
+
+
+/******************************************************************************
+** Function: SC_SIM_REC_Config
+**
+** Notes:
+**   1. Channels with equal priorities keep their channel order.
+**
+*/
+void SC_SIM_REC_Config(SC_SIM_REC_Class_t *Rec, const SC_SIM_TBL_Fsw_t *Tbl)
+{
+
+   uint16 i, j;
+   uint8  v;
+
+   Rec->Capacity = (uint64)(Tbl->RecCapacity*1.0e6);
+
+   for (i=0; i < SC_SIM_REC_VC_CNT; i++)
+   {
+
+      Rec->Vc[i].Priority  = (uint8)Tbl->RecVc[i].Priority;
+      Rec->Vc[i].Retention = (Tbl->RecVc[i].Retention == SC_SIM_REC_OVERWRITE) ? SC_SIM_REC_OVERWRITE : SC_SIM_REC_KEEP;
+
+      /* Insertion sort, there are only a few channels */
+      v = (uint8)i;
+      for (j=i; j > 0 && Rec->Vc[Rec->Order[j-1]].Priority > Rec->Vc[v].Priority; j--)
+      {
+         Rec->Order[j] = Rec->Order[j-1];
+      }
+      Rec->Order[j] = v;
+
+   }
+
+} /* End SC_SIM_REC_Config() */
+
+
+/******************************************************************************
+** Function: SC_SIM_REC_PctUsed
+**
+*/
+float SC_SIM_REC_PctUsed(const SC_SIM_REC_Class_t *Rec)
+{
+
+   return (Rec->Capacity > 0) ? (float)((double)Rec->UsedBytes*100.0/(double)Rec->Capacity) : 0.0;
+
+} /* End SC_SIM_REC_PctUsed() */
+
+
+/******************************************************************************
+** Function: SC_SIM_REC_Playback
+**
+*/
+uint64 SC_SIM_REC_Playback(SC_SIM_REC_Class_t *Rec, uint64 Bytes)
+{
+
+   SC_SIM_REC_Vc_t   *Vc;
+   SC_SIM_REC_File_t *File;
+   uint64 Played = 0;
+   uint64 VcPlayed;
+   uint32 Remaining;
+   uint16 i;
+
+   for (i=0; i < SC_SIM_REC_VC_CNT && Played < Bytes; i++)
+   {
+
+      if (Rec->PlbkVc != SC_SIM_REC_VC_ALL && Rec->PlbkVc != Rec->Order[i]) continue;
+
+      Vc = &Rec->Vc[Rec->Order[i]];
+      VcPlayed = Played;
+
+      while (Vc->Cursor < Vc->SlotCnt && Played < Bytes)
+      {
+
+         File = VC_FILE(Vc, Vc->Cursor);
+         if (File->CreateTime > Rec->PlbkEnd) break;
+
+         Remaining = File->Size - File->Played;
+
+         if ((Bytes - Played) >= Remaining)
+         {
+            Played += Remaining;
+            File->Played = File->Size;
+            File->Flags |= SC_SIM_REC_FILE_PLAYED;
+            Vc->FileCnt--;
+            Rec->FileCnt--;
+            Vc->Cursor++;
+            SkipPlayed(Vc);
+         }
+         else
+         {
+            File->Played += (uint32)(Bytes - Played);
+            Played = Bytes;
+         }
+
+      } /* End file loop */
+
+      VcPlayed = Played - VcPlayed;
+      Vc->UsedBytes  -= VcPlayed;
+      Rec->UsedBytes -= VcPlayed;
+
+      FreePlayed(Vc);
+
+   } /* End channel loop */
+
+   return Played;
+
+} /* End SC_SIM_REC_Playback() */
+
+
+/******************************************************************************
+** Function: SC_SIM_REC_PlaybackPending
+**
+*/
+bool SC_SIM_REC_PlaybackPending(const SC_SIM_REC_Class_t *Rec)
+{
+
+   const SC_SIM_REC_Vc_t *Vc;
+   uint16 i;
+
+   for (i=0; i < SC_SIM_REC_VC_CNT; i++)
+   {
+
+      if (Rec->PlbkVc != SC_SIM_REC_VC_ALL && Rec->PlbkVc != i) continue;
+
+      Vc = &Rec->Vc[i];
+      if (Vc->Cursor < Vc->SlotCnt && VC_FILE(Vc, Vc->Cursor)->CreateTime <= Rec->PlbkEnd) return true;
+
+   }
+
+   return false;
+
+} /* End SC_SIM_REC_PlaybackPending() */
+
+
+/******************************************************************************
+** Function: SC_SIM_REC_Preload
+**
+*/
+void SC_SIM_REC_Preload(SC_SIM_REC_Class_t *Rec, uint32 FileCnt, uint64 Bytes,
+                        uint32 Time, uint16 Apid, uint8 Vc)
+{
+
+   SC_SIM_REC_Vc_t   *Chan;
+   SC_SIM_REC_File_t *File;
+   uint64 FileSize, Free;
+   uint32 i;
+
+   if (Vc >= SC_SIM_REC_VC_CNT) return;
+
+   Chan = &Rec->Vc[Vc];
+
+   Rec->UsedBytes -= Chan->UsedBytes;
+   Rec->FileCnt   -= Chan->FileCnt;
+   Chan->UsedBytes = 0;
+   Chan->FileCnt   = 0;
+   Chan->SlotCnt   = 0;
+   Chan->Head      = 0;
+   Chan->Cursor    = 0;
+   Chan->Full      = false;
+
+   if (FileCnt == 0) return;
+   if (FileCnt > Chan->MaxFiles) FileCnt = Chan->MaxFiles;
+   Free = (Rec->Capacity > Rec->UsedBytes) ? (Rec->Capacity - Rec->UsedBytes) : 0;
+   if (Bytes > Free) Bytes = Free;
+
+   FileSize = Bytes/FileCnt;
+
+   for (i=0; i < FileCnt; i++)
+   {
+      File = &Chan->File[i];
+      File->Size       = (uint32)((i == (FileCnt-1)) ? (Bytes - FileSize*(FileCnt-1)) : FileSize);
+      File->CreateTime = Time;
+      File->Played     = 0;
+      File->Apid       = Apid;
+      File->Vc         = Vc;
+      File->Flags      = 0;
+   }
+
+   Chan->FileCnt   = FileCnt;
+   Chan->SlotCnt   = FileCnt;
+   Chan->UsedBytes = Bytes;
+   Rec->FileCnt   += FileCnt;
+   Rec->UsedBytes += Bytes;
+
+   SelectVc(Rec, Chan);
+
+} /* End SC_SIM_REC_Preload() */
+
+
+/******************************************************************************
+** Function: SC_SIM_REC_Select
+**
+*/
+uint32 SC_SIM_REC_Select(SC_SIM_REC_Class_t *Rec, uint8 Vc, uint32 Start, uint32 End)
+{
+
+   uint32 Selected = 0;
+   uint16 i;
+
+   Rec->PlbkVc    = (Vc < SC_SIM_REC_VC_CNT) ? Vc : SC_SIM_REC_VC_ALL;
+   Rec->PlbkStart = Start;
+   Rec->PlbkEnd   = End;
+
+   for (i=0; i < SC_SIM_REC_VC_CNT; i++)
+   {
+      if (Rec->PlbkVc == SC_SIM_REC_VC_ALL || Rec->PlbkVc == i)
+      {
+         Selected += SelectVc(Rec, &Rec->Vc[i]);
+      }
+   }
+
+   return Selected;
+
+} /* End SC_SIM_REC_Select() */
+
+
+/******************************************************************************
+** Function: SC_SIM_REC_Store
+**
+*/
+bool SC_SIM_REC_Store(SC_SIM_REC_Class_t *Rec, uint32 Size, uint32 Time, uint16 Apid, uint8 Vc)
+{
+
+   SC_SIM_REC_Vc_t   *Chan;
+   SC_SIM_REC_File_t *File;
+   uint64 Others;
+
+   if (Vc >= SC_SIM_REC_VC_CNT) return false;
+
+   Chan = &Rec->Vc[Vc];
+   Others = Rec->UsedBytes - Chan->UsedBytes;
+
+   /* Only overwrite if dropping the whole channel would make enough room */
+   if (Chan->Retention == SC_SIM_REC_OVERWRITE && (Others + Size) <= Rec->Capacity)
+   {
+      while (Chan->SlotCnt > 0 &&
+             (Chan->SlotCnt >= Chan->MaxFiles || (Rec->UsedBytes + Size) > Rec->Capacity))
+      {
+         DropOldest(Rec, Chan);
+      }
+      SkipPlayed(Chan);
+   }
+
+   if (Chan->SlotCnt >= Chan->MaxFiles || (Rec->UsedBytes + Size) > Rec->Capacity)
+   {
+
+      Chan->RejectCnt++;
+      if (!Chan->Full)
+      {
+         CFE_EVS_SendEvent(SC_SIM_REC_FULL_EID, CFE_EVS_EventType_ERROR,
+                           "Recorder %s channel full at %d, %d files using %.1f%%. Rejecting new files",
+                           VcName[Vc], Time, Chan->FileCnt, SC_SIM_REC_PctUsed(Rec));
+         Chan->Full = true;
+      }
+
+      return false;
+   }
+
+   File = VC_FILE(Chan, Chan->SlotCnt);
+   File->Size       = Size;
+   File->CreateTime = Time;
+   File->Played     = 0;
+   File->Apid       = Apid;
+   File->Vc         = Vc;
+   File->Flags      = 0;
+
+   Chan->SlotCnt++;
+   Chan->FileCnt++;
+   Chan->UsedBytes += Size;
+   Chan->Full       = false;
+   Rec->FileCnt++;
+   Rec->UsedBytes  += Size;
+
+   return true;
+
+} /* End SC_SIM_REC_Store() */
+
+
+/******************************************************************************
+** Function: SC_SIM_REC_Upset
+**
+*/
+bool SC_SIM_REC_Upset(SC_SIM_REC_Class_t *Rec, double Frac)
+{
+
+   SC_SIM_REC_Vc_t   *Vc;
+   SC_SIM_REC_File_t *File;
+   uint64 Offset = (uint64)(Frac*(double)Rec->Capacity);
+   uint32 Remaining;
+   uint32 s;
+   uint16 i;
+
+   if (Offset >= Rec->UsedBytes) return false;
+
+   for (i=0; i < SC_SIM_REC_VC_CNT; i++)
+   {
+
+      Vc = &Rec->Vc[i];
+      if (Offset >= Vc->UsedBytes)
+      {
+         Offset -= Vc->UsedBytes;
+         continue;
+      }
+
+      for (s=0; s < Vc->SlotCnt; s++)
+      {
+
+         File = VC_FILE(Vc, s);
+         if (File->Flags & SC_SIM_REC_FILE_PLAYED) continue;
+
+         Remaining = File->Size - File->Played;
+         if (Offset < Remaining)
+         {
+            File->Flags |= SC_SIM_REC_FILE_CORRUPT;
+            Rec->UpsetCnt++;
+            return true;
+         }
+         Offset -= Remaining;
+
+      } /* End file loop */
+   } /* End channel loop */
+
+   return false;
+
+} /* End SC_SIM_REC_Upset() */
+
+
+/******************************************************************************
+** Function: DropOldest
+**
+** Remove a channel's oldest file whether or not it has been played back.
+**
+*/
+static void DropOldest(SC_SIM_REC_Class_t *Rec, SC_SIM_REC_Vc_t *Vc)
+{
+
+   SC_SIM_REC_File_t *File = VC_FILE(Vc, 0);
+   uint32 Remaining;
+
+   if ((File->Flags & SC_SIM_REC_FILE_PLAYED) == 0)
+   {
+      Remaining = File->Size - File->Played;
+      Vc->UsedBytes  -= Remaining;
+      Rec->UsedBytes -= Remaining;
+      Vc->FileCnt--;
+      Rec->FileCnt--;
+      Vc->DropCnt++;
+   }
+
+   Vc->Head = (Vc->Head + 1) & RING_MASK(Vc);
+   Vc->SlotCnt--;
+   if (Vc->Cursor > 0) Vc->Cursor--;
+
+} /* End DropOldest() */
+
+
+/******************************************************************************
+** Function: FreePlayed
+**
+** Free the ring slots of the played files at the head of a channel.
+**
+*/
+static void FreePlayed(SC_SIM_REC_Vc_t *Vc)
+{
+
+   while (Vc->SlotCnt > 0 && (VC_FILE(Vc, 0)->Flags & SC_SIM_REC_FILE_PLAYED))
+   {
+      Vc->Head = (Vc->Head + 1) & RING_MASK(Vc);
+      Vc->SlotCnt--;
+      if (Vc->Cursor > 0) Vc->Cursor--;
+   }
+
+} /* End FreePlayed() */
+
+
+/******************************************************************************
+** Function: Search
+**
+** Return the offset from the head of a channel's first file created at
+** or after Time, or after Time if After is true. Returns the slot count
+** if there's no such file.
+**
+*/
+static uint32 Search(const SC_SIM_REC_Vc_t *Vc, uint32 Time, bool After)
+{
+
+   uint32 Lo = 0;
+   uint32 Hi = Vc->SlotCnt;
+   uint32 Mid, FileTime;
+
+   while (Lo < Hi)
+   {
+
+      Mid = Lo + (Hi - Lo)/2;
+      FileTime = VC_FILE(Vc, Mid)->CreateTime;
+
+      if (FileTime < Time || (After && FileTime == Time))
+      {
+         Lo = Mid + 1;
+      }
+      else
+      {
+         Hi = Mid;
+      }
+
+   }
+
+   return Lo;
+
+} /* End Search() */
+
+
+/******************************************************************************
+** Function: SelectVc
+**
+** Move a channel's playback cursor to the first file of the selected time
+** range and return the number of files in the range.
+**
+*/
+static uint32 SelectVc(SC_SIM_REC_Class_t *Rec, SC_SIM_REC_Vc_t *Vc)
+{
+
+   uint32 Last;
+
+   Vc->Cursor = Search(Vc, Rec->PlbkStart, false);
+   Last = (Rec->PlbkEnd == TIME_MAX) ? Vc->SlotCnt : Search(Vc, Rec->PlbkEnd, true);
+
+   SkipPlayed(Vc);
+
+   return (Last > Vc->Cursor) ? (Last - Vc->Cursor) : 0;
+
+} /* End SelectVc() */
+
+
+/******************************************************************************
+** Function: SkipPlayed
+**
+** Advance a channel's playback cursor past files that have been played.
+**
+*/
+static void SkipPlayed(SC_SIM_REC_Vc_t *Vc)
+{
+
+   while (Vc->Cursor < Vc->SlotCnt && (VC_FILE(Vc, Vc->Cursor)->Flags & SC_SIM_REC_FILE_PLAYED))
+   {
+      Vc->Cursor++;
+   }
+
+} /* End SkipPlayed() */
@@ -0,0 +1,268 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Define an onboard recorder model
+**
+** Notes:
+**   1. The recorder is partitioned into virtual channels (housekeeping,
+**      science and event log) that share the capacity. Each channel is a
+**      FIFO of file descriptors held in a ring buffer. The ring size is a
+**      power of two so the wrap is a mask and storing or removing a file
+**      is O(1). The rings are sized for each channel's file rate and share
+**      one descriptor pool.
+**   2. Files are stored in creation time order so each channel's ring is
+**      also a time sorted index. A playback selects a channel, or all
+**      channels, and a creation time range. The first file in the range
+**      is found with a binary search and playback continues from there
+**      until a file is newer than the range.
+**   3. All channels play back in priority order, a lower priority
+**      channel only gets the bytes left over in a step after the higher
+**      priority channels' selected files have been played back.
+**   4. A file that completes playback is marked played and its bytes are
+**      freed. Its ring slot is freed when it reaches the head of the
+**      channel, so selective playback doesn't have to remove files from
+**      the middle of the ring.
+**   5. When a file doesn't fit, a KEEP channel rejects the new file and an
+**      OVERWRITE channel drops its own oldest files to make room.
+**
+*/
+
+#ifndef _sc_sim_rec_
+#define _sc_sim_rec_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "sc_sim_tbl.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SC_SIM_REC_HK_MAX_FILES   (32768)    /* Per channel ring sizes, must be powers of 2 */
+#define SC_SIM_REC_SCI_MAX_FILES  (131072)
+#define SC_SIM_REC_EVS_MAX_FILES  (8192)
+#define SC_SIM_REC_MAX_FILES      (SC_SIM_REC_HK_MAX_FILES + SC_SIM_REC_SCI_MAX_FILES + SC_SIM_REC_EVS_MAX_FILES)
+
+/*
+** Virtual channels, must match the EDS RecVc definitions
+*/
+
+#define SC_SIM_REC_VC_HK    0
+#define SC_SIM_REC_VC_SCI   1
+#define SC_SIM_REC_VC_EVS   2
+#define SC_SIM_REC_VC_CNT   SC_SIM_TBL_REC_VC_CNT
+#define SC_SIM_REC_VC_ALL   SC_SIM_REC_VC_CNT
+
+/*
+** Retention policies
+*/
+
+#define SC_SIM_REC_KEEP       0   /* Reject new files when full */
+#define SC_SIM_REC_OVERWRITE  1   /* Drop the channel's oldest files when full */
+
+#define SC_SIM_REC_FILE_PLAYED   0x01
+#define SC_SIM_REC_FILE_CORRUPT  0x02
+
+/*
+** Event Message IDs
+*/
+
+#define SC_SIM_REC_FULL_EID  (SC_SIM_REC_BASE_EID + 0)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+
+   uint32  Size;            /* Bytes */
+   uint32  CreateTime;      /* Sim seconds */
+   uint32  Played;          /* Bytes already played back */
+   uint16  Apid;
+   uint8   Vc;              /* Virtual channel */
+   uint8   Flags;
+
+} SC_SIM_REC_File_t;
+
+
+typedef struct
+{
+
+   uint8   Priority;        /* 0 is the highest */
+   uint8   Retention;
+   uint64  UsedBytes;
+   uint32  FileCnt;         /* Files not played back */
+   uint32  SlotCnt;         /* Ring slots in use, includes played files behind the head */
+   uint32  Head;            /* Oldest file */
+   uint32  Cursor;          /* Next file to play back, offset from the head */
+   uint32  RejectCnt;
+   uint32  DropCnt;         /* Unplayed files dropped by an overwrite */
+   bool    Full;            /* Last store was rejected, limits the full event to once per episode */
+
+   uint32  MaxFiles;        /* Ring size */
+   SC_SIM_REC_File_t *File; /* Channel's ring in the recorder's descriptor pool */
+
+} SC_SIM_REC_Vc_t;
+
+
+typedef struct
+{
+
+   uint64  Capacity;        /* Bytes */
+   uint64  UsedBytes;
+   uint32  FileCnt;         /* Files not played back, all channels */
+   uint32  UpsetCnt;        /* Upsets that hit a stored file */
+
+   uint8   Order[SC_SIM_REC_VC_CNT];   /* Channels in priority order */
+
+   /* Playback selection */
+
+   uint8   PlbkVc;          /* Channel or SC_SIM_REC_VC_ALL */
+   uint32  PlbkStart;       /* Creation time range (sim seconds) */
+   uint32  PlbkEnd;
+
+   SC_SIM_REC_Vc_t Vc[SC_SIM_REC_VC_CNT];
+
+   SC_SIM_REC_File_t File[SC_SIM_REC_MAX_FILES];
+
+} SC_SIM_REC_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SC_SIM_REC_Constructor
+**
+** Assign each channel its ring in the descriptor pool and clear the
+** recorder.
+**
+*/
+void SC_SIM_REC_Constructor(SC_SIM_REC_Class_t *Rec);
+
+
+/******************************************************************************
+** Function: SC_SIM_REC_Clear
+**
+** Remove all files and select all files of all channels for playback.
+**
+*/
+void SC_SIM_REC_Clear(SC_SIM_REC_Class_t *Rec);
+
+
+/******************************************************************************
+** Function: SC_SIM_REC_Config
+**
+** Set the capacity and the channels' priority and retention from the
+** table. The contents are kept.
+**
+*/
+void SC_SIM_REC_Config(SC_SIM_REC_Class_t *Rec, const SC_SIM_TBL_Fsw_t *Tbl);
+
+
+/******************************************************************************
+** Function: SC_SIM_REC_PctUsed
+**
+*/
+float SC_SIM_REC_PctUsed(const SC_SIM_REC_Class_t *Rec);
+
+
+/******************************************************************************
+** Function: SC_SIM_REC_Playback
+**
+** Play back up to Bytes of the selected files in channel priority order.
+** Returns the bytes played back.
+**
+*/
+uint64 SC_SIM_REC_Playback(SC_SIM_REC_Class_t *Rec, uint64 Bytes);
+
+
+/******************************************************************************
+** Function: SC_SIM_REC_PlaybackPending
+**
+** Return true if a selected file hasn't been played back.
+**
+*/
+bool SC_SIM_REC_PlaybackPending(const SC_SIM_REC_Class_t *Rec);
+
+
+/******************************************************************************
+** Function: SC_SIM_REC_Preload
+**
+** Replace a channel's contents with FileCnt files that together hold Bytes.
+**
+** Notes:
+**   1. Used to initialize a scenario's recorder. Bytes is limited to the
+**      capacity left by the other channels and FileCnt to the ring size.
+**   2. The division remainder goes in the last file so the total is exact.
+**
+*/
+void SC_SIM_REC_Preload(SC_SIM_REC_Class_t *Rec, uint32 FileCnt, uint64 Bytes,
+                        uint32 Time, uint16 Apid, uint8 Vc);
+
+
+/******************************************************************************
+** Function: SC_SIM_REC_Upset
+**
+** Apply a single event upset at Frac (0 to 1) of the recorder memory and
+** mark the file stored there corrupt. Returns false if the upset hit
+** free memory.
+**
+** Notes:
+**   1. Memory is modeled as the channels' unplayed bytes laid out in
+**      channel order and each channel's files in FIFO order, followed by
+**      the free bytes. Finding the file is linear in the channel's files,
+**      upsets are rare.
+**
+*/
+bool SC_SIM_REC_Upset(SC_SIM_REC_Class_t *Rec, double Frac);
+
+
+/******************************************************************************
+** Function: SC_SIM_REC_Select
+**
+** Select the files of channel Vc, or all channels, created from Start to
+** End (inclusive) for playback. Returns the number of files in the range
+** still held by the recorder.
+**
+** Notes:
+**   1. Files stored later in the range are also played back.
+**   2. A channel's files are searched in O(log n).
+**
+*/
+uint32 SC_SIM_REC_Select(SC_SIM_REC_Class_t *Rec, uint8 Vc, uint32 Start, uint32 End);
+
+
+/******************************************************************************
+** Function: SC_SIM_REC_Store
+**
+** Add a file to the end of a channel's FIFO.
+**
+** Notes:
+**   1. Returns false if the file is rejected.
+**
+*/
+bool SC_SIM_REC_Store(SC_SIM_REC_Class_t *Rec, uint32 Size, uint32 Time, uint16 Apid, uint8 Vc);
+
+
+#endif /* _sc_sim_rec_ */
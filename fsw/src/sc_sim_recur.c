@@ -0,0 +1,169 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Implement the recurring event command generators
+**
+** Notes:
+**   None
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "sc_sim_recur.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void UpdateNextTime(SC_SIM_RECUR_Class_t *Recur);
+
+
+/******************************************************************************
+** Function: SC_SIM_RECUR_Reset
+**
+*/
+void SC_SIM_RECUR_Reset(SC_SIM_RECUR_Class_t *Recur, const SC_SIM_RECUR_Def_t *Def, uint16 DefCnt,
+                        uint64 RunId, uint16 CraftId)
+{
+
+   SC_SIM_RECUR_Item_t *Item;
+   uint16 i;
+
+   memset(Recur, 0, sizeof(SC_SIM_RECUR_Class_t));
+   SC_SIM_RNG_Seed(&Recur->Rng, RunId, CraftId, SC_SIM_RNG_MODEL_RECUR);
+
+   Recur->ItemCnt = (DefCnt < SC_SIM_RECUR_MAX) ? DefCnt : SC_SIM_RECUR_MAX;
+   for (i=0; i < Recur->ItemCnt; i++)
+   {
+      Item = &Recur->Item[i];
+      Item->Def      = &Def[i];
+      Item->Jitter   = Def[i].Jitter;
+      if (Def[i].Period > 0 && Item->Jitter > (Def[i].Period - 1)/2)
+      {
+         Item->Jitter = (Def[i].Period - 1)/2;
+      }
+      Item->NextTime = 0;
+      Item->Pending  = false;
+   }
+
+   UpdateNextTime(Recur);
+
+} /* End SC_SIM_RECUR_Reset() */
+
+
+/******************************************************************************
+** Function: SC_SIM_RECUR_Schedule
+**
+** Notes:
+**   1. An occurrence is skipped when even its latest possible time isn't
+**      after Time. The first one left is found directly from the period so
+**      a long gap costs the same as a short one.
+**
+*/
+const SC_SIM_RECUR_Item_t *SC_SIM_RECUR_Schedule(SC_SIM_RECUR_Class_t *Recur, uint32 Time)
+{
+
+   SC_SIM_RECUR_Item_t *Item = NULL;
+   const SC_SIM_RECUR_Def_t *Def;
+   int64  Late;
+   int64  Next;
+   uint32 Occurrence;
+   uint16 i;
+
+   if (Time < Recur->NextTime) return NULL;
+
+   for (i=0; i < Recur->ItemCnt; i++)
+   {
+      if (Recur->Item[i].NextTime <= Time)
+      {
+         Item = &Recur->Item[i];
+         break;
+      }
+   }
+
+   if (Item == NULL) return NULL;
+
+   Def = Item->Def;
+   Occurrence = Item->Occurrence;
+   if (Item->Pending)
+   {
+      Item->FireCnt++;
+      Recur->FireCnt++;
+      Occurrence++;
+   }
+
+   Late = (int64)Time - Def->Start - Item->Jitter;
+   if (Late >= (int64)Occurrence*Def->Period)
+   {
+      Occurrence = (Def->Period > 0) ? (uint32)(Late/Def->Period + 1) : 1;
+   }
+
+   Next = (int64)Def->Start + (int64)Occurrence*Def->Period;
+   
+   if ((Def->Count > 0 && Item->FireCnt >= Def->Count) || (Def->Period == 0 && Occurrence > 0) ||
+       (Def->Until > 0 && Next > Def->Until))
+   {
+      Next = SC_SIM_RECUR_NEVER;
+   }
+   else
+   {
+      if (Item->Jitter > 0)
+      {
+         SC_SIM_RNG_Seek(&Recur->Rng, ((uint64)i << 32) | Occurrence);
+         Next += (int64)(SC_SIM_RNG_Next(&Recur->Rng) % (2*Item->Jitter + 1)) - Item->Jitter;
+      }
+      if (Next <= (int64)Time) Next = (int64)Time + 1;
+   }
+
+   if (Next < SC_SIM_RECUR_NEVER)
+   {
+      Item->NextTime   = (uint32)Next;
+      Item->Occurrence = Occurrence;
+      Item->Pending    = true;
+   }
+   else
+   {
+      Item->NextTime = SC_SIM_RECUR_NEVER;
+      Item->Pending  = false;
+   }
+
+   UpdateNextTime(Recur);
+
+   return Item;
+
+} /* End SC_SIM_RECUR_Schedule() */
+
+
+/******************************************************************************
+** Function: UpdateNextTime
+**
+*/
+static void UpdateNextTime(SC_SIM_RECUR_Class_t *Recur)
+{
+
+   uint16 i;
+
+   Recur->NextTime = SC_SIM_RECUR_NEVER;
+   for (i=0; i < Recur->ItemCnt; i++)
+   {
+      if (Recur->Item[i].NextTime < Recur->NextTime) Recur->NextTime = Recur->Item[i].NextTime;
+   }
+
+} /* End UpdateNextTime() */
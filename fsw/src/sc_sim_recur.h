@@ -0,0 +1,136 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Define the recurring event command generators
+**
+** Notes:
+**   1. A recurring definition describes a series of event commands that
+**      occur every Period seconds from Start, limited by an occurrence
+**      count and/or a last time. Each occurrence can be moved by a random
+**      jitter of up to +/- Jitter seconds. The jitter is limited to less
+**      than half the period so occurrences stay in order.
+**   2. Like the fault slots, only the next occurrence of each item is
+**      computed. The sim adds it to the event command list and asks for
+**      the item's following occurrence when its time is reached, so an
+**      item takes one event command entry however long the scenario is.
+**   3. An occurrence's jitter is drawn from the recurring model's random
+**      stream at a position keyed by the item and the occurrence number,
+**      so it doesn't depend on when the occurrence is computed.
+**   4. Occurrences that can't be added before their time, e.g. the ones
+**      skipped from the scenario initialization to the first step, are
+**      skipped and don't count against the occurrence count.
+**
+*/
+
+#ifndef _sc_sim_recur_
+#define _sc_sim_recur_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "sc_sim_rng.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SC_SIM_RECUR_MAX    (8)
+#define SC_SIM_RECUR_NEVER  (0xFFFFFFFF)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+
+   int32   Start;           /* Sim time of the first occurrence */
+   uint32  Period;          /* Seconds between occurrences, 0 for a single occurrence */
+   uint32  Count;           /* Number of occurrences, 0 for no limit */
+   int32   Until;           /* No occurrences after this sim time, 0 for no limit */
+   uint32  Jitter;          /* Seconds */
+   uint8   SubSys;
+   uint8   Id;
+   uint8   ScanfType;
+   const char *Param;
+
+} SC_SIM_RECUR_Def_t;
+
+
+typedef struct
+{
+
+   const SC_SIM_RECUR_Def_t *Def;
+   uint32  Jitter;          /* Def's jitter limited to less than half the period */
+   uint32  Occurrence;      /* Number of the pending occurrence */
+   uint32  NextTime;        /* Sim time of the pending occurrence */
+   bool    Pending;         /* NextTime is an occurrence, not a request to compute one */
+   uint32  FireCnt;
+
+} SC_SIM_RECUR_Item_t;
+
+
+typedef struct
+{
+
+   SC_SIM_RNG_Class_t Rng;
+   uint32  NextTime;        /* Earliest item time */
+   uint16  ItemCnt;
+   uint32  FireCnt;
+
+   SC_SIM_RECUR_Item_t Item[SC_SIM_RECUR_MAX];
+
+} SC_SIM_RECUR_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SC_SIM_RECUR_Reset
+**
+** Load a scenario's recurring definitions and select the run's jitter
+** stream. Definitions beyond SC_SIM_RECUR_MAX are ignored. The items
+** compute their first occurrence on the first schedule.
+**
+*/
+void SC_SIM_RECUR_Reset(SC_SIM_RECUR_Class_t *Recur, const SC_SIM_RECUR_Def_t *Def, uint16 DefCnt,
+                        uint64 RunId, uint16 CraftId);
+
+
+/******************************************************************************
+** Function: SC_SIM_RECUR_Schedule
+**
+** Return an item whose pending occurrence time has been reached after
+** computing its next occurrence, NULL if no item is due. The caller adds
+** the item's event command at the item's NextTime and calls again until
+** it gets NULL.
+**
+** Notes:
+**   1. An item's NextTime is SC_SIM_RECUR_NEVER when it has no more
+**      occurrences.
+**   2. The next occurrence is always after Time.
+**
+*/
+const SC_SIM_RECUR_Item_t *SC_SIM_RECUR_Schedule(SC_SIM_RECUR_Class_t *Recur, uint32 Time);
+
+
+#endif /* _sc_sim_recur_ */
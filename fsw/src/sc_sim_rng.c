@@ -0,0 +1,460 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Implement the random number service
+**
+** Notes:
+**   1. The ziggurat tables are file scope data computed on the first seed.
+**      They only depend on constants so every stream shares them.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <math.h>
+
+#include "sc_sim_rng.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define PHILOX_M0  (0xD2511F53)
+#define PHILOX_M1  (0xCD9E8D57)
+#define PHILOX_W0  (0x9E3779B9)   /* Key schedule, golden ratio */
+#define PHILOX_W1  (0xBB67AE85)   /* Key schedule, sqrt(3)-1 */
+
+#define ZIG_LAYERS  (128)
+#define ZIG_R       (3.442619855899)        /* Start of the tail */
+#define ZIG_V       (9.91256303526217e-3)   /* Area of each layer */
+#define ZIG_SCALE   (16777216.0)            /* Magnitude is a 24 bit integer */
+
+#define WORD_TO_FLOAT(W)  (((float)((W) >> 8) + 0.5f)*(1.0f/16777216.0f))
+
+#define LANES       (8)     /* Blocks generated together */
+#define FILL_CHUNK  (256)   /* Words per batch, a multiple of 4*LANES */
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static bool   ZigReady = false;
+static uint32 ZigK[ZIG_LAYERS];   /* Magnitudes below ZigK[i] are inside layer i's rectangle */
+static float  ZigW[ZIG_LAYERS];   /* Magnitude to deviate scale of layer i */
+static float  ZigF[ZIG_LAYERS];   /* Density at layer i's edge */
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static inline void Philox(const uint32 Key[2], uint32 Ctr0, uint32 Ctr1, uint32 Ctr3, uint32 Out[4]);
+static void  GenBlocks(SC_SIM_RNG_Class_t *Rng, uint32 *Word, uint32 BlockCnt);
+static void  NextBlock(SC_SIM_RNG_Class_t *Rng);
+static void  ZigSetup(void);
+static float ZigSlow(SC_SIM_RNG_Class_t *Rng, uint32 Word);
+
+
+/******************************************************************************
+** Function: SC_SIM_RNG_Seed
+**
+*/
+void SC_SIM_RNG_Seed(SC_SIM_RNG_Class_t *Rng, uint64 RunId, uint16 CraftId, uint16 ModelId)
+{
+
+   if (!ZigReady) ZigSetup();
+
+   Rng->Key[0] = (uint32)RunId;
+   Rng->Key[1] = ((uint32)CraftId << 16) | ModelId;
+   Rng->Ctr[0] = 0;
+   Rng->Ctr[1] = 0;
+   Rng->Ctr[2] = 0;
+   Rng->Ctr[3] = (uint32)(RunId >> 32);
+   Rng->BufIdx = 4;
+
+} /* End SC_SIM_RNG_Seed() */
+
+
+/******************************************************************************
+** Function: SC_SIM_RNG_Seek
+**
+*/
+void SC_SIM_RNG_Seek(SC_SIM_RNG_Class_t *Rng, uint64 Pos)
+{
+
+   uint64 Block = Pos >> 2;
+
+   Rng->Ctr[0] = (uint32)Block;
+   Rng->Ctr[1] = (uint32)(Block >> 32);
+   Rng->BufIdx = 4;
+
+   if ((Pos & 3) != 0)
+   {
+      NextBlock(Rng);
+      Rng->BufIdx = (uint16)(Pos & 3);
+   }
+
+} /* End SC_SIM_RNG_Seek() */
+
+
+/******************************************************************************
+** Function: SC_SIM_RNG_Tell
+**
+*/
+uint64 SC_SIM_RNG_Tell(const SC_SIM_RNG_Class_t *Rng)
+{
+
+   uint64 Block = ((uint64)Rng->Ctr[1] << 32) | Rng->Ctr[0];
+
+   return (Rng->BufIdx < 4) ? ((Block - 1) << 2) + Rng->BufIdx : (Block << 2);
+
+} /* End SC_SIM_RNG_Tell() */
+
+
+/******************************************************************************
+** Function: SC_SIM_RNG_Next
+**
+*/
+uint32 SC_SIM_RNG_Next(SC_SIM_RNG_Class_t *Rng)
+{
+
+   if (Rng->BufIdx >= 4) NextBlock(Rng);
+
+   return Rng->Buf[Rng->BufIdx++];
+
+} /* End SC_SIM_RNG_Next() */
+
+
+/******************************************************************************
+** Function: SC_SIM_RNG_Uniform
+**
+*/
+double SC_SIM_RNG_Uniform(SC_SIM_RNG_Class_t *Rng)
+{
+
+   uint64 Hi = SC_SIM_RNG_Next(Rng) >> 6;   /* 26 bits */
+   uint64 Lo = SC_SIM_RNG_Next(Rng) >> 5;   /* 27 bits */
+
+   return ((double)((Hi << 27) | Lo) + 1.0)*(1.0/9007199254740992.0);
+
+} /* End SC_SIM_RNG_Uniform() */
+
+
+/******************************************************************************
+** Function: SC_SIM_RNG_Normal
+**
+*/
+float SC_SIM_RNG_Normal(SC_SIM_RNG_Class_t *Rng)
+{
+
+   uint32 Word = SC_SIM_RNG_Next(Rng);
+   uint32 Mag  = Word >> 8;
+   uint32 i    = Word & (ZIG_LAYERS-1);
+
+   if (Mag < ZigK[i]) return (Word & 0x80) ? -(float)Mag*ZigW[i] : (float)Mag*ZigW[i];
+
+   return ZigSlow(Rng, Word);
+
+} /* End SC_SIM_RNG_Normal() */
+
+
+/******************************************************************************
+** Function: SC_SIM_RNG_FillUniform
+**
+*/
+void SC_SIM_RNG_FillUniform(SC_SIM_RNG_Class_t *Rng, float *U, uint32 Cnt)
+{
+
+   uint32 Word[FILL_CHUNK];
+   uint32 i = 0, j, Len;
+
+   while (Rng->BufIdx < 4 && i < Cnt)
+   {
+      U[i++] = WORD_TO_FLOAT(Rng->Buf[Rng->BufIdx++]);
+   }
+
+   while ((Cnt - i) >= 4)
+   {
+      Len = (Cnt - i) & ~3u;
+      if (Len > FILL_CHUNK) Len = FILL_CHUNK;
+      GenBlocks(Rng, Word, Len/4);
+      for (j=0; j < Len; j++)
+      {
+         U[i+j] = WORD_TO_FLOAT(Word[j]);
+      }
+      i += Len;
+   }
+
+   while (i < Cnt)
+   {
+      U[i++] = WORD_TO_FLOAT(SC_SIM_RNG_Next(Rng));
+   }
+
+} /* End SC_SIM_RNG_FillUniform() */
+
+
+/******************************************************************************
+** Function: SC_SIM_RNG_FillNormal
+**
+** Notes:
+**   1. Words are generated a chunk at a time and the ziggurat is applied to
+**      the chunk so the Philox loop stays separate from the branches.
+**
+*/
+void SC_SIM_RNG_FillNormal(SC_SIM_RNG_Class_t *Rng, float *N, uint32 Cnt)
+{
+
+   uint32 Word[FILL_CHUNK];
+   uint32 Mag, Layer;
+   uint32 i = 0, j, Len;
+
+   while (i < Cnt)
+   {
+
+      /* A chunk starts on a block boundary so leftover words are used one at a time */
+      if (Rng->BufIdx < 4 || (Cnt - i) < 4)
+      {
+         N[i++] = SC_SIM_RNG_Normal(Rng);
+         continue;
+      }
+
+      Len = (Cnt - i) & ~3u;
+      if (Len > FILL_CHUNK) Len = FILL_CHUNK;
+
+      GenBlocks(Rng, Word, Len/4);
+
+      for (j=0; j < Len; j++)
+      {
+         Mag   = Word[j] >> 8;
+         Layer = Word[j] & (ZIG_LAYERS-1);
+         if (Mag < ZigK[Layer])
+         {
+            N[i+j] = (Word[j] & 0x80) ? -(float)Mag*ZigW[Layer] : (float)Mag*ZigW[Layer];
+         }
+         else
+         {
+            N[i+j] = ZigSlow(Rng, Word[j]);
+         }
+      }
+      i += Len;
+
+   } /* End while */
+
+} /* End SC_SIM_RNG_FillNormal() */
+
+
+/******************************************************************************
+** Function: Philox
+**
+** Compute Philox4x32-10 output block (Ctr0, Ctr1, 0, Ctr3).
+**
+*/
+static inline void Philox(const uint32 Key[2], uint32 Ctr0, uint32 Ctr1, uint32 Ctr3, uint32 Out[4])
+{
+
+   uint32 C0 = Ctr0, C1 = Ctr1, C2 = 0, C3 = Ctr3;
+   uint32 K0 = Key[0], K1 = Key[1];
+   uint64 P0, P1;
+   int    r;
+
+   for (r=0; r < 10; r++)
+   {
+      P0 = (uint64)PHILOX_M0*C0;
+      P1 = (uint64)PHILOX_M1*C2;
+      C0 = (uint32)(P1 >> 32) ^ C1 ^ K0;
+      C2 = (uint32)(P0 >> 32) ^ C3 ^ K1;
+      C1 = (uint32)P1;
+      C3 = (uint32)P0;
+      K0 += PHILOX_W0;
+      K1 += PHILOX_W1;
+   }
+
+   Out[0] = C0;
+   Out[1] = C1;
+   Out[2] = C2;
+   Out[3] = C3;
+
+} /* End Philox() */
+
+
+/******************************************************************************
+** Function: GenBlocks
+**
+** Generate BlockCnt blocks from the stream's counter into Word and advance
+** the counter.
+**
+** Notes:
+**   1. Groups of LANES blocks are computed round by round across the group
+**      so the independent multiplies of different blocks overlap (and
+**      vectorize where the target supports it).
+**
+*/
+static void GenBlocks(SC_SIM_RNG_Class_t *Rng, uint32 *Word, uint32 BlockCnt)
+{
+
+   uint64 Block = ((uint64)Rng->Ctr[1] << 32) | Rng->Ctr[0];
+   uint32 Key0 = Rng->Key[0], Key1 = Rng->Key[1], Ctr3 = Rng->Ctr[3];
+   uint32 C[4][LANES], K0, K1, Lo0, Lo1;
+   uint64 P0, P1;
+   uint32 b = 0, l, r;
+
+   for (; (BlockCnt - b) >= LANES; b += LANES)
+   {
+
+      for (l=0; l < LANES; l++)
+      {
+         C[0][l] = (uint32)(Block + b + l);
+         C[1][l] = (uint32)((Block + b + l) >> 32);
+         C[2][l] = 0;
+         C[3][l] = Ctr3;
+      }
+
+      K0 = Key0;
+      K1 = Key1;
+      for (r=0; r < 10; r++)
+      {
+         for (l=0; l < LANES; l++)
+         {
+            P0  = (uint64)PHILOX_M0*C[0][l];
+            P1  = (uint64)PHILOX_M1*C[2][l];
+            Lo0 = (uint32)P0;
+            Lo1 = (uint32)P1;
+            C[0][l] = (uint32)(P1 >> 32) ^ C[1][l] ^ K0;
+            C[2][l] = (uint32)(P0 >> 32) ^ C[3][l] ^ K1;
+            C[1][l] = Lo1;
+            C[3][l] = Lo0;
+         }
+         K0 += PHILOX_W0;
+         K1 += PHILOX_W1;
+      }
+
+      for (l=0; l < LANES; l++)
+      {
+         Word[4*(b+l)]     = C[0][l];
+         Word[4*(b+l) + 1] = C[1][l];
+         Word[4*(b+l) + 2] = C[2][l];
+         Word[4*(b+l) + 3] = C[3][l];
+      }
+
+   } /* End lane group loop */
+
+   for (; b < BlockCnt; b++)
+   {
+      Philox(Rng->Key, (uint32)(Block + b), (uint32)((Block + b) >> 32), Rng->Ctr[3], &Word[4*b]);
+   }
+
+   Block += BlockCnt;
+   Rng->Ctr[0] = (uint32)Block;
+   Rng->Ctr[1] = (uint32)(Block >> 32);
+
+} /* End GenBlocks() */
+
+
+/******************************************************************************
+** Function: NextBlock
+**
+*/
+static void NextBlock(SC_SIM_RNG_Class_t *Rng)
+{
+
+   Philox(Rng->Key, Rng->Ctr[0], Rng->Ctr[1], Rng->Ctr[3], Rng->Buf);
+
+   if (++Rng->Ctr[0] == 0) Rng->Ctr[1]++;
+   Rng->BufIdx = 0;
+
+} /* End NextBlock() */
+
+
+/******************************************************************************
+** Function: ZigSetup
+**
+** Compute the layer edges of the 128 layer ziggurat (Marsaglia & Tsang,
+** "The Ziggurat Method for Generating Random Variables", 2000).
+**
+*/
+static void ZigSetup(void)
+{
+
+   double Dn = ZIG_R, Tn = ZIG_R;
+   double Q  = ZIG_V/exp(-0.5*ZIG_R*ZIG_R);
+   int    i;
+
+   ZigK[0] = (uint32)((Dn/Q)*ZIG_SCALE);
+   ZigK[1] = 0;
+   ZigW[0] = (float)(Q/ZIG_SCALE);
+   ZigW[ZIG_LAYERS-1] = (float)(Dn/ZIG_SCALE);
+   ZigF[0] = 1.0f;
+   ZigF[ZIG_LAYERS-1] = (float)exp(-0.5*Dn*Dn);
+
+   for (i=(ZIG_LAYERS-2); i >= 1; i--)
+   {
+      Dn = sqrt(-2.0*log(ZIG_V/Dn + exp(-0.5*Dn*Dn)));
+      ZigK[i+1] = (uint32)((Dn/Tn)*ZIG_SCALE);
+      Tn = Dn;
+      ZigF[i] = (float)exp(-0.5*Dn*Dn);
+      ZigW[i] = (float)(Dn/ZIG_SCALE);
+   }
+
+   ZigReady = true;
+
+} /* End ZigSetup() */
+
+
+/******************************************************************************
+** Function: ZigSlow
+**
+** Handle a word outside its layer's rectangle: the tail for layer 0 and
+** the wedge test for the other layers. New words are drawn until one is
+** accepted.
+**
+*/
+static float ZigSlow(SC_SIM_RNG_Class_t *Rng, uint32 Word)
+{
+
+   uint32 Mag   = Word >> 8;
+   uint32 Layer = Word & (ZIG_LAYERS-1);
+   float  X, Y;
+
+   for (;;)
+   {
+
+      if (Layer == 0)
+      {
+         /* Marsaglia's tail method beyond R */
+         do
+         {
+            X = (float)(-log(SC_SIM_RNG_Uniform(Rng))/ZIG_R);
+            Y = (float)(-log(SC_SIM_RNG_Uniform(Rng)));
+         } while ((Y + Y) < (X*X));
+         return (Word & 0x80) ? -(float)(ZIG_R + X) : (float)(ZIG_R + X);
+      }
+
+      X = (float)Mag*ZigW[Layer];
+      if ((ZigF[Layer] + WORD_TO_FLOAT(SC_SIM_RNG_Next(Rng))*(ZigF[Layer-1] - ZigF[Layer])) < expf(-0.5f*X*X))
+      {
+         return (Word & 0x80) ? -X : X;
+      }
+
+      Word  = SC_SIM_RNG_Next(Rng);
+      Mag   = Word >> 8;
+      Layer = Word & (ZIG_LAYERS-1);
+      if (Mag < ZigK[Layer]) return (Word & 0x80) ? -(float)Mag*ZigW[Layer] : (float)Mag*ZigW[Layer];
+
+   } /* End for */
+
+} /* End ZigSlow() */
@@ -0,0 +1,164 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Define the random number service used by stochastic models
+**
+** Notes:
+**   1. The generator is Philox4x32-10 (Salmon et al., "Parallel Random
+**      Numbers: As Easy as 1, 2, 3"), a counter based generator. Output
+**      block n of a stream is a keyed bijection of n so a stream has no
+**      evolving state, jumping ahead is setting the counter and streams
+**      with different keys are independent.
+**   2. Each model owns a stream keyed by (run ID, spacecraft ID, model ID)
+**      so runs and spacecraft are reproducible and can be generated in
+**      parallel without locking or sharing state.
+**   3. A stream is a small value type (key, counter and the unused words
+**      of the current block). Copying the owning model copies its random
+**      state so a saved sim state resumes the same sequence.
+**   4. Normal deviates use the Marsaglia & Tsang ziggurat with 128
+**      layers. The layer index and the magnitude come from different bits
+**      of a word to avoid the correlation of the original method.
+**
+*/
+
+#ifndef _sc_sim_rng_
+#define _sc_sim_rng_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** Model IDs, each model that draws random numbers has its own stream
+*/
+
+#define SC_SIM_RNG_MODEL_FAULT   1
+#define SC_SIM_RNG_MODEL_SENSOR  2
+#define SC_SIM_RNG_MODEL_RECUR   3
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+
+   uint32  Key[2];          /* Run ID low word, spacecraft and model IDs */
+   uint32  Ctr[4];          /* Next block number (words 0-1), run ID high word (word 3) */
+   uint32  Buf[4];          /* Current block */
+   uint16  BufIdx;          /* Next unused word in Buf, 4 when empty */
+
+} SC_SIM_RNG_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SC_SIM_RNG_Seed
+**
+** Select the stream of a model on a spacecraft in a run and position it at
+** the first word.
+**
+*/
+void SC_SIM_RNG_Seed(SC_SIM_RNG_Class_t *Rng, uint64 RunId, uint16 CraftId, uint16 ModelId);
+
+
+/******************************************************************************
+** Function: SC_SIM_RNG_Seek
+**
+** Position the stream at word Pos. O(1), the block containing the word
+** is generated directly from its counter.
+**
+*/
+void SC_SIM_RNG_Seek(SC_SIM_RNG_Class_t *Rng, uint64 Pos);
+
+
+/******************************************************************************
+** Function: SC_SIM_RNG_Tell
+**
+** Return the position of the stream's next word.
+**
+*/
+uint64 SC_SIM_RNG_Tell(const SC_SIM_RNG_Class_t *Rng);
+
+
+/******************************************************************************
+** Function: SC_SIM_RNG_Next
+**
+** Return the next 32 bit word of the stream.
+**
+*/
+uint32 SC_SIM_RNG_Next(SC_SIM_RNG_Class_t *Rng);
+
+
+/******************************************************************************
+** Function: SC_SIM_RNG_Uniform
+**
+** Return a uniform double on (0,1] with 53 random bits.
+**
+*/
+double SC_SIM_RNG_Uniform(SC_SIM_RNG_Class_t *Rng);
+
+
+/******************************************************************************
+** Function: SC_SIM_RNG_Normal
+**
+** Return a standard normal deviate.
+**
+*/
+float SC_SIM_RNG_Normal(SC_SIM_RNG_Class_t *Rng);
+
+
+/******************************************************************************
+** Function: SC_SIM_RNG_FillUniform
+**
+** Fill U with Cnt uniform floats on (0,1).
+**
+** Notes:
+**   1. Each value is the upper 24 bits of one word plus a half step so
+**      the stream advances by Cnt words and 0 and 1 are never returned.
+**   2. Whole blocks are generated in groups that interleave the blocks'
+**      rounds, the scalar path is only used for a partial block.
+**
+*/
+void SC_SIM_RNG_FillUniform(SC_SIM_RNG_Class_t *Rng, float *U, uint32 Cnt);
+
+
+/******************************************************************************
+** Function: SC_SIM_RNG_FillNormal
+**
+** Fill N with Cnt standard normal deviates.
+**
+** Notes:
+**   1. About 1% of the words fall outside the ziggurat's rectangles and
+**      draw extra words so the stream advances by a few percent more
+**      than Cnt.
+**
+*/
+void SC_SIM_RNG_FillNormal(SC_SIM_RNG_Class_t *Rng, float *N, uint32 Cnt);
+
+
+#endif /* _sc_sim_rng_ */
@@ -0,0 +1,212 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Implement the shared resource contact scheduler
+**
+** Notes:
+**   None
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdlib.h>
+
+#include "sc_sim_sched.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static int    CompareEnd(const void *A, const void *B);
+static uint16 SchedulePass(SC_SIM_SCHED_Class_t *Sched, uint16 Resource);
+
+
+/******************************************************************************
+** Function: SC_SIM_SCHED_AddRequest
+**
+*/
+bool SC_SIM_SCHED_AddRequest(SC_SIM_SCHED_Class_t *Sched, uint16 Craft, uint16 Resource,
+                             double Start, double End, double Weight)
+{
+
+   SC_SIM_SCHED_Request_t *Req;
+
+   if (Sched->ReqCnt >= SC_SIM_SCHED_MAX_REQUESTS) return false;
+
+   Req = &Sched->Req[Sched->ReqCnt++];
+   Req->Craft    = Craft;
+   Req->Resource = Resource;
+   Req->Start    = Start;
+   Req->End      = End;
+   Req->Weight   = Weight;
+   Req->Granted  = false;
+
+   return true;
+
+} /* End SC_SIM_SCHED_AddRequest() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SCHED_Clear
+**
+*/
+void SC_SIM_SCHED_Clear(SC_SIM_SCHED_Class_t *Sched)
+{
+
+   Sched->ReqCnt   = 0;
+   Sched->GrantCnt = 0;
+   Sched->DenyCnt  = 0;
+
+} /* End SC_SIM_SCHED_Clear() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SCHED_Resolve
+**
+*/
+uint16 SC_SIM_SCHED_Resolve(SC_SIM_SCHED_Class_t *Sched, const uint16 Capacity[], uint16 ResourceCnt)
+{
+
+   uint16 Resource, Pass, i;
+
+   for (i=0; i < Sched->ReqCnt; i++)
+   {
+      Sched->Req[i].Granted = false;
+   }
+
+   Sched->GrantCnt = 0;
+
+   for (Resource=0; Resource < ResourceCnt && Resource < SC_SIM_SCHED_MAX_RESOURCES; Resource++)
+   {
+      for (Pass=0; Pass < Capacity[Resource]; Pass++)
+      {
+         if (SchedulePass(Sched, Resource) == 0) break;
+      }
+   }
+
+   Sched->DenyCnt = Sched->ReqCnt - Sched->GrantCnt;
+
+   return Sched->GrantCnt;
+
+} /* End SC_SIM_SCHED_Resolve() */
+
+
+/******************************************************************************
+** Function: CompareEnd
+**
+** qsort() comparison of candidates by end time.
+**
+*/
+static int CompareEnd(const void *A, const void *B)
+{
+
+   double EndA = ((const SC_SIM_SCHED_Cand_t *)A)->End;
+   double EndB = ((const SC_SIM_SCHED_Cand_t *)B)->End;
+
+   return (EndA > EndB) - (EndA < EndB);
+
+} /* End CompareEnd() */
+
+
+/******************************************************************************
+** Function: SchedulePass
+**
+** Grant the maximum weight set of non-overlapping ungranted requests for
+** one server of a resource. Returns the number of requests granted.
+**
+** Notes:
+**   1. Best[j] is the best total weight using the first j candidates in
+**      end time order. Candidate j either isn't used, Best[j], or is used
+**      with the best schedule of the candidates that end before it
+**      starts, Best[Pred[j]]. Pred[j] is a binary search since the
+**      candidates are sorted by end time.
+**   2. Requests that touch, one ending when the next starts, don't
+**      overlap.
+**
+*/
+static uint16 SchedulePass(SC_SIM_SCHED_Class_t *Sched, uint16 Resource)
+{
+
+   SC_SIM_SCHED_Cand_t *Cand = Sched->Cand;
+   const SC_SIM_SCHED_Request_t *Req;
+   double Take;
+   uint16 CandCnt = 0, GrantCnt = 0;
+   uint16 i, j, Lo, Hi, Mid;
+
+   for (i=0; i < Sched->ReqCnt; i++)
+   {
+      if (Sched->Req[i].Resource == Resource && !Sched->Req[i].Granted)
+      {
+         Cand[CandCnt].End = Sched->Req[i].End;
+         Cand[CandCnt].Req = i;
+         CandCnt++;
+      }
+   }
+
+   if (CandCnt == 0) return 0;
+
+   qsort(Cand, CandCnt, sizeof(SC_SIM_SCHED_Cand_t), CompareEnd);
+
+   Sched->Best[0] = 0.0;
+   for (j=0; j < CandCnt; j++)
+   {
+
+      Req = &Sched->Req[Cand[j].Req];
+
+      Lo = 0;
+      Hi = j;
+      while (Lo < Hi)
+      {
+         Mid = (Lo + Hi)/2;
+         if (Cand[Mid].End <= Req->Start)
+         {
+            Lo = Mid + 1;
+         }
+         else
+         {
+            Hi = Mid;
+         }
+      }
+      Sched->Pred[j] = Lo;
+
+      Take = Req->Weight + Sched->Best[Lo];
+      Sched->Best[j+1] = (Take > Sched->Best[j]) ? Take : Sched->Best[j];
+
+   } /* End candidate loop */
+
+   /* Walk back through the decisions */
+   j = CandCnt;
+   while (j > 0)
+   {
+      if (Sched->Best[j] > Sched->Best[j-1])
+      {
+         Sched->Req[Cand[j-1].Req].Granted = true;
+         GrantCnt++;
+         j = Sched->Pred[j-1];
+      }
+      else
+      {
+         j--;
+      }
+   }
+
+   Sched->GrantCnt += GrantCnt;
+
+   return GrantCnt;
+
+} /* End SchedulePass() */
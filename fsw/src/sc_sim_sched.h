@@ -0,0 +1,139 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Define a shared resource contact scheduler
+**
+** Notes:
+**   1. Spacecraft (crafts) request time on shared resources (ground
+**      stations and relays). Each request is a visibility window with a
+**      weight. The scheduler grants a subset of the requests so no
+**      resource is used by more crafts than its capacity at any time.
+**   2. Each resource is solved independently. A resource with a capacity
+**      of N is N single server passes, each a weighted interval
+**      scheduling problem solved exactly by dynamic programming over
+**      the requests sorted by end time. A pass only sees the requests the
+**      previous passes didn't grant.
+**   3. A craft may be granted overlapping requests on different resources.
+**      The craft's own contact plan picks between them.
+**   4. Resolving n requests is O(n log n).
+**
+*/
+
+#ifndef _sc_sim_sched_
+#define _sc_sim_sched_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SC_SIM_SCHED_MAX_REQUESTS   (2048)
+#define SC_SIM_SCHED_MAX_RESOURCES  (16)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+
+   uint16  Craft;
+   uint16  Resource;
+   double  Start;
+   double  End;
+   double  Weight;
+   bool    Granted;
+
+} SC_SIM_SCHED_Request_t;
+
+
+/*
+** Request reference sorted by end time
+*/
+typedef struct
+{
+
+   double  End;
+   uint16  Req;
+
+} SC_SIM_SCHED_Cand_t;
+
+
+typedef struct
+{
+
+   uint16  ReqCnt;
+   SC_SIM_SCHED_Request_t Req[SC_SIM_SCHED_MAX_REQUESTS];
+
+   uint16  GrantCnt;
+   uint16  DenyCnt;
+
+   /* Work buffers, one pass at a time */
+
+   SC_SIM_SCHED_Cand_t Cand[SC_SIM_SCHED_MAX_REQUESTS];
+   uint16  Pred[SC_SIM_SCHED_MAX_REQUESTS];      /* Count of candidates that end before candidate j starts */
+   double  Best[SC_SIM_SCHED_MAX_REQUESTS+1];    /* Best total weight using the first j candidates */
+
+} SC_SIM_SCHED_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SC_SIM_SCHED_Clear
+**
+** Remove all requests.
+**
+*/
+void SC_SIM_SCHED_Clear(SC_SIM_SCHED_Class_t *Sched);
+
+
+/******************************************************************************
+** Function: SC_SIM_SCHED_AddRequest
+**
+** Notes:
+**   1. Returns false if the request buffer is full.
+**
+*/
+bool SC_SIM_SCHED_AddRequest(SC_SIM_SCHED_Class_t *Sched, uint16 Craft, uint16 Resource,
+                             double Start, double End, double Weight);
+
+
+/******************************************************************************
+** Function: SC_SIM_SCHED_Resolve
+**
+** Grant the requests that maximize the total granted weight on each
+** resource without exceeding its capacity. Returns the number of granted
+** requests.
+**
+** Notes:
+**   1. Capacity[r] is resource r's simultaneous craft limit. Requests for
+**      resources at or beyond ResourceCnt are denied.
+**
+*/
+uint16 SC_SIM_SCHED_Resolve(SC_SIM_SCHED_Class_t *Sched, const uint16 Capacity[], uint16 ResourceCnt);
+
+
+#endif /* _sc_sim_sched_ */
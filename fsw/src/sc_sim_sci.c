@@ -0,0 +1,268 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Implement the science instrument data generation model
+**
+** Notes:
+**   None
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <math.h>
+
+#include "sc_sim_sci.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static double Acquired(const SC_SIM_SCI_Mode_t *Mode, double Span);
+static double PhaseRef(const SC_SIM_SCI_Class_t *Sci);
+
+
+/******************************************************************************
+** Function: SC_SIM_SCI_Config
+**
+*/
+void SC_SIM_SCI_Config(SC_SIM_SCI_Class_t *Sci, const SC_SIM_TBL_Instr_t *Tbl)
+{
+
+   SC_SIM_SCI_Mode_t *Mode;
+   uint16 i;
+
+   for (i=0; i < SC_SIM_SCI_MODE_CNT; i++)
+   {
+      Mode = &Sci->Mode[i];
+      Mode->ByteRate   = Tbl->Mode[i].Rate*1000.0/8.0/((Tbl->Mode[i].Compression >= 1.0) ? Tbl->Mode[i].Compression : 1.0);
+      Mode->DutyOn     = Tbl->Mode[i].DutyOn;
+      Mode->DutyPeriod = Tbl->Mode[i].DutyPeriod;
+   }
+
+   Sci->DefaultMode = (Tbl->DefaultMode < SC_SIM_SCI_MODE_CNT) ? (uint16)Tbl->DefaultMode : 0;
+   Sci->WarmUp      = Tbl->WarmUp;
+   Sci->FileBytes   = (uint32)(Tbl->FileSize*1.0e6);
+   if (Sci->FileBytes == 0) Sci->FileBytes = 1;
+
+} /* End SC_SIM_SCI_Config() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SCI_Reset
+**
+*/
+void SC_SIM_SCI_Reset(SC_SIM_SCI_Class_t *Sci, double Time)
+{
+
+   Sci->PwrEna     = false;
+   Sci->SciEna     = false;
+   Sci->ModeIdx    = Sci->DefaultMode;
+   Sci->PwrOnTime  = Time;
+   Sci->StartTime  = Time;
+   Sci->LastTime   = Time;
+   Sci->Pending    = 0.0;
+   Sci->TotalBytes = 0;
+
+} /* End SC_SIM_SCI_Reset() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SCI_Advance
+**
+*/
+uint32 SC_SIM_SCI_Advance(SC_SIM_SCI_Class_t *Sci, double Time)
+{
+
+   uint32 Files;
+
+   if (Time > Sci->LastTime)
+   {
+      Sci->Pending += SC_SIM_SCI_Volume(Sci, Sci->LastTime, Time);
+      Sci->LastTime = Time;
+   }
+
+   Files = (uint32)(Sci->Pending/(double)Sci->FileBytes);
+   Sci->Pending    -= (double)Files*(double)Sci->FileBytes;
+   Sci->TotalBytes += (uint64)Files*Sci->FileBytes;
+
+   return Files;
+
+} /* End SC_SIM_SCI_Advance() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SCI_Rate
+**
+*/
+double SC_SIM_SCI_Rate(const SC_SIM_SCI_Class_t *Sci, double Time)
+{
+
+   const SC_SIM_SCI_Mode_t *Mode = &Sci->Mode[Sci->ModeIdx];
+   double Span;
+
+   if (!Sci->PwrEna || !Sci->SciEna) return 0.0;
+
+   Span = Time - PhaseRef(Sci);
+   if (Span < 0.0) return 0.0;
+
+   if (Mode->DutyPeriod > Mode->DutyOn && fmod(Span, Mode->DutyPeriod) >= Mode->DutyOn) return 0.0;
+
+   return Mode->ByteRate*8.0/1000.0;
+
+} /* End SC_SIM_SCI_Rate() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SCI_Ready
+**
+*/
+bool SC_SIM_SCI_Ready(const SC_SIM_SCI_Class_t *Sci, double Time)
+{
+
+   return (Sci->PwrEna && Time >= (Sci->PwrOnTime + Sci->WarmUp));
+
+} /* End SC_SIM_SCI_Ready() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SCI_SetMode
+**
+*/
+bool SC_SIM_SCI_SetMode(SC_SIM_SCI_Class_t *Sci, uint16 Mode, double Time)
+{
+
+   if (Mode >= SC_SIM_SCI_MODE_CNT)
+   {
+      CFE_EVS_SendEvent(SC_SIM_SCI_MODE_EID, CFE_EVS_EventType_ERROR,
+                        "Invalid instrument mode %d, must be less than %d", Mode, SC_SIM_SCI_MODE_CNT);
+      return false;
+   }
+
+   SC_SIM_SCI_Advance(Sci, Time);
+   Sci->ModeIdx   = Mode;
+   Sci->StartTime = Time;
+
+   CFE_EVS_SendEvent(SC_SIM_SCI_MODE_EID, CFE_EVS_EventType_INFORMATION,
+                     "Instrument mode %d selected, %.0f kbps for %.0f of every %.0f sec",
+                     Mode, Sci->Mode[Mode].ByteRate*8.0/1000.0, Sci->Mode[Mode].DutyOn, Sci->Mode[Mode].DutyPeriod);
+
+   return true;
+
+} /* End SC_SIM_SCI_SetMode() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SCI_SetPower
+**
+*/
+void SC_SIM_SCI_SetPower(SC_SIM_SCI_Class_t *Sci, bool Ena, double Time)
+{
+
+   SC_SIM_SCI_Advance(Sci, Time);
+
+   if (Ena && !Sci->PwrEna) Sci->PwrOnTime = Time;
+   Sci->PwrEna = Ena;
+
+} /* End SC_SIM_SCI_SetPower() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SCI_SetScience
+**
+*/
+void SC_SIM_SCI_SetScience(SC_SIM_SCI_Class_t *Sci, bool Ena, double Time)
+{
+
+   SC_SIM_SCI_Advance(Sci, Time);
+
+   if (Ena && !Sci->SciEna) Sci->StartTime = Time;
+   Sci->SciEna = Ena;
+
+} /* End SC_SIM_SCI_SetScience() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SCI_Skip
+**
+*/
+void SC_SIM_SCI_Skip(SC_SIM_SCI_Class_t *Sci, double Time)
+{
+
+   if (Time > Sci->LastTime) Sci->LastTime = Time;
+
+} /* End SC_SIM_SCI_Skip() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SCI_Volume
+**
+*/
+double SC_SIM_SCI_Volume(const SC_SIM_SCI_Class_t *Sci, double T0, double T1)
+{
+
+   const SC_SIM_SCI_Mode_t *Mode = &Sci->Mode[Sci->ModeIdx];
+   double Ref;
+
+   if (!Sci->PwrEna || !Sci->SciEna) return 0.0;
+
+   Ref = PhaseRef(Sci);
+   if (T0 < Ref) T0 = Ref;
+   if (T1 <= T0) return 0.0;
+
+   return Mode->ByteRate*(Acquired(Mode, T1 - Ref) - Acquired(Mode, T0 - Ref));
+
+} /* End SC_SIM_SCI_Volume() */
+
+
+/******************************************************************************
+** Function: Acquired
+**
+** Return the acquisition time in the first Span seconds of a duty cycle
+** sequence.
+**
+*/
+static double Acquired(const SC_SIM_SCI_Mode_t *Mode, double Span)
+{
+
+   double Cycles, Partial;
+
+   if (Mode->DutyPeriod <= Mode->DutyOn) return Span;
+
+   Cycles  = floor(Span/Mode->DutyPeriod);
+   Partial = Span - Cycles*Mode->DutyPeriod;
+
+   return Cycles*Mode->DutyOn + ((Partial < Mode->DutyOn) ? Partial : Mode->DutyOn);
+
+} /* End Acquired() */
+
+
+/******************************************************************************
+** Function: PhaseRef
+**
+** Return the start of the current acquisition, the later of the science
+** start and the end of the warm-up.
+**
+*/
+static double PhaseRef(const SC_SIM_SCI_Class_t *Sci)
+{
+
+   double Ready = Sci->PwrOnTime + Sci->WarmUp;
+
+   return (Sci->StartTime > Ready) ? Sci->StartTime : Ready;
+
+} /* End PhaseRef() */
@@ -0,0 +1,191 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Define a science instrument data generation model
+**
+** Notes:
+**   1. Each instrument mode has a raw data rate, a compression ratio and
+**      a duty cycle: the instrument acquires for DutyOn seconds at the
+**      start of every DutyPeriod seconds.
+**   2. Acquisition starts when science is enabled or the mode changes,
+**      but not before the warm-up time has elapsed since power on. The
+**      duty cycle phase is referenced to the acquisition start.
+**   3. The acquired volume is computed in closed form over any time span
+**      so a step's cost doesn't depend on its length. The state changes
+**      account for the volume up to the change before applying it.
+**   4. Acquired bytes accumulate until they fill a file.
+**
+*/
+
+#ifndef _sc_sim_sci_
+#define _sc_sim_sci_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "sc_sim_tbl.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SC_SIM_SCI_MODE_CNT  SC_SIM_TBL_INSTR_MODE_CNT
+
+/*
+** Event Message IDs
+*/
+
+#define SC_SIM_SCI_MODE_EID  (SC_SIM_SCI_BASE_EID + 0)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+
+   double  ByteRate;        /* Compressed output while acquiring (bytes/sec) */
+   double  DutyOn;          /* Sec */
+   double  DutyPeriod;      /* Sec, acquisition is continuous if not longer than DutyOn */
+
+} SC_SIM_SCI_Mode_t;
+
+
+typedef struct
+{
+
+   /* Configuration */
+
+   SC_SIM_SCI_Mode_t Mode[SC_SIM_SCI_MODE_CNT];
+   uint16  DefaultMode;
+   double  WarmUp;          /* Sec from power on to the first acquisition */
+   uint32  FileBytes;
+
+   /* State */
+
+   bool    PwrEna;
+   bool    SciEna;
+   uint16  ModeIdx;
+   double  PwrOnTime;
+   double  StartTime;       /* Science enabled or mode changed */
+   double  LastTime;        /* Volume has been accounted up to this time */
+   double  Pending;         /* Acquired bytes not yet in a file */
+   uint64  TotalBytes;      /* Bytes delivered in files */
+
+} SC_SIM_SCI_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SC_SIM_SCI_Config
+**
+** Load the modes, warm-up time and file size from the table. The state
+** is kept.
+**
+*/
+void SC_SIM_SCI_Config(SC_SIM_SCI_Class_t *Sci, const SC_SIM_TBL_Instr_t *Tbl);
+
+
+/******************************************************************************
+** Function: SC_SIM_SCI_Reset
+**
+** Power the instrument off, select the default mode and clear the
+** acquired data.
+**
+*/
+void SC_SIM_SCI_Reset(SC_SIM_SCI_Class_t *Sci, double Time);
+
+
+/******************************************************************************
+** Function: SC_SIM_SCI_Advance
+**
+** Account for the data acquired up to Time and return the number of
+** files that are complete. The files' bytes are removed from the pending
+** bytes.
+**
+*/
+uint32 SC_SIM_SCI_Advance(SC_SIM_SCI_Class_t *Sci, double Time);
+
+
+/******************************************************************************
+** Function: SC_SIM_SCI_Rate
+**
+** Return the output data rate (kbps) at Time, 0 when not acquiring.
+**
+*/
+double SC_SIM_SCI_Rate(const SC_SIM_SCI_Class_t *Sci, double Time);
+
+
+/******************************************************************************
+** Function: SC_SIM_SCI_Ready
+**
+** Return true if the instrument is powered and warmed up at Time.
+**
+*/
+bool SC_SIM_SCI_Ready(const SC_SIM_SCI_Class_t *Sci, double Time);
+
+
+/******************************************************************************
+** Function: SC_SIM_SCI_SetMode
+**
+** Notes:
+**   1. Returns false if the mode is invalid.
+**
+*/
+bool SC_SIM_SCI_SetMode(SC_SIM_SCI_Class_t *Sci, uint16 Mode, double Time);
+
+
+/******************************************************************************
+** Function: SC_SIM_SCI_SetPower
+**
+*/
+void SC_SIM_SCI_SetPower(SC_SIM_SCI_Class_t *Sci, bool Ena, double Time);
+
+
+/******************************************************************************
+** Function: SC_SIM_SCI_SetScience
+**
+*/
+void SC_SIM_SCI_SetScience(SC_SIM_SCI_Class_t *Sci, bool Ena, double Time);
+
+
+/******************************************************************************
+** Function: SC_SIM_SCI_Skip
+**
+** Resume the volume accounting at Time without acquiring data for the
+** time skipped.
+**
+*/
+void SC_SIM_SCI_Skip(SC_SIM_SCI_Class_t *Sci, double Time);
+
+
+/******************************************************************************
+** Function: SC_SIM_SCI_Volume
+**
+** Return the bytes acquired from T0 to T1 in the current state.
+**
+*/
+double SC_SIM_SCI_Volume(const SC_SIM_SCI_Class_t *Sci, double T0, double T1);
+
+
+#endif /* _sc_sim_sci_ */
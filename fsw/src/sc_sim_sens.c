@@ -0,0 +1,170 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Implement the sensor models
+**
+** Notes:
+**   None
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <math.h>
+
+#include "sc_sim_sens.h"
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static const uint8 ChanKind[SC_SIM_SENS_CHAN_CNT] =
+{
+
+   SC_SIM_SENS_KIND_CSS,
+   SC_SIM_SENS_KIND_GYRO, SC_SIM_SENS_KIND_GYRO, SC_SIM_SENS_KIND_GYRO,
+   SC_SIM_SENS_KIND_ST,
+   SC_SIM_SENS_KIND_BATT_VOLT,
+   SC_SIM_SENS_KIND_BATT_CURR,
+   SC_SIM_SENS_KIND_TEMP, SC_SIM_SENS_KIND_TEMP, SC_SIM_SENS_KIND_TEMP, SC_SIM_SENS_KIND_TEMP,
+   SC_SIM_SENS_KIND_TEMP, SC_SIM_SENS_KIND_TEMP, SC_SIM_SENS_KIND_TEMP, SC_SIM_SENS_KIND_TEMP
+
+};
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static float NextNormal(SC_SIM_SENS_Class_t *Sens);
+
+
+/******************************************************************************
+** Function: SC_SIM_SENS_Config
+**
+*/
+void SC_SIM_SENS_Config(SC_SIM_SENS_Class_t *Sens, const SC_SIM_TBL_Sens_t *Tbl)
+{
+
+   SC_SIM_SENS_Kind_t *Kind;
+   uint16 i;
+
+   for (i=0; i < SC_SIM_SENS_KIND_CNT; i++)
+   {
+      Kind = &Sens->Kind[i];
+      Kind->Noise  = (Tbl->Kind[i].Noise > 0.0) ? Tbl->Kind[i].Noise : 0.0;
+      Kind->Drift  = (Tbl->Kind[i].Drift > 0.0) ? Tbl->Kind[i].Drift : 0.0;
+      Kind->Lsb    = (Tbl->Kind[i].Lsb   > 0.0) ? Tbl->Kind[i].Lsb   : 0.0;
+      Kind->Period = (Tbl->Kind[i].Period > 0) ? Tbl->Kind[i].Period : 1;
+   }
+
+} /* End SC_SIM_SENS_Config() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SENS_Reset
+**
+*/
+void SC_SIM_SENS_Reset(SC_SIM_SENS_Class_t *Sens, uint64 RunId, uint16 CraftId, uint32 Time)
+{
+
+   uint16 i;
+
+   SC_SIM_RNG_Seed(&Sens->Rng, RunId, CraftId, SC_SIM_RNG_MODEL_SENSOR);
+   Sens->PoolIdx   = SC_SIM_SENS_POOL_LEN;
+   Sens->SampleCnt = 0;
+
+   for (i=0; i < SC_SIM_SENS_CHAN_CNT; i++)
+   {
+      Sens->Chan[i].Bias     = 0.0;
+      Sens->Chan[i].Value    = 0.0;
+      Sens->Chan[i].LastTime = Time;
+      Sens->Chan[i].NextTime = Time;
+   }
+
+} /* End SC_SIM_SENS_Reset() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SENS_Sample
+**
+** Notes:
+**   1. The bias walk's step is scaled by the square root of the time since
+**      the channel's last reading so the drift doesn't depend on the
+**      sample period.
+**   2. Quantization rounds to the nearest LSB.
+**
+*/
+void SC_SIM_SENS_Sample(SC_SIM_SENS_Class_t *Sens, uint32 Time, const float *Truth)
+{
+
+   const SC_SIM_SENS_Kind_t *Kind;
+   SC_SIM_SENS_Chan_t *Chan;
+   float  Reading;
+   uint16 i;
+
+   for (i=0; i < SC_SIM_SENS_CHAN_CNT; i++)
+   {
+
+      Chan = &Sens->Chan[i];
+      if (Time < Chan->NextTime) continue;
+
+      Kind = &Sens->Kind[ChanKind[i]];
+
+      if (Kind->Drift > 0.0 && Time > Chan->LastTime)
+      {
+         Chan->Bias += Kind->Drift*sqrtf((float)(Time - Chan->LastTime))*NextNormal(Sens);
+      }
+
+      Reading = Truth[i] + Chan->Bias;
+      if (Kind->Noise > 0.0)
+      {
+         Reading += Kind->Noise*NextNormal(Sens);
+      }
+      if (Kind->Lsb > 0.0)
+      {
+         Reading = Kind->Lsb*floorf(Reading/Kind->Lsb + 0.5f);
+      }
+
+      Chan->Value    = Reading;
+      Chan->LastTime = Time;
+      Chan->NextTime = Time + Kind->Period;
+      Sens->SampleCnt++;
+
+   } /* End channel loop */
+
+} /* End SC_SIM_SENS_Sample() */
+
+
+/******************************************************************************
+** Function: NextNormal
+**
+** Return the next deviate from the pool, refilling it when empty.
+**
+*/
+static float NextNormal(SC_SIM_SENS_Class_t *Sens)
+{
+
+   if (Sens->PoolIdx >= SC_SIM_SENS_POOL_LEN)
+   {
+      SC_SIM_RNG_FillNormal(&Sens->Rng, Sens->Pool, SC_SIM_SENS_POOL_LEN);
+      Sens->PoolIdx = 0;
+   }
+
+   return Sens->Pool[Sens->PoolIdx++];
+
+} /* End NextNormal() */
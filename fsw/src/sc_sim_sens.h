@@ -0,0 +1,152 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Define the sensor models
+**
+** Notes:
+**   1. Each channel measures a model truth value with white noise, a bias
+**      that drifts as a random walk and an output quantized to the
+**      channel's LSB. A channel holds its last reading between samples.
+**   2. Channels of the same kind (e.g. the three gyro axes or the
+**      thermistors) share the kind's table parameters.
+**   3. Noise draws come from a pool of normal deviates that is refilled a
+**      batch at a time from the sensor model's random stream, so a run ID
+**      always produces the same readings.
+**
+*/
+
+#ifndef _sc_sim_sens_
+#define _sc_sim_sens_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "sc_sim_tbl.h"
+#include "sc_sim_rng.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** Sensor kinds, index the table parameters
+*/
+
+#define SC_SIM_SENS_KIND_CSS        0   /* Coarse sun sensor, cosine of the sun angle */
+#define SC_SIM_SENS_KIND_GYRO       1   /* Body rate (deg/sec) */
+#define SC_SIM_SENS_KIND_ST         2   /* Star tracker attitude error (deg) */
+#define SC_SIM_SENS_KIND_BATT_VOLT  3   /* Volts */
+#define SC_SIM_SENS_KIND_BATT_CURR  4   /* Amps */
+#define SC_SIM_SENS_KIND_TEMP       5   /* Thermistor (deg C) */
+#define SC_SIM_SENS_KIND_CNT        SC_SIM_TBL_SENS_KIND_CNT
+
+/*
+** Channels, the caller's truth array is in this order
+*/
+
+#define SC_SIM_SENS_CSS        0
+#define SC_SIM_SENS_GYRO_X     1
+#define SC_SIM_SENS_GYRO_Y     2
+#define SC_SIM_SENS_GYRO_Z     3
+#define SC_SIM_SENS_ST         4
+#define SC_SIM_SENS_BATT_VOLT  5
+#define SC_SIM_SENS_BATT_CURR  6
+#define SC_SIM_SENS_TEMP_0     7   /* One per thermal network node */
+#define SC_SIM_SENS_TEMP_CNT   8
+#define SC_SIM_SENS_CHAN_CNT   (SC_SIM_SENS_TEMP_0 + SC_SIM_SENS_TEMP_CNT)
+
+#define SC_SIM_SENS_POOL_LEN   (256)   /* Normal deviates generated per batch */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+
+   float   Noise;
+   float   Drift;
+   float   Lsb;
+   uint32  Period;          /* Sec, at least 1 */
+
+} SC_SIM_SENS_Kind_t;
+
+
+typedef struct
+{
+
+   float   Bias;
+   float   Value;           /* Last reading */
+   uint32  LastTime;        /* Sim time of the last reading */
+   uint32  NextTime;        /* Sim time of the next reading */
+
+} SC_SIM_SENS_Chan_t;
+
+
+typedef struct
+{
+
+   SC_SIM_RNG_Class_t Rng;
+   uint16  PoolIdx;         /* Next unused deviate, SC_SIM_SENS_POOL_LEN when empty */
+   uint32  SampleCnt;
+
+   SC_SIM_SENS_Kind_t Kind[SC_SIM_SENS_KIND_CNT];
+   SC_SIM_SENS_Chan_t Chan[SC_SIM_SENS_CHAN_CNT];
+
+   float   Pool[SC_SIM_SENS_POOL_LEN];
+
+} SC_SIM_SENS_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SC_SIM_SENS_Config
+**
+** Load the sensor kinds' parameters from the table. The channels' biases
+** and readings are kept, a new period applies after the next reading.
+**
+*/
+void SC_SIM_SENS_Config(SC_SIM_SENS_Class_t *Sens, const SC_SIM_TBL_Sens_t *Tbl);
+
+
+/******************************************************************************
+** Function: SC_SIM_SENS_Reset
+**
+** Select the run's sensor stream, zero the biases and readings and take
+** the first reading of each channel at Time.
+**
+*/
+void SC_SIM_SENS_Reset(SC_SIM_SENS_Class_t *Sens, uint64 RunId, uint16 CraftId, uint32 Time);
+
+
+/******************************************************************************
+** Function: SC_SIM_SENS_Sample
+**
+** Take a reading of each channel that is due at Time. Truth holds
+** SC_SIM_SENS_CHAN_CNT values in channel order.
+**
+*/
+void SC_SIM_SENS_Sample(SC_SIM_SENS_Class_t *Sens, uint32 Time, const float *Truth);
+
+
+#endif /* _sc_sim_sens_ */
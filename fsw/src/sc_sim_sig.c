@@ -0,0 +1,275 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Implement the inter-model signal bus
+**
+** Notes:
+**   None
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "sc_sim_sig.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool Publish(SC_SIM_SIG_Class_t *Bus, uint16 Id, uint8 Type, int32 IntValue, double FltValue);
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_Constructor
+**
+*/
+void SC_SIM_SIG_Constructor(SC_SIM_SIG_Class_t *Bus)
+{
+
+   memset(Bus, 0, sizeof(SC_SIM_SIG_Class_t));
+   Bus->Version = 2;   /* An acknowledge in the first epoch mustn't invalidate */
+
+} /* End SC_SIM_SIG_Constructor() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_Define
+**
+*/
+bool SC_SIM_SIG_Define(SC_SIM_SIG_Class_t *Bus, uint16 Id, const char *Name, uint8 Type, uint8 Producer)
+{
+
+   SC_SIM_SIG_Signal_t *Sig;
+
+   if (Id >= SC_SIM_SIG_MAX) return false;
+
+   Sig = &Bus->Sig[Id];
+   Sig->Name      = Name;
+   Sig->Type      = Type;
+   Sig->Producer  = Producer;
+   Sig->Version   = 0;
+   Sig->Deadband  = 0.0;
+   Sig->Value.Int = 0;
+   Sig->Value.Flt = 0.0;
+
+   return true;
+
+} /* End SC_SIM_SIG_Define() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_SetDeadband
+**
+*/
+bool SC_SIM_SIG_SetDeadband(SC_SIM_SIG_Class_t *Bus, uint16 Id, double Deadband)
+{
+
+   if (Id >= SC_SIM_SIG_MAX || Bus->Sig[Id].Type != SC_SIM_SIG_FLT || Deadband < 0.0) return false;
+
+   Bus->Sig[Id].Deadband = Deadband;
+
+   return true;
+
+} /* End SC_SIM_SIG_SetDeadband() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_SetBool
+**
+*/
+bool SC_SIM_SIG_SetBool(SC_SIM_SIG_Class_t *Bus, uint16 Id, bool Value)
+{
+
+   return Publish(Bus, Id, SC_SIM_SIG_BOOL, Value ? 1 : 0, 0.0);
+
+} /* End SC_SIM_SIG_SetBool() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_SetInt
+**
+*/
+bool SC_SIM_SIG_SetInt(SC_SIM_SIG_Class_t *Bus, uint16 Id, int32 Value)
+{
+
+   return Publish(Bus, Id, SC_SIM_SIG_INT, Value, 0.0);
+
+} /* End SC_SIM_SIG_SetInt() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_SetFlt
+**
+*/
+bool SC_SIM_SIG_SetFlt(SC_SIM_SIG_Class_t *Bus, uint16 Id, double Value)
+{
+
+   return Publish(Bus, Id, SC_SIM_SIG_FLT, 0, Value);
+
+} /* End SC_SIM_SIG_SetFlt() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_GetBool
+**
+*/
+bool SC_SIM_SIG_GetBool(const SC_SIM_SIG_Class_t *Bus, uint16 Id)
+{
+
+   return (Bus->Sig[Id].Value.Int != 0);
+
+} /* End SC_SIM_SIG_GetBool() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_GetInt
+**
+*/
+int32 SC_SIM_SIG_GetInt(const SC_SIM_SIG_Class_t *Bus, uint16 Id)
+{
+
+   return Bus->Sig[Id].Value.Int;
+
+} /* End SC_SIM_SIG_GetInt() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_GetFlt
+**
+*/
+double SC_SIM_SIG_GetFlt(const SC_SIM_SIG_Class_t *Bus, uint16 Id)
+{
+
+   return Bus->Sig[Id].Value.Flt;
+
+} /* End SC_SIM_SIG_GetFlt() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_NextEpoch
+**
+*/
+void SC_SIM_SIG_NextEpoch(SC_SIM_SIG_Class_t *Bus)
+{
+
+   Bus->Version++;
+
+} /* End SC_SIM_SIG_NextEpoch() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_Subscribe
+**
+*/
+void SC_SIM_SIG_Subscribe(SC_SIM_SIG_Sub_t *Sub, uint16 Id)
+{
+
+   if (Id < SC_SIM_SIG_MAX) Sub->Mask |= ((uint32)1 << Id);
+
+} /* End SC_SIM_SIG_Subscribe() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_Changed
+**
+*/
+bool SC_SIM_SIG_Changed(const SC_SIM_SIG_Class_t *Bus, const SC_SIM_SIG_Sub_t *Sub)
+{
+
+   uint32 Mask;
+   uint16 i;
+
+   if (Sub->Seen == 0) return true;
+
+   for (Mask = Sub->Mask, i = 0; Mask != 0; Mask >>= 1, i++)
+   {
+      if ((Mask & 1) && Bus->Sig[i].Version > Sub->Seen) return true;
+   }
+
+   return false;
+
+} /* End SC_SIM_SIG_Changed() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_Ack
+**
+** Notes:
+**   1. Bus epochs start at 2 so Seen is never 0 after an acknowledge.
+**
+*/
+void SC_SIM_SIG_Ack(const SC_SIM_SIG_Class_t *Bus, SC_SIM_SIG_Sub_t *Sub)
+{
+
+   Sub->Seen = Bus->Version - 1;
+
+} /* End SC_SIM_SIG_Ack() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_Invalidate
+**
+*/
+void SC_SIM_SIG_Invalidate(SC_SIM_SIG_Sub_t *Sub)
+{
+
+   Sub->Seen = 0;
+
+} /* End SC_SIM_SIG_Invalidate() */
+
+
+/******************************************************************************
+** Function: Publish
+**
+** Store a value and stamp the signal with the current epoch if it changed.
+** A float only changes when it moves beyond the signal's deadband.
+**
+*/
+static bool Publish(SC_SIM_SIG_Class_t *Bus, uint16 Id, uint8 Type, int32 IntValue, double FltValue)
+{
+
+   SC_SIM_SIG_Signal_t *Sig;
+
+   if (Id >= SC_SIM_SIG_MAX || Bus->Sig[Id].Type != Type)
+   {
+      Bus->RejectCnt++;
+      return false;
+   }
+
+   Sig = &Bus->Sig[Id];
+   if (Sig->Version != 0 &&
+       ((Type == SC_SIM_SIG_FLT) ? (fabs(Sig->Value.Flt - FltValue) <= Sig->Deadband) : (Sig->Value.Int == IntValue)))
+   {
+      return false;
+   }
+
+   if (Type == SC_SIM_SIG_FLT)
+   {
+      Sig->Value.Flt = FltValue;
+   }
+   else
+   {
+      Sig->Value.Int = IntValue;
+   }
+   Sig->Version = Bus->Version;
+
+   return true;
+
+} /* End Publish() */
@@ -0,0 +1,220 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Define the inter-model signal bus
+**
+** Notes:
+**   1. Models publish their outputs as named, typed signals and read the
+**      outputs of other models from the bus instead of from the other
+**      models' state. Each signal records its producer and each consumer
+**      declares the signals it subscribes to so the model dependency
+**      graph is explicit.
+**   2. Publishing a value that doesn't change is a no-op. A change stamps
+**      the signal with the bus epoch so a consumer can tell whether any of
+**      its inputs changed since it last acknowledged them by comparing
+**      versions. Models use this to skip recomputing values that only
+**      depend on quiescent inputs.
+**   3. The epoch is advanced by the model scheduler before each level of
+**      models, publishing doesn't write shared bus state so models in a
+**      level can run concurrently. An acknowledge doesn't cover changes
+**      stamped with the current epoch, a change made later in the same
+**      epoch is never missed. A consumer's inputs are published in
+**      earlier levels so this only adds a spurious change when a
+**      consumer acknowledges outside the scheduler.
+**   4. A subscription is a bit mask so the bus holds at most 32 signals
+**      and a change check is a loop over the subscribed bits.
+**   5. A float signal that varies continuously can be given a deadband.
+**      A publish within the deadband of the last changed value is a no-op
+**      and the bus holds the last changed value, so a consumer of the
+**      signal only recomputes when the value has moved by more than the
+**      deadband.
+**
+*/
+
+#ifndef _sc_sim_sig_
+#define _sc_sim_sig_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SC_SIM_SIG_MAX  (32)   /* Subscriptions are a uint32 mask */
+
+/*
+** Signal types
+*/
+
+#define SC_SIM_SIG_UNDEF  0
+#define SC_SIM_SIG_BOOL   1
+#define SC_SIM_SIG_INT    2
+#define SC_SIM_SIG_FLT    3
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+
+   const char *Name;
+   uint8   Type;
+   uint8   Producer;        /* Subsystem that publishes the signal */
+   uint32  Version;         /* Bus epoch of the last change, 0 if never published */
+   double  Deadband;        /* Float publishes within this of the value are not a change */
+   
+   union
+   {
+      int32   Int;          /* Bool and int signals */
+      double  Flt;
+   } Value;
+
+} SC_SIM_SIG_Signal_t;
+
+
+typedef struct
+{
+
+   uint32  Mask;            /* Bit n set when subscribed to signal n */
+   uint32  Seen;            /* Changes up to this epoch have been acknowledged, 0 reports a change */
+
+} SC_SIM_SIG_Sub_t;
+
+
+typedef struct
+{
+
+   uint32  Version;         /* Current epoch, starts at 2 */
+   uint32  RejectCnt;       /* Publishes with the wrong type or an undefined ID, not thread safe */
+
+   SC_SIM_SIG_Signal_t Sig[SC_SIM_SIG_MAX];
+
+} SC_SIM_SIG_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_Constructor
+**
+** Remove all signal definitions.
+**
+*/
+void SC_SIM_SIG_Constructor(SC_SIM_SIG_Class_t *Bus);
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_Define
+**
+** Define signal Id with a zero value. Returns false if Id is out of range.
+**
+*/
+bool SC_SIM_SIG_Define(SC_SIM_SIG_Class_t *Bus, uint16 Id, const char *Name, uint8 Type, uint8 Producer);
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_SetDeadband
+**
+** Set a float signal's change deadband. Returns false if Id isn't a
+** float signal or the deadband is negative.
+**
+*/
+bool SC_SIM_SIG_SetDeadband(SC_SIM_SIG_Class_t *Bus, uint16 Id, double Deadband);
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_SetBool, SC_SIM_SIG_SetInt, SC_SIM_SIG_SetFlt
+**
+** Publish a signal's value. Returns true if the value changed.
+**
+** Notes:
+**   1. A publish whose type doesn't match the signal's definition is
+**      rejected and counted, it's a model wiring error.
+**
+*/
+bool SC_SIM_SIG_SetBool(SC_SIM_SIG_Class_t *Bus, uint16 Id, bool Value);
+bool SC_SIM_SIG_SetInt(SC_SIM_SIG_Class_t *Bus, uint16 Id, int32 Value);
+bool SC_SIM_SIG_SetFlt(SC_SIM_SIG_Class_t *Bus, uint16 Id, double Value);
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_GetBool, SC_SIM_SIG_GetInt, SC_SIM_SIG_GetFlt
+**
+** Return a signal's value.
+**
+*/
+bool   SC_SIM_SIG_GetBool(const SC_SIM_SIG_Class_t *Bus, uint16 Id);
+int32  SC_SIM_SIG_GetInt(const SC_SIM_SIG_Class_t *Bus, uint16 Id);
+double SC_SIM_SIG_GetFlt(const SC_SIM_SIG_Class_t *Bus, uint16 Id);
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_NextEpoch
+**
+** Start a new epoch, called when no model is executing.
+**
+*/
+void SC_SIM_SIG_NextEpoch(SC_SIM_SIG_Class_t *Bus);
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_Subscribe
+**
+** Add signal Id to a consumer's inputs.
+**
+*/
+void SC_SIM_SIG_Subscribe(SC_SIM_SIG_Sub_t *Sub, uint16 Id);
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_Changed
+**
+** Return true if an input changed since the consumer's last acknowledge
+** or the consumer has been invalidated.
+**
+*/
+bool SC_SIM_SIG_Changed(const SC_SIM_SIG_Class_t *Bus, const SC_SIM_SIG_Sub_t *Sub);
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_Ack
+**
+** Mark the consumer's inputs as seen, up to the previous epoch.
+**
+*/
+void SC_SIM_SIG_Ack(const SC_SIM_SIG_Class_t *Bus, SC_SIM_SIG_Sub_t *Sub);
+
+
+/******************************************************************************
+** Function: SC_SIM_SIG_Invalidate
+**
+** Force the next change check to report a change, used when something
+** other than the inputs (e.g. a table load) affects the consumer.
+**
+*/
+void SC_SIM_SIG_Invalidate(SC_SIM_SIG_Sub_t *Sub);
+
+
+#endif /* _sc_sim_sig_ */
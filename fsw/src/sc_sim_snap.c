@@ -0,0 +1,104 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Implement the double buffered state snapshot
+**
+** Notes:
+**   1. The sequence counts and the published buffer index are accessed
+**      with the GCC atomic builtins so the buffer copies can't be
+**      reordered across them.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "sc_sim_snap.h"
+
+
+/******************************************************************************
+** Function: SC_SIM_SNAP_Constructor
+**
+*/
+bool SC_SIM_SNAP_Constructor(SC_SIM_SNAP_Class_t *Snap, uint16 Size)
+{
+
+   memset(Snap, 0, sizeof(SC_SIM_SNAP_Class_t));
+   
+   if (Size > SC_SIM_SNAP_MAX_SIZE) return false;
+   
+   Snap->Size = Size;
+   
+   return true;
+
+} /* End SC_SIM_SNAP_Constructor() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SNAP_Write
+**
+*/
+void SC_SIM_SNAP_Write(SC_SIM_SNAP_Class_t *Snap, const void *Data)
+{
+
+   uint16 i = Snap->Pub ^ 1;
+
+   __atomic_store_n(&Snap->Seq[i], Snap->Seq[i] + 1, __ATOMIC_RELAXED);
+   __atomic_thread_fence(__ATOMIC_RELEASE);
+   
+   memcpy(Snap->Buf[i], Data, Snap->Size);
+   
+   __atomic_store_n(&Snap->Seq[i], Snap->Seq[i] + 1, __ATOMIC_RELEASE);
+   __atomic_store_n(&Snap->Pub, i, __ATOMIC_RELEASE);
+   
+   __atomic_store_n(&Snap->WriteCnt, Snap->WriteCnt + 1, __ATOMIC_RELEASE);
+
+} /* End SC_SIM_SNAP_Write() */
+
+
+/******************************************************************************
+** Function: SC_SIM_SNAP_Read
+**
+*/
+bool SC_SIM_SNAP_Read(SC_SIM_SNAP_Class_t *Snap, void *Data)
+{
+
+   uint16 i;
+   uint32 Seq;
+
+   if (__atomic_load_n(&Snap->WriteCnt, __ATOMIC_ACQUIRE) == 0) return false;
+   
+   for (;;)
+   {
+   
+      i   = __atomic_load_n(&Snap->Pub, __ATOMIC_ACQUIRE);
+      Seq = __atomic_load_n(&Snap->Seq[i], __ATOMIC_ACQUIRE);
+      
+      if ((Seq & 1) == 0)
+      {
+         memcpy(Data, Snap->Buf[i], Snap->Size);
+         __atomic_thread_fence(__ATOMIC_ACQUIRE);
+         if (__atomic_load_n(&Snap->Seq[i], __ATOMIC_RELAXED) == Seq) break;
+      }
+      
+      Snap->RetryCnt++;
+   
+   }
+   
+   return true;
+
+} /* End SC_SIM_SNAP_Read() */
@@ -0,0 +1,101 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Define the double buffered state snapshot
+**
+** Notes:
+**   1. A snapshot passes a block of state from one writer task to reader
+**      tasks without a lock so a reader never waits for the writer. The
+**      writer fills the buffer that isn't published and then publishes
+**      it, so a reader normally copies a buffer that isn't being written.
+**   2. Each buffer has a sequence count that's odd while the buffer is
+**      being written. A reader that sees an odd count or a count that
+**      changed during its copy was overtaken by the writer and copies the
+**      newly published buffer again.
+**   3. Only one task may write at a time. Writers are serialized by the
+**      owner, e.g. by writing while holding the lock that protects the
+**      state being copied.
+**
+*/
+
+#ifndef _sc_sim_snap_
+#define _sc_sim_snap_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SC_SIM_SNAP_MAX_SIZE  (1024)   /* Bytes */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+
+   uint16  Size;          /* Bytes */
+   uint16  Pub;           /* Buffer readers copy */
+   uint32  Seq[2];        /* Odd while the buffer is being written */
+   uint32  WriteCnt;
+   uint32  RetryCnt;      /* Reads repeated because the writer overtook the reader */
+   
+   uint8   Buf[2][SC_SIM_SNAP_MAX_SIZE];
+
+} SC_SIM_SNAP_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SC_SIM_SNAP_Constructor
+**
+** Return false if Size is larger than SC_SIM_SNAP_MAX_SIZE.
+**
+*/
+bool SC_SIM_SNAP_Constructor(SC_SIM_SNAP_Class_t *Snap, uint16 Size);
+
+
+/******************************************************************************
+** Function: SC_SIM_SNAP_Write
+**
+** Copy Size bytes from Data into the snapshot and publish them.
+**
+*/
+void SC_SIM_SNAP_Write(SC_SIM_SNAP_Class_t *Snap, const void *Data);
+
+
+/******************************************************************************
+** Function: SC_SIM_SNAP_Read
+**
+** Copy the last published snapshot to Data. Return false and leave Data
+** unchanged if nothing has been published.
+**
+*/
+bool SC_SIM_SNAP_Read(SC_SIM_SNAP_Class_t *Snap, void *Data);
+
+
+#endif /* _sc_sim_snap_ */
@@ -49,27 +49,219 @@ static SC_SIM_TBL_Class_t* ScSimTbl = NULL;
 
 static SC_SIM_TBL_Data_t TblData; /* Working buffer for loads */
 
+static const char *RecVcKey[SC_SIM_TBL_REC_VC_CNT] = { "hk", "sci", "evs" };
+static const char *SensKindKey[SC_SIM_TBL_SENS_KIND_CNT] = { "css", "gyro", "st", "batt-volt", "batt-curr", "temp" };
+
 static CJSON_Obj_t JsonTblObjs[] = {
 
    /* Table Data Address   Data Length      Updated  Data Type   Float,  Query string    Query string len (exclude '\0') */
    
-   { &TblData.Adcs.Tbd1,   sizeof(uint32),  false,   JSONNumber, false,  { "adcs.tbd-1",  (sizeof("adcs.tbd-1")-1)}  },
-   { &TblData.Adcs.Tbd2,   sizeof(uint32),  false,   JSONNumber, false,  { "adcs.tbd-2",  (sizeof("adcs.tbd-2")-1)}  },
-
-   { &TblData.Cdh.Tbd1,    sizeof(uint32),  false,   JSONNumber, false,  { "cdh.tbd-1",   (sizeof("cdh.tbd-1")-1)}   },
-   { &TblData.Cdh.Tbd2,    sizeof(uint32),  false,   JSONNumber, false,  { "cdh.tbd-2",   (sizeof("cdh.tbd-2")-1)}   },
-
-   { &TblData.Comm.Tbd1,   sizeof(uint32),  false,   JSONNumber, false,  { "comm.tbd-1",  (sizeof("comm.tbd-1")-1)}  },
-   { &TblData.Comm.Tbd2,   sizeof(uint32),  false,   JSONNumber, false,  { "comm.tbd-2",  (sizeof("comm.tbd-2")-1)}  },
-
-   { &TblData.Fsw.Tbd1,    sizeof(uint32),  false,   JSONNumber, false,  { "fsw.tbd-1",   (sizeof("fsw.tbd-1")-1)}   },
-   { &TblData.Fsw.Tbd2,    sizeof(uint32),  false,   JSONNumber, false,  { "fsw.tbd-2",   (sizeof("fsw.tbd-2")-1)}   },
-
-   { &TblData.Power.Tbd1,  sizeof(uint32),  false,   JSONNumber, false,  { "power.tbd-1", (sizeof("power.tbd-1")-1)} },
-   { &TblData.Power.Tbd2,  sizeof(uint32),  false,   JSONNumber, false,  { "power.tbd-2", (sizeof("power.tbd-2")-1)} },
-
-   { &TblData.Therm.Tbd1,  sizeof(uint32),  false,   JSONNumber, false,  { "therm.tbd-1", (sizeof("therm.tbd-1")-1)} },
-   { &TblData.Therm.Tbd2,  sizeof(uint32),  false,   JSONNumber, false,  { "therm.tbd-2", (sizeof("therm.tbd-2")-1)} },
+   { &TblData.Adcs.OrbitProp,     sizeof(uint32), false, JSONNumber, false, { "adcs.orbit-prop",     (sizeof("adcs.orbit-prop")-1)}     },
+   { &TblData.Adcs.BallisticCoef, sizeof(float),  false, JSONNumber, true,  { "adcs.ballistic-coef", (sizeof("adcs.ballistic-coef")-1)} },
+   { &TblData.Adcs.SrpCoef,       sizeof(float),  false, JSONNumber, true,  { "adcs.srp-coef",       (sizeof("adcs.srp-coef")-1)}       },
+   { &TblData.Adcs.MaxStep,       sizeof(float),  false, JSONNumber, true,  { "adcs.max-step",       (sizeof("adcs.max-step")-1)}       },
+   { &TblData.Adcs.RelTol,        sizeof(float),  false, JSONNumber, true,  { "adcs.rel-tol",        (sizeof("adcs.rel-tol")-1)}        },
+
+   { &TblData.Cdh.BootTimeA,     sizeof(uint32), false, JSONNumber, false, { "cdh.boot-time-a",     (sizeof("cdh.boot-time-a")-1)}     },
+   { &TblData.Cdh.BootTimeB,     sizeof(uint32), false, JSONNumber, false, { "cdh.boot-time-b",     (sizeof("cdh.boot-time-b")-1)}     },
+   { &TblData.Cdh.PwrCycOff,     sizeof(uint32), false, JSONNumber, false, { "cdh.pwr-cyc-off",     (sizeof("cdh.pwr-cyc-off")-1)}     },
+   { &TblData.Cdh.WdTimeout,     sizeof(uint32), false, JSONNumber, false, { "cdh.wd-timeout",      (sizeof("cdh.wd-timeout")-1)}      },
+   { &TblData.Cdh.WdKickPeriod,  sizeof(uint32), false, JSONNumber, false, { "cdh.wd-kick-period",  (sizeof("cdh.wd-kick-period")-1)}  },
+
+   { &TblData.Comm.PlannerEna,             sizeof(uint32), false, JSONNumber, false, { "comm.planner-ena",         (sizeof("comm.planner-ena")-1)} },
+   { &TblData.Comm.Policy,                 sizeof(uint32), false, JSONNumber, false, { "comm.policy",              (sizeof("comm.policy")-1)} },
+   { &TblData.Comm.Horizon,                sizeof(float),  false, JSONNumber, true,  { "comm.horizon",             (sizeof("comm.horizon")-1)} },
+   { &TblData.Comm.GridStep,               sizeof(float),  false, JSONNumber, true,  { "comm.grid-step",           (sizeof("comm.grid-step")-1)} },
+   { &TblData.Comm.MinPass,                sizeof(float),  false, JSONNumber, true,  { "comm.min-pass",            (sizeof("comm.min-pass")-1)} },
+   { &TblData.Comm.RelayGrazeAlt,          sizeof(float),  false, JSONNumber, true,  { "comm.relay-graze-alt",     (sizeof("comm.relay-graze-alt")-1)} },
+   { &TblData.Comm.Station[0].Ena,         sizeof(uint32), false, JSONNumber, false, { "comm.gs-1-ena",            (sizeof("comm.gs-1-ena")-1)} },
+   { &TblData.Comm.Station[0].Lat,         sizeof(float),  false, JSONNumber, true,  { "comm.gs-1-lat",            (sizeof("comm.gs-1-lat")-1)} },
+   { &TblData.Comm.Station[0].Lon,         sizeof(float),  false, JSONNumber, true,  { "comm.gs-1-lon",            (sizeof("comm.gs-1-lon")-1)} },
+   { &TblData.Comm.Station[0].Alt,         sizeof(float),  false, JSONNumber, true,  { "comm.gs-1-alt",            (sizeof("comm.gs-1-alt")-1)} },
+   { &TblData.Comm.Station[0].MinElev,     sizeof(float),  false, JSONNumber, true,  { "comm.gs-1-min-elev",       (sizeof("comm.gs-1-min-elev")-1)} },
+   { &TblData.Comm.Station[0].Capacity,    sizeof(uint32), false, JSONNumber, false, { "comm.gs-1-capacity",       (sizeof("comm.gs-1-capacity")-1)} },
+   { &TblData.Comm.Station[1].Ena,         sizeof(uint32), false, JSONNumber, false, { "comm.gs-2-ena",            (sizeof("comm.gs-2-ena")-1)} },
+   { &TblData.Comm.Station[1].Lat,         sizeof(float),  false, JSONNumber, true,  { "comm.gs-2-lat",            (sizeof("comm.gs-2-lat")-1)} },
+   { &TblData.Comm.Station[1].Lon,         sizeof(float),  false, JSONNumber, true,  { "comm.gs-2-lon",            (sizeof("comm.gs-2-lon")-1)} },
+   { &TblData.Comm.Station[1].Alt,         sizeof(float),  false, JSONNumber, true,  { "comm.gs-2-alt",            (sizeof("comm.gs-2-alt")-1)} },
+   { &TblData.Comm.Station[1].MinElev,     sizeof(float),  false, JSONNumber, true,  { "comm.gs-2-min-elev",       (sizeof("comm.gs-2-min-elev")-1)} },
+   { &TblData.Comm.Station[1].Capacity,    sizeof(uint32), false, JSONNumber, false, { "comm.gs-2-capacity",       (sizeof("comm.gs-2-capacity")-1)} },
+   { &TblData.Comm.Station[2].Ena,         sizeof(uint32), false, JSONNumber, false, { "comm.gs-3-ena",            (sizeof("comm.gs-3-ena")-1)} },
+   { &TblData.Comm.Station[2].Lat,         sizeof(float),  false, JSONNumber, true,  { "comm.gs-3-lat",            (sizeof("comm.gs-3-lat")-1)} },
+   { &TblData.Comm.Station[2].Lon,         sizeof(float),  false, JSONNumber, true,  { "comm.gs-3-lon",            (sizeof("comm.gs-3-lon")-1)} },
+   { &TblData.Comm.Station[2].Alt,         sizeof(float),  false, JSONNumber, true,  { "comm.gs-3-alt",            (sizeof("comm.gs-3-alt")-1)} },
+   { &TblData.Comm.Station[2].MinElev,     sizeof(float),  false, JSONNumber, true,  { "comm.gs-3-min-elev",       (sizeof("comm.gs-3-min-elev")-1)} },
+   { &TblData.Comm.Station[2].Capacity,    sizeof(uint32), false, JSONNumber, false, { "comm.gs-3-capacity",       (sizeof("comm.gs-3-capacity")-1)} },
+   { &TblData.Comm.Station[3].Ena,         sizeof(uint32), false, JSONNumber, false, { "comm.gs-4-ena",            (sizeof("comm.gs-4-ena")-1)} },
+   { &TblData.Comm.Station[3].Lat,         sizeof(float),  false, JSONNumber, true,  { "comm.gs-4-lat",            (sizeof("comm.gs-4-lat")-1)} },
+   { &TblData.Comm.Station[3].Lon,         sizeof(float),  false, JSONNumber, true,  { "comm.gs-4-lon",            (sizeof("comm.gs-4-lon")-1)} },
+   { &TblData.Comm.Station[3].Alt,         sizeof(float),  false, JSONNumber, true,  { "comm.gs-4-alt",            (sizeof("comm.gs-4-alt")-1)} },
+   { &TblData.Comm.Station[3].MinElev,     sizeof(float),  false, JSONNumber, true,  { "comm.gs-4-min-elev",       (sizeof("comm.gs-4-min-elev")-1)} },
+   { &TblData.Comm.Station[3].Capacity,    sizeof(uint32), false, JSONNumber, false, { "comm.gs-4-capacity",       (sizeof("comm.gs-4-capacity")-1)} },
+   { &TblData.Comm.Relay[0].Ena,           sizeof(uint32), false, JSONNumber, false, { "comm.relay-1-ena",         (sizeof("comm.relay-1-ena")-1)} },
+   { &TblData.Comm.Relay[0].Lon,           sizeof(float),  false, JSONNumber, true,  { "comm.relay-1-lon",         (sizeof("comm.relay-1-lon")-1)} },
+   { &TblData.Comm.Relay[0].Capacity,      sizeof(uint32), false, JSONNumber, false, { "comm.relay-1-capacity",    (sizeof("comm.relay-1-capacity")-1)} },
+   { &TblData.Comm.Relay[1].Ena,           sizeof(uint32), false, JSONNumber, false, { "comm.relay-2-ena",         (sizeof("comm.relay-2-ena")-1)} },
+   { &TblData.Comm.Relay[1].Lon,           sizeof(float),  false, JSONNumber, true,  { "comm.relay-2-lon",         (sizeof("comm.relay-2-lon")-1)} },
+   { &TblData.Comm.Relay[1].Capacity,      sizeof(uint32), false, JSONNumber, false, { "comm.relay-2-capacity",    (sizeof("comm.relay-2-capacity")-1)} },
+   { &TblData.Comm.Relay[2].Ena,           sizeof(uint32), false, JSONNumber, false, { "comm.relay-3-ena",         (sizeof("comm.relay-3-ena")-1)} },
+   { &TblData.Comm.Relay[2].Lon,           sizeof(float),  false, JSONNumber, true,  { "comm.relay-3-lon",         (sizeof("comm.relay-3-lon")-1)} },
+   { &TblData.Comm.Relay[2].Capacity,      sizeof(uint32), false, JSONNumber, false, { "comm.relay-3-capacity",    (sizeof("comm.relay-3-capacity")-1)} },
+   { &TblData.Comm.Peer[0].Ena,            sizeof(uint32), false, JSONNumber, false, { "comm.peer-1-ena",          (sizeof("comm.peer-1-ena")-1)} },
+   { &TblData.Comm.Peer[0].RaanOffset,     sizeof(float),  false, JSONNumber, true,  { "comm.peer-1-raan-offset",  (sizeof("comm.peer-1-raan-offset")-1)} },
+   { &TblData.Comm.Peer[0].PhaseOffset,    sizeof(float),  false, JSONNumber, true,  { "comm.peer-1-phase-offset", (sizeof("comm.peer-1-phase-offset")-1)} },
+   { &TblData.Comm.Peer[0].RecFill,        sizeof(float),  false, JSONNumber, true,  { "comm.peer-1-rec-fill",     (sizeof("comm.peer-1-rec-fill")-1)} },
+   { &TblData.Comm.Peer[1].Ena,            sizeof(uint32), false, JSONNumber, false, { "comm.peer-2-ena",          (sizeof("comm.peer-2-ena")-1)} },
+   { &TblData.Comm.Peer[1].RaanOffset,     sizeof(float),  false, JSONNumber, true,  { "comm.peer-2-raan-offset",  (sizeof("comm.peer-2-raan-offset")-1)} },
+   { &TblData.Comm.Peer[1].PhaseOffset,    sizeof(float),  false, JSONNumber, true,  { "comm.peer-2-phase-offset", (sizeof("comm.peer-2-phase-offset")-1)} },
+   { &TblData.Comm.Peer[1].RecFill,        sizeof(float),  false, JSONNumber, true,  { "comm.peer-2-rec-fill",     (sizeof("comm.peer-2-rec-fill")-1)} },
+   { &TblData.Comm.Peer[2].Ena,            sizeof(uint32), false, JSONNumber, false, { "comm.peer-3-ena",          (sizeof("comm.peer-3-ena")-1)} },
+   { &TblData.Comm.Peer[2].RaanOffset,     sizeof(float),  false, JSONNumber, true,  { "comm.peer-3-raan-offset",  (sizeof("comm.peer-3-raan-offset")-1)} },
+   { &TblData.Comm.Peer[2].PhaseOffset,    sizeof(float),  false, JSONNumber, true,  { "comm.peer-3-phase-offset", (sizeof("comm.peer-3-phase-offset")-1)} },
+   { &TblData.Comm.Peer[2].RecFill,        sizeof(float),  false, JSONNumber, true,  { "comm.peer-3-rec-fill",     (sizeof("comm.peer-3-rec-fill")-1)} },
+   { &TblData.Comm.Peer[3].Ena,            sizeof(uint32), false, JSONNumber, false, { "comm.peer-4-ena",          (sizeof("comm.peer-4-ena")-1)} },
+   { &TblData.Comm.Peer[3].RaanOffset,     sizeof(float),  false, JSONNumber, true,  { "comm.peer-4-raan-offset",  (sizeof("comm.peer-4-raan-offset")-1)} },
+   { &TblData.Comm.Peer[3].PhaseOffset,    sizeof(float),  false, JSONNumber, true,  { "comm.peer-4-phase-offset", (sizeof("comm.peer-4-phase-offset")-1)} },
+   { &TblData.Comm.Peer[3].RecFill,        sizeof(float),  false, JSONNumber, true,  { "comm.peer-4-rec-fill",     (sizeof("comm.peer-4-rec-fill")-1)} },
+   { &TblData.Comm.LinkFreq,               sizeof(float),  false, JSONNumber, true,  { "comm.link-freq",           (sizeof("comm.link-freq")-1)} },
+   { &TblData.Comm.Eirp,                   sizeof(float),  false, JSONNumber, true,  { "comm.eirp",                (sizeof("comm.eirp")-1)} },
+   { &TblData.Comm.StationGt,              sizeof(float),  false, JSONNumber, true,  { "comm.gs-gt",               (sizeof("comm.gs-gt")-1)} },
+   { &TblData.Comm.RelayGt,                sizeof(float),  false, JSONNumber, true,  { "comm.relay-gt",            (sizeof("comm.relay-gt")-1)} },
+   { &TblData.Comm.AtmLoss,                sizeof(float),  false, JSONNumber, true,  { "comm.atm-loss",            (sizeof("comm.atm-loss")-1)} },
+   { &TblData.Comm.ImplLoss,               sizeof(float),  false, JSONNumber, true,  { "comm.impl-loss",           (sizeof("comm.impl-loss")-1)} },
+   { &TblData.Comm.LinkMargin,             sizeof(float),  false, JSONNumber, true,  { "comm.link-margin",         (sizeof("comm.link-margin")-1)} },
+   { &TblData.Comm.RateHyst,               sizeof(float),  false, JSONNumber, true,  { "comm.rate-hyst",           (sizeof("comm.rate-hyst")-1)} },
+   { &TblData.Comm.Modcod[0].Rate,         sizeof(float),  false, JSONNumber, true,  { "comm.modcod-1-rate",       (sizeof("comm.modcod-1-rate")-1)} },
+   { &TblData.Comm.Modcod[0].EbN0,         sizeof(float),  false, JSONNumber, true,  { "comm.modcod-1-ebn0",       (sizeof("comm.modcod-1-ebn0")-1)} },
+   { &TblData.Comm.Modcod[1].Rate,         sizeof(float),  false, JSONNumber, true,  { "comm.modcod-2-rate",       (sizeof("comm.modcod-2-rate")-1)} },
+   { &TblData.Comm.Modcod[1].EbN0,         sizeof(float),  false, JSONNumber, true,  { "comm.modcod-2-ebn0",       (sizeof("comm.modcod-2-ebn0")-1)} },
+   { &TblData.Comm.Modcod[2].Rate,         sizeof(float),  false, JSONNumber, true,  { "comm.modcod-3-rate",       (sizeof("comm.modcod-3-rate")-1)} },
+   { &TblData.Comm.Modcod[2].EbN0,         sizeof(float),  false, JSONNumber, true,  { "comm.modcod-3-ebn0",       (sizeof("comm.modcod-3-ebn0")-1)} },
+   { &TblData.Comm.Modcod[3].Rate,         sizeof(float),  false, JSONNumber, true,  { "comm.modcod-4-rate",       (sizeof("comm.modcod-4-rate")-1)} },
+   { &TblData.Comm.Modcod[3].EbN0,         sizeof(float),  false, JSONNumber, true,  { "comm.modcod-4-ebn0",       (sizeof("comm.modcod-4-ebn0")-1)} },
+
+   { &TblData.Fsw.RecCapacity,             sizeof(float),  false, JSONNumber, true,  { "fsw.rec-capacity",         (sizeof("fsw.rec-capacity")-1)} },
+   { &TblData.Fsw.RecVc[0].Priority,       sizeof(uint32), false, JSONNumber, false, { "fsw.rec-hk-priority",      (sizeof("fsw.rec-hk-priority")-1)} },
+   { &TblData.Fsw.RecVc[0].Retention,      sizeof(uint32), false, JSONNumber, false, { "fsw.rec-hk-retention",     (sizeof("fsw.rec-hk-retention")-1)} },
+   { &TblData.Fsw.RecVc[1].Priority,       sizeof(uint32), false, JSONNumber, false, { "fsw.rec-sci-priority",     (sizeof("fsw.rec-sci-priority")-1)} },
+   { &TblData.Fsw.RecVc[1].Retention,      sizeof(uint32), false, JSONNumber, false, { "fsw.rec-sci-retention",    (sizeof("fsw.rec-sci-retention")-1)} },
+   { &TblData.Fsw.RecVc[2].Priority,       sizeof(uint32), false, JSONNumber, false, { "fsw.rec-evs-priority",     (sizeof("fsw.rec-evs-priority")-1)} },
+   { &TblData.Fsw.RecVc[2].Retention,      sizeof(uint32), false, JSONNumber, false, { "fsw.rec-evs-retention",    (sizeof("fsw.rec-evs-retention")-1)} },
+
+   { &TblData.Instr.DefaultMode,           sizeof(uint32), false, JSONNumber, false, { "instr.default-mode",       (sizeof("instr.default-mode")-1)} },
+   { &TblData.Instr.WarmUp,                sizeof(float),  false, JSONNumber, true,  { "instr.warm-up",            (sizeof("instr.warm-up")-1)} },
+   { &TblData.Instr.FileSize,              sizeof(float),  false, JSONNumber, true,  { "instr.file-size",          (sizeof("instr.file-size")-1)} },
+   { &TblData.Instr.TargetEna,             sizeof(uint32), false, JSONNumber, false, { "instr.target-ena",         (sizeof("instr.target-ena")-1)} },
+   { &TblData.Instr.Fov,                   sizeof(float),  false, JSONNumber, true,  { "instr.fov",                (sizeof("instr.fov")-1)} },
+   { &TblData.Instr.Mode[0].Rate,          sizeof(float),  false, JSONNumber, true,  { "instr.mode-1-rate",        (sizeof("instr.mode-1-rate")-1)} },
+   { &TblData.Instr.Mode[0].Compression,   sizeof(float),  false, JSONNumber, true,  { "instr.mode-1-compression", (sizeof("instr.mode-1-compression")-1)} },
+   { &TblData.Instr.Mode[0].DutyOn,        sizeof(float),  false, JSONNumber, true,  { "instr.mode-1-duty-on",     (sizeof("instr.mode-1-duty-on")-1)} },
+   { &TblData.Instr.Mode[0].DutyPeriod,    sizeof(float),  false, JSONNumber, true,  { "instr.mode-1-duty-period", (sizeof("instr.mode-1-duty-period")-1)} },
+   { &TblData.Instr.Mode[1].Rate,          sizeof(float),  false, JSONNumber, true,  { "instr.mode-2-rate",        (sizeof("instr.mode-2-rate")-1)} },
+   { &TblData.Instr.Mode[1].Compression,   sizeof(float),  false, JSONNumber, true,  { "instr.mode-2-compression", (sizeof("instr.mode-2-compression")-1)} },
+   { &TblData.Instr.Mode[1].DutyOn,        sizeof(float),  false, JSONNumber, true,  { "instr.mode-2-duty-on",     (sizeof("instr.mode-2-duty-on")-1)} },
+   { &TblData.Instr.Mode[1].DutyPeriod,    sizeof(float),  false, JSONNumber, true,  { "instr.mode-2-duty-period", (sizeof("instr.mode-2-duty-period")-1)} },
+   { &TblData.Instr.Mode[2].Rate,          sizeof(float),  false, JSONNumber, true,  { "instr.mode-3-rate",        (sizeof("instr.mode-3-rate")-1)} },
+   { &TblData.Instr.Mode[2].Compression,   sizeof(float),  false, JSONNumber, true,  { "instr.mode-3-compression", (sizeof("instr.mode-3-compression")-1)} },
+   { &TblData.Instr.Mode[2].DutyOn,        sizeof(float),  false, JSONNumber, true,  { "instr.mode-3-duty-on",     (sizeof("instr.mode-3-duty-on")-1)} },
+   { &TblData.Instr.Mode[2].DutyPeriod,    sizeof(float),  false, JSONNumber, true,  { "instr.mode-3-duty-period", (sizeof("instr.mode-3-duty-period")-1)} },
+
+   { &TblData.Power.BattCapacity, sizeof(float),  false, JSONNumber, true,  { "power.batt-capacity",    (sizeof("power.batt-capacity")-1)} },
+   { &TblData.Power.BattResistance, sizeof(float),  false, JSONNumber, true,  { "power.batt-resistance",  (sizeof("power.batt-resistance")-1)} },
+   { &TblData.Power.ChargeEff,    sizeof(float),  false, JSONNumber, true,  { "power.charge-eff",       (sizeof("power.charge-eff")-1)} },
+   { &TblData.Power.Ocv[0],       sizeof(float),  false, JSONNumber, true,  { "power.ocv-0",            (sizeof("power.ocv-0")-1)} },
+   { &TblData.Power.Ocv[1],       sizeof(float),  false, JSONNumber, true,  { "power.ocv-10",           (sizeof("power.ocv-10")-1)} },
+   { &TblData.Power.Ocv[2],       sizeof(float),  false, JSONNumber, true,  { "power.ocv-20",           (sizeof("power.ocv-20")-1)} },
+   { &TblData.Power.Ocv[3],       sizeof(float),  false, JSONNumber, true,  { "power.ocv-30",           (sizeof("power.ocv-30")-1)} },
+   { &TblData.Power.Ocv[4],       sizeof(float),  false, JSONNumber, true,  { "power.ocv-40",           (sizeof("power.ocv-40")-1)} },
+   { &TblData.Power.Ocv[5],       sizeof(float),  false, JSONNumber, true,  { "power.ocv-50",           (sizeof("power.ocv-50")-1)} },
+   { &TblData.Power.Ocv[6],       sizeof(float),  false, JSONNumber, true,  { "power.ocv-60",           (sizeof("power.ocv-60")-1)} },
+   { &TblData.Power.Ocv[7],       sizeof(float),  false, JSONNumber, true,  { "power.ocv-70",           (sizeof("power.ocv-70")-1)} },
+   { &TblData.Power.Ocv[8],       sizeof(float),  false, JSONNumber, true,  { "power.ocv-80",           (sizeof("power.ocv-80")-1)} },
+   { &TblData.Power.Ocv[9],       sizeof(float),  false, JSONNumber, true,  { "power.ocv-90",           (sizeof("power.ocv-90")-1)} },
+   { &TblData.Power.Ocv[10],      sizeof(float),  false, JSONNumber, true,  { "power.ocv-100",          (sizeof("power.ocv-100")-1)} },
+   { &TblData.Power.SaIsc,        sizeof(float),  false, JSONNumber, true,  { "power.sa-isc",           (sizeof("power.sa-isc")-1)} },
+   { &TblData.Power.SaRefTemp,    sizeof(float),  false, JSONNumber, true,  { "power.sa-ref-temp",      (sizeof("power.sa-ref-temp")-1)} },
+   { &TblData.Power.SaTempCoef,   sizeof(float),  false, JSONNumber, true,  { "power.sa-temp-coef",     (sizeof("power.sa-temp-coef")-1)} },
+   { &TblData.Power.SaInertialCos, sizeof(float),  false, JSONNumber, true,  { "power.sa-inertial-cos",  (sizeof("power.sa-inertial-cos")-1)} },
+
+   { &TblData.Therm.Heater1OnTemp, sizeof(float),  false, JSONNumber, true,  { "therm.heater-1-on",      (sizeof("therm.heater-1-on")-1)} },
+   { &TblData.Therm.Heater1OffTemp, sizeof(float),  false, JSONNumber, true,  { "therm.heater-1-off",     (sizeof("therm.heater-1-off")-1)} },
+   { &TblData.Therm.Heater2OnTemp, sizeof(float),  false, JSONNumber, true,  { "therm.heater-2-on",      (sizeof("therm.heater-2-on")-1)} },
+   { &TblData.Therm.Heater2OffTemp, sizeof(float),  false, JSONNumber, true,  { "therm.heater-2-off",     (sizeof("therm.heater-2-off")-1)} },
+   { &TblData.Therm.SolarFlux,    sizeof(float),  false, JSONNumber, true,  { "therm.solar-flux",       (sizeof("therm.solar-flux")-1)} },
+   { &TblData.Therm.Albedo,       sizeof(float),  false, JSONNumber, true,  { "therm.albedo",           (sizeof("therm.albedo")-1)} },
+   { &TblData.Therm.EarthIr,      sizeof(float),  false, JSONNumber, true,  { "therm.earth-ir",         (sizeof("therm.earth-ir")-1)} },
+   { &TblData.Therm.Step,         sizeof(float),  false, JSONNumber, true,  { "therm.step",             (sizeof("therm.step")-1)} },
+
+   { &TblData.Load.CdhBase,       sizeof(float),  false, JSONNumber, true,  { "load.cdh-base",          (sizeof("load.cdh-base")-1)} },
+   { &TblData.Load.AdcsSafehold,  sizeof(float),  false, JSONNumber, true,  { "load.adcs-safehold",     (sizeof("load.adcs-safehold")-1)} },
+   { &TblData.Load.AdcsSunPoint,  sizeof(float),  false, JSONNumber, true,  { "load.adcs-sun-point",    (sizeof("load.adcs-sun-point")-1)} },
+   { &TblData.Load.AdcsInertial,  sizeof(float),  false, JSONNumber, true,  { "load.adcs-inertial",     (sizeof("load.adcs-inertial")-1)} },
+   { &TblData.Load.AdcsSlew,      sizeof(float),  false, JSONNumber, true,  { "load.adcs-slew",         (sizeof("load.adcs-slew")-1)} },
+   { &TblData.Load.CommTx,        sizeof(float),  false, JSONNumber, true,  { "load.comm-tx",           (sizeof("load.comm-tx")-1)} },
+   { &TblData.Load.InstrPwr,      sizeof(float),  false, JSONNumber, true,  { "load.instr-pwr",         (sizeof("load.instr-pwr")-1)} },
+   { &TblData.Load.InstrSci,      sizeof(float),  false, JSONNumber, true,  { "load.instr-sci",         (sizeof("load.instr-sci")-1)} },
+   { &TblData.Load.Heater1,       sizeof(float),  false, JSONNumber, true,  { "load.heater-1",          (sizeof("load.heater-1")-1)} },
+   { &TblData.Load.Heater2,       sizeof(float),  false, JSONNumber, true,  { "load.heater-2",          (sizeof("load.heater-2")-1)} },
+
+   { &TblData.Ephem.EpochDay, sizeof(uint32), false, JSONNumber, false,  { "ephem.epoch-day", (sizeof("ephem.epoch-day")-1)} },
+   { &TblData.Ephem.EpochSec, sizeof(uint32), false, JSONNumber, false,  { "ephem.epoch-sec", (sizeof("ephem.epoch-sec")-1)} },
+
+   { &TblData.Rng.RunId, sizeof(uint32), false, JSONNumber, false,  { "rng.run-id", (sizeof("rng.run-id")-1)} },
+
+   { &TblData.Fault.Slot[0].Rate,      sizeof(float),  false, JSONNumber, true,  { "fault.slot-1-rate",     (sizeof("fault.slot-1-rate")-1)} },
+   { &TblData.Fault.Slot[0].SubSys,    sizeof(uint32), false, JSONNumber, false, { "fault.slot-1-subsys",   (sizeof("fault.slot-1-subsys")-1)} },
+   { &TblData.Fault.Slot[0].Event,     sizeof(uint32), false, JSONNumber, false, { "fault.slot-1-event",    (sizeof("fault.slot-1-event")-1)} },
+   { &TblData.Fault.Slot[0].Param,     sizeof(int32),  false, JSONNumber, false, { "fault.slot-1-param",    (sizeof("fault.slot-1-param")-1)} },
+   { &TblData.Fault.Slot[1].Rate,      sizeof(float),  false, JSONNumber, true,  { "fault.slot-2-rate",     (sizeof("fault.slot-2-rate")-1)} },
+   { &TblData.Fault.Slot[1].SubSys,    sizeof(uint32), false, JSONNumber, false, { "fault.slot-2-subsys",   (sizeof("fault.slot-2-subsys")-1)} },
+   { &TblData.Fault.Slot[1].Event,     sizeof(uint32), false, JSONNumber, false, { "fault.slot-2-event",    (sizeof("fault.slot-2-event")-1)} },
+   { &TblData.Fault.Slot[1].Param,     sizeof(int32),  false, JSONNumber, false, { "fault.slot-2-param",    (sizeof("fault.slot-2-param")-1)} },
+   { &TblData.Fault.Slot[2].Rate,      sizeof(float),  false, JSONNumber, true,  { "fault.slot-3-rate",     (sizeof("fault.slot-3-rate")-1)} },
+   { &TblData.Fault.Slot[2].SubSys,    sizeof(uint32), false, JSONNumber, false, { "fault.slot-3-subsys",   (sizeof("fault.slot-3-subsys")-1)} },
+   { &TblData.Fault.Slot[2].Event,     sizeof(uint32), false, JSONNumber, false, { "fault.slot-3-event",    (sizeof("fault.slot-3-event")-1)} },
+   { &TblData.Fault.Slot[2].Param,     sizeof(int32),  false, JSONNumber, false, { "fault.slot-3-param",    (sizeof("fault.slot-3-param")-1)} },
+   { &TblData.Fault.Slot[3].Rate,      sizeof(float),  false, JSONNumber, true,  { "fault.slot-4-rate",     (sizeof("fault.slot-4-rate")-1)} },
+   { &TblData.Fault.Slot[3].SubSys,    sizeof(uint32), false, JSONNumber, false, { "fault.slot-4-subsys",   (sizeof("fault.slot-4-subsys")-1)} },
+   { &TblData.Fault.Slot[3].Event,     sizeof(uint32), false, JSONNumber, false, { "fault.slot-4-event",    (sizeof("fault.slot-4-event")-1)} },
+   { &TblData.Fault.Slot[3].Param,     sizeof(int32),  false, JSONNumber, false, { "fault.slot-4-param",    (sizeof("fault.slot-4-param")-1)} },
+
+   { &TblData.Sens.Kind[0].Noise,      sizeof(float),  false, JSONNumber, true,  { "sens.css-noise",          (sizeof("sens.css-noise")-1)} },
+   { &TblData.Sens.Kind[0].Drift,      sizeof(float),  false, JSONNumber, true,  { "sens.css-drift",          (sizeof("sens.css-drift")-1)} },
+   { &TblData.Sens.Kind[0].Lsb,        sizeof(float),  false, JSONNumber, true,  { "sens.css-lsb",            (sizeof("sens.css-lsb")-1)} },
+   { &TblData.Sens.Kind[0].Period,     sizeof(uint32), false, JSONNumber, false, { "sens.css-period",         (sizeof("sens.css-period")-1)} },
+   { &TblData.Sens.Kind[1].Noise,      sizeof(float),  false, JSONNumber, true,  { "sens.gyro-noise",         (sizeof("sens.gyro-noise")-1)} },
+   { &TblData.Sens.Kind[1].Drift,      sizeof(float),  false, JSONNumber, true,  { "sens.gyro-drift",         (sizeof("sens.gyro-drift")-1)} },
+   { &TblData.Sens.Kind[1].Lsb,        sizeof(float),  false, JSONNumber, true,  { "sens.gyro-lsb",           (sizeof("sens.gyro-lsb")-1)} },
+   { &TblData.Sens.Kind[1].Period,     sizeof(uint32), false, JSONNumber, false, { "sens.gyro-period",        (sizeof("sens.gyro-period")-1)} },
+   { &TblData.Sens.Kind[2].Noise,      sizeof(float),  false, JSONNumber, true,  { "sens.st-noise",           (sizeof("sens.st-noise")-1)} },
+   { &TblData.Sens.Kind[2].Drift,      sizeof(float),  false, JSONNumber, true,  { "sens.st-drift",           (sizeof("sens.st-drift")-1)} },
+   { &TblData.Sens.Kind[2].Lsb,        sizeof(float),  false, JSONNumber, true,  { "sens.st-lsb",             (sizeof("sens.st-lsb")-1)} },
+   { &TblData.Sens.Kind[2].Period,     sizeof(uint32), false, JSONNumber, false, { "sens.st-period",          (sizeof("sens.st-period")-1)} },
+   { &TblData.Sens.Kind[3].Noise,      sizeof(float),  false, JSONNumber, true,  { "sens.batt-volt-noise",    (sizeof("sens.batt-volt-noise")-1)} },
+   { &TblData.Sens.Kind[3].Drift,      sizeof(float),  false, JSONNumber, true,  { "sens.batt-volt-drift",    (sizeof("sens.batt-volt-drift")-1)} },
+   { &TblData.Sens.Kind[3].Lsb,        sizeof(float),  false, JSONNumber, true,  { "sens.batt-volt-lsb",      (sizeof("sens.batt-volt-lsb")-1)} },
+   { &TblData.Sens.Kind[3].Period,     sizeof(uint32), false, JSONNumber, false, { "sens.batt-volt-period",   (sizeof("sens.batt-volt-period")-1)} },
+   { &TblData.Sens.Kind[4].Noise,      sizeof(float),  false, JSONNumber, true,  { "sens.batt-curr-noise",    (sizeof("sens.batt-curr-noise")-1)} },
+   { &TblData.Sens.Kind[4].Drift,      sizeof(float),  false, JSONNumber, true,  { "sens.batt-curr-drift",    (sizeof("sens.batt-curr-drift")-1)} },
+   { &TblData.Sens.Kind[4].Lsb,        sizeof(float),  false, JSONNumber, true,  { "sens.batt-curr-lsb",      (sizeof("sens.batt-curr-lsb")-1)} },
+   { &TblData.Sens.Kind[4].Period,     sizeof(uint32), false, JSONNumber, false, { "sens.batt-curr-period",   (sizeof("sens.batt-curr-period")-1)} },
+   { &TblData.Sens.Kind[5].Noise,      sizeof(float),  false, JSONNumber, true,  { "sens.temp-noise",         (sizeof("sens.temp-noise")-1)} },
+   { &TblData.Sens.Kind[5].Drift,      sizeof(float),  false, JSONNumber, true,  { "sens.temp-drift",         (sizeof("sens.temp-drift")-1)} },
+   { &TblData.Sens.Kind[5].Lsb,        sizeof(float),  false, JSONNumber, true,  { "sens.temp-lsb",           (sizeof("sens.temp-lsb")-1)} },
+   { &TblData.Sens.Kind[5].Period,     sizeof(uint32), false, JSONNumber, false, { "sens.temp-period",        (sizeof("sens.temp-period")-1)} },
+
+   { &TblData.Rate.MinorHz,            sizeof(uint32), false, JSONNumber, false, { "rate.minor-hz",           (sizeof("rate.minor-hz")-1)} },
+   { &TblData.Rate.AdcsHz,             sizeof(float),  false, JSONNumber, true,  { "rate.adcs-hz",            (sizeof("rate.adcs-hz")-1)} },
+   { &TblData.Rate.PowerHz,            sizeof(float),  false, JSONNumber, true,  { "rate.power-hz",           (sizeof("rate.power-hz")-1)} },
+   { &TblData.Rate.ThermHz,            sizeof(float),  false, JSONNumber, true,  { "rate.therm-hz",           (sizeof("rate.therm-hz")-1)} },
+
+   { &TblData.Integ.Adaptive,          sizeof(uint32), false, JSONNumber, false, { "integ.adaptive",          (sizeof("integ.adaptive")-1)} },
+   { &TblData.Integ.RelTol,            sizeof(float),  false, JSONNumber, true,  { "integ.rel-tol",           (sizeof("integ.rel-tol")-1)} },
+   { &TblData.Integ.AbsTol,            sizeof(float),  false, JSONNumber, true,  { "integ.abs-tol",           (sizeof("integ.abs-tol")-1)} },
+   { &TblData.Integ.MaxStep,           sizeof(float),  false, JSONNumber, true,  { "integ.max-step",          (sizeof("integ.max-step")-1)} },
+   { &TblData.Integ.InputTol,          sizeof(float),  false, JSONNumber, true,  { "integ.input-tol",         (sizeof("integ.input-tol")-1)} },
 
 };
 
@@ -106,29 +298,162 @@ bool SC_SIM_TBL_DumpCmd(osal_id_t FileHandle)
 {
 
    char DumpRecord[256];
+   int  i;
 
-   sprintf(DumpRecord,"   \"adcs\": {\n   \"tbd-1\": %d,\n   \"tbd-2\": %d\n   },\n", 
-           ScSimTbl->Data.Adcs.Tbd1, ScSimTbl->Data.Adcs.Tbd2);
+   sprintf(DumpRecord,"   \"adcs\": {\n   \"orbit-prop\": %d,\n   \"ballistic-coef\": %f,\n   \"srp-coef\": %f,\n   \"max-step\": %f,\n   \"rel-tol\": %e\n   },\n", 
+           ScSimTbl->Data.Adcs.OrbitProp, ScSimTbl->Data.Adcs.BallisticCoef, ScSimTbl->Data.Adcs.SrpCoef,
+           ScSimTbl->Data.Adcs.MaxStep, ScSimTbl->Data.Adcs.RelTol);
    OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
    
-   sprintf(DumpRecord,"   \"cdh\": {\n   \"tbd-1\": %d,\n   \"tbd-2\": %d\n   },\n", 
-           ScSimTbl->Data.Cdh.Tbd1, ScSimTbl->Data.Cdh.Tbd2);
+   sprintf(DumpRecord,"   \"cdh\": {\n   \"boot-time-a\": %d,\n   \"boot-time-b\": %d,\n   \"pwr-cyc-off\": %d,\n   \"wd-timeout\": %d,\n   \"wd-kick-period\": %d\n   },\n", 
+           ScSimTbl->Data.Cdh.BootTimeA, ScSimTbl->Data.Cdh.BootTimeB, ScSimTbl->Data.Cdh.PwrCycOff,
+           ScSimTbl->Data.Cdh.WdTimeout, ScSimTbl->Data.Cdh.WdKickPeriod);
    OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
    
-   sprintf(DumpRecord,"   \"comm\": {\n   \"tbd-1\": %d,\n   \"tbd-2\": %d\n   },\n", 
-           ScSimTbl->Data.Comm.Tbd1, ScSimTbl->Data.Comm.Tbd2);
+   sprintf(DumpRecord,"   \"comm\": {\n   \"planner-ena\": %d,\n   \"policy\": %d,\n   \"horizon\": %f,\n   \"grid-step\": %f,\n   \"min-pass\": %f,\n   \"relay-graze-alt\": %f,\n", 
+           ScSimTbl->Data.Comm.PlannerEna, ScSimTbl->Data.Comm.Policy, ScSimTbl->Data.Comm.Horizon,
+           ScSimTbl->Data.Comm.GridStep, ScSimTbl->Data.Comm.MinPass, ScSimTbl->Data.Comm.RelayGrazeAlt);
    OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
    
-   sprintf(DumpRecord,"   \"fsw\": {\n   \"tbd-1\": %d,\n   \"tbd-2\": %d\n   },\n", 
-           ScSimTbl->Data.Fsw.Tbd1, ScSimTbl->Data.Fsw.Tbd2);
+   for (i=0; i < SC_SIM_TBL_STATION_CNT; i++)
+   {
+      sprintf(DumpRecord,"   \"gs-%d-ena\": %d,\n   \"gs-%d-lat\": %f,\n   \"gs-%d-lon\": %f,\n   \"gs-%d-alt\": %f,\n   \"gs-%d-min-elev\": %f,\n   \"gs-%d-capacity\": %d,\n", 
+              i+1, ScSimTbl->Data.Comm.Station[i].Ena, i+1, ScSimTbl->Data.Comm.Station[i].Lat,
+              i+1, ScSimTbl->Data.Comm.Station[i].Lon, i+1, ScSimTbl->Data.Comm.Station[i].Alt,
+              i+1, ScSimTbl->Data.Comm.Station[i].MinElev, i+1, ScSimTbl->Data.Comm.Station[i].Capacity);
+      OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+   }
+
+   for (i=0; i < SC_SIM_TBL_RELAY_CNT; i++)
+   {
+      sprintf(DumpRecord,"   \"relay-%d-ena\": %d,\n   \"relay-%d-lon\": %f,\n   \"relay-%d-capacity\": %d,\n", 
+              i+1, ScSimTbl->Data.Comm.Relay[i].Ena, i+1, ScSimTbl->Data.Comm.Relay[i].Lon,
+              i+1, ScSimTbl->Data.Comm.Relay[i].Capacity);
+      OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+   }
+
+   for (i=0; i < SC_SIM_TBL_PEER_CNT; i++)
+   {
+      sprintf(DumpRecord,"   \"peer-%d-ena\": %d,\n   \"peer-%d-raan-offset\": %f,\n   \"peer-%d-phase-offset\": %f,\n   \"peer-%d-rec-fill\": %f,\n", 
+              i+1, ScSimTbl->Data.Comm.Peer[i].Ena, i+1, ScSimTbl->Data.Comm.Peer[i].RaanOffset,
+              i+1, ScSimTbl->Data.Comm.Peer[i].PhaseOffset, i+1, ScSimTbl->Data.Comm.Peer[i].RecFill);
+      OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+   }
+   
+   sprintf(DumpRecord,"   \"link-freq\": %f,\n   \"eirp\": %f,\n   \"gs-gt\": %f,\n   \"relay-gt\": %f,\n   \"atm-loss\": %f,\n   \"impl-loss\": %f,\n   \"link-margin\": %f,\n   \"rate-hyst\": %f,\n", 
+           ScSimTbl->Data.Comm.LinkFreq, ScSimTbl->Data.Comm.Eirp, ScSimTbl->Data.Comm.StationGt,
+           ScSimTbl->Data.Comm.RelayGt, ScSimTbl->Data.Comm.AtmLoss, ScSimTbl->Data.Comm.ImplLoss,
+           ScSimTbl->Data.Comm.LinkMargin, ScSimTbl->Data.Comm.RateHyst);
    OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+
+   for (i=0; i < SC_SIM_TBL_MODCOD_CNT; i++)
+   {
+      sprintf(DumpRecord,"   \"modcod-%d-rate\": %f,\n   \"modcod-%d-ebn0\": %f%s\n", 
+              i+1, ScSimTbl->Data.Comm.Modcod[i].Rate, i+1, ScSimTbl->Data.Comm.Modcod[i].EbN0,
+              (i == (SC_SIM_TBL_MODCOD_CNT-1)) ? "\n   }," : ",");
+      OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+   }
+   
+   sprintf(DumpRecord,"   \"fsw\": {\n   \"rec-capacity\": %f,\n", 
+           ScSimTbl->Data.Fsw.RecCapacity);
+   OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+
+   for (i=0; i < SC_SIM_TBL_REC_VC_CNT; i++)
+   {
+      sprintf(DumpRecord,"   \"rec-%s-priority\": %d,\n   \"rec-%s-retention\": %d%s\n", 
+              RecVcKey[i], ScSimTbl->Data.Fsw.RecVc[i].Priority, RecVcKey[i], ScSimTbl->Data.Fsw.RecVc[i].Retention,
+              (i == (SC_SIM_TBL_REC_VC_CNT-1)) ? "\n   }," : ",");
+      OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+   }
    
-   sprintf(DumpRecord,"   \"power\": {\n   \"tbd-1\": %d,\n   \"tbd-2\": %d\n   },\n", 
-           ScSimTbl->Data.Power.Tbd1, ScSimTbl->Data.Power.Tbd2);
+   sprintf(DumpRecord,"   \"instr\": {\n   \"default-mode\": %d,\n   \"warm-up\": %f,\n   \"file-size\": %f,\n   \"target-ena\": %d,\n   \"fov\": %f,\n", 
+           ScSimTbl->Data.Instr.DefaultMode, ScSimTbl->Data.Instr.WarmUp, ScSimTbl->Data.Instr.FileSize,
+           ScSimTbl->Data.Instr.TargetEna, ScSimTbl->Data.Instr.Fov);
    OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+
+   for (i=0; i < SC_SIM_TBL_INSTR_MODE_CNT; i++)
+   {
+      sprintf(DumpRecord,"   \"mode-%d-rate\": %f,\n   \"mode-%d-compression\": %f,\n   \"mode-%d-duty-on\": %f,\n   \"mode-%d-duty-period\": %f%s\n", 
+              i+1, ScSimTbl->Data.Instr.Mode[i].Rate, i+1, ScSimTbl->Data.Instr.Mode[i].Compression,
+              i+1, ScSimTbl->Data.Instr.Mode[i].DutyOn, i+1, ScSimTbl->Data.Instr.Mode[i].DutyPeriod,
+              (i == (SC_SIM_TBL_INSTR_MODE_CNT-1)) ? "\n   }," : ",");
+      OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+   }
    
-   sprintf(DumpRecord,"   \"therm\": {\n   \"tbd-1\": %d,\n   \"tbd-2\": %d\n   }\n", 
-           ScSimTbl->Data.Therm.Tbd1, ScSimTbl->Data.Therm.Tbd2);
+   sprintf(DumpRecord,"   \"power\": {\n   \"batt-capacity\": %f,\n   \"batt-resistance\": %f,\n   \"charge-eff\": %f,\n", 
+           ScSimTbl->Data.Power.BattCapacity, ScSimTbl->Data.Power.BattResistance, ScSimTbl->Data.Power.ChargeEff);
+   OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+   
+   for (i=0; i < SC_SIM_TBL_OCV_PTS; i++)
+   {
+      sprintf(DumpRecord,"   \"ocv-%d\": %f,\n", i*10, ScSimTbl->Data.Power.Ocv[i]);
+      OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+   }
+
+   sprintf(DumpRecord,"   \"sa-isc\": %f,\n   \"sa-ref-temp\": %f,\n   \"sa-temp-coef\": %f,\n   \"sa-inertial-cos\": %f\n   },\n", 
+           ScSimTbl->Data.Power.SaIsc, ScSimTbl->Data.Power.SaRefTemp, ScSimTbl->Data.Power.SaTempCoef,
+           ScSimTbl->Data.Power.SaInertialCos);
+   OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+   
+   sprintf(DumpRecord,"   \"therm\": {\n   \"heater-1-on\": %f,\n   \"heater-1-off\": %f,\n   \"heater-2-on\": %f,\n   \"heater-2-off\": %f,\n", 
+           ScSimTbl->Data.Therm.Heater1OnTemp, ScSimTbl->Data.Therm.Heater1OffTemp,
+           ScSimTbl->Data.Therm.Heater2OnTemp, ScSimTbl->Data.Therm.Heater2OffTemp);
+   OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+
+   sprintf(DumpRecord,"   \"solar-flux\": %f,\n   \"albedo\": %f,\n   \"earth-ir\": %f,\n   \"step\": %f\n   },\n", 
+           ScSimTbl->Data.Therm.SolarFlux, ScSimTbl->Data.Therm.Albedo,
+           ScSimTbl->Data.Therm.EarthIr, ScSimTbl->Data.Therm.Step);
+   OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+
+   sprintf(DumpRecord,"   \"load\": {\n   \"cdh-base\": %f,\n   \"adcs-safehold\": %f,\n   \"adcs-sun-point\": %f,\n   \"adcs-inertial\": %f,\n   \"adcs-slew\": %f,\n", 
+           ScSimTbl->Data.Load.CdhBase, ScSimTbl->Data.Load.AdcsSafehold, ScSimTbl->Data.Load.AdcsSunPoint,
+           ScSimTbl->Data.Load.AdcsInertial, ScSimTbl->Data.Load.AdcsSlew);
+   OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+
+   sprintf(DumpRecord,"   \"comm-tx\": %f,\n   \"instr-pwr\": %f,\n   \"instr-sci\": %f,\n   \"heater-1\": %f,\n   \"heater-2\": %f\n   },\n", 
+           ScSimTbl->Data.Load.CommTx, ScSimTbl->Data.Load.InstrPwr, ScSimTbl->Data.Load.InstrSci,
+           ScSimTbl->Data.Load.Heater1, ScSimTbl->Data.Load.Heater2);
+   OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+
+   sprintf(DumpRecord,"   \"ephem\": {\n   \"epoch-day\": %d,\n   \"epoch-sec\": %d\n   },\n", 
+           ScSimTbl->Data.Ephem.EpochDay, ScSimTbl->Data.Ephem.EpochSec);
+   OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+
+   sprintf(DumpRecord,"   \"rng\": {\n   \"run-id\": %d\n   },\n", ScSimTbl->Data.Rng.RunId);
+   OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+
+   sprintf(DumpRecord,"   \"fault\": {\n");
+   OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+
+   for (i=0; i < SC_SIM_TBL_FAULT_CNT; i++)
+   {
+      sprintf(DumpRecord,"   \"slot-%d-rate\": %f,\n   \"slot-%d-subsys\": %d,\n   \"slot-%d-event\": %d,\n   \"slot-%d-param\": %d%s\n", 
+              i+1, ScSimTbl->Data.Fault.Slot[i].Rate, i+1, ScSimTbl->Data.Fault.Slot[i].SubSys,
+              i+1, ScSimTbl->Data.Fault.Slot[i].Event, i+1, ScSimTbl->Data.Fault.Slot[i].Param,
+              (i == (SC_SIM_TBL_FAULT_CNT-1)) ? "\n   }," : ",");
+      OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+   }
+
+   sprintf(DumpRecord,"   \"sens\": {\n");
+   OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+
+   for (i=0; i < SC_SIM_TBL_SENS_KIND_CNT; i++)
+   {
+      sprintf(DumpRecord,"   \"%s-noise\": %f,\n   \"%s-drift\": %f,\n   \"%s-lsb\": %f,\n   \"%s-period\": %d%s\n", 
+              SensKindKey[i], ScSimTbl->Data.Sens.Kind[i].Noise, SensKindKey[i], ScSimTbl->Data.Sens.Kind[i].Drift,
+              SensKindKey[i], ScSimTbl->Data.Sens.Kind[i].Lsb, SensKindKey[i], ScSimTbl->Data.Sens.Kind[i].Period,
+              (i == (SC_SIM_TBL_SENS_KIND_CNT-1)) ? "\n   }," : ",");
+      OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+   }
+
+   sprintf(DumpRecord,"   \"rate\": {\n   \"minor-hz\": %d,\n   \"adcs-hz\": %f,\n   \"power-hz\": %f,\n   \"therm-hz\": %f\n   },\n", 
+           ScSimTbl->Data.Rate.MinorHz, ScSimTbl->Data.Rate.AdcsHz, ScSimTbl->Data.Rate.PowerHz,
+           ScSimTbl->Data.Rate.ThermHz);
+   OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
+
+   sprintf(DumpRecord,"   \"integ\": {\n   \"adaptive\": %d,\n   \"rel-tol\": %e,\n   \"abs-tol\": %e,\n   \"max-step\": %f,\n   \"input-tol\": %f\n   }", 
+           ScSimTbl->Data.Integ.Adaptive, ScSimTbl->Data.Integ.RelTol, ScSimTbl->Data.Integ.AbsTol,
+           ScSimTbl->Data.Integ.MaxStep, ScSimTbl->Data.Integ.InputTol);
    OS_write(FileHandle,DumpRecord,strlen(DumpRecord));
       
 
@@ -60,8 +60,11 @@ typedef void (*SC_SIM_TBL_LoadFunc_t)(void);
 typedef struct
 {
 
-   uint32  Tbd1;
-   uint32  Tbd2;
+   uint32  OrbitProp;       /* 0=Analytic, 1=Numerical (SC_SIM_ORBIT_Prop_t) */
+   float   BallisticCoef;   /* Cd*A/m (m^2/kg), 0 disables drag */
+   float   SrpCoef;         /* Cr*A/m (m^2/kg), 0 disables SRP */
+   float   MaxStep;         /* Numerical integrator maximum step (sec) */
+   float   RelTol;          /* Numerical integrator relative error tolerance */
    
 } SC_SIM_TBL_Adcs_t;
 
@@ -69,43 +72,248 @@ typedef struct
 typedef struct
 {
 
-   uint32  Tbd1;
-   uint32  Tbd2;
+   uint32  BootTimeA;       /* Time from reset to operational with boot image A (sec) */
+   uint32  BootTimeB;       /* Time from reset to operational with boot image B (sec) */
+   uint32  PwrCycOff;       /* Power cycle off time (sec) */
+   uint32  WdTimeout;       /* Watchdog expires this long after the last kick (sec) */
+   uint32  WdKickPeriod;    /* Flight software watchdog kick period (sec) */
    
 } SC_SIM_TBL_Cdh_t;
 
+#define SC_SIM_TBL_STATION_CNT  4   /* Ground stations */
+#define SC_SIM_TBL_RELAY_CNT    3   /* Geosynchronous relays, index+1 is the COMM TDRS ID */
+#define SC_SIM_TBL_PEER_CNT     4   /* Constellation members sharing the stations and relays */
+#define SC_SIM_TBL_MODCOD_CNT   4   /* Downlink modulation/coding steps in increasing rate order */
+
+typedef struct 
+{
+
+   uint32  Ena;
+   float   Lat;             /* Geodetic latitude (deg) */
+   float   Lon;             /* East longitude (deg) */
+   float   Alt;             /* Km */
+   float   MinElev;         /* Minimum elevation for a contact (deg) */
+   uint32  Capacity;        /* Simultaneous spacecraft contacts (antennas) */
+   
+} SC_SIM_TBL_Station_t;
+
+typedef struct 
+{
+
+   uint32  Ena;
+   float   Lon;             /* Geosynchronous slot east longitude (deg) */
+   uint32  Capacity;        /* Simultaneous spacecraft contacts (links) */
+   
+} SC_SIM_TBL_Relay_t;
+
 typedef struct 
 {
 
-   uint32  Tbd1;
-   uint32  Tbd2;
+   uint32  Ena;
+   float   RaanOffset;      /* Orbit plane offset from the simulated spacecraft (deg) */
+   float   PhaseOffset;     /* Mean anomaly offset from the simulated spacecraft (deg) */
+   float   RecFill;         /* Recorder fill used as the peer's contact priority (%) */
+   
+} SC_SIM_TBL_Peer_t;
+
+typedef struct 
+{
+
+   float   Rate;            /* Information rate (kbps), 0 disables the step */
+   float   EbN0;            /* Eb/N0 required by the modulation and coding (dB) */
+   
+} SC_SIM_TBL_Modcod_t;
+
+typedef struct 
+{
+
+   uint32  PlannerEna;      /* Plan contacts from the orbit when one is defined */
+   uint32  Policy;          /* 0=Longest, 1=Priority (SC_SIM_CONTACT_Policy_t) */
+   float   Horizon;         /* Planning span (sec) */
+   float   GridStep;        /* Visibility search step (sec) */
+   float   MinPass;         /* Shortest usable contact (sec) */
+   float   RelayGrazeAlt;   /* Relay line of sight must clear the Earth by this (km) */
+   SC_SIM_TBL_Station_t  Station[SC_SIM_TBL_STATION_CNT];
+   SC_SIM_TBL_Relay_t    Relay[SC_SIM_TBL_RELAY_CNT];
+   SC_SIM_TBL_Peer_t     Peer[SC_SIM_TBL_PEER_CNT];
+   float   LinkFreq;        /* Downlink carrier (GHz) */
+   float   Eirp;            /* Spacecraft EIRP (dBW) */
+   float   StationGt;       /* Ground station G/T (dB/K) */
+   float   RelayGt;         /* Relay G/T (dB/K) */
+   float   AtmLoss;         /* Atmospheric loss at zenith (dB), scaled by 1/sin(elevation) */
+   float   ImplLoss;        /* Implementation and polarization losses (dB) */
+   float   LinkMargin;      /* Margin required above the step's Eb/N0 (dB) */
+   float   RateHyst;        /* Extra margin required to switch up a step (dB) */
+   SC_SIM_TBL_Modcod_t   Modcod[SC_SIM_TBL_MODCOD_CNT];
    
 } SC_SIM_TBL_Comm_t;
 
+#define SC_SIM_TBL_REC_VC_CNT  3   /* Recorder virtual channels: housekeeping, science, event log */
+
 typedef struct
 {
 
-   uint32  Tbd1;
-   uint32  Tbd2;
+   uint32  Priority;        /* Playback order, 0 is the highest */
+   uint32  Retention;       /* 0=Keep oldest and reject new files, 1=Overwrite oldest */
+   
+} SC_SIM_TBL_RecVc_t;
+
+typedef struct
+{
+
+   float   RecCapacity;     /* Recorder capacity (Mbytes) */
+   SC_SIM_TBL_RecVc_t  RecVc[SC_SIM_TBL_REC_VC_CNT];
    
 } SC_SIM_TBL_Fsw_t;
 
+#define SC_SIM_TBL_INSTR_MODE_CNT  3   /* Instrument modes, e.g. survey, burst and calibration */
+
+typedef struct
+{
+
+   float   Rate;            /* Raw data rate while acquiring (kbps) */
+   float   Compression;     /* Raw to stored size ratio, at least 1 */
+   float   DutyOn;          /* Acquisition time at the start of each duty period (sec) */
+   float   DutyPeriod;      /* Sec, not longer than DutyOn for continuous acquisition */
+   
+} SC_SIM_TBL_InstrMode_t;
+
 typedef struct
 {
 
-   uint32  Tbd1;
-   uint32  Tbd2;
+   uint32  DefaultMode;     /* Mode selected when a sim starts */
+   float   WarmUp;          /* Time from power on to the first acquisition (sec) */
+   float   FileSize;        /* Science file size (Mbytes) */
+   uint32  TargetEna;       /* Collect science only while ground targets are in access */
+   float   Fov;             /* Sensor half angle (deg) */
+   SC_SIM_TBL_InstrMode_t  Mode[SC_SIM_TBL_INSTR_MODE_CNT];
+   
+} SC_SIM_TBL_Instr_t;
+
+#define SC_SIM_TBL_OCV_PTS  11   /* Battery open circuit voltage breakpoints at 0%, 10%, .. 100% SOC */
+
+typedef struct
+{
+
+   float   BattCapacity;    /* Amp-hours */
+   float   BattResistance;  /* Internal resistance (ohms) */
+   float   ChargeEff;       /* Fraction of charge current stored */
+   float   Ocv[SC_SIM_TBL_OCV_PTS];  /* Volts */
+   float   SaIsc;           /* Array current at normal incidence & reference temperature (amps) */
+   float   SaRefTemp;       /* Deg C */
+   float   SaTempCoef;      /* Fractional current change per deg C */
+   float   SaInertialCos;   /* Sun incidence cosine when the ADCS mode isn't sun pointing */
    
 } SC_SIM_TBL_Power_t;
 
 typedef struct
 {
 
-   uint32  Tbd1;
-   uint32  Tbd2;
+   float   Heater1OnTemp;   /* Thermostat turns heater on at or below (deg C) */
+   float   Heater1OffTemp;  /* Thermostat turns heater off at or above (deg C) */
+   float   Heater2OnTemp;
+   float   Heater2OffTemp;
+   float   SolarFlux;       /* W/m^2 */
+   float   Albedo;          /* Fraction of solar flux reflected by the Earth */
+   float   EarthIr;         /* W/m^2 at the Earth's surface */
+   float   Step;            /* Nominal solver step the network is factored for (sec) */
    
 } SC_SIM_TBL_Therm_t;
 
+/*
+** Component power draw (watts) in each component state. The power model's
+** bus load is the sum of the draws of each component's current state.
+*/
+typedef struct
+{
+
+   float   CdhBase;         /* Always on avionics baseline */
+   float   AdcsSafehold;    /* ADCS draw in each control mode, undefined mode is 0 */
+   float   AdcsSunPoint;
+   float   AdcsInertial;
+   float   AdcsSlew;
+   float   CommTx;          /* Transmitter on during a contact */
+   float   InstrPwr;        /* Instrument powered */
+   float   InstrSci;        /* Additional draw while collecting science */
+   float   Heater1;
+   float   Heater2;
+   
+} SC_SIM_TBL_Load_t;
+
+typedef struct
+{
+
+   uint32  EpochDay;   /* Days since 2000-01-01 of sim time zero */
+   uint32  EpochSec;   /* Seconds past midnight of sim time zero */
+   
+} SC_SIM_TBL_Ephem_t;
+
+typedef struct
+{
+
+   uint32  RunId;      /* Selects the random streams, combined with the scenario ID for each sim */
+   
+} SC_SIM_TBL_Rng_t;
+
+#define SC_SIM_TBL_SENS_KIND_CNT  6   /* Sun sensor, gyro, star tracker, battery voltage, battery current, thermistor */
+
+typedef struct
+{
+
+   float   Noise;      /* White noise standard deviation (sensor units) */
+   float   Drift;      /* Bias random walk (sensor units per root second) */
+   float   Lsb;        /* Quantization step, 0 for none */
+   uint32  Period;     /* Sample period (sec) */
+
+} SC_SIM_TBL_SensKind_t;
+
+typedef struct
+{
+
+   SC_SIM_TBL_SensKind_t  Kind[SC_SIM_TBL_SENS_KIND_CNT];
+
+} SC_SIM_TBL_Sens_t;
+
+#define SC_SIM_TBL_FAULT_CNT  4   /* Fault injection slots */
+
+typedef struct
+{
+
+   float   Rate;            /* Mean faults per sim hour, 0 disables the slot */
+   uint32  SubSys;          /* Target subsystem (SC_SIM_Subsystem) */
+   uint32  Event;           /* Target subsystem's event command ID */
+   int32   Param;           /* Event command parameter, negative draws a random parameter if the event accepts one */
+
+} SC_SIM_TBL_FaultSlot_t;
+
+typedef struct
+{
+
+   SC_SIM_TBL_FaultSlot_t  Slot[SC_SIM_TBL_FAULT_CNT];
+
+} SC_SIM_TBL_Fault_t;
+
+typedef struct
+{
+
+   uint32  MinorHz;         /* Minor frames per second */
+   float   AdcsHz;          /* Model rates, rounded to a whole number of minor frames */
+   float   PowerHz;
+   float   ThermHz;
+
+} SC_SIM_TBL_Rate_t;
+
+typedef struct
+{
+
+   uint32  Adaptive;        /* Error controlled integration of continuous models during time-lapse */
+   float   RelTol;
+   float   AbsTol;
+   float   MaxStep;         /* Seconds */
+   float   InputTol;        /* Relative input drift that restarts the integration */
+
+} SC_SIM_TBL_Integ_t;
+
 
 typedef struct
 {
@@ -114,8 +322,16 @@ typedef struct
    SC_SIM_TBL_Cdh_t    Cdh;
    SC_SIM_TBL_Comm_t   Comm;
    SC_SIM_TBL_Fsw_t    Fsw;
+   SC_SIM_TBL_Instr_t  Instr;
    SC_SIM_TBL_Power_t  Power;
    SC_SIM_TBL_Therm_t  Therm;
+   SC_SIM_TBL_Load_t   Load;
+   SC_SIM_TBL_Ephem_t  Ephem;
+   SC_SIM_TBL_Rng_t    Rng;
+   SC_SIM_TBL_Fault_t  Fault;
+   SC_SIM_TBL_Sens_t   Sens;
+   SC_SIM_TBL_Rate_t   Rate;
+   SC_SIM_TBL_Integ_t  Integ;
 
 } SC_SIM_TBL_Data_t;
 
@@ -0,0 +1,360 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Implement the ground target access model
+**
+** Notes:
+**   None
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <math.h>
+#include <stdio.h>
+
+#include "sc_sim_tgt.h"
+#include "sc_sim_ephem.h"
+#include "sc_sim_orbit.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define DEG2RAD  (M_PI/180.0)
+#define RAD2DEG  (180.0/M_PI)
+
+#define READ_BUF_LEN  (512)
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static uint32 CellOf(const SC_SIM_TGT_Target_t *Target);
+static void   BuildIndex(SC_SIM_TGT_Class_t *Tgt);
+static bool   ParseLine(SC_SIM_TGT_Class_t *Tgt, const char *Line);
+
+
+/******************************************************************************
+** Function: SC_SIM_TGT_Clear
+**
+*/
+void SC_SIM_TGT_Clear(SC_SIM_TGT_Class_t *Tgt)
+{
+
+   uint32 i;
+
+   for (i=0; i < Tgt->ActiveCnt; i++)
+   {
+      Tgt->InAccess[Tgt->Active[i]] = 0;
+   }
+
+   Tgt->ActiveCnt   = 0;
+   Tgt->AccessCnt   = 0;
+   Tgt->OverflowCnt = 0;
+   Tgt->CellsTested = 0;
+   Tgt->Lambda      = 0.0;
+
+} /* End SC_SIM_TGT_Clear() */
+
+
+/******************************************************************************
+** Function: SC_SIM_TGT_Config
+**
+*/
+void SC_SIM_TGT_Config(SC_SIM_TGT_Class_t *Tgt, double HalfAngleDeg)
+{
+
+   Tgt->HalfAngle = HalfAngleDeg*DEG2RAD;
+
+} /* End SC_SIM_TGT_Config() */
+
+
+/******************************************************************************
+** Function: SC_SIM_TGT_Load
+**
+*/
+uint32 SC_SIM_TGT_Load(SC_SIM_TGT_Class_t *Tgt, const char *Filename)
+{
+
+   osal_id_t FileHandle;
+   char   ReadBuf[READ_BUF_LEN];
+   char   Line[SC_SIM_TGT_LINE_LEN];
+   uint16 LineLen = 0;
+   uint32 SkipCnt = 0;
+   int32  ReadLen;
+   int32  i;
+
+   SC_SIM_TGT_Clear(Tgt);
+   Tgt->TargetCnt = 0;
+
+   if (OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_NONE, OS_READ_ONLY) != OS_SUCCESS)
+   {
+      CFE_EVS_SendEvent(SC_SIM_TGT_LOAD_EID, CFE_EVS_EventType_INFORMATION,
+                        "No ground targets loaded, can't open %s", Filename);
+      BuildIndex(Tgt);
+      return 0;
+   }
+
+   while ((ReadLen = OS_read(FileHandle, ReadBuf, READ_BUF_LEN)) > 0)
+   {
+      for (i=0; i < ReadLen; i++)
+      {
+         if (ReadBuf[i] == '\n')
+         {
+            Line[LineLen] = '\0';
+            if (!ParseLine(Tgt, Line)) SkipCnt++;
+            LineLen = 0;
+         }
+         else if (LineLen < (SC_SIM_TGT_LINE_LEN-1))
+         {
+            Line[LineLen++] = ReadBuf[i];
+         }
+      }
+   }
+
+   if (LineLen > 0)
+   {
+      Line[LineLen] = '\0';
+      if (!ParseLine(Tgt, Line)) SkipCnt++;
+   }
+
+   OS_close(FileHandle);
+
+   BuildIndex(Tgt);
+
+   CFE_EVS_SendEvent(SC_SIM_TGT_LOAD_EID, CFE_EVS_EventType_INFORMATION,
+                     "Loaded %d ground targets from %s, skipped %d lines", Tgt->TargetCnt, Filename, SkipCnt);
+
+   return Tgt->TargetCnt;
+
+} /* End SC_SIM_TGT_Load() */
+
+
+/******************************************************************************
+** Function: SC_SIM_TGT_Update
+**
+** Notes:
+**   1. With the sensor half angle eta and the Earth's angular radius rho
+**      seen from the spacecraft, the footprint edge elevation is
+**      cos(eps) = sin(eta)/sin(rho) and the footprint central angle is
+**      lambda = 90 - eta - eps. The footprint is the visible cap when
+**      the sensor sees past the horizon.
+**   2. The cap's bounding box is lat +/- lambda and lon +/- asin(sin(lambda)/
+**      cos(lat)), all longitudes when the cap contains a pole.
+*/
+bool SC_SIM_TGT_Update(SC_SIM_TGT_Class_t *Tgt, const double PosEci[3], double J2000Sec)
+{
+
+   const SC_SIM_TGT_Target_t *Target;
+   bool   WasActive = (Tgt->ActiveCnt > 0);
+   double Pos[3], U[3];
+   double R, SinRho, SinEta, CosLambda;
+   double Lat, Lon, LamDeg, DLon;
+   int32  Row, Row0, Row1, Col, Col0, Col1;
+   uint32 Cell, k, t;
+
+   SC_SIM_EPHEM_EciToEcef(PosEci, J2000Sec, Pos);
+   R = sqrt(Pos[0]*Pos[0] + Pos[1]*Pos[1] + Pos[2]*Pos[2]);
+   U[0] = Pos[0]/R;
+   U[1] = Pos[1]/R;
+   U[2] = Pos[2]/R;
+
+   SinRho = SC_SIM_ORBIT_RE_KM/R;
+   SinEta = sin(Tgt->HalfAngle);
+   if (SinRho >= 1.0)
+   {
+      Tgt->Lambda = 0.0;
+   }
+   else if (SinEta >= SinRho)
+   {
+      Tgt->Lambda = acos(SinRho);
+   }
+   else
+   {
+      Tgt->Lambda = M_PI/2.0 - Tgt->HalfAngle - acos(SinEta/SinRho);
+   }
+   CosLambda = cos(Tgt->Lambda);
+
+   /* End accesses of targets that left the footprint */
+
+   k = 0;
+   while (k < Tgt->ActiveCnt)
+   {
+      t = Tgt->Active[k];
+      Target = &Tgt->Target[t];
+      if ((U[0]*Target->Unit[0] + U[1]*Target->Unit[1] + U[2]*Target->Unit[2]) < CosLambda)
+      {
+         Tgt->InAccess[t] = 0;
+         Tgt->Active[k] = Tgt->Active[--Tgt->ActiveCnt];
+      }
+      else
+      {
+         k++;
+      }
+   }
+
+   /* Start accesses of targets in the cells under the footprint */
+
+   Lat    = asin(U[2])*RAD2DEG;
+   Lon    = atan2(U[1], U[0])*RAD2DEG;
+   LamDeg = Tgt->Lambda*RAD2DEG;
+
+   Row0 = (int32)floor((Lat - LamDeg + 90.0)/SC_SIM_TGT_CELL_DEG);
+   Row1 = (int32)floor((Lat + LamDeg + 90.0)/SC_SIM_TGT_CELL_DEG);
+   if (Row0 < 0) Row0 = 0;
+   if (Row1 >= SC_SIM_TGT_LAT_CELLS) Row1 = SC_SIM_TGT_LAT_CELLS - 1;
+
+   if ((Lat + LamDeg) >= 90.0 || (Lat - LamDeg) <= -90.0)
+   {
+      Col0 = 0;
+      Col1 = SC_SIM_TGT_LON_CELLS - 1;
+   }
+   else
+   {
+      DLon = asin(sin(Tgt->Lambda)/cos(Lat*DEG2RAD))*RAD2DEG;
+      Col0 = (int32)floor((Lon - DLon + 180.0)/SC_SIM_TGT_CELL_DEG);
+      Col1 = (int32)floor((Lon + DLon + 180.0)/SC_SIM_TGT_CELL_DEG);
+      if ((Col1 - Col0) >= SC_SIM_TGT_LON_CELLS)
+      {
+         Col0 = 0;
+         Col1 = SC_SIM_TGT_LON_CELLS - 1;
+      }
+   }
+
+   Tgt->CellsTested = 0;
+   for (Row=Row0; Row <= Row1; Row++)
+   {
+      for (Col=Col0; Col <= Col1; Col++)
+      {
+
+         Cell = Row*SC_SIM_TGT_LON_CELLS + ((Col + SC_SIM_TGT_LON_CELLS) % SC_SIM_TGT_LON_CELLS);
+         Tgt->CellsTested++;
+
+         for (k=Tgt->CellStart[Cell]; k < Tgt->CellStart[Cell+1]; k++)
+         {
+
+            t = Tgt->CellTarget[k];
+            if (Tgt->InAccess[t]) continue;
+
+            Target = &Tgt->Target[t];
+            if ((U[0]*Target->Unit[0] + U[1]*Target->Unit[1] + U[2]*Target->Unit[2]) >= CosLambda)
+            {
+               if (Tgt->ActiveCnt < SC_SIM_TGT_MAX_ACTIVE)
+               {
+                  Tgt->InAccess[t] = 1;
+                  Tgt->Active[Tgt->ActiveCnt++] = t;
+                  Tgt->AccessCnt++;
+                  CFE_EVS_SendEvent(SC_SIM_TGT_ACCESS_EID, CFE_EVS_EventType_DEBUG,
+                                    "Ground target %d access started, %d targets in access", t, Tgt->ActiveCnt);
+               }
+               else
+               {
+                  Tgt->OverflowCnt++;
+               }
+            }
+
+         } /* End target loop */
+      } /* End column loop */
+   } /* End row loop */
+
+   return (WasActive != (Tgt->ActiveCnt > 0));
+
+} /* End SC_SIM_TGT_Update() */
+
+
+/******************************************************************************
+** Function: BuildIndex
+**
+** Bucket the targets by cell with a counting sort.
+**
+*/
+static void BuildIndex(SC_SIM_TGT_Class_t *Tgt)
+{
+
+   uint32 i, Cell;
+
+   for (i=0; i <= SC_SIM_TGT_CELLS; i++) Tgt->CellStart[i] = 0;
+
+   /* Count, then prefix sum so CellStart[c] is the end of cell c */
+   for (i=0; i < Tgt->TargetCnt; i++) Tgt->CellStart[CellOf(&Tgt->Target[i])]++;
+   for (i=1; i <= SC_SIM_TGT_CELLS; i++) Tgt->CellStart[i] += Tgt->CellStart[i-1];
+
+   /* Filling each cell from its end leaves CellStart[c] at its start */
+   for (i=Tgt->TargetCnt; i > 0; i--)
+   {
+      Cell = CellOf(&Tgt->Target[i-1]);
+      Tgt->CellTarget[--Tgt->CellStart[Cell]] = i-1;
+   }
+
+   for (i=0; i < Tgt->TargetCnt; i++) Tgt->InAccess[i] = 0;
+
+} /* End BuildIndex() */
+
+
+/******************************************************************************
+** Function: CellOf
+**
+*/
+static uint32 CellOf(const SC_SIM_TGT_Target_t *Target)
+{
+
+   int32 Row = (int32)floor((asin(Target->Unit[2])*RAD2DEG + 90.0)/SC_SIM_TGT_CELL_DEG);
+   int32 Col = (int32)floor((atan2(Target->Unit[1], Target->Unit[0])*RAD2DEG + 180.0)/SC_SIM_TGT_CELL_DEG);
+
+   if (Row < 0) Row = 0;
+   if (Row >= SC_SIM_TGT_LAT_CELLS) Row = SC_SIM_TGT_LAT_CELLS - 1;
+   Col = (Col + SC_SIM_TGT_LON_CELLS) % SC_SIM_TGT_LON_CELLS;
+
+   return (uint32)(Row*SC_SIM_TGT_LON_CELLS + Col);
+
+} /* End CellOf() */
+
+
+/******************************************************************************
+** Function: ParseLine
+**
+** Add the target on a line. Returns false if the line is malformed or the
+** target list is full, true for targets, blank lines and comments.
+**
+*/
+static bool ParseLine(SC_SIM_TGT_Class_t *Tgt, const char *Line)
+{
+
+   SC_SIM_TGT_Target_t *Target;
+   double Lat, Lon, CosLat;
+
+   while (*Line == ' ' || *Line == '\t') Line++;
+   if (*Line == '\0' || *Line == '\r' || *Line == '#') return true;
+
+   if (sscanf(Line, "%lf , %lf", &Lat, &Lon) != 2) return false;
+   if (Lat < -90.0 || Lat > 90.0 || Lon < -180.0 || Lon > 360.0) return false;
+   if (Tgt->TargetCnt >= SC_SIM_TGT_MAX) return false;
+
+   Lat *= DEG2RAD;
+   Lon *= DEG2RAD;
+   CosLat = cos(Lat);
+
+   Target = &Tgt->Target[Tgt->TargetCnt++];
+   Target->Unit[0] = (float)(CosLat*cos(Lon));
+   Target->Unit[1] = (float)(CosLat*sin(Lon));
+   Target->Unit[2] = (float)sin(Lat);
+
+   return true;
+
+} /* End ParseLine() */
@@ -0,0 +1,156 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Define a ground target access model
+**
+** Notes:
+**   1. Targets are loaded from a text file with one "lat, lon" pair
+**      (geodetic degrees) per line. Blank lines and lines starting with
+**      '#' are ignored.
+**   2. Targets are bucketed in a fixed latitude/longitude grid stored in
+**      compressed row form: the targets of a cell are contiguous in the
+**      index and a cell's range is given by its start and the next
+**      cell's start.
+**   3. A target is accessible when it's inside the sensor footprint, the
+**      spherical cap of Earth central angle lambda around the subpoint
+**      seen within the sensor half angle. Each step only the cells
+**      overlapping the cap's bounding box are tested so the cost depends
+**      on the target density under the footprint and not the number of
+**      targets.
+**   4. Targets in access are kept in an active list. A target leaving
+**      the footprint ends its access.
+**   5. The Earth is a sphere for the footprint and target directions.
+**
+*/
+
+#ifndef _sc_sim_tgt_
+#define _sc_sim_tgt_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SC_SIM_TGT_MAX         (100000)
+#define SC_SIM_TGT_MAX_ACTIVE  (1024)    /* Targets in access at once */
+
+#define SC_SIM_TGT_CELL_DEG    (1)       /* Grid cell size, must divide 180 */
+#define SC_SIM_TGT_LAT_CELLS   (180/SC_SIM_TGT_CELL_DEG)
+#define SC_SIM_TGT_LON_CELLS   (360/SC_SIM_TGT_CELL_DEG)
+#define SC_SIM_TGT_CELLS       (SC_SIM_TGT_LAT_CELLS*SC_SIM_TGT_LON_CELLS)
+
+#define SC_SIM_TGT_LINE_LEN    (128)
+
+/*
+** Event Message IDs
+*/
+
+#define SC_SIM_TGT_LOAD_EID    (SC_SIM_TGT_BASE_EID + 0)
+#define SC_SIM_TGT_ACCESS_EID  (SC_SIM_TGT_BASE_EID + 1)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+typedef struct
+{
+
+   float   Unit[3];         /* Earth fixed unit vector */
+
+} SC_SIM_TGT_Target_t;
+
+
+typedef struct
+{
+
+   /* Configuration */
+
+   double  HalfAngle;       /* Sensor half angle (rad) */
+
+   /* Targets and grid index */
+
+   uint32  TargetCnt;
+   SC_SIM_TGT_Target_t Target[SC_SIM_TGT_MAX];
+   uint32  CellStart[SC_SIM_TGT_CELLS+1];
+   uint32  CellTarget[SC_SIM_TGT_MAX];
+
+   /* Access state */
+
+   uint8   InAccess[SC_SIM_TGT_MAX];
+   uint32  ActiveCnt;
+   uint32  Active[SC_SIM_TGT_MAX_ACTIVE];
+   uint32  AccessCnt;       /* Accesses started */
+   uint32  OverflowCnt;     /* Accesses not tracked because the active list was full */
+   uint32  CellsTested;     /* Last update */
+   double  Lambda;          /* Last update's footprint central angle (rad) */
+
+} SC_SIM_TGT_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SC_SIM_TGT_Clear
+**
+** End all accesses.
+**
+*/
+void SC_SIM_TGT_Clear(SC_SIM_TGT_Class_t *Tgt);
+
+
+/******************************************************************************
+** Function: SC_SIM_TGT_Config
+**
+** Set the sensor half angle (deg).
+**
+*/
+void SC_SIM_TGT_Config(SC_SIM_TGT_Class_t *Tgt, double HalfAngleDeg);
+
+
+/******************************************************************************
+** Function: SC_SIM_TGT_Load
+**
+** Replace the targets with the targets in Filename and build the grid
+** index. Returns the number of targets loaded.
+**
+** Notes:
+**   1. Malformed lines are skipped and targets beyond SC_SIM_TGT_MAX are
+**      ignored.
+**
+*/
+uint32 SC_SIM_TGT_Load(SC_SIM_TGT_Class_t *Tgt, const char *Filename);
+
+
+/******************************************************************************
+** Function: SC_SIM_TGT_Update
+**
+** Update the accesses for a spacecraft ECI position (km) at J2000Sec.
+** Returns true if the number of targets in access changed from or to 0.
+**
+*/
+bool SC_SIM_TGT_Update(SC_SIM_TGT_Class_t *Tgt, const double PosEci[3], double J2000Sec);
+
+
+#endif /* _sc_sim_tgt_ */
@@ -0,0 +1,383 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Implement the model timer service
+**
+** Notes:
+**   None
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "sc_sim_tmr.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SLOT_MASK  (SC_SIM_TMR_SLOTS - 1)
+#define MAX_DELTA  (1u << (SC_SIM_TMR_SLOT_BITS*SC_SIM_TMR_LEVELS))
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void Insert(SC_SIM_TMR_Class_t *Wheel, uint16 Id);
+static void Unlink(SC_SIM_TMR_Class_t *Wheel, uint16 Id);
+static void Cascade(SC_SIM_TMR_Class_t *Wheel, uint16 Slot);
+
+
+/******************************************************************************
+** Function: SC_SIM_TMR_Constructor
+**
+*/
+void SC_SIM_TMR_Constructor(SC_SIM_TMR_Class_t *Wheel)
+{
+
+   memset(Wheel, 0, sizeof(SC_SIM_TMR_Class_t));
+   SC_SIM_TMR_Reset(Wheel, 0);
+
+} /* End SC_SIM_TMR_Constructor() */
+
+
+/******************************************************************************
+** Function: SC_SIM_TMR_Create
+**
+*/
+uint16 SC_SIM_TMR_Create(SC_SIM_TMR_Class_t *Wheel, const char *Name,
+                         SC_SIM_TMR_Callback_t Callback, void *Obj)
+{
+
+   SC_SIM_TMR_Timer_t *Tmr;
+   
+   if (Wheel->TimerCnt >= SC_SIM_TMR_MAX) return SC_SIM_TMR_NULL_IDX;
+   
+   Tmr = &Wheel->Timer[Wheel->TimerCnt];
+   Tmr->Name     = Name;
+   Tmr->Callback = Callback;
+   Tmr->Obj      = Obj;
+   Tmr->Expiry   = 0;
+   Tmr->Period   = 0;
+   Tmr->Slot     = SC_SIM_TMR_NULL_IDX;
+   Tmr->Prev     = SC_SIM_TMR_NULL_IDX;
+   Tmr->Next     = SC_SIM_TMR_NULL_IDX;
+
+   return Wheel->TimerCnt++;
+
+} /* End SC_SIM_TMR_Create() */
+
+
+/******************************************************************************
+** Function: SC_SIM_TMR_Reset
+**
+*/
+void SC_SIM_TMR_Reset(SC_SIM_TMR_Class_t *Wheel, uint32 Time)
+{
+
+   uint16 i;
+   
+   for (i=0; i < Wheel->TimerCnt; i++)
+   {
+      Wheel->Timer[i].Slot = SC_SIM_TMR_NULL_IDX;
+      Wheel->Timer[i].Prev = SC_SIM_TMR_NULL_IDX;
+      Wheel->Timer[i].Next = SC_SIM_TMR_NULL_IDX;
+   }
+   memset(Wheel->Head, 0xFF, sizeof(Wheel->Head));
+   memset(Wheel->Tail, 0xFF, sizeof(Wheel->Tail));
+   
+   Wheel->Now      = Time;
+   Wheel->Firing   = false;
+   Wheel->ArmedCnt = 0;
+
+} /* End SC_SIM_TMR_Reset() */
+
+
+/******************************************************************************
+** Function: SC_SIM_TMR_Start
+**
+*/
+void SC_SIM_TMR_Start(SC_SIM_TMR_Class_t *Wheel, uint16 Id, uint32 Expiry, uint32 Period)
+{
+
+   if (Id >= Wheel->TimerCnt) return;
+   
+   if (Wheel->Timer[Id].Slot != SC_SIM_TMR_NULL_IDX) Unlink(Wheel, Id);
+   
+   Wheel->Timer[Id].Expiry = Expiry;
+   Wheel->Timer[Id].Period = Period;
+   Insert(Wheel, Id);
+
+} /* End SC_SIM_TMR_Start() */
+
+
+/******************************************************************************
+** Function: SC_SIM_TMR_Stop
+**
+*/
+void SC_SIM_TMR_Stop(SC_SIM_TMR_Class_t *Wheel, uint16 Id)
+{
+
+   if (Id < Wheel->TimerCnt && Wheel->Timer[Id].Slot != SC_SIM_TMR_NULL_IDX) Unlink(Wheel, Id);
+
+} /* End SC_SIM_TMR_Stop() */
+
+
+/******************************************************************************
+** Function: SC_SIM_TMR_Active
+**
+*/
+bool SC_SIM_TMR_Active(const SC_SIM_TMR_Class_t *Wheel, uint16 Id)
+{
+
+   return (Id < Wheel->TimerCnt && Wheel->Timer[Id].Slot != SC_SIM_TMR_NULL_IDX);
+
+} /* End SC_SIM_TMR_Active() */
+
+
+/******************************************************************************
+** Function: SC_SIM_TMR_Expiry
+**
+*/
+uint32 SC_SIM_TMR_Expiry(const SC_SIM_TMR_Class_t *Wheel, uint16 Id)
+{
+
+   return (Id < Wheel->TimerCnt) ? Wheel->Timer[Id].Expiry : 0;
+
+} /* End SC_SIM_TMR_Expiry() */
+
+
+/******************************************************************************
+** Function: SC_SIM_TMR_Run
+**
+** Notes:
+**   1. Higher level slots are moved down before the level 0 slot is
+**      processed so a timer moved down on its expiration tick expires on
+**      time.
+**   2. A periodic timer is rearmed before its callback so the callback
+**      can stop it.
+**
+*/
+uint16 SC_SIM_TMR_Run(SC_SIM_TMR_Class_t *Wheel, uint32 Time)
+{
+
+   SC_SIM_TMR_Timer_t *Tmr;
+   uint16 Fired = 0;
+   uint16 Level;
+   uint16 Id;
+   
+   while (Wheel->Now < Time)
+   {
+      
+      if (Wheel->ArmedCnt == 0)
+      {
+         Wheel->Now = Time;
+         break;
+      }
+      
+      Wheel->Now++;
+      Wheel->Firing = true;
+      
+      for (Level = SC_SIM_TMR_LEVELS-1; Level > 0; Level--)
+      {
+         if ((Wheel->Now & ((1u << (SC_SIM_TMR_SLOT_BITS*Level)) - 1)) == 0)
+         {
+            Cascade(Wheel, Level*SC_SIM_TMR_SLOTS + ((Wheel->Now >> (SC_SIM_TMR_SLOT_BITS*Level)) & SLOT_MASK));
+         }
+      }
+      
+      /* Callbacks may add timers expiring on this tick to the slot */
+      while ((Id = Wheel->Head[Wheel->Now & SLOT_MASK]) != SC_SIM_TMR_NULL_IDX)
+      {
+         
+         Tmr = &Wheel->Timer[Id];
+         Unlink(Wheel, Id);
+         if (Tmr->Period > 0)
+         {
+            Tmr->Expiry += Tmr->Period;
+            Insert(Wheel, Id);
+         }
+         
+         Fired++;
+         Wheel->FireCnt++;
+         if (Tmr->Callback != NULL) Tmr->Callback(Tmr->Obj, Wheel->Now);
+      
+      } /* End slot loop */
+      
+      Wheel->Firing = false;
+      
+   } /* End tick loop */
+   
+   return Fired;
+   
+} /* End SC_SIM_TMR_Run() */
+
+
+/******************************************************************************
+** Function: SC_SIM_TMR_Skip
+**
+*/
+void SC_SIM_TMR_Skip(SC_SIM_TMR_Class_t *Wheel, uint32 Time)
+{
+
+   bool   Armed[SC_SIM_TMR_MAX];
+   uint32 Delta;
+   uint16 i;
+   
+   if (Time <= Wheel->Now) return;
+   
+   Delta = Time - Wheel->Now;
+   for (i=0; i < Wheel->TimerCnt; i++)
+   {
+      Armed[i] = (Wheel->Timer[i].Slot != SC_SIM_TMR_NULL_IDX);
+      if (Armed[i]) Unlink(Wheel, i);
+   }
+   
+   Wheel->Now = Time;
+   for (i=0; i < Wheel->TimerCnt; i++)
+   {
+      if (Armed[i])
+      {
+         Wheel->Timer[i].Expiry += Delta;
+         Insert(Wheel, i);
+      }
+   }
+
+} /* End SC_SIM_TMR_Skip() */
+
+
+/******************************************************************************
+** Function: Insert
+**
+** Append a timer to the slot of its expiration.
+**
+** Notes:
+**   1. Level L holds the timers expiring in 64^L to 64^(L+1) ticks, in
+**      the slot indexed by bits 6L to 6L+5 of the expiration. The slot is
+**      moved down when the tick's lower bits are all zero, which is the
+**      first tick of the 64^L ticks containing the expiration.
+**
+*/
+static void Insert(SC_SIM_TMR_Class_t *Wheel, uint16 Id)
+{
+
+   SC_SIM_TMR_Timer_t *Tmr = &Wheel->Timer[Id];
+   uint32 Base = Wheel->Firing ? Wheel->Now : Wheel->Now + 1;
+   uint32 Expiry;
+   uint32 Delta;
+   uint16 Level = 0;
+   uint16 Slot;
+   
+   if (Tmr->Expiry < Base) Tmr->Expiry = Base;
+   
+   Expiry = Tmr->Expiry;
+   Delta  = Expiry - Base;
+   if (Delta >= MAX_DELTA)
+   {
+      Delta  = MAX_DELTA - 1;
+      Expiry = Base + Delta;
+   }
+   
+   while (Level < (SC_SIM_TMR_LEVELS-1) && Delta >= (1u << (SC_SIM_TMR_SLOT_BITS*(Level+1))))
+   {
+      Level++;
+   }
+   Slot = Level*SC_SIM_TMR_SLOTS + ((Expiry >> (SC_SIM_TMR_SLOT_BITS*Level)) & SLOT_MASK);
+   
+   Tmr->Slot = Slot;
+   Tmr->Next = SC_SIM_TMR_NULL_IDX;
+   Tmr->Prev = Wheel->Tail[Slot];
+   if (Tmr->Prev == SC_SIM_TMR_NULL_IDX)
+   {
+      Wheel->Head[Slot] = Id;
+   }
+   else
+   {
+      Wheel->Timer[Tmr->Prev].Next = Id;
+   }
+   Wheel->Tail[Slot] = Id;
+   Wheel->ArmedCnt++;
+
+} /* End Insert() */
+
+
+/******************************************************************************
+** Function: Unlink
+**
+*/
+static void Unlink(SC_SIM_TMR_Class_t *Wheel, uint16 Id)
+{
+
+   SC_SIM_TMR_Timer_t *Tmr = &Wheel->Timer[Id];
+   
+   if (Tmr->Prev == SC_SIM_TMR_NULL_IDX)
+   {
+      Wheel->Head[Tmr->Slot] = Tmr->Next;
+   }
+   else
+   {
+      Wheel->Timer[Tmr->Prev].Next = Tmr->Next;
+   }
+   
+   if (Tmr->Next == SC_SIM_TMR_NULL_IDX)
+   {
+      Wheel->Tail[Tmr->Slot] = Tmr->Prev;
+   }
+   else
+   {
+      Wheel->Timer[Tmr->Next].Prev = Tmr->Prev;
+   }
+   
+   Tmr->Slot = SC_SIM_TMR_NULL_IDX;
+   Tmr->Prev = SC_SIM_TMR_NULL_IDX;
+   Tmr->Next = SC_SIM_TMR_NULL_IDX;
+   Wheel->ArmedCnt--;
+
+} /* End Unlink() */
+
+
+/******************************************************************************
+** Function: Cascade
+**
+** Move the timers of a higher level slot down to the levels for the time
+** they have left. The slot is emptied first, a timer beyond the wheel's
+** range is put back in the last level.
+**
+*/
+static void Cascade(SC_SIM_TMR_Class_t *Wheel, uint16 Slot)
+{
+
+   uint16 Id = Wheel->Head[Slot];
+   uint16 Next;
+   
+   Wheel->Head[Slot] = SC_SIM_TMR_NULL_IDX;
+   Wheel->Tail[Slot] = SC_SIM_TMR_NULL_IDX;
+   
+   while (Id != SC_SIM_TMR_NULL_IDX)
+   {
+      Next = Wheel->Timer[Id].Next;
+      Wheel->Timer[Id].Slot = SC_SIM_TMR_NULL_IDX;
+      Wheel->ArmedCnt--;
+      Insert(Wheel, Id);
+      Wheel->CascadeCnt++;
+      Id = Next;
+   }
+
+} /* End Cascade() */
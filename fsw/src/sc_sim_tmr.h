@@ -0,0 +1,201 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Define the model timer service
+**
+** Notes:
+**   1. Timers are kept in a hierarchical timing wheel (Varghese & Lauck,
+**      "Hashed and Hierarchical Timing Wheels"). Level 0 has a slot per
+**      second for the next 64 seconds and each higher level's slots span
+**      64 of the level below, so four levels cover about 194 days. Later
+**      expirations wait in the last level's farthest slot.
+**   2. Arming and stopping a timer is O(1). A tick only visits the
+**      timers in its level 0 slot, plus one higher level slot every 64
+**      ticks whose timers move down a level, so the cost of running the
+**      wheel doesn't depend on the number of armed timers.
+**   3. Timers are created once when a model is initialized and live in a
+**      fixed pool. Slot lists are linked by pool index like the event
+**      cmd list.
+**   4. The wheel isn't thread safe. Timers are run before the models
+**      execute and a model that arms a timer from its execute function
+**      must declare it in the dependency graph.
+**
+*/
+
+#ifndef _sc_sim_tmr_
+#define _sc_sim_tmr_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SC_SIM_TMR_MAX         16
+#define SC_SIM_TMR_LEVELS      4
+#define SC_SIM_TMR_SLOT_BITS   6
+#define SC_SIM_TMR_SLOTS       (1 << SC_SIM_TMR_SLOT_BITS)
+
+#define SC_SIM_TMR_NULL_IDX    0xFFFF
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/*
+** Called with the model object and the time the timer expired. A
+** callback may arm timers including its own.
+*/
+typedef void (*SC_SIM_TMR_Callback_t)(void *Obj, uint32 Time);
+
+typedef struct
+{
+
+   const char            *Name;
+   SC_SIM_TMR_Callback_t Callback;   /* May be NULL for a timer that's only queried */
+   void                  *Obj;
+   
+   uint32  Expiry;     /* Sim seconds */
+   uint32  Period;     /* Seconds between expirations, 0 for a one-shot */
+   uint16  Slot;       /* Wheel slot, SC_SIM_TMR_NULL_IDX when the timer isn't armed */
+   uint16  Prev;
+   uint16  Next;
+
+} SC_SIM_TMR_Timer_t;
+
+typedef struct
+{
+
+   uint32  Now;        /* Last tick processed */
+   bool    Firing;     /* Processing the tick Now */
+   uint16  TimerCnt;
+   uint16  ArmedCnt;
+   uint32  FireCnt;
+   uint32  CascadeCnt; /* Timers moved down a level */
+   
+   uint16  Head[SC_SIM_TMR_LEVELS*SC_SIM_TMR_SLOTS];
+   uint16  Tail[SC_SIM_TMR_LEVELS*SC_SIM_TMR_SLOTS];
+   
+   SC_SIM_TMR_Timer_t Timer[SC_SIM_TMR_MAX];
+
+} SC_SIM_TMR_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SC_SIM_TMR_Constructor
+**
+** Empty the wheel and the timer pool.
+**
+*/
+void SC_SIM_TMR_Constructor(SC_SIM_TMR_Class_t *Wheel);
+
+
+/******************************************************************************
+** Function: SC_SIM_TMR_Create
+**
+** Add a timer to the pool and return its ID, SC_SIM_TMR_NULL_IDX if the
+** pool is full. The timer isn't armed.
+**
+*/
+uint16 SC_SIM_TMR_Create(SC_SIM_TMR_Class_t *Wheel, const char *Name,
+                         SC_SIM_TMR_Callback_t Callback, void *Obj);
+
+
+/******************************************************************************
+** Function: SC_SIM_TMR_Reset
+**
+** Stop every timer and set the wheel's time.
+**
+*/
+void SC_SIM_TMR_Reset(SC_SIM_TMR_Class_t *Wheel, uint32 Time);
+
+
+/******************************************************************************
+** Function: SC_SIM_TMR_Start
+**
+** Arm a timer to expire at Expiry and then every Period seconds, Period 0
+** for a one-shot. An armed timer is rearmed.
+**
+** Notes:
+**   1. A timer that expires at or before the current tick expires on the
+**      next tick, or on the current tick when armed by a callback.
+**
+*/
+void SC_SIM_TMR_Start(SC_SIM_TMR_Class_t *Wheel, uint16 Id, uint32 Expiry, uint32 Period);
+
+
+/******************************************************************************
+** Function: SC_SIM_TMR_Stop
+**
+*/
+void SC_SIM_TMR_Stop(SC_SIM_TMR_Class_t *Wheel, uint16 Id);
+
+
+/******************************************************************************
+** Function: SC_SIM_TMR_Active
+**
+** Return true if the timer is armed.
+**
+*/
+bool SC_SIM_TMR_Active(const SC_SIM_TMR_Class_t *Wheel, uint16 Id);
+
+
+/******************************************************************************
+** Function: SC_SIM_TMR_Expiry
+**
+** Return the time an armed timer expires next.
+**
+*/
+uint32 SC_SIM_TMR_Expiry(const SC_SIM_TMR_Class_t *Wheel, uint16 Id);
+
+
+/******************************************************************************
+** Function: SC_SIM_TMR_Run
+**
+** Process the ticks after the last one processed up to and including
+** Time and call the callbacks of the timers that expire. Return the
+** number of expirations.
+**
+** Notes:
+**   1. Timers that expire on the same tick are called in the order they
+**      were armed or moved down to level 0.
+**   2. An empty wheel jumps to Time.
+**
+*/
+uint16 SC_SIM_TMR_Run(SC_SIM_TMR_Class_t *Wheel, uint32 Time);
+
+
+/******************************************************************************
+** Function: SC_SIM_TMR_Skip
+**
+** Move the wheel to Time without processing the skipped ticks. Armed
+** timers keep the time they had left.
+**
+*/
+void SC_SIM_TMR_Skip(SC_SIM_TMR_Class_t *Wheel, uint32 Time);
+
+
+#endif /* _sc_sim_tmr_ */
@@ -0,0 +1,400 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Implement the lumped parameter thermal network solver
+**
+** Notes:
+**   1. The explicit part of the radiative exchange is the difference
+**      between the T^4 flux and its linearization at the reference
+**      temperature. Its derivative is smaller than the implicit linear
+**      conductance for temperatures below ~370K so the scheme remains
+**      stable for large steps over the range of spacecraft temperatures.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <math.h>
+
+#include "sc_sim_tnet.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define STEFAN_BOLTZMANN  (5.670374e-8)
+#define KELVIN_OFFSET     (273.15)
+
+/* Skyline entry (Row,Col) of matrix M, requires FirstCol[Row] <= Col <= Row */
+#define SKY(Tnet, M, Row, Col)  ((M)[(Tnet)->RowStart[Row] + (Col) - (Tnet)->FirstCol[Row]])
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool Factor(SC_SIM_TNET_Class_t *Tnet, double Dt);
+
+
+/******************************************************************************
+** Function: SC_SIM_TNET_Config
+**
+*/
+bool SC_SIM_TNET_Config(SC_SIM_TNET_Class_t *Tnet,
+                        const SC_SIM_TNET_NodeDef_t *NodeDef, uint16 NodeCnt,
+                        const SC_SIM_TNET_CouplingDef_t *CouplingDef, uint16 CouplingCnt,
+                        double Dt)
+{
+
+   const SC_SIM_TNET_CouplingDef_t *Couple;
+   uint16  FirstCol[SC_SIM_TNET_MAX_NODES];
+   uint32  SkylineCnt = 0;
+   uint16  i, Lo, Hi;
+   double  G, SigmaA;
+   bool    NodeCntChanged;
+
+   if (NodeCnt == 0 || NodeCnt > SC_SIM_TNET_MAX_NODES || CouplingCnt > SC_SIM_TNET_MAX_COUPLINGS)
+   {
+      CFE_EVS_SendEvent(SC_SIM_TNET_CONFIG_EID, CFE_EVS_EventType_ERROR,
+                        "Thermal network rejected: %d nodes and %d couplings exceed limits of %d and %d",
+                        NodeCnt, CouplingCnt, SC_SIM_TNET_MAX_NODES, SC_SIM_TNET_MAX_COUPLINGS);
+      return false;
+   }
+
+   /*
+   ** Validate and size the skyline before modifying the network
+   */
+
+   for (i=0; i < NodeCnt; i++) FirstCol[i] = i;
+
+   for (i=0; i < CouplingCnt; i++)
+   {
+
+      Couple = &CouplingDef[i];
+      if (Couple->NodeA >= NodeCnt || Couple->NodeA == Couple->NodeB ||
+         (Couple->NodeB >= NodeCnt && Couple->NodeB != SC_SIM_TNET_SPACE))
+      {
+         CFE_EVS_SendEvent(SC_SIM_TNET_CONFIG_EID, CFE_EVS_EventType_ERROR,
+                           "Thermal network rejected: Invalid coupling %d between nodes %d and %d",
+                           i, Couple->NodeA, Couple->NodeB);
+         return false;
+      }
+
+      if (Couple->NodeB != SC_SIM_TNET_SPACE)
+      {
+         Lo = (Couple->NodeA < Couple->NodeB) ? Couple->NodeA : Couple->NodeB;
+         Hi = (Couple->NodeA < Couple->NodeB) ? Couple->NodeB : Couple->NodeA;
+         if (Lo < FirstCol[Hi]) FirstCol[Hi] = Lo;
+      }
+
+   } /* End coupling loop */
+
+   for (i=0; i < NodeCnt; i++) SkylineCnt += (i - FirstCol[i] + 1);
+
+   if (SkylineCnt > SC_SIM_TNET_MAX_SKYLINE)
+   {
+      CFE_EVS_SendEvent(SC_SIM_TNET_CONFIG_EID, CFE_EVS_EventType_ERROR,
+                        "Thermal network rejected: Skyline requires %d entries, limit is %d. Renumber nodes to reduce the profile",
+                        (int)SkylineCnt, SC_SIM_TNET_MAX_SKYLINE);
+      return false;
+   }
+
+   /*
+   ** Assemble
+   */
+
+   NodeCntChanged = (NodeCnt != Tnet->NodeCnt);
+
+   Tnet->NodeCnt     = NodeCnt;
+   Tnet->NodeDef     = NodeDef;
+   Tnet->RadiatorCnt = 0;
+
+   Tnet->RowStart[0] = 0;
+   for (i=0; i < NodeCnt; i++)
+   {
+      Tnet->FirstCol[i]   = FirstCol[i];
+      Tnet->RowStart[i+1] = Tnet->RowStart[i] + (i - FirstCol[i] + 1);
+      Tnet->Capacitance[i] = NodeDef[i].Capacitance;
+      Tnet->SpaceH[i]      = 0.0;
+   }
+   for (i=0; i < SkylineCnt; i++) Tnet->K[i] = 0.0;
+
+   for (i=0; i < CouplingCnt; i++)
+   {
+
+      Couple = &CouplingDef[i];
+
+      if (Couple->Type == SC_SIM_TNET_RADIATIVE)
+      {
+         SigmaA = STEFAN_BOLTZMANN*Couple->Value;
+         G = 4.0*SigmaA*SC_SIM_TNET_REF_TEMP_K*SC_SIM_TNET_REF_TEMP_K*SC_SIM_TNET_REF_TEMP_K;
+         Tnet->Radiator[Tnet->RadiatorCnt].NodeA  = Couple->NodeA;
+         Tnet->Radiator[Tnet->RadiatorCnt].NodeB  = Couple->NodeB;
+         Tnet->Radiator[Tnet->RadiatorCnt].SigmaA = SigmaA;
+         Tnet->Radiator[Tnet->RadiatorCnt].HRef   = G;
+         Tnet->RadiatorCnt++;
+      }
+      else
+      {
+         G = Couple->Value;
+      }
+
+      SKY(Tnet, Tnet->K, Couple->NodeA, Couple->NodeA) += G;
+      if (Couple->NodeB == SC_SIM_TNET_SPACE)
+      {
+         Tnet->SpaceH[Couple->NodeA] += G;
+      }
+      else
+      {
+         Lo = (Couple->NodeA < Couple->NodeB) ? Couple->NodeA : Couple->NodeB;
+         Hi = (Couple->NodeA < Couple->NodeB) ? Couple->NodeB : Couple->NodeA;
+         SKY(Tnet, Tnet->K, Couple->NodeB, Couple->NodeB) += G;
+         SKY(Tnet, Tnet->K, Hi, Lo) -= G;
+      }
+
+   } /* End coupling loop */
+
+   if (NodeCntChanged) SC_SIM_TNET_InitTemps(Tnet);
+   for (i=0; i < NodeCnt; i++) Tnet->Power[i] = 0.0;
+
+   Tnet->FactorDt = 0.0;
+   Factor(Tnet, Dt);
+
+   CFE_EVS_SendEvent(SC_SIM_TNET_CONFIG_EID, CFE_EVS_EventType_INFORMATION,
+                     "Thermal network configured with %d nodes, %d couplings and %d skyline entries",
+                     NodeCnt, CouplingCnt, (int)SkylineCnt);
+
+   return true;
+
+} /* End SC_SIM_TNET_Config() */
+
+
+/******************************************************************************
+** Function: SC_SIM_TNET_InitTemps
+**
+*/
+void SC_SIM_TNET_InitTemps(SC_SIM_TNET_Class_t *Tnet)
+{
+
+   uint16 i;
+
+   for (i=0; i < Tnet->NodeCnt; i++)
+   {
+      Tnet->Temp[i] = Tnet->NodeDef[i].InitTemp + KELVIN_OFFSET;
+   }
+
+} /* End SC_SIM_TNET_InitTemps() */
+
+
+/******************************************************************************
+** Function: SC_SIM_TNET_SetEnvironment
+**
+*/
+void SC_SIM_TNET_SetEnvironment(SC_SIM_TNET_Class_t *Tnet, double SolarFlux,
+                                double AlbedoFlux, double EarthIrFlux)
+{
+
+   Tnet->SolarFlux   = SolarFlux;
+   Tnet->AlbedoFlux  = AlbedoFlux;
+   Tnet->EarthIrFlux = EarthIrFlux;
+
+} /* End SC_SIM_TNET_SetEnvironment() */
+
+
+/******************************************************************************
+** Function: SC_SIM_TNET_SetPower
+**
+*/
+void SC_SIM_TNET_SetPower(SC_SIM_TNET_Class_t *Tnet, uint16 Node, double Watts)
+{
+
+   if (Node < Tnet->NodeCnt) Tnet->Power[Node] = Watts;
+
+} /* End SC_SIM_TNET_SetPower() */
+
+
+/******************************************************************************
+** Function: SC_SIM_TNET_Step
+**
+** Notes:
+**   1. The right hand side is built in Temp[] and solved in place with the
+**      forward (L) and backward (L transpose) skyline substitutions.
+**
+*/
+void SC_SIM_TNET_Step(SC_SIM_TNET_Class_t *Tnet, double Dt)
+{
+
+   const SC_SIM_TNET_NodeDef_t *Node;
+   const SC_SIM_TNET_Radiator_t *Rad;
+   double *T = Tnet->Temp;
+   double RadQ[SC_SIM_TNET_MAX_NODES];
+   double TaK, TbK, Corr;
+   uint16 i, k;
+
+   if (Tnet->NodeCnt == 0 || Dt <= 0.0) return;
+
+   if (Dt != Tnet->FactorDt)
+   {
+      if (!Factor(Tnet, Dt)) return;
+   }
+
+   /* Radiative remainder beyond the linearized conductance, evaluated at T(n) */
+   for (i=0; i < Tnet->NodeCnt; i++) RadQ[i] = 0.0;
+   for (i=0; i < Tnet->RadiatorCnt; i++)
+   {
+      Rad = &Tnet->Radiator[i];
+      TaK = T[Rad->NodeA];
+      TbK = (Rad->NodeB == SC_SIM_TNET_SPACE) ? SC_SIM_TNET_SPACE_TEMP_K : T[Rad->NodeB];
+      Corr = Rad->SigmaA*(TaK*TaK*TaK*TaK - TbK*TbK*TbK*TbK) - Rad->HRef*(TaK - TbK);
+      RadQ[Rad->NodeA] -= Corr;
+      if (Rad->NodeB != SC_SIM_TNET_SPACE) RadQ[Rad->NodeB] += Corr;
+   }
+
+   for (i=0; i < Tnet->NodeCnt; i++)
+   {
+      Node = &Tnet->NodeDef[i];
+      T[i] = Tnet->Capacitance[i]/Dt*T[i] + Tnet->Power[i] + RadQ[i] +
+             Tnet->SolarFlux*Node->SolarArea + Tnet->AlbedoFlux*Node->AlbedoArea +
+             Tnet->EarthIrFlux*Node->IrArea + Tnet->SpaceH[i]*SC_SIM_TNET_SPACE_TEMP_K;
+   }
+
+   for (i=0; i < Tnet->NodeCnt; i++)
+   {
+      for (k=Tnet->FirstCol[i]; k < i; k++) T[i] -= SKY(Tnet, Tnet->L, i, k)*T[k];
+      T[i] /= SKY(Tnet, Tnet->L, i, i);
+   }
+
+   for (i=Tnet->NodeCnt; i-- > 0; )
+   {
+      T[i] /= SKY(Tnet, Tnet->L, i, i);
+      for (k=Tnet->FirstCol[i]; k < i; k++) T[k] -= SKY(Tnet, Tnet->L, i, k)*T[i];
+   }
+
+} /* End SC_SIM_TNET_Step() */
+
+
+/******************************************************************************
+** Function: SC_SIM_TNET_Derivatives
+**
+*/
+void SC_SIM_TNET_Derivatives(const SC_SIM_TNET_Class_t *Tnet, const double *T, double *DTdt)
+{
+
+   const SC_SIM_TNET_NodeDef_t *Node;
+   const SC_SIM_TNET_Radiator_t *Rad;
+   double TaK, TbK, Corr, Kik;
+   uint16 i, k;
+
+   for (i=0; i < Tnet->NodeCnt; i++)
+   {
+      Node = &Tnet->NodeDef[i];
+      DTdt[i] = Tnet->Power[i] + Tnet->SolarFlux*Node->SolarArea + Tnet->AlbedoFlux*Node->AlbedoArea +
+                Tnet->EarthIrFlux*Node->IrArea + Tnet->SpaceH[i]*SC_SIM_TNET_SPACE_TEMP_K;
+   }
+
+   /* Linear couplings, K is symmetric and only the lower profile is stored */
+   for (i=0; i < Tnet->NodeCnt; i++)
+   {
+      for (k=Tnet->FirstCol[i]; k < i; k++)
+      {
+         Kik = SKY(Tnet, Tnet->K, i, k);
+         DTdt[i] -= Kik*T[k];
+         DTdt[k] -= Kik*T[i];
+      }
+      DTdt[i] -= SKY(Tnet, Tnet->K, i, i)*T[i];
+   }
+
+   /* Radiative remainder beyond the linearized conductance */
+   for (i=0; i < Tnet->RadiatorCnt; i++)
+   {
+      Rad = &Tnet->Radiator[i];
+      TaK = T[Rad->NodeA];
+      TbK = (Rad->NodeB == SC_SIM_TNET_SPACE) ? SC_SIM_TNET_SPACE_TEMP_K : T[Rad->NodeB];
+      Corr = Rad->SigmaA*(TaK*TaK*TaK*TaK - TbK*TbK*TbK*TbK) - Rad->HRef*(TaK - TbK);
+      DTdt[Rad->NodeA] -= Corr;
+      if (Rad->NodeB != SC_SIM_TNET_SPACE) DTdt[Rad->NodeB] += Corr;
+   }
+
+   for (i=0; i < Tnet->NodeCnt; i++) DTdt[i] /= Tnet->Capacitance[i];
+
+} /* End SC_SIM_TNET_Derivatives() */
+
+
+/******************************************************************************
+** Function: SC_SIM_TNET_TempC
+**
+*/
+double SC_SIM_TNET_TempC(const SC_SIM_TNET_Class_t *Tnet, uint16 Node)
+{
+
+   return (Node < Tnet->NodeCnt) ? (Tnet->Temp[Node] - KELVIN_OFFSET) : 0.0;
+
+} /* End SC_SIM_TNET_TempC() */
+
+
+/******************************************************************************
+** Function: Factor
+**
+** Cholesky factor C/Dt + K in skyline form.
+**
+*/
+static bool Factor(SC_SIM_TNET_Class_t *Tnet, double Dt)
+{
+
+   double Sum;
+   uint16 i, j, k, k0;
+
+   for (i=0; i < Tnet->RowStart[Tnet->NodeCnt]; i++) Tnet->L[i] = Tnet->K[i];
+   for (i=0; i < Tnet->NodeCnt; i++) SKY(Tnet, Tnet->L, i, i) += Tnet->Capacitance[i]/Dt;
+
+   for (i=0; i < Tnet->NodeCnt; i++)
+   {
+      for (j=Tnet->FirstCol[i]; j <= i; j++)
+      {
+
+         Sum = SKY(Tnet, Tnet->L, i, j);
+         k0  = (Tnet->FirstCol[i] > Tnet->FirstCol[j]) ? Tnet->FirstCol[i] : Tnet->FirstCol[j];
+         for (k=k0; k < j; k++) Sum -= SKY(Tnet, Tnet->L, i, k)*SKY(Tnet, Tnet->L, j, k);
+
+         if (j < i)
+         {
+            SKY(Tnet, Tnet->L, i, j) = Sum/SKY(Tnet, Tnet->L, j, j);
+         }
+         else
+         {
+            if (Sum <= 0.0)
+            {
+               CFE_EVS_SendEvent(SC_SIM_TNET_FACTOR_EID, CFE_EVS_EventType_ERROR,
+                                 "Thermal network factorization failed at node %d, check for zero capacitance", i);
+               Tnet->FactorDt = 0.0;
+               return false;
+            }
+            SKY(Tnet, Tnet->L, i, i) = sqrt(Sum);
+         }
+
+      } /* End column loop */
+   } /* End row loop */
+
+   Tnet->FactorDt = Dt;
+   Tnet->FactorCnt++;
+
+   CFE_EVS_SendEvent(SC_SIM_TNET_FACTOR_EID, CFE_EVS_EventType_DEBUG,
+                     "Thermal network factored for a %.2f second step", Dt);
+
+   return true;
+
+} /* End Factor() */
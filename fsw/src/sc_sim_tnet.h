@@ -0,0 +1,239 @@
+/*
+**  Copyright 2023 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+** Purpose: Define a lumped parameter thermal network solver
+**
+** Notes:
+**   1. Nodes have a thermal capacitance and absorb solar, albedo, Earth IR
+**      and internally dissipated power. Nodes are coupled to each other
+**      and to space by conductive (W/K) and radiative (emissivity*area*
+**      view factor, m^2) couplings.
+**   2. Each step is a backward Euler solve of
+**         (C/dt + K) T(n+1) = C/dt T(n) + Q(T(n))
+**      K holds the conductances plus each radiative coupling linearized
+**      at SC_SIM_TNET_REF_TEMP_K. The remainder of the T^4 exchange is
+**      evaluated at T(n) and carried in Q. K doesn't depend on temperature
+**      so the matrix is factored once per configuration and step size.
+**   3. The matrix is symmetric positive definite and is stored and factored
+**      (Cholesky) in skyline form: each row holds the entries from its
+**      first coupled node to the diagonal. Fill is confined to the
+**      skyline so node order matters: number strongly coupled nodes close
+**      together to keep the profile small.
+**   4. Temperatures are kelvin internally and Celsius in the interface.
+**
+*/
+
+#ifndef _sc_sim_tnet_
+#define _sc_sim_tnet_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SC_SIM_TNET_MAX_NODES     (128)
+#define SC_SIM_TNET_MAX_COUPLINGS (512)
+#define SC_SIM_TNET_MAX_SKYLINE   (4096)  /* Stored matrix entries, worst case dense is N*(N+1)/2 */
+
+#define SC_SIM_TNET_SPACE         (0xFFFF) /* Coupling node ID for deep space */
+
+#define SC_SIM_TNET_REF_TEMP_K    (293.15)
+#define SC_SIM_TNET_SPACE_TEMP_K  (3.0)
+
+/*
+** Event Message IDs
+*/
+
+#define SC_SIM_TNET_CONFIG_EID    (SC_SIM_TNET_BASE_EID + 0)
+#define SC_SIM_TNET_FACTOR_EID    (SC_SIM_TNET_BASE_EID + 1)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+
+   SC_SIM_TNET_CONDUCTIVE = 0,
+   SC_SIM_TNET_RADIATIVE  = 1
+
+} SC_SIM_TNET_CouplingType_t;
+
+
+typedef struct
+{
+
+   const char *Name;
+   float  Capacitance;  /* J/K */
+   float  InitTemp;     /* Deg C */
+   float  SolarArea;    /* Absorptivity * projected area (m^2) */
+   float  AlbedoArea;   /* Absorptivity * area viewing Earth (m^2) */
+   float  IrArea;       /* Emissivity * area viewing Earth (m^2) */
+
+} SC_SIM_TNET_NodeDef_t;
+
+
+typedef struct
+{
+
+   uint16  NodeA;
+   uint16  NodeB;       /* Node index or SC_SIM_TNET_SPACE */
+   SC_SIM_TNET_CouplingType_t Type;
+   float   Value;       /* Conductance (W/K) or emissivity*area*view factor (m^2) */
+
+} SC_SIM_TNET_CouplingDef_t;
+
+
+typedef struct
+{
+
+   uint16  NodeA;
+   uint16  NodeB;
+   double  SigmaA;      /* Stefan-Boltzmann * Value */
+   double  HRef;        /* Linearized conductance in the matrix */
+
+} SC_SIM_TNET_Radiator_t;
+
+
+typedef struct
+{
+
+   /* Network */
+
+   uint16  NodeCnt;
+   const SC_SIM_TNET_NodeDef_t *NodeDef;
+
+   double  Capacitance[SC_SIM_TNET_MAX_NODES];
+   double  SpaceH[SC_SIM_TNET_MAX_NODES];      /* Linear conductance to space */
+
+   uint16  RadiatorCnt;
+   SC_SIM_TNET_Radiator_t Radiator[SC_SIM_TNET_MAX_COUPLINGS];
+
+   /* Skyline matrix storage */
+
+   uint16  FirstCol[SC_SIM_TNET_MAX_NODES];    /* First stored column of each row */
+   uint16  RowStart[SC_SIM_TNET_MAX_NODES+1];  /* Index of each row's first entry */
+   double  K[SC_SIM_TNET_MAX_SKYLINE];         /* Coupling matrix */
+   double  L[SC_SIM_TNET_MAX_SKYLINE];         /* Cholesky factor of C/dt + K */
+   double  FactorDt;                           /* Step size L was factored for, 0 if none */
+   uint32  FactorCnt;
+
+   /* State */
+
+   double  Temp[SC_SIM_TNET_MAX_NODES];        /* Kelvin */
+   double  Power[SC_SIM_TNET_MAX_NODES];       /* Internal dissipation (W) */
+   double  SolarFlux;                          /* Environment (W/m^2) */
+   double  AlbedoFlux;
+   double  EarthIrFlux;
+
+} SC_SIM_TNET_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SC_SIM_TNET_Config
+**
+** Build the coupling matrix for a network and factor it for step Dt.
+**
+** Notes:
+**   1. The node definitions must remain valid for the life of the network.
+**   2. Temperatures are only initialized if the node count changes. Use
+**      SC_SIM_TNET_InitTemps() to restart a network at its initial
+**      temperatures.
+**   3. Returns false if the network exceeds the storage limits or has an
+**      invalid coupling. The previous network is left unchanged.
+**
+*/
+bool SC_SIM_TNET_Config(SC_SIM_TNET_Class_t *Tnet,
+                        const SC_SIM_TNET_NodeDef_t *NodeDef, uint16 NodeCnt,
+                        const SC_SIM_TNET_CouplingDef_t *CouplingDef, uint16 CouplingCnt,
+                        double Dt);
+
+
+/******************************************************************************
+** Function: SC_SIM_TNET_InitTemps
+**
+** Set each node to its defined initial temperature.
+**
+*/
+void SC_SIM_TNET_InitTemps(SC_SIM_TNET_Class_t *Tnet);
+
+
+/******************************************************************************
+** Function: SC_SIM_TNET_SetEnvironment
+**
+** Set the solar, albedo and Earth IR fluxes (W/m^2) used by the next step.
+**
+*/
+void SC_SIM_TNET_SetEnvironment(SC_SIM_TNET_Class_t *Tnet, double SolarFlux,
+                                double AlbedoFlux, double EarthIrFlux);
+
+
+/******************************************************************************
+** Function: SC_SIM_TNET_SetPower
+**
+** Set a node's internally dissipated power (W) used by the next step.
+**
+*/
+void SC_SIM_TNET_SetPower(SC_SIM_TNET_Class_t *Tnet, uint16 Node, double Watts);
+
+
+/******************************************************************************
+** Function: SC_SIM_TNET_Step
+**
+** Advance the network temperatures by Dt seconds.
+**
+** Notes:
+**   1. The matrix is refactored if Dt differs from the factored step.
+**
+*/
+void SC_SIM_TNET_Step(SC_SIM_TNET_Class_t *Tnet, double Dt);
+
+
+/******************************************************************************
+** Function: SC_SIM_TNET_Derivatives
+**
+** Compute the rate of change (K/s) of temperatures T (kelvin) with the
+** current environment and dissipation.
+**
+** Notes:
+**   1. The continuous form of the network with the full T^4 radiative
+**      exchange so the network can be integrated by a general solver.
+**      T may be the network's own temperatures.
+**
+*/
+void SC_SIM_TNET_Derivatives(const SC_SIM_TNET_Class_t *Tnet, const double *T, double *DTdt);
+
+
+/******************************************************************************
+** Function: SC_SIM_TNET_TempC
+**
+** Return a node's temperature in Celsius.
+**
+*/
+double SC_SIM_TNET_TempC(const SC_SIM_TNET_Class_t *Tnet, uint16 Node);
+
+
+#endif /* _sc_sim_tnet_ */